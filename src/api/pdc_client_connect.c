@@ -45,6 +45,9 @@
 #include "mercury.h"
 #include "mercury_macros.h"
 #include "mercury_hl.h"
+#include "mercury_thread.h"
+#include "mercury_thread_condition.h"
+#include "mercury_thread_mutex.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -69,10 +72,14 @@ int                    pdc_client_mpi_size_g  = 1;
 #ifdef ENABLE_MPI
 MPI_Comm PDC_SAME_NODE_COMM_g;
 MPI_Comm PDC_CLIENT_COMM_WORLD_g;
+// Clients of a node that share a data server, the group merged by one aggregator
+static MPI_Comm PDC_SAME_SERVER_COMM_g;
 #endif
 
-int pdc_client_same_node_rank_g = 0;
-int pdc_client_same_node_size_g = 1;
+int        pdc_client_same_node_rank_g   = 0;
+int        pdc_client_same_node_size_g   = 1;
+static int pdc_client_same_server_rank_g = 0;
+static int pdc_client_same_server_size_g = 1;
 
 int pdc_server_num_g;
 int pdc_nclient_per_server_g = 0;
@@ -100,8 +107,19 @@ static hg_context_t *send_context_g     = NULL;
 static int           work_todo_g        = 0;
 int                  query_id_g         = 0;
 
+// Background progress of asynchronous RPCs, which are forwarded on their own context
+static hg_context_t *    async_context_g          = NULL;
+static hg_thread_t       progress_thread_g;
+static int               progress_thread_active_g = 0;
+static int               progress_thread_stop_g   = 0;
+static hg_thread_mutex_t async_mutex_g;
+static hg_thread_cond_t  async_cond_g;
+
 static hg_id_t client_test_connect_register_id_g;
 static hg_id_t gen_obj_register_id_g;
+static hg_id_t gen_obj_many_register_id_g;
+static hg_id_t kvtag_many_register_id_g;
+static hg_id_t meta_store_stats_register_id_g;
 static hg_id_t gen_cont_register_id_g;
 static hg_id_t close_server_register_id_g;
 static hg_id_t metadata_query_register_id_g;
@@ -124,6 +142,7 @@ static hg_id_t data_server_write_check_register_id_g;
 static hg_id_t data_server_write_register_id_g;
 static hg_id_t server_checkpoint_rpc_register_id_g;
 static hg_id_t send_shm_register_id_g;
+static hg_id_t detach_shm_register_id_g;
 
 // bulk
 static hg_id_t    query_partial_register_id_g;
@@ -134,6 +153,8 @@ hg_atomic_int32_t bulk_transfer_done_g;
 static hg_id_t transfer_request_register_id_g;
 static hg_id_t transfer_request_status_register_id_g;
 static hg_id_t transfer_request_wait_register_id_g;
+static hg_id_t obj_put_data_register_id_g;
+static hg_id_t obj_get_data_register_id_g;
 static hg_id_t buf_map_register_id_g;
 static hg_id_t buf_unmap_register_id_g;
 
@@ -160,13 +181,13 @@ pdc_data_server_io_list_t *client_cache_list_head_g = NULL;
 static inline uint32_t
 get_server_id_by_hash_name(const char *name)
 {
-    return (uint32_t)(PDC_get_hash_by_name(name) % pdc_server_num_g);
+    return PDC_get_server_by_name((char *)name, pdc_server_num_g);
 }
 
 static inline uint32_t
 get_server_id_by_obj_id(uint64_t obj_id)
 {
-    return (uint32_t)((obj_id / PDC_SERVER_ID_INTERVEL - 1) % pdc_server_num_g);
+    return PDC_get_server_by_obj_id(obj_id, pdc_server_num_g);
 }
 
 // Generic function to check the return value (RPC receipt) is 1
@@ -230,6 +251,93 @@ PDC_Client_check_response(hg_context_t **hg_context)
     FUNC_LEAVE(ret_value);
 }
 
+static HG_THREAD_RETURN_TYPE
+pdc_client_progress_thread(void *arg)
+{
+    hg_thread_ret_t ret_value = (hg_thread_ret_t)0;
+    hg_return_t     hg_ret;
+    unsigned int    actual_count;
+    int             stop;
+
+    FUNC_ENTER(NULL);
+
+    while (1) {
+        hg_thread_mutex_lock(&async_mutex_g);
+        stop = progress_thread_stop_g;
+        hg_thread_mutex_unlock(&async_mutex_g);
+        if (stop)
+            break;
+
+        do {
+            hg_ret = HG_Trigger(async_context_g, 0 /* timeout */, 1 /* max count */, &actual_count);
+        } while ((hg_ret == HG_SUCCESS) && actual_count);
+
+        hg_ret = HG_Progress(async_context_g, HG_MAX_IDLE_TIME);
+        if (hg_ret != HG_SUCCESS && hg_ret != HG_TIMEOUT) {
+            printf("==PDC_CLIENT[%d]: progress thread error with HG_Progress\n", pdc_client_mpi_rank_g);
+            fflush(stdout);
+            break;
+        }
+    }
+
+    FUNC_LEAVE(ret_value);
+}
+
+static perr_t
+PDC_Client_start_progress_thread()
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    async_context_g = HG_Context_create(send_class_g);
+    if (async_context_g == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: could not create progress context", pdc_client_mpi_rank_g);
+
+    hg_thread_mutex_init(&async_mutex_g);
+    hg_thread_cond_init(&async_cond_g);
+    progress_thread_stop_g = 0;
+    if (hg_thread_create(&progress_thread_g, pdc_client_progress_thread, NULL) != 0) {
+        hg_thread_cond_destroy(&async_cond_g);
+        hg_thread_mutex_destroy(&async_mutex_g);
+        HG_Context_destroy(async_context_g);
+        async_context_g = NULL;
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: could not create progress thread", pdc_client_mpi_rank_g);
+    }
+    progress_thread_active_g = 1;
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+static perr_t
+PDC_Client_stop_progress_thread()
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (progress_thread_active_g == 0)
+        PGOTO_DONE(ret_value);
+
+    hg_thread_mutex_lock(&async_mutex_g);
+    progress_thread_stop_g = 1;
+    hg_thread_mutex_unlock(&async_mutex_g);
+    hg_thread_join(progress_thread_g);
+    progress_thread_active_g = 0;
+
+    hg_thread_cond_destroy(&async_cond_g);
+    hg_thread_mutex_destroy(&async_mutex_g);
+    if (HG_Context_destroy(async_context_g) != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with HG_Context_destroy", pdc_client_mpi_rank_g);
+    async_context_g = NULL;
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Client_read_server_addr_from_file()
 {
@@ -281,6 +389,10 @@ PDC_Client_read_server_addr_from_file()
         return -1;
     }
 
+    // Metadata placement depends on the server count
+    if (PDC_hash_ring_init(pdc_server_num_g) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot build hash ring", pdc_client_mpi_rank_g);
+
     // Allocate $pdc_server_info_g
     pdc_server_info_g = (struct _pdc_server_info *)calloc(sizeof(struct _pdc_server_info), pdc_server_num_g);
 
@@ -342,6 +454,22 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+// Copy the data of a small read that came back with the response
+static void
+transfer_request_copy_inline(struct _pdc_transfer_request_args *args, transfer_request_out_t *output)
+{
+    if (output->inline_size == 0 || args->inline_dest == NULL)
+        return;
+
+    if (output->inline_size != args->inline_size) {
+        printf("PDC_CLIENT[%d]: inline read returned %u bytes, expected %" PRIu64 "\n", pdc_client_mpi_rank_g,
+               output->inline_size, args->inline_size);
+        args->ret = -1;
+        return;
+    }
+    memcpy(args->inline_dest, output->inline_buf, output->inline_size);
+}
+
 static hg_return_t
 client_send_transfer_request_rpc_cb(const struct hg_cb_info *callback_info)
 {
@@ -365,6 +493,7 @@ client_send_transfer_request_rpc_cb(const struct hg_cb_info *callback_info)
 
     region_transfer_args->ret         = output.ret;
     region_transfer_args->metadata_id = output.metadata_id;
+    transfer_request_copy_inline(region_transfer_args, &output);
 done:
     fflush(stdout);
     work_todo_g--;
@@ -373,6 +502,42 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+// Runs on the progress thread, records the acknowledgement in the pending start
+static hg_return_t
+client_send_transfer_request_async_rpc_cb(const struct hg_cb_info *callback_info)
+{
+    hg_return_t                         ret_value = HG_SUCCESS;
+    hg_handle_t                         handle;
+    struct _pdc_transfer_request_async *async;
+    transfer_request_out_t              output;
+
+    FUNC_ENTER(NULL);
+
+    async  = (struct _pdc_transfer_request_async *)callback_info->arg;
+    handle = callback_info->info.forward.handle;
+
+    ret_value = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS) {
+        printf("PDC_CLIENT[%d]: client_send_transfer_request_async_rpc_cb error with HG_Get_output\n",
+               pdc_client_mpi_rank_g);
+        async->args.ret = -1;
+    }
+    else {
+        async->args.ret         = output.ret;
+        async->args.metadata_id = output.metadata_id;
+        transfer_request_copy_inline(&async->args, &output);
+        HG_Free_output(handle, &output);
+    }
+
+    hg_thread_mutex_lock(&async_mutex_g);
+    async->completed = 1;
+    hg_thread_cond_broadcast(&async_cond_g);
+    hg_thread_mutex_unlock(&async_mutex_g);
+
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 static hg_return_t
 client_send_transfer_request_status_rpc_cb(const struct hg_cb_info *callback_info)
 {
@@ -772,60 +937,6 @@ done:
     FUNC_LEAVE(ret_value);
 }
 */
-// Bulk
-// Callback after bulk transfer is received by client
-static hg_return_t
-hg_test_bulk_transfer_cb(const struct hg_cb_info *hg_cb_info)
-{
-    hg_return_t         ret_value = HG_SUCCESS;
-    struct bulk_args_t *bulk_args;
-    hg_bulk_t           local_bulk_handle;
-    uint32_t            i;
-    void *              buf = NULL;
-    uint32_t            n_meta;
-    uint64_t            buf_sizes[2] = {0, 0};
-    uint32_t            actual_cnt;
-    pdc_metadata_t *    meta_ptr;
-
-    FUNC_ENTER(NULL);
-
-    bulk_args         = (struct bulk_args_t *)hg_cb_info->arg;
-    local_bulk_handle = hg_cb_info->info.bulk.local_handle;
-
-    if (hg_cb_info->ret == HG_CANCELED)
-        printf("HG_Bulk_transfer() was successfully canceled\n");
-    else if (hg_cb_info->ret != HG_SUCCESS)
-        PGOTO_ERROR(HG_PROTOCOL_ERROR, "Error in callback");
-
-    n_meta = bulk_args->n_meta;
-
-    if (hg_cb_info->ret == HG_SUCCESS) {
-        HG_Bulk_access(local_bulk_handle, 0, bulk_args->nbytes, HG_BULK_READWRITE, 1, &buf, buf_sizes,
-                       &actual_cnt);
-
-        meta_ptr            = (pdc_metadata_t *)(buf);
-        bulk_args->meta_arr = (pdc_metadata_t **)calloc(sizeof(pdc_metadata_t *), n_meta);
-        for (i = 0; i < n_meta; i++) {
-            bulk_args->meta_arr[i] = meta_ptr;
-            meta_ptr++;
-        }
-    }
-
-    bulk_todo_g--;
-    hg_atomic_set32(&bulk_transfer_done_g, 1);
-
-    // Free block handle
-    ret_value = HG_Bulk_free(local_bulk_handle);
-    if (ret_value != HG_SUCCESS)
-        PGOTO_ERROR(ret_value, "Could not free HG bulk handle");
-
-done:
-    fflush(stdout);
-    free(bulk_args);
-
-    FUNC_LEAVE(ret_value);
-}
-
 // Bulk
 // No need to have multi-threading
 int
@@ -982,6 +1093,9 @@ drc_access_again:
     // Register RPC
     client_test_connect_register_id_g = PDC_client_test_connect_register(*hg_class);
     gen_obj_register_id_g             = PDC_gen_obj_id_register(*hg_class);
+    gen_obj_many_register_id_g        = PDC_gen_obj_id_many_register(*hg_class);
+    kvtag_many_register_id_g          = PDC_kvtag_many_register(*hg_class);
+    meta_store_stats_register_id_g    = PDC_meta_store_stats_register(*hg_class);
     gen_cont_register_id_g            = PDC_gen_cont_id_register(*hg_class);
     close_server_register_id_g        = PDC_close_server_register(*hg_class);
     // HG_Registered_disable_response(*hg_class, close_server_register_id_g, HG_TRUE);
@@ -1006,6 +1120,7 @@ drc_access_again:
     data_server_write_register_id_g        = PDC_data_server_write_register(*hg_class);
     server_checkpoint_rpc_register_id_g    = PDC_server_checkpoint_rpc_register(*hg_class);
     send_shm_register_id_g                 = PDC_send_shm_register(*hg_class);
+    detach_shm_register_id_g               = PDC_detach_shm_register(*hg_class);
 
     // bulk
     query_partial_register_id_g = PDC_query_partial_register(*hg_class);
@@ -1021,6 +1136,8 @@ drc_access_again:
     transfer_request_register_id_g        = PDC_transfer_request_register(*hg_class);
     transfer_request_status_register_id_g = PDC_transfer_request_status_register(*hg_class);
     transfer_request_wait_register_id_g   = PDC_transfer_request_wait_register(*hg_class);
+    obj_put_data_register_id_g            = PDC_obj_put_data_register(*hg_class);
+    obj_get_data_register_id_g            = PDC_obj_get_data_register(*hg_class);
     buf_map_register_id_g                 = PDC_buf_map_register(*hg_class);
     buf_unmap_register_id_g               = PDC_buf_unmap_register(*hg_class);
 
@@ -1116,8 +1233,10 @@ PDC_Client_init()
     pdc_client_mpi_rank_g = 0;
     pdc_client_mpi_size_g = 1;
 
-    pdc_client_same_node_rank_g = 0;
-    pdc_client_same_node_size_g = 1;
+    pdc_client_same_node_rank_g   = 0;
+    pdc_client_same_node_size_g   = 1;
+    pdc_client_same_server_rank_g = 0;
+    pdc_client_same_server_size_g = 1;
 
 #ifdef ENABLE_MPI
     MPI_Initialized(&is_mpi_init);
@@ -1157,6 +1276,15 @@ PDC_Client_init()
     if (pdc_nclient_per_server_g <= 0)
         pdc_nclient_per_server_g = 1;
 
+#ifdef ENABLE_MPI
+    // A node can span several data servers, its clients are grouped by the server their data goes to
+    int data_server_id = (pdc_client_mpi_rank_g / pdc_nclient_per_server_g) % pdc_server_num_g;
+    MPI_Comm_split(PDC_SAME_NODE_COMM_g, data_server_id, pdc_client_same_node_rank_g,
+                   &PDC_SAME_SERVER_COMM_g);
+    MPI_Comm_rank(PDC_SAME_SERVER_COMM_g, &pdc_client_same_server_rank_g);
+    MPI_Comm_size(PDC_SAME_SERVER_COMM_g, &pdc_client_same_server_size_g);
+#endif
+
     PDC_set_execution_locus(CLIENT_MEMORY);
 
     if (pdc_client_mpi_rank_g == 0) {
@@ -1188,6 +1316,13 @@ PDC_Client_init()
                pdc_client_tmp_dir_g, pdc_nclient_per_server_g);
     }
 
+    // Make progress on region transfer requests in the background
+    tmp_dir = getenv("PDC_CLIENT_PROGRESS_THREAD");
+    if (tmp_dir != NULL && atoi(tmp_dir) > 0 && progress_thread_active_g == 0) {
+        if (PDC_Client_start_progress_thread() != SUCCEED)
+            printf("==PDC_CLIENT[%d]: could not start progress thread\n", pdc_client_mpi_rank_g);
+    }
+
     srand(time(NULL));
 
 done:
@@ -1216,177 +1351,888 @@ PDC_Client_destroy_all_handles()
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDC_Client_finalize()
+/*
+ * Shared memory arena registered with the data server when it runs on the same node. Region data is
+ * staged in blocks carved out of the arena (first fit, each prefixed with its size) and the server
+ * reads/writes them in place instead of pulling/pushing a bulk transfer.
+ */
+typedef struct pdc_shm_arena_block_t {
+    uint64_t                      offset;
+    uint64_t                      size;
+    struct pdc_shm_arena_block_t *prev;
+    struct pdc_shm_arena_block_t *next;
+} pdc_shm_arena_block_t;
+
+static char                   shm_arena_addr_g[ADDR_MAX];
+static char *                 shm_arena_base_g   = NULL;
+static uint64_t               shm_arena_size_g   = 0;
+static int                    shm_arena_state_g  = 0; // 0: not tried, 1: active, -1: disabled
+static pdc_shm_arena_block_t *shm_arena_free_g   = NULL;
+static uint64_t               shm_arena_token_g  = 0; // MPI ranks repeat across applications, this does not
+static uint32_t               shm_arena_server_g = 0;
+
+static int
+shm_arena_block_cmp(pdc_shm_arena_block_t *a, pdc_shm_arena_block_t *b)
 {
-    hg_return_t hg_ret;
-    perr_t      ret_value = SUCCEED;
-    int         i;
+    return a->offset < b->offset ? -1 : (a->offset > b->offset ? 1 : 0);
+}
 
-    FUNC_ENTER(NULL);
+static void
+shm_arena_release()
+{
+    pdc_shm_arena_block_t *elt, *tmp;
 
-    // Finalize Mercury
-    for (i = 0; i < pdc_server_num_g; i++) {
-        if (pdc_server_info_g[i].addr_valid) {
-            HG_Addr_free(send_class_g, pdc_server_info_g[i].addr);
-            pdc_server_info_g[i].addr_valid = 0;
-        }
+    // Let the server unmap the arena now rather than when it shuts down
+    if (shm_arena_state_g == 1) {
+        PDC_Client_detach_client_shm(shm_arena_server_g, shm_arena_token_g);
+        shm_arena_state_g = -1;
     }
+    if (shm_arena_base_g != NULL) {
+        munmap(shm_arena_base_g, shm_arena_size_g);
+        shm_unlink(shm_arena_addr_g);
+        shm_arena_base_g = NULL;
+    }
+    DL_FOREACH_SAFE(shm_arena_free_g, elt, tmp)
+    {
+        DL_DELETE(shm_arena_free_g, elt);
+        free(elt);
+    }
+}
 
-    if (pdc_server_info_g != NULL)
-        free(pdc_server_info_g);
+static perr_t
+shm_arena_init(uint32_t server_id)
+{
+    perr_t                  ret_value = SUCCEED;
+    pdc_shm_arena_header_t *header;
+    pdc_shm_arena_block_t * block;
+    uint64_t                size_mb = PDC_SHM_ARENA_DEFAULT_MB;
+    char *                  env;
+    struct timeval          now;
 
-#ifndef ENABLE_MPI
-    for (i = 0; i < pdc_server_num_g; i++) {
-        printf("  Server%3d, %d\n", i, debug_server_id_count[i]);
-    }
-#endif
-    // free debug info
-    if (debug_server_id_count != NULL)
-        free(debug_server_id_count);
+    FUNC_ENTER(NULL);
 
-#ifdef ENABLE_TIMING
-    if (pdc_client_mpi_rank_g == 0)
-        printf("==PDC_CLIENT[%d]: T_memcpy: %.2f\n", pdc_client_mpi_rank_g, memcpy_time_g);
-#endif
+    shm_arena_state_g = -1;
 
-    hg_ret = HG_Context_destroy(send_context_g);
-    if (hg_ret != HG_SUCCESS)
-        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with HG_Context_destroy", pdc_client_mpi_rank_g);
+    env = getenv("PDC_SHM_ARENA_SIZE_MB");
+    if (env != NULL)
+        size_mb = strtoull(env, NULL, 10);
+    if (size_mb == 0)
+        PGOTO_DONE(FAIL);
 
-    hg_ret = HG_Finalize(send_class_g);
-    if (hg_ret != HG_SUCCESS)
-        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with HG_Finalize", pdc_client_mpi_rank_g);
+    shm_arena_size_g = size_mb * 1048576;
+    if (PDC_create_shm_segment_ind(shm_arena_size_g, shm_arena_addr_g, (void **)&shm_arena_base_g) !=
+        SUCCEED) {
+        shm_arena_base_g = NULL;
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: failed to create shared memory arena", pdc_client_mpi_rank_g);
+    }
+
+    // pid plus a nonce, so a later process reusing the pid does not match an arena the server still maps
+    gettimeofday(&now, NULL);
+    shm_arena_token_g = ((uint64_t)now.tv_sec * 1000000 + now.tv_usec) ^ (uint64_t)shm_arena_base_g;
+    shm_arena_token_g = ((uint64_t)getpid() << 32) | (shm_arena_token_g & 0xffffffff);
+    shm_arena_server_g = server_id;
+
+    header        = (pdc_shm_arena_header_t *)shm_arena_base_g;
+    header->magic = PDC_SHM_ARENA_MAGIC;
+    header->size  = shm_arena_size_g;
+    header->token = shm_arena_token_g;
+
+    block         = (pdc_shm_arena_block_t *)calloc(1, sizeof(pdc_shm_arena_block_t));
+    block->offset = PDC_SHM_ARENA_ALIGN;
+    block->size   = shm_arena_size_g - PDC_SHM_ARENA_ALIGN;
+    DL_APPEND(shm_arena_free_g, block);
+
+    // The server only accepts the arena if it can map it, i.e. it runs on the same node
+    if (PDC_Client_send_client_shm_info(server_id, shm_arena_addr_g, shm_arena_size_g, shm_arena_token_g) !=
+        SUCCEED) {
+        shm_arena_release();
+        if (is_client_debug_g == 1)
+            printf("==PDC_CLIENT[%d]: server %u did not attach the shared memory arena\n",
+                   pdc_client_mpi_rank_g, server_id);
+        PGOTO_DONE(FAIL);
+    }
+
+    shm_arena_state_g = 1;
 
 done:
     fflush(stdout);
     FUNC_LEAVE(ret_value);
 }
 
-// Bulk
-static hg_return_t
-metadata_query_bulk_cb(const struct hg_cb_info *callback_info)
+static char *
+shm_arena_alloc(uint64_t size)
 {
-    hg_return_t                   ret_value;
-    struct bulk_args_t *          client_lookup_args;
-    hg_handle_t                   handle;
-    metadata_query_transfer_out_t output;
-    uint32_t                      n_meta;
-    hg_op_id_t                    hg_bulk_op_id;
-    hg_bulk_t                     local_bulk_handle  = HG_BULK_NULL;
-    hg_bulk_t                     origin_bulk_handle = HG_BULK_NULL;
-    const struct hg_info *        hg_info            = NULL;
-    struct bulk_args_t *          bulk_args;
-    void *                        recv_meta;
+    pdc_shm_arena_block_t *elt;
+    uint64_t               need;
+    char *                 ptr;
 
-    FUNC_ENTER(NULL);
+    need = (size + PDC_SHM_ARENA_ALIGN - 1) / PDC_SHM_ARENA_ALIGN * PDC_SHM_ARENA_ALIGN;
+    need += PDC_SHM_ARENA_ALIGN;
+    DL_FOREACH(shm_arena_free_g, elt)
+    {
+        if (elt->size < need)
+            continue;
+        ptr = shm_arena_base_g + elt->offset;
+        if (elt->size - need >= 2 * PDC_SHM_ARENA_ALIGN) {
+            elt->offset += need;
+            elt->size -= need;
+        }
+        else {
+            need = elt->size;
+            DL_DELETE(shm_arena_free_g, elt);
+            free(elt);
+        }
+        *((uint64_t *)ptr) = need;
+        return ptr + PDC_SHM_ARENA_ALIGN;
+    }
+    return NULL;
+}
 
-    client_lookup_args = (struct bulk_args_t *)callback_info->arg;
-    handle             = callback_info->info.forward.handle;
+static inline int
+shm_arena_owns(char *ptr)
+{
+    return shm_arena_base_g != NULL && ptr >= shm_arena_base_g && ptr < shm_arena_base_g + shm_arena_size_g;
+}
 
-    // Get output from server
-    ret_value = HG_Get_output(handle, &output);
-    if (ret_value != HG_SUCCESS)
-        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: - error HG_Get_output", pdc_client_mpi_rank_g);
+static void
+shm_arena_free(char *ptr)
+{
+    pdc_shm_arena_block_t *block, *neighbor;
 
-    n_meta                     = output.ret;
-    client_lookup_args->n_meta = n_meta;
-    if (n_meta == 0) {
-        client_lookup_args->meta_arr = NULL;
-        PGOTO_DONE(ret_value);
+    block         = (pdc_shm_arena_block_t *)calloc(1, sizeof(pdc_shm_arena_block_t));
+    block->offset = ptr - PDC_SHM_ARENA_ALIGN - shm_arena_base_g;
+    block->size   = *((uint64_t *)(shm_arena_base_g + block->offset));
+    DL_INSERT_INORDER(shm_arena_free_g, block, shm_arena_block_cmp);
+
+    // Coalesce with the following and preceding free blocks
+    neighbor = block->next;
+    if (neighbor != NULL && block->offset + block->size == neighbor->offset) {
+        block->size += neighbor->size;
+        DL_DELETE(shm_arena_free_g, neighbor);
+        free(neighbor);
     }
-    else
-        client_lookup_args->meta_arr = (pdc_metadata_t **)calloc(n_meta, sizeof(pdc_metadata_t *));
+    neighbor = block->prev;
+    if (block != shm_arena_free_g && neighbor->offset + neighbor->size == block->offset) {
+        neighbor->size += block->size;
+        DL_DELETE(shm_arena_free_g, block);
+        free(block);
+    }
+}
 
-    // We have received the bulk handle from server (server uses hg_respond)
-    // Use this to initiate a bulk transfer
-    origin_bulk_handle = output.bulk_handle;
-    hg_info            = HG_Get_info(handle);
+/*
+ * Registration cache for bulk handles on application buffers, keyed by (address, length, access).
+ * Registering memory is expensive with RDMA transports and the same buffers are usually transferred
+ * every timestep. Entries are kept in LRU order and only entries not referenced by an in-flight
+ * transfer or mapping are evicted, so that the total registered size stays under the configured limit.
+ */
+typedef struct pdc_bulk_cache_entry_t {
+    void *                         addr;
+    hg_size_t                      size;
+    hg_uint8_t                     flags;
+    hg_bulk_t                      handle;
+    int                            refcount;
+    struct pdc_bulk_cache_entry_t *prev;
+    struct pdc_bulk_cache_entry_t *next;
+} pdc_bulk_cache_entry_t;
+
+/* Buffer mapped with PDC_Client_buf_map through the cache, released on unmap */
+typedef struct pdc_bulk_cache_map_t {
+    pdcid_t                      remote_obj_id;
+    struct pdc_region_info *     remote_region;
+    void *                       addr;
+    struct pdc_bulk_cache_map_t *prev;
+    struct pdc_bulk_cache_map_t *next;
+} pdc_bulk_cache_map_t;
+
+static pdc_bulk_cache_entry_t *bulk_cache_head_g   = NULL;
+static pdc_bulk_cache_map_t *  bulk_cache_maps_g   = NULL;
+static int                     bulk_cache_state_g  = 0; // 0: not configured, 1: active, -1: disabled
+static hg_size_t               bulk_cache_limit_g  = 0;
+static hg_size_t               bulk_cache_pinned_g = 0;
+static pdc_bulk_cache_stats_t  bulk_cache_stats_g;
 
-    bulk_args = (struct bulk_args_t *)malloc(sizeof(struct bulk_args_t));
+static void
+bulk_cache_evict(pdc_bulk_cache_entry_t *entry)
+{
+    DL_DELETE(bulk_cache_head_g, entry);
+    HG_Bulk_free(entry->handle);
+    bulk_cache_pinned_g -= entry->size;
+    bulk_cache_stats_g.n_evict++;
+    free(entry);
+}
 
-    bulk_args->handle = handle;
-    bulk_args->nbytes = HG_Bulk_get_size(origin_bulk_handle);
-    bulk_args->n_meta = client_lookup_args->n_meta;
+/*
+ * Get a bulk handle for a single contiguous buffer, from the cache when possible. The handle stays
+ * referenced until bulk_cache_release() is called with the same address.
+ */
+static hg_return_t
+bulk_cache_acquire(hg_class_t *hg_class, void *addr, hg_size_t size, hg_uint8_t flags, hg_bulk_t *handle)
+{
+    hg_return_t             ret_value = HG_SUCCESS;
+    pdc_bulk_cache_entry_t *entry, *tmp;
+    char *                  env;
 
-    recv_meta = (void *)calloc(sizeof(pdc_metadata_t), n_meta);
+    FUNC_ENTER(NULL);
 
-    /* Create a new bulk handle to read the data */
-    HG_Bulk_create(hg_info->hg_class, 1, (void **)&recv_meta, (hg_size_t *)&bulk_args->nbytes,
-                   HG_BULK_READWRITE, &local_bulk_handle);
+    if (bulk_cache_state_g == 0) {
+        bulk_cache_state_g = -1;
+        env                = getenv("PDC_BULK_CACHE_SIZE_MB");
+        if (env != NULL && strtoull(env, NULL, 10) > 0) {
+            bulk_cache_limit_g = strtoull(env, NULL, 10) * 1048576;
+            bulk_cache_state_g = 1;
+        }
+    }
 
-    /* Pull bulk data */
-    ret_value =
-        HG_Bulk_transfer(hg_info->context, hg_test_bulk_transfer_cb, bulk_args, HG_BULK_PULL, hg_info->addr,
-                         origin_bulk_handle, 0, local_bulk_handle, 0, bulk_args->nbytes, &hg_bulk_op_id);
+    if (bulk_cache_state_g != 1 || size > bulk_cache_limit_g) {
+        ret_value = HG_Bulk_create(hg_class, 1, &addr, &size, flags, handle);
+        PGOTO_DONE(ret_value);
+    }
+
+    DL_FOREACH(bulk_cache_head_g, entry)
+    {
+        if (entry->addr == addr && entry->size == size && entry->flags == flags) {
+            // Move to the front of the LRU list
+            DL_DELETE(bulk_cache_head_g, entry);
+            DL_PREPEND(bulk_cache_head_g, entry);
+            entry->refcount++;
+            bulk_cache_stats_g.n_hit++;
+            *handle = entry->handle;
+            PGOTO_DONE(ret_value);
+        }
+    }
+    bulk_cache_stats_g.n_miss++;
+
+    // Evict least recently used entries that are not in use until the new registration fits
+    if (bulk_cache_head_g != NULL) {
+        entry = bulk_cache_head_g->prev;
+        while (bulk_cache_pinned_g + size > bulk_cache_limit_g) {
+            tmp = (entry == bulk_cache_head_g) ? NULL : entry->prev;
+            if (entry->refcount == 0)
+                bulk_cache_evict(entry);
+            if (tmp == NULL)
+                break;
+            entry = tmp;
+        }
+    }
+
+    ret_value = HG_Bulk_create(hg_class, 1, &addr, &size, flags, handle);
     if (ret_value != HG_SUCCESS)
-        PGOTO_ERROR(ret_value, "Could not read bulk data");
+        PGOTO_DONE(ret_value);
 
-    // loop
-    bulk_todo_g = 1;
-    PDC_Client_check_bulk(send_context_g);
+    // Everything left is in use, hand out an uncached handle
+    if (bulk_cache_pinned_g + size > bulk_cache_limit_g)
+        PGOTO_DONE(ret_value);
 
-    client_lookup_args->meta_arr = bulk_args->meta_arr;
+    entry           = (pdc_bulk_cache_entry_t *)calloc(1, sizeof(pdc_bulk_cache_entry_t));
+    entry->addr     = addr;
+    entry->size     = size;
+    entry->flags    = flags;
+    entry->handle   = *handle;
+    entry->refcount = 1;
+    DL_PREPEND(bulk_cache_head_g, entry);
+    bulk_cache_pinned_g += size;
+    if (bulk_cache_pinned_g > bulk_cache_stats_g.max_pinned_size)
+        bulk_cache_stats_g.max_pinned_size = bulk_cache_pinned_g;
 
 done:
-    fflush(stdout);
-    work_todo_g--;
-    HG_Free_output(handle, &output);
-
     FUNC_LEAVE(ret_value);
 }
 
-// bulk test
-perr_t
-PDC_Client_list_all(int *n_res, pdc_metadata_t ***out)
+// Drop the reference taken by bulk_cache_acquire(), the handle stays registered for reuse
+static void
+bulk_cache_release(void *addr)
 {
-    perr_t ret_value;
+    pdc_bulk_cache_entry_t *entry;
 
-    FUNC_ENTER(NULL);
+    DL_FOREACH(bulk_cache_head_g, entry)
+    {
+        if (entry->addr == addr && entry->refcount > 0) {
+            entry->refcount--;
+            break;
+        }
+    }
+}
 
-    ret_value = PDC_partial_query(1, -1, NULL, NULL, -1, -1, -1, NULL, n_res, out);
+// Drop registrations of a memory range that is about to be unmapped
+static void
+bulk_cache_invalidate(void *addr, hg_size_t size)
+{
+    pdc_bulk_cache_entry_t *entry, *tmp;
 
-    FUNC_LEAVE(ret_value);
+    DL_FOREACH_SAFE(bulk_cache_head_g, entry, tmp)
+    {
+        if ((char *)entry->addr < (char *)addr + size && (char *)entry->addr + entry->size > (char *)addr)
+            bulk_cache_evict(entry);
+    }
 }
 
-perr_t
-PDC_partial_query(int is_list_all, int user_id, const char *app_name, const char *obj_name,
-                  int time_step_from, int time_step_to, int ndim, const char *tags, int *n_res,
-                  pdc_metadata_t ***out)
+static void
+bulk_cache_finalize()
 {
-    perr_t             ret_value = SUCCEED;
-    hg_return_t        hg_ret;
-    int                n_recv = 0;
-    uint32_t           i, server_id = 0, my_server_start, my_server_end, my_server_count;
-    size_t             out_size = 0;
-    hg_handle_t        query_partial_handle;
-    struct bulk_args_t lookup_args;
-
-    FUNC_ENTER(NULL);
+    pdc_bulk_cache_entry_t *entry, *tmp;
+    pdc_bulk_cache_map_t *  map, *map_tmp;
 
-    // Fill input structure
-    metadata_query_transfer_in_t in;
-    in.is_list_all    = is_list_all;
-    in.user_id        = -1;
-    in.app_name       = " ";
-    in.obj_name       = " ";
-    in.time_step_from = -1;
-    in.time_step_to   = -1;
-    in.ndim           = -1;
-    in.tags           = " ";
+    if (bulk_cache_state_g == 1 && is_client_debug_g == 1)
+        printf("==PDC_CLIENT[%d]: bulk cache %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64
+               " evictions, max %" PRIu64 " bytes registered\n",
+               pdc_client_mpi_rank_g, bulk_cache_stats_g.n_hit, bulk_cache_stats_g.n_miss,
+               bulk_cache_stats_g.n_evict, bulk_cache_stats_g.max_pinned_size);
 
-    if (is_list_all != 1) {
-        in.user_id        = user_id;
-        in.ndim           = ndim;
-        in.time_step_from = time_step_from;
-        in.time_step_to   = time_step_to;
-        if (app_name != NULL)
-            in.app_name = app_name;
+    DL_FOREACH_SAFE(bulk_cache_head_g, entry, tmp)
+    {
+        bulk_cache_evict(entry);
+    }
+    DL_FOREACH_SAFE(bulk_cache_maps_g, map, map_tmp)
+    {
+        DL_DELETE(bulk_cache_maps_g, map);
+        free(map);
+    }
+}
+
+perr_t
+PDC_Client_bulk_cache_get_stats(pdc_bulk_cache_stats_t *stats)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (stats == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: NULL stats", pdc_client_mpi_rank_g);
+    *stats = bulk_cache_stats_g;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Cache of metadata returned by name queries, indexed by name and time step and by object ID. An
+ * entry is used until its lease, set with PDC_METADATA_CACHE_LEASE in seconds, runs out, so updates
+ * made by other clients are seen at most one lease late. Updates and deletes issued by this client
+ * drop the affected entry right away.
+ */
+#define PDC_META_CACHE_NBUCKET   1024
+#define PDC_META_CACHE_MAX_ENTRY 65536
+
+typedef struct pdc_meta_cache_entry_t {
+    pdc_metadata_t *               meta; // with its strings, from PDC_metadata_dup
+    double                         expire_time;
+    struct pdc_meta_cache_entry_t *name_prev; // chain of the name bucket
+    struct pdc_meta_cache_entry_t *name_next;
+    struct pdc_meta_cache_entry_t *id_prev; // chain of the ID bucket
+    struct pdc_meta_cache_entry_t *id_next;
+    struct pdc_meta_cache_entry_t *prev; // LRU list
+    struct pdc_meta_cache_entry_t *next;
+} pdc_meta_cache_entry_t;
+
+static pdc_meta_cache_entry_t *   meta_cache_name_bucket_g[PDC_META_CACHE_NBUCKET];
+static pdc_meta_cache_entry_t *   meta_cache_id_bucket_g[PDC_META_CACHE_NBUCKET];
+static pdc_meta_cache_entry_t *   meta_cache_head_g    = NULL;
+static int                        meta_cache_state_g   = 0; // 0: not configured, 1: active, -1: disabled
+static double                     meta_cache_lease_g   = 0.0;
+static int                        meta_cache_n_entry_g = 0;
+static pdc_metadata_cache_stats_t meta_cache_stats_g;
+
+static inline int
+meta_cache_active()
+{
+    char *env;
+
+    if (meta_cache_state_g == 0) {
+        meta_cache_state_g = -1;
+        env                = getenv("PDC_METADATA_CACHE_LEASE");
+        if (env != NULL && strtod(env, NULL) > 0) {
+            meta_cache_lease_g = strtod(env, NULL);
+            meta_cache_state_g = 1;
+        }
+    }
+
+    return meta_cache_state_g == 1;
+}
+
+static inline double
+meta_cache_now()
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+static inline uint32_t
+meta_cache_name_bucket(const char *obj_name, int time_step)
+{
+    return (PDC_get_hash_by_name(obj_name) + (uint32_t)time_step) % PDC_META_CACHE_NBUCKET;
+}
+
+static inline uint32_t
+meta_cache_id_bucket(uint64_t obj_id)
+{
+    return (uint32_t)((obj_id * 0x9e3779b97f4a7c15ULL) >> 32) % PDC_META_CACHE_NBUCKET;
+}
+
+static void
+meta_cache_remove(pdc_meta_cache_entry_t *entry)
+{
+    pdc_metadata_t *meta = entry->meta;
+
+    DL_DELETE2(meta_cache_name_bucket_g[meta_cache_name_bucket(meta->obj_name, meta->time_step)], entry,
+               name_prev, name_next);
+    DL_DELETE2(meta_cache_id_bucket_g[meta_cache_id_bucket(meta->obj_id)], entry, id_prev, id_next);
+    DL_DELETE(meta_cache_head_g, entry);
+    meta_cache_n_entry_g--;
+    free(meta);
+    free(entry);
+}
+
+// Find the entry of an object by name and time step, expired entries are dropped
+static pdc_meta_cache_entry_t *
+meta_cache_find_name(const char *obj_name, int time_step)
+{
+    pdc_meta_cache_entry_t *entry;
+
+    DL_FOREACH2(meta_cache_name_bucket_g[meta_cache_name_bucket(obj_name, time_step)], entry, name_next)
+    {
+        if (entry->meta->time_step == time_step && strcmp(entry->meta->obj_name, obj_name) == 0)
+            break;
+    }
+    if (entry != NULL && entry->expire_time < meta_cache_now()) {
+        meta_cache_stats_g.n_expire++;
+        meta_cache_remove(entry);
+        entry = NULL;
+    }
+
+    return entry;
+}
+
+static pdc_meta_cache_entry_t *
+meta_cache_find_id(uint64_t obj_id)
+{
+    pdc_meta_cache_entry_t *entry;
+
+    DL_FOREACH2(meta_cache_id_bucket_g[meta_cache_id_bucket(obj_id)], entry, id_next)
+    {
+        if (entry->meta->obj_id == obj_id)
+            break;
+    }
+
+    return entry;
+}
+
+// Cache a copy of metadata received from a server, replacing the older entries of the object
+static void
+meta_cache_insert(pdc_metadata_t *meta)
+{
+    pdc_meta_cache_entry_t *entry;
+
+    if (!meta_cache_active() || meta == NULL || meta->obj_name == NULL)
+        return;
+
+    if ((entry = meta_cache_find_name(meta->obj_name, meta->time_step)) != NULL)
+        meta_cache_remove(entry);
+    if ((entry = meta_cache_find_id(meta->obj_id)) != NULL)
+        meta_cache_remove(entry);
+    if (meta_cache_n_entry_g >= PDC_META_CACHE_MAX_ENTRY) {
+        meta_cache_stats_g.n_evict++;
+        meta_cache_remove(meta_cache_head_g->prev);
+    }
+
+    entry = (pdc_meta_cache_entry_t *)calloc(1, sizeof(pdc_meta_cache_entry_t));
+    if (entry == NULL)
+        return;
+    entry->meta = PDC_metadata_dup(meta);
+    if (entry->meta == NULL) {
+        free(entry);
+        return;
+    }
+    // Lists are not kept so a copy given out never shares them
+    entry->meta->kvtag_list_head          = NULL;
+    entry->meta->storage_region_list_head = NULL;
+    entry->meta->region_lock_head         = NULL;
+    entry->meta->region_map_head          = NULL;
+    entry->meta->region_buf_map_head      = NULL;
+    entry->meta->obj_hist                 = NULL;
+    entry->meta->prev                     = NULL;
+    entry->meta->next                     = NULL;
+    entry->meta->bloom                    = NULL;
+    entry->expire_time                    = meta_cache_now() + meta_cache_lease_g;
+
+    DL_PREPEND2(meta_cache_name_bucket_g[meta_cache_name_bucket(meta->obj_name, meta->time_step)], entry,
+                name_prev, name_next);
+    DL_PREPEND2(meta_cache_id_bucket_g[meta_cache_id_bucket(meta->obj_id)], entry, id_prev, id_next);
+    DL_PREPEND(meta_cache_head_g, entry);
+    meta_cache_n_entry_g++;
+}
+
+// Get a copy of cached metadata, the caller owns it like the result of a query
+static pdc_metadata_t *
+meta_cache_get(const char *obj_name, int time_step)
+{
+    pdc_meta_cache_entry_t *entry;
+    pdc_metadata_t *        ret_value = NULL;
+
+    if (!meta_cache_active())
+        return NULL;
+
+    entry = meta_cache_find_name(obj_name, time_step);
+    if (entry == NULL) {
+        meta_cache_stats_g.n_miss++;
+        return NULL;
+    }
+
+    ret_value = PDC_metadata_dup(entry->meta);
+    if (ret_value == NULL)
+        return NULL;
+    meta_cache_stats_g.n_hit++;
+    DL_DELETE(meta_cache_head_g, entry);
+    DL_PREPEND(meta_cache_head_g, entry);
+
+    return ret_value;
+}
+
+static void
+meta_cache_invalidate_id(uint64_t obj_id)
+{
+    pdc_meta_cache_entry_t *entry;
+
+    if (meta_cache_state_g != 1)
+        return;
+    if ((entry = meta_cache_find_id(obj_id)) != NULL) {
+        meta_cache_stats_g.n_invalidate++;
+        meta_cache_remove(entry);
+    }
+}
+
+static void
+meta_cache_invalidate_name(const char *obj_name, int time_step)
+{
+    pdc_meta_cache_entry_t *entry;
+
+    if (meta_cache_state_g != 1)
+        return;
+    if ((entry = meta_cache_find_name(obj_name, time_step)) != NULL) {
+        meta_cache_stats_g.n_invalidate++;
+        meta_cache_remove(entry);
+    }
+}
+
+static void
+meta_cache_finalize()
+{
+    if (meta_cache_state_g == 1 && is_client_debug_g == 1)
+        printf("==PDC_CLIENT[%d]: metadata cache %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64
+               " expired, %" PRIu64 " invalidated, %" PRIu64 " evicted\n",
+               pdc_client_mpi_rank_g, meta_cache_stats_g.n_hit, meta_cache_stats_g.n_miss,
+               meta_cache_stats_g.n_expire, meta_cache_stats_g.n_invalidate, meta_cache_stats_g.n_evict);
+
+    while (meta_cache_head_g != NULL)
+        meta_cache_remove(meta_cache_head_g);
+}
+
+perr_t
+PDC_Client_metadata_cache_get_stats(pdc_metadata_cache_stats_t *stats)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (stats == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: NULL stats", pdc_client_mpi_rank_g);
+    *stats = meta_cache_stats_g;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Client_metadata_cache_clear()
+{
+    FUNC_ENTER(NULL);
+
+    while (meta_cache_head_g != NULL) {
+        meta_cache_stats_g.n_invalidate++;
+        meta_cache_remove(meta_cache_head_g);
+    }
+
+    FUNC_LEAVE(SUCCEED);
+}
+
+/*
+ * Partial queries are answered a page at a time: a server serializes as many results as fit in the
+ * client page buffer, pushes them into it and returns the cursor to resume from. The buffer is
+ * registered once and reused for every page, its size is set with PDC_QUERY_PAGE_SIZE_KB.
+ */
+#define PDC_QUERY_PAGE_SIZE_DEFAULT 1048576
+
+static char *    query_page_buf_g  = NULL;
+static hg_size_t query_page_size_g = 0;
+static hg_bulk_t query_page_bulk_g = HG_BULK_NULL;
+
+static perr_t
+query_page_buf_init()
+{
+    perr_t ret_value = SUCCEED;
+    char * env;
+
+    FUNC_ENTER(NULL);
+
+    if (query_page_buf_g != NULL)
+        PGOTO_DONE(ret_value);
+
+    query_page_size_g = PDC_QUERY_PAGE_SIZE_DEFAULT;
+    env               = getenv("PDC_QUERY_PAGE_SIZE_KB");
+    if (env != NULL && atol(env) > 0)
+        query_page_size_g = (hg_size_t)atol(env) * 1024;
+
+    query_page_buf_g = (char *)malloc(query_page_size_g);
+    if (query_page_buf_g == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot allocate query page buffer", pdc_client_mpi_rank_g);
+
+    if (HG_Bulk_create(send_class_g, 1, (void **)&query_page_buf_g, &query_page_size_g, HG_BULK_WRITE_ONLY,
+                       &query_page_bulk_g) != HG_SUCCESS) {
+        free(query_page_buf_g);
+        query_page_buf_g = NULL;
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot register query page buffer", pdc_client_mpi_rank_g);
+    }
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+static void
+query_page_finalize()
+{
+    if (query_page_bulk_g != HG_BULK_NULL)
+        HG_Bulk_free(query_page_bulk_g);
+    query_page_bulk_g = HG_BULK_NULL;
+    free(query_page_buf_g);
+    query_page_buf_g = NULL;
+}
+
+perr_t
+PDC_Client_finalize()
+{
+    hg_return_t hg_ret;
+    perr_t      ret_value = SUCCEED;
+    int         i;
+
+    FUNC_ENTER(NULL);
+
+    // Detaches the arena from the server, which needs the server address
+    shm_arena_release();
+
+    if (PDC_Client_stop_progress_thread() != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error stopping progress thread", pdc_client_mpi_rank_g);
+
+    // Finalize Mercury
+    for (i = 0; i < pdc_server_num_g; i++) {
+        if (pdc_server_info_g[i].addr_valid) {
+            HG_Addr_free(send_class_g, pdc_server_info_g[i].addr);
+            pdc_server_info_g[i].addr_valid = 0;
+        }
+    }
+
+    if (pdc_server_info_g != NULL)
+        free(pdc_server_info_g);
+    PDC_hash_ring_free();
+
+    bulk_cache_finalize();
+#ifdef ENABLE_MPI
+    MPI_Comm_free(&PDC_SAME_SERVER_COMM_g);
+#endif
+    meta_cache_finalize();
+    query_page_finalize();
+
+#ifndef ENABLE_MPI
+    for (i = 0; i < pdc_server_num_g; i++) {
+        printf("  Server%3d, %d\n", i, debug_server_id_count[i]);
+    }
+#endif
+    // free debug info
+    if (debug_server_id_count != NULL)
+        free(debug_server_id_count);
+
+#ifdef ENABLE_TIMING
+    if (pdc_client_mpi_rank_g == 0)
+        printf("==PDC_CLIENT[%d]: T_memcpy: %.2f\n", pdc_client_mpi_rank_g, memcpy_time_g);
+#endif
+
+    hg_ret = HG_Context_destroy(send_context_g);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with HG_Context_destroy", pdc_client_mpi_rank_g);
+
+    hg_ret = HG_Finalize(send_class_g);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with HG_Finalize", pdc_client_mpi_rank_g);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+struct _pdc_query_page_args {
+    int32_t  ret;
+    uint64_t nbytes;
+    uint64_t next_cursor;
+    uint64_t next_cursor_minor;
+};
+
+static hg_return_t
+metadata_query_page_rpc_cb(const struct hg_cb_info *callback_info)
+{
+    hg_return_t                  ret_value;
+    struct _pdc_query_page_args *client_lookup_args;
+    hg_handle_t                  handle;
+    metadata_query_page_out_t    output;
+
+    FUNC_ENTER(NULL);
+
+    client_lookup_args = (struct _pdc_query_page_args *)callback_info->arg;
+    handle             = callback_info->info.forward.handle;
+
+    ret_value = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS) {
+        client_lookup_args->ret = -1;
+        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: - error HG_Get_output", pdc_client_mpi_rank_g);
+    }
+    client_lookup_args->ret               = output.ret;
+    client_lookup_args->nbytes            = output.nbytes;
+    client_lookup_args->next_cursor       = output.next_cursor;
+    client_lookup_args->next_cursor_minor = output.next_cursor_minor;
+
+done:
+    fflush(stdout);
+    work_todo_g--;
+    HG_Free_output(handle, &output);
+
+    FUNC_LEAVE(ret_value);
+}
+
+static void
+query_page_in_init(metadata_query_page_in_t *in, int is_list_all, int user_id, const char *app_name,
+                   const char *obj_name, int time_step_from, int time_step_to, int ndim, const char *tags)
+{
+    in->query.is_list_all    = is_list_all;
+    in->query.user_id        = -1;
+    in->query.app_name       = " ";
+    in->query.obj_name       = " ";
+    in->query.time_step_from = -1;
+    in->query.time_step_to   = -1;
+    in->query.ndim           = -1;
+    in->query.tags           = " ";
+    in->cursor               = 0;
+    in->cursor_minor         = 0;
+    in->bulk_handle          = HG_BULK_NULL;
+
+    if (is_list_all != 1) {
+        in->query.user_id        = user_id;
+        in->query.ndim           = ndim;
+        in->query.time_step_from = time_step_from;
+        in->query.time_step_to   = time_step_to;
+        if (app_name != NULL)
+            in->query.app_name = app_name;
         if (obj_name != NULL)
-            in.obj_name = obj_name;
+            in->query.obj_name = obj_name;
         if (tags != NULL)
-            in.tags = tags;
+            in->query.tags = tags;
     }
+}
+
+// Get the next page of results from a server and append them to the *n_res results in *out, the
+// metadata of a page are allocated together and the first of them owns the block
+static perr_t
+PDC_Client_query_page(uint32_t server_id, metadata_query_page_in_t *in, int *n_res, pdc_metadata_t ***out)
+{
+    perr_t                      ret_value = SUCCEED;
+    hg_return_t                 hg_ret;
+    hg_handle_t                 query_partial_handle = NULL;
+    struct _pdc_query_page_args lookup_args;
+    pdc_metadata_t *            meta;
+    pdc_metadata_t **           new_out;
+    char *                      page;
+    size_t                      offset;
+    int32_t                     i;
+
+    FUNC_ENTER(NULL);
+
+    if (query_page_buf_init() != SUCCEED)
+        PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with query_page_buf_init", pdc_client_mpi_rank_g);
+    if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
+
+    hg_ret = HG_Create(send_context_g, pdc_server_info_g[server_id].addr, query_partial_register_id_g,
+                       &query_partial_handle);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==CLIENT[%d]: Error with query_partial_handle", pdc_client_mpi_rank_g);
+
+    in->bulk_handle = query_page_bulk_g;
+    lookup_args.ret = -1;
+    hg_ret          = HG_Forward(query_partial_handle, metadata_query_page_rpc_cb, &lookup_args, in);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==CLIENT[%d]: Could not start HG_Forward()", pdc_client_mpi_rank_g);
+
+    // Wait for response from server, which is sent after the page has been pushed
+    work_todo_g = 1;
+    PDC_Client_check_response(&send_context_g);
+
+    if (lookup_args.ret < 0)
+        PGOTO_ERROR(FAIL, "==CLIENT[%d]: partial query failed on server %u", pdc_client_mpi_rank_g,
+                    server_id);
+
+    if (lookup_args.ret > 0) {
+        // The structs are followed by a copy of the page their strings point into, so the page buffer
+        // can be reused right away and freeing the first struct frees them all
+        meta    = (pdc_metadata_t *)malloc(lookup_args.ret * sizeof(pdc_metadata_t) + lookup_args.nbytes);
+        new_out = (pdc_metadata_t **)realloc(*out, (*n_res + lookup_args.ret) * sizeof(pdc_metadata_t *));
+        if (meta == NULL || new_out == NULL) {
+            free(meta);
+            PGOTO_ERROR(FAIL, "==CLIENT[%d]: cannot allocate query results", pdc_client_mpi_rank_g);
+        }
+        *out = new_out;
+        page = (char *)(meta + lookup_args.ret);
+        memcpy(page, query_page_buf_g, lookup_args.nbytes);
+
+        for (i = 0, offset = 0; i < lookup_args.ret && offset < lookup_args.nbytes; i++) {
+            offset += PDC_metadata_deserialize(page + offset, &meta[i]);
+            (*out)[(*n_res)++] = &meta[i];
+        }
+    }
+    in->cursor       = lookup_args.next_cursor;
+    in->cursor_minor = lookup_args.next_cursor_minor;
+
+done:
+    fflush(stdout);
+    if (query_partial_handle != NULL)
+        HG_Destroy(query_partial_handle);
+
+    FUNC_LEAVE(ret_value);
+}
+
+// bulk test
+perr_t
+PDC_Client_list_all(int *n_res, pdc_metadata_t ***out)
+{
+    perr_t ret_value;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_partial_query(1, -1, NULL, NULL, -1, -1, -1, NULL, n_res, out);
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_partial_query(int is_list_all, int user_id, const char *app_name, const char *obj_name,
+                  int time_step_from, int time_step_to, int ndim, const char *tags, int *n_res,
+                  pdc_metadata_t ***out)
+{
+    perr_t                   ret_value = SUCCEED;
+    uint32_t                 server_id = 0, my_server_start, my_server_end, my_server_count;
+    metadata_query_page_in_t in;
+
+    FUNC_ENTER(NULL);
+
+    query_page_in_init(&in, is_list_all, user_id, app_name, obj_name, time_step_from, time_step_to, ndim,
+                       tags);
 
     *out   = NULL;
     *n_res = 0;
@@ -1408,53 +2254,46 @@ PDC_partial_query(int is_list_all, int user_id, const char *app_name, const char
     }
 
     for (server_id = my_server_start; server_id < my_server_end; server_id++) {
-        if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
-            PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
-
-        hg_ret = HG_Create(send_context_g, pdc_server_info_g[server_id].addr, query_partial_register_id_g,
-                           &query_partial_handle);
-
-        if (query_partial_handle == NULL)
-            PGOTO_ERROR(FAIL, "==CLIENT[%d]: Error with query_partial_handle", pdc_client_mpi_rank_g);
-
-        hg_ret = HG_Forward(query_partial_handle, metadata_query_bulk_cb, &lookup_args, &in);
-        if (hg_ret != HG_SUCCESS)
-            PGOTO_ERROR(FAIL, "PDC_client_list_all(): Could not start HG_Forward()");
-
-        hg_atomic_set32(&bulk_transfer_done_g, 0);
+        in.cursor = 0;
+        do {
+            if (PDC_Client_query_page(server_id, &in, n_res, out) != SUCCEED)
+                PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_query_page", pdc_client_mpi_rank_g);
+        } while (in.cursor != 0);
+    }
 
-        // Wait for response from server
-        work_todo_g = 1;
-        PDC_Client_check_response(&send_context_g);
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
 
-        if (lookup_args.n_meta == 0)
-            continue;
+perr_t
+PDC_partial_query_page(int is_list_all, int user_id, const char *app_name, const char *obj_name,
+                       int time_step_from, int time_step_to, int ndim, const char *tags,
+                       pdc_query_cursor_t *cursor, int *n_res, pdc_metadata_t ***out)
+{
+    perr_t                   ret_value = SUCCEED;
+    metadata_query_page_in_t in;
 
-        // We do not have the results ready yet, need to wait.
-        while (1) {
-            if (hg_atomic_get32(&bulk_transfer_done_g))
-                break;
-        }
+    FUNC_ENTER(NULL);
 
-        if (*out == NULL) {
-            out_size = sizeof(pdc_metadata_t *) * (lookup_args.n_meta);
-            *out     = (pdc_metadata_t **)malloc(out_size);
-        }
-        else {
-            out_size += sizeof(pdc_metadata_t *) * (lookup_args.n_meta);
-            *out = (pdc_metadata_t **)realloc(*out, out_size);
-        }
+    query_page_in_init(&in, is_list_all, user_id, app_name, obj_name, time_step_from, time_step_to, ndim,
+                       tags);
 
-        *n_res += lookup_args.n_meta;
-        for (i = 0; i < lookup_args.n_meta; i++) {
-            (*out)[n_recv] = lookup_args.meta_arr[i];
-            n_recv++;
-        }
+    *out   = NULL;
+    *n_res = 0;
 
-        HG_Destroy(query_partial_handle);
+    // Servers with no more results are skipped, so only the end of the query gives an empty page
+    while (*n_res == 0 && !cursor->done) {
+        in.cursor       = cursor->pos;
+        in.cursor_minor = cursor->pos_minor;
+        if (PDC_Client_query_page(cursor->server_id, &in, n_res, out) != SUCCEED)
+            PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_query_page", pdc_client_mpi_rank_g);
+        cursor->pos       = in.cursor;
+        cursor->pos_minor = in.cursor_minor;
+        if (cursor->pos == 0 && ++cursor->server_id >= (uint32_t)pdc_server_num_g)
+            cursor->done = 1;
     }
 
-    // TODO: need to be careful when freeing the lookup_args, as it include the results returned to user
 done:
     fflush(stdout);
     FUNC_LEAVE(ret_value);
@@ -1463,82 +2302,28 @@ done:
 perr_t
 PDC_Client_query_tag(const char *tags, int *n_res, pdc_metadata_t ***out)
 {
-    perr_t             ret_value = SUCCEED;
-    hg_return_t        hg_ret;
-    int                n_recv = 0;
-    uint32_t           i;
-    int                server_id = 0;
-    size_t             out_size  = 0;
-    hg_handle_t        query_partial_handle;
-    struct bulk_args_t lookup_args;
+    perr_t                   ret_value = SUCCEED;
+    int                      server_id = 0;
+    metadata_query_page_in_t in;
 
     FUNC_ENTER(NULL);
 
     if (tags == NULL)
         PGOTO_ERROR(FAIL, "==CLIENT[%d]: input tag is NULL!", pdc_client_mpi_rank_g);
 
-    // Fill input structure
-    metadata_query_transfer_in_t in;
-    in.is_list_all    = 0;
-    in.user_id        = -1;
-    in.app_name       = " ";
-    in.obj_name       = " ";
-    in.time_step_from = -1;
-    in.time_step_to   = -1;
-    in.ndim           = 0;
-    in.tags           = tags;
+    query_page_in_init(&in, 0, -1, NULL, NULL, -1, -1, 0, tags);
 
     *out   = NULL;
     *n_res = 0;
 
     for (server_id = 0; server_id < pdc_server_num_g; server_id++) {
-        if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
-            PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
-
-        hg_ret = HG_Create(send_context_g, pdc_server_info_g[server_id].addr, query_partial_register_id_g,
-                           &query_partial_handle);
-
-        if (query_partial_handle == NULL)
-            PGOTO_ERROR(FAIL, "==CLIENT[%d]: Error with query_partial_handle", pdc_client_mpi_rank_g);
-
-        hg_ret = HG_Forward(query_partial_handle, metadata_query_bulk_cb, &lookup_args, &in);
-        if (hg_ret != HG_SUCCESS)
-            PGOTO_ERROR(FAIL, "PDC_client_list_all(): Could not start HG_Forward()");
-
-        hg_atomic_set32(&bulk_transfer_done_g, 0);
-
-        // Wait for response from server
-        work_todo_g = 1;
-        PDC_Client_check_response(&send_context_g);
-
-        if ((lookup_args.n_meta) == 0)
-            continue;
-
-        // We do not have the results ready yet, need to wait.
-        while (1) {
-            if (hg_atomic_get32(&bulk_transfer_done_g))
-                break;
-        }
-
-        if (*out == NULL) {
-            out_size = sizeof(pdc_metadata_t *) * ((lookup_args.n_meta));
-            *out     = (pdc_metadata_t **)malloc(out_size);
-        }
-        else {
-            out_size += sizeof(pdc_metadata_t *) * ((lookup_args.n_meta));
-            *out = (pdc_metadata_t **)realloc(*out, out_size);
-        }
-
-        *n_res += (lookup_args.n_meta);
-        for (i = 0; i < lookup_args.n_meta; i++) {
-            (*out)[n_recv] = lookup_args.meta_arr[i];
-            n_recv++;
-        }
-
-        HG_Destroy(query_partial_handle);
-    } // for server_id
+        in.cursor = 0;
+        do {
+            if (PDC_Client_query_page(server_id, &in, n_res, out) != SUCCEED)
+                PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_query_page", pdc_client_mpi_rank_g);
+        } while (in.cursor != 0);
+    }
 
-    // TODO: need to be careful when freeing the lookup_args, as it include the results returned to user
 done:
     fflush(stdout);
     FUNC_LEAVE(ret_value);
@@ -1552,6 +2337,7 @@ metadata_query_rpc_cb(const struct hg_cb_info *callback_info)
     struct _pdc_metadata_query_args *client_lookup_args;
     hg_handle_t                      handle;
     metadata_query_out_t             output;
+    pdc_metadata_t                   meta;
 
     FUNC_ENTER(NULL);
 
@@ -1568,15 +2354,14 @@ metadata_query_rpc_cb(const struct hg_cb_info *callback_info)
         client_lookup_args->data = NULL;
     }
     else {
-        client_lookup_args->data = (pdc_metadata_t *)malloc(sizeof(pdc_metadata_t));
+        // Now copy the received metadata info, its strings are freed with the output
+        PDC_metadata_init(&meta);
+        PDC_transfer_t_to_metadata_t(&output.ret, &meta);
+        client_lookup_args->data = PDC_metadata_dup(&meta);
         if (client_lookup_args->data == NULL)
             PGOTO_ERROR(HG_OTHER_ERROR,
                         "==PDC_CLIENT[%d]: - cannnot allocate space for client_lookup_args->data",
                         pdc_client_mpi_rank_g);
-
-        // Now copy the received metadata info
-        ret_value = PDC_metadata_init(client_lookup_args->data);
-        ret_value = PDC_transfer_t_to_metadata_t(&output.ret, client_lookup_args->data);
     }
 
 done:
@@ -1699,6 +2484,7 @@ PDC_Client_add_tag(pdcid_t obj_id, const char *tag)
     obj_prop  = PDC_obj_get_info(obj_id);
     meta_id   = obj_prop->obj_info_pub->meta_id;
     server_id = PDC_get_server_by_obj_id(meta_id, pdc_server_num_g);
+    meta_cache_invalidate_id(meta_id);
 
     // Debug statistics for counting number of messages sent to each server.
     debug_server_id_count[server_id]++;
@@ -1781,9 +2567,9 @@ PDC_Client_update_metadata(pdc_metadata_t *old, pdc_metadata_t *new)
     if (old == NULL || new == NULL)
         PGOTO_ERROR(FAIL, "==PDC_CLIENT: PDC_Client_update_metadata() - NULL inputs!");
 
+    meta_cache_invalidate_id(old->obj_id);
     hash_name_value = PDC_get_hash_by_name(old->obj_name);
-    server_id       = (hash_name_value + old->time_step);
-    server_id %= pdc_server_num_g;
+    server_id       = PDC_get_server_by_hash(hash_name_value + old->time_step, pdc_server_num_g);
 
     // Debug statistics for counting number of messages sent to each server.
     debug_server_id_count[server_id]++;
@@ -1870,6 +2656,7 @@ PDC_Client_delete_metadata_by_id(uint64_t obj_id)
     // Fill input structure
     in.obj_id = obj_id;
     server_id = PDC_get_server_by_obj_id(obj_id, pdc_server_num_g);
+    meta_cache_invalidate_id(obj_id);
 
     // Debug statistics for counting number of messages sent to each server.
     if (server_id >= (uint32_t)pdc_server_num_g)
@@ -1921,10 +2708,10 @@ PDC_Client_delete_metadata(char *delete_name, pdcid_t obj_delete_prop)
     // Fill input structure
     in.obj_name  = delete_name;
     in.time_step = delete_prop->time_step;
+    meta_cache_invalidate_name(delete_name, in.time_step);
 
     hash_name_value = PDC_get_hash_by_name(delete_name);
-    server_id       = (hash_name_value + in.time_step);
-    server_id %= pdc_server_num_g;
+    server_id       = PDC_get_server_by_hash(hash_name_value + in.time_step, pdc_server_num_g);
 
     in.hash_value = hash_name_value;
 
@@ -2031,14 +2818,17 @@ PDC_Client_query_metadata_name_timestep(const char *obj_name, int time_step, pdc
     uint32_t                        server_id;
     metadata_query_in_t             in;
     struct _pdc_metadata_query_args lookup_args;
-    hg_handle_t                     metadata_query_handle;
+    hg_handle_t                     metadata_query_handle = NULL;
 
     FUNC_ENTER(NULL);
 
+    *out = meta_cache_get(obj_name, time_step);
+    if (*out != NULL)
+        PGOTO_DONE(ret_value);
+
     // Compute server id
     hash_name_value = PDC_get_hash_by_name(obj_name);
-    server_id       = (hash_name_value + time_step);
-    server_id %= pdc_server_num_g;
+    server_id       = PDC_get_server_by_hash(hash_name_value + time_step, pdc_server_num_g);
 
     // Debug statistics for counting number of messages sent to each server.
     debug_server_id_count[server_id]++;
@@ -2069,14 +2859,51 @@ PDC_Client_query_metadata_name_timestep(const char *obj_name, int time_step, pdc
     work_todo_g = 1;
     PDC_Client_check_response(&send_context_g);
     *out = lookup_args.data;
+    meta_cache_insert(*out);
 
 done:
     fflush(stdout);
-    HG_Destroy(metadata_query_handle);
+    if (metadata_query_handle != NULL)
+        HG_Destroy(metadata_query_handle);
 
     FUNC_LEAVE(ret_value);
 }
 
+#ifdef ENABLE_MPI
+// Broadcast a metadata struct along with its strings from rank 0 of comm, the other ranks replace *meta
+// with a struct whose strings are in the same allocation
+static void
+PDC_Client_bcast_metadata(pdc_metadata_t **meta, MPI_Comm comm)
+{
+    int             rank;
+    int             size = 0;
+    char *          buf;
+    pdc_metadata_t *recv;
+
+    FUNC_ENTER(NULL);
+
+    MPI_Comm_rank(comm, &rank);
+    if (rank == 0)
+        size = (int)PDC_metadata_serialize(*meta, NULL);
+    MPI_Bcast(&size, 1, MPI_INT, 0, comm);
+
+    buf = (char *)malloc(sizeof(pdc_metadata_t) + size);
+    if (rank == 0)
+        PDC_metadata_serialize(*meta, buf + sizeof(pdc_metadata_t));
+    MPI_Bcast(buf + sizeof(pdc_metadata_t), size, MPI_CHAR, 0, comm);
+    if (rank != 0) {
+        recv = (pdc_metadata_t *)buf;
+        PDC_metadata_deserialize(buf + sizeof(pdc_metadata_t), recv);
+        free(*meta);
+        *meta = recv;
+    }
+    else
+        free(buf);
+
+    FUNC_LEAVE_VOID;
+}
+#endif
+
 // Only let one process per node to do the actual query, then broadcast to all others
 perr_t
 PDC_Client_query_metadata_name_timestep_agg_same_node(const char *obj_name, int time_step,
@@ -2097,7 +2924,7 @@ PDC_Client_query_metadata_name_timestep_agg_same_node(const char *obj_name, int
     else
         *out = (pdc_metadata_t *)calloc(1, sizeof(pdc_metadata_t));
 
-    MPI_Bcast(*out, sizeof(pdc_metadata_t), MPI_CHAR, 0, PDC_SAME_NODE_COMM_g);
+    PDC_Client_bcast_metadata(out, PDC_SAME_NODE_COMM_g);
 
 #else
     ret_value = PDC_Client_query_metadata_name_timestep(obj_name, time_step, out);
@@ -2126,7 +2953,7 @@ PDC_Client_query_metadata_name_timestep_agg(const char *obj_name, int time_step,
     else
         *out = (pdc_metadata_t *)calloc(1, sizeof(pdc_metadata_t));
 
-    MPI_Bcast(*out, sizeof(pdc_metadata_t), MPI_CHAR, 0, PDC_CLIENT_COMM_WORLD_g);
+    PDC_Client_bcast_metadata(out, PDC_CLIENT_COMM_WORLD_g);
 
 #else
     ret_value = PDC_Client_query_metadata_name_timestep(obj_name, time_step, out);
@@ -2179,8 +3006,7 @@ PDC_Client_create_cont_id(const char *cont_name, pdcid_t cont_create_prop ATTRIB
     in.cont_name    = cont_name;
 
     // Calculate server id
-    server_id = hash_name_value;
-    server_id %= pdc_server_num_g;
+    server_id = PDC_get_server_by_hash(hash_name_value, pdc_server_num_g);
 
     // Debug statistics for counting number of messages sent to each server.
     debug_server_id_count[server_id]++;
@@ -2239,6 +3065,46 @@ PDC_Client_create_cont_id_mpi(const char *cont_name, pdcid_t cont_create_prop, p
     FUNC_LEAVE(ret_value);
 }
 
+// Fill the metadata transfer fields an object takes from its creation property
+static void
+PDC_Client_fill_obj_transfer(struct _pdc_obj_prop *create_prop, uint64_t cont_id,
+                             pdc_metadata_transfer_t *data)
+{
+    FUNC_ENTER(NULL);
+
+    data->cont_id   = cont_id;
+    data->time_step = create_prop->time_step;
+    data->user_id   = create_prop->user_id;
+
+    if ((data->ndim = create_prop->obj_prop_pub->ndim) > 0) {
+        if (data->ndim >= 1)
+            data->dims0 = create_prop->obj_prop_pub->dims[0];
+        if (data->ndim >= 2)
+            data->dims1 = create_prop->obj_prop_pub->dims[1];
+        if (data->ndim >= 3)
+            data->dims2 = create_prop->obj_prop_pub->dims[2];
+        if (data->ndim >= 4)
+            data->dims3 = create_prop->obj_prop_pub->dims[3];
+    }
+
+    if (create_prop->tags == NULL)
+        data->tags = " ";
+    else
+        data->tags = create_prop->tags;
+
+    if (create_prop->app_name == NULL)
+        data->app_name = "Noname";
+    else
+        data->app_name = create_prop->app_name;
+
+    if (create_prop->data_loc == NULL)
+        data->data_location = " ";
+    else
+        data->data_location = create_prop->data_loc;
+
+    FUNC_LEAVE_VOID;
+}
+
 // Send a name to server and receive an obj id
 perr_t
 PDC_Client_send_name_recv_id(const char *obj_name, uint64_t cont_id, pdcid_t obj_create_prop,
@@ -2267,44 +3133,15 @@ PDC_Client_send_name_recv_id(const char *obj_name, uint64_t cont_id, pdcid_t obj
 
     // Fill input structure
     memset(&in, 0, sizeof(in));
-    in.data.obj_name  = obj_name;
-    in.data.cont_id   = cont_id;
-    in.data.time_step = create_prop->time_step;
-    in.data.user_id   = create_prop->user_id;
-    in.data_type      = create_prop->obj_prop_pub->type;
-
-    if ((in.data.ndim = create_prop->obj_prop_pub->ndim) > 0) {
-        if (in.data.ndim >= 1)
-            in.data.dims0 = create_prop->obj_prop_pub->dims[0];
-        if (in.data.ndim >= 2)
-            in.data.dims1 = create_prop->obj_prop_pub->dims[1];
-        if (in.data.ndim >= 3)
-            in.data.dims2 = create_prop->obj_prop_pub->dims[2];
-        if (in.data.ndim >= 4)
-            in.data.dims3 = create_prop->obj_prop_pub->dims[3];
-    }
-
-    if (create_prop->tags == NULL)
-        in.data.tags = " ";
-    else
-        in.data.tags = create_prop->tags;
-
-    if (create_prop->app_name == NULL)
-        in.data.app_name = "Noname";
-    else
-        in.data.app_name = create_prop->app_name;
-
-    if (create_prop->data_loc == NULL)
-        in.data.data_location = " ";
-    else
-        in.data.data_location = create_prop->data_loc;
+    PDC_Client_fill_obj_transfer(create_prop, cont_id, &in.data);
+    in.data.obj_name = obj_name;
+    in.data_type     = create_prop->obj_prop_pub->type;
 
     hash_name_value = PDC_get_hash_by_name(obj_name);
     in.hash_value   = hash_name_value;
 
     // Compute server id
-    server_id = (hash_name_value + in.data.time_step);
-    server_id %= pdc_server_num_g;
+    server_id = PDC_get_server_by_hash(hash_name_value + in.data.time_step, pdc_server_num_g);
 
     // Debug statistics for counting number of messages sent to each server.
     debug_server_id_count[server_id]++;
@@ -2408,6 +3245,7 @@ PDC_Client_buf_unmap(pdcid_t remote_obj_id, pdcid_t remote_reg_id, struct pdc_re
     size_t                   unit;
     uint32_t                 data_server_id, meta_server_id;
     struct _pdc_buf_map_args unmap_args;
+    pdc_bulk_cache_map_t *   map;
 
     hg_handle_t client_send_buf_unmap_handle;
 
@@ -2458,6 +3296,16 @@ PDC_Client_buf_unmap(pdcid_t remote_obj_id, pdcid_t remote_reg_id, struct pdc_re
     if (unmap_args.ret != 1)
         PGOTO_ERROR(FAIL, "PDC_CLIENT: buf unmap failed...");
 
+    DL_FOREACH(bulk_cache_maps_g, map)
+    {
+        if (map->remote_obj_id == remote_obj_id && map->remote_region == reginfo) {
+            bulk_cache_release(map->addr);
+            DL_DELETE(bulk_cache_maps_g, map);
+            free(map);
+            break;
+        }
+    }
+
 done:
     fflush(stdout);
     HG_Destroy(client_send_buf_unmap_handle);
@@ -2500,6 +3348,48 @@ pack_region_metadata(int ndim, uint64_t *offset, uint64_t *size, region_info_tra
     FUNC_LEAVE(ret_value);
 }
 
+// Copy between a (possibly strided) application buffer and its packed contiguous form
+static void
+copy_region_buffer(char *buf, char *packed, uint64_t *obj_dims, int local_ndim, uint64_t *local_offset,
+                   uint64_t *local_size, size_t unit, uint64_t nbytes, int to_packed)
+{
+    uint64_t i, j;
+    char *   ptr = packed;
+    char *   src;
+
+    if (local_ndim == 1) {
+        src = buf + local_offset[0] * unit;
+        if (to_packed)
+            memcpy(packed, src, nbytes);
+        else
+            memcpy(src, packed, nbytes);
+    }
+    else if (local_ndim == 2) {
+        for (i = 0; i < local_size[0]; ++i) {
+            src = buf + ((local_offset[0] + i) * obj_dims[1] + local_offset[1]) * unit;
+            if (to_packed)
+                memcpy(ptr, src, local_size[1] * unit);
+            else
+                memcpy(src, ptr, local_size[1] * unit);
+            ptr += local_size[1] * unit;
+        }
+    }
+    else if (local_ndim == 3) {
+        for (i = 0; i < local_size[0]; ++i) {
+            for (j = 0; j < local_size[1]; ++j) {
+                src = buf + ((local_offset[0] + i) * obj_dims[1] * obj_dims[2] +
+                             (local_offset[1] + j) * obj_dims[2] + local_offset[2]) *
+                                unit;
+                if (to_packed)
+                    memcpy(ptr, src, local_size[2] * unit);
+                else
+                    memcpy(src, ptr, local_size[2] * unit);
+                ptr += local_size[2] * unit;
+            }
+        }
+    }
+}
+
 static perr_t
 pack_region_buffer(char *buf, char **new_buf, uint64_t *obj_dims, size_t total_data_size, int local_ndim,
                    uint64_t *local_offset, uint64_t *local_size, size_t unit, pdc_access_t access_type)
@@ -2554,12 +3444,21 @@ static perr_t
 release_region_buffer(char *buf, char *new_buf, uint64_t *obj_dims, int local_ndim, uint64_t *local_offset,
                       uint64_t *local_size, size_t unit, pdc_access_t access_type)
 {
-    uint64_t i, j;
+    uint64_t i, j, nbytes;
     perr_t   ret_value = SUCCEED;
     char *   ptr;
     FUNC_ENTER(NULL);
 
-    if (local_ndim == 2) {
+    if (shm_arena_owns(new_buf)) {
+        if (access_type == PDC_READ) {
+            nbytes = unit;
+            for (i = 0; i < (uint64_t)local_ndim; ++i)
+                nbytes *= local_size[i];
+            copy_region_buffer(buf, new_buf, obj_dims, local_ndim, local_offset, local_size, unit, nbytes, 0);
+        }
+        shm_arena_free(new_buf);
+    }
+    else if (local_ndim == 2) {
         if (access_type == PDC_READ) {
             ptr = new_buf;
             for (i = 0; i < local_size[0]; ++i) {
@@ -2585,7 +3484,12 @@ release_region_buffer(char *buf, char *new_buf, uint64_t *obj_dims, int local_nd
         }
         free(new_buf);
     }
-    else if (local_ndim != 1) {
+    else if (local_ndim == 1) {
+        // Small regions are sent inline and never hold a bulk handle
+        if (unit * local_size[0] > PDC_TRANSFER_INLINE_MAX)
+            bulk_cache_release(new_buf);
+    }
+    else {
         ret_value = FAIL;
     }
 
@@ -2597,19 +3501,21 @@ perr_t
 PDC_Client_transfer_request(void *buf, pdcid_t obj_id, int obj_ndim, uint64_t *obj_dims, int local_ndim,
                             uint64_t *local_offset, uint64_t *local_size, int remote_ndim,
                             uint64_t *remote_offset, uint64_t *remote_size, pdc_var_type_t mem_type,
-                            pdc_access_t access_type, pdcid_t *metadata_id, char **new_buf_ptr)
-{
-    perr_t                            ret_value = SUCCEED;
-    hg_return_t                       hg_ret    = HG_SUCCESS;
-    transfer_request_in_t             in;
-    hg_class_t *                      hg_class;
-    uint32_t                          data_server_id, meta_server_id;
-    size_t                            unit;
-    hg_size_t                         total_data_size;
-    int                               i;
-    hg_handle_t                       client_send_transfer_request_handle;
-    struct _pdc_transfer_request_args transfer_args;
-    char *                            new_buf = NULL;
+                            pdc_access_t access_type, pdcid_t *metadata_id, char **new_buf_ptr,
+                            struct _pdc_transfer_request_async **async)
+{
+    perr_t                              ret_value = SUCCEED;
+    hg_return_t                         hg_ret    = HG_SUCCESS;
+    transfer_request_in_t               in;
+    hg_class_t *                        hg_class;
+    uint32_t                            data_server_id, meta_server_id;
+    size_t                              unit;
+    hg_size_t                           total_data_size;
+    int                                 i;
+    hg_handle_t                         client_send_transfer_request_handle;
+    struct _pdc_transfer_request_args   transfer_args;
+    struct _pdc_transfer_request_async *async_args = NULL;
+    char *                              new_buf    = NULL;
 
     FUNC_ENTER(NULL);
 #ifdef PDC_TIMING
@@ -2655,8 +3561,43 @@ PDC_Client_transfer_request(void *buf, pdcid_t obj_id, int obj_ndim, uint64_t *o
     }
     pack_region_metadata(remote_ndim, remote_offset, remote_size, &(in.remote_region));
 
-    pack_region_buffer(buf, &new_buf, obj_dims, total_data_size, local_ndim, local_offset, local_size, unit,
-                       access_type);
+    in.shm_token  = shm_arena_token_g;
+    in.shm_offset = 0;
+    in.use_shm    = 0;
+    if (shm_arena_state_g == 0)
+        shm_arena_init(data_server_id);
+    if (shm_arena_state_g == 1 && local_ndim >= 1 && local_ndim <= 3)
+        new_buf = shm_arena_alloc(total_data_size);
+
+    if (new_buf != NULL) {
+        // Stage the data in the shared memory arena, the server accesses it in place
+        in.use_shm    = 1;
+        in.shm_offset = new_buf - shm_arena_base_g;
+        if (access_type == PDC_WRITE)
+            copy_region_buffer(buf, new_buf, obj_dims, local_ndim, local_offset, local_size, unit,
+                               total_data_size, 1);
+    }
+    else
+        pack_region_buffer(buf, &new_buf, obj_dims, total_data_size, local_ndim, local_offset, local_size,
+                           unit, access_type);
+
+    in.use_inline             = 0;
+    in.inline_size            = 0;
+    in.inline_buf             = NULL;
+    transfer_args.inline_dest = NULL;
+    transfer_args.inline_size = 0;
+    if (!in.use_shm && total_data_size <= PDC_TRANSFER_INLINE_MAX) {
+        // Small region, the data travels in the request (write) or in the response (read)
+        in.use_inline = 1;
+        if (access_type == PDC_WRITE) {
+            in.inline_size = total_data_size;
+            in.inline_buf  = new_buf;
+        }
+        else {
+            transfer_args.inline_dest = new_buf;
+            transfer_args.inline_size = total_data_size;
+        }
+    }
     /*
         printf("obj ID = %u, data_server_id = %u, total_mem_size = %zu local_offset[0] = %llu @ line %d\n",
                (unsigned)obj_id, (unsigned)data_server_id, total_data_size, (long long
@@ -2667,18 +3608,54 @@ PDC_Client_transfer_request(void *buf, pdcid_t obj_id, int obj_ndim, uint64_t *o
         PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server @ line %d",
                     pdc_client_mpi_rank_g, __LINE__);
 
-    hg_ret = HG_Create(send_context_g, pdc_server_info_g[data_server_id].addr, transfer_request_register_id_g,
+    // With a progress thread, forward the request on its context and return without waiting for the server
+    if (async != NULL) {
+        *async = NULL;
+        if (progress_thread_active_g)
+            async_args = (struct _pdc_transfer_request_async *)calloc(1, sizeof(*async_args));
+    }
+
+    hg_ret = HG_Create(async_args == NULL ? send_context_g : async_context_g,
+                       pdc_server_info_g[data_server_id].addr, transfer_request_register_id_g,
                        &client_send_transfer_request_handle);
 
     // Create bulk handle
-    hg_ret = HG_Bulk_create(hg_class, 1, (void **)&new_buf, (hg_size_t *)&total_data_size, HG_BULK_READWRITE,
-                            &(in.local_bulk_handle));
+    if (in.use_shm || in.use_inline)
+        in.local_bulk_handle = HG_BULK_NULL;
+    else if (local_ndim == 1)
+        // new_buf points into the application buffer, which is usually transferred again
+        hg_ret = bulk_cache_acquire(hg_class, new_buf, total_data_size, HG_BULK_READWRITE,
+                                    &(in.local_bulk_handle));
+    else
+        hg_ret = HG_Bulk_create(hg_class, 1, (void **)&new_buf, (hg_size_t *)&total_data_size,
+                                HG_BULK_READWRITE, &(in.local_bulk_handle));
 
     if (hg_ret != HG_SUCCESS)
         PGOTO_ERROR(FAIL,
                     "PDC_Client_transfer_request(): Could not create local bulk data handle @ line %d\n",
                     __LINE__);
 
+    if (async_args != NULL) {
+        async_args->handle  = client_send_transfer_request_handle;
+        async_args->use_shm = in.use_shm;
+        async_args->new_buf = new_buf;
+        async_args->args    = transfer_args;
+
+        hg_ret = HG_Forward(client_send_transfer_request_handle, client_send_transfer_request_async_rpc_cb,
+                            async_args, &in);
+        if (hg_ret != HG_SUCCESS) {
+            if (in.use_shm)
+                shm_arena_free(new_buf);
+            HG_Destroy(client_send_transfer_request_handle);
+            free(async_args);
+            PGOTO_ERROR(FAIL, "PDC_Client_send_transfer_request(): Could not start HG_Forward() @ line %d\n",
+                        __LINE__);
+        }
+        *new_buf_ptr = new_buf;
+        *async       = async_args;
+        PGOTO_DONE(ret_value);
+    }
+
     hg_ret = HG_Forward(client_send_transfer_request_handle, client_send_transfer_request_rpc_cb,
                         &transfer_args, &in);
 
@@ -2716,6 +3693,10 @@ PDC_Client_transfer_request(void *buf, pdcid_t obj_id, int obj_ndim, uint64_t *o
     */
     *metadata_id = transfer_args.metadata_id;
 
+    if (transfer_args.ret != 1 && in.use_shm) {
+        shm_arena_free(new_buf);
+        new_buf = NULL;
+    }
     *new_buf_ptr = new_buf;
     if (transfer_args.ret != 1)
         PGOTO_ERROR(FAIL, "PDC_CLIENT: transfer request failed... @ line %d\n", __LINE__);
@@ -2726,6 +3707,52 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+int
+PDC_Client_transfer_request_async_test(struct _pdc_transfer_request_async *async)
+{
+    int ret_value;
+
+    FUNC_ENTER(NULL);
+
+    hg_thread_mutex_lock(&async_mutex_g);
+    ret_value = async->completed;
+    hg_thread_mutex_unlock(&async_mutex_g);
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Client_transfer_request_async_complete(struct _pdc_transfer_request_async *async, uint64_t *metadata_id,
+                                           char **new_buf)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    hg_thread_mutex_lock(&async_mutex_g);
+    while (async->completed == 0)
+        hg_thread_cond_wait(&async_cond_g, &async_mutex_g);
+    hg_thread_mutex_unlock(&async_mutex_g);
+
+    HG_Destroy(async->handle);
+
+    *metadata_id = async->args.metadata_id;
+    *new_buf     = async->new_buf;
+    if (async->args.ret != 1) {
+        if (async->use_shm) {
+            shm_arena_free(async->new_buf);
+            *new_buf = NULL;
+        }
+        *metadata_id = 0;
+        ret_value    = FAIL;
+        printf("PDC_CLIENT: transfer request failed... @ line %d\n", __LINE__);
+    }
+    free(async);
+
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Client_transfer_request_status(pdcid_t transfer_request_id, pdc_transfer_status_t *completed, char *buf,
                                    char *new_buf, uint64_t *obj_dims, int local_ndim, uint64_t *local_offset,
@@ -2847,16 +3874,398 @@ PDC_Client_transfer_request_wait(pdcid_t transfer_request_id, int access_type, c
         timings.PDCtransfer_request_wait_read_rpc_wait += end - start;
         pdc_timestamp_register(client_transfer_request_wait_read_timestamps, function_start, end);
     }
-    else {
-        timings.PDCtransfer_request_wait_write_rpc_wait += end - start;
-        pdc_timestamp_register(client_transfer_request_wait_write_timestamps, function_start, end);
+    else {
+        timings.PDCtransfer_request_wait_write_rpc_wait += end - start;
+        pdc_timestamp_register(client_transfer_request_wait_write_timestamps, function_start, end);
+    }
+#endif
+
+    if (transfer_args.ret != 1)
+        PGOTO_ERROR(FAIL, "PDC_CLIENT: transfer request failed... @ line %d\n", __LINE__);
+
+    HG_Destroy(client_send_transfer_request_wait_handle);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+/* Only one aggregated batch may be in flight per aggregation group, as start and wait are collective */
+static struct _pdc_transfer_agg_batch *transfer_agg_batch_g = NULL;
+
+/* Per-request descriptor sent from each client to its aggregator */
+typedef struct pdc_transfer_agg_desc_t {
+    pdcid_t  obj_id;
+    uint64_t arena_offset;
+    uint64_t nbytes;
+    uint64_t remote_offset[DIM_MAX];
+    uint64_t remote_size[DIM_MAX];
+    uint64_t obj_dims[DIM_MAX];
+    int32_t  remote_ndim;
+    int32_t  obj_ndim;
+    int32_t  mem_type;
+    int32_t  access_type;
+} pdc_transfer_agg_desc_t;
+
+static int
+transfer_agg_desc_cmp(const void *a, const void *b)
+{
+    const pdc_transfer_agg_desc_t *x = (const pdc_transfer_agg_desc_t *)a;
+    const pdc_transfer_agg_desc_t *y = (const pdc_transfer_agg_desc_t *)b;
+
+    if (x->access_type != y->access_type)
+        return x->access_type < y->access_type ? -1 : 1;
+    if (x->obj_id != y->obj_id)
+        return x->obj_id < y->obj_id ? -1 : 1;
+    if (x->remote_offset[0] != y->remote_offset[0])
+        return x->remote_offset[0] < y->remote_offset[0] ? -1 : 1;
+    return 0;
+}
+
+// Two sorted 1D requests can be merged when they are adjacent both in the object and in the arena
+static int
+transfer_agg_desc_can_merge(const pdc_transfer_agg_desc_t *prev, const pdc_transfer_agg_desc_t *next)
+{
+    return prev->remote_ndim == 1 && next->remote_ndim == 1 && prev->obj_id == next->obj_id &&
+           prev->access_type == next->access_type && prev->mem_type == next->mem_type &&
+           prev->remote_offset[0] + prev->remote_size[0] == next->remote_offset[0] &&
+           prev->arena_offset + prev->nbytes == next->arena_offset;
+}
+
+static uint64_t
+transfer_agg_request_nbytes(pdc_transfer_request *request)
+{
+    uint64_t nbytes = PDC_get_var_type_size(request->mem_type);
+    int      i;
+
+    for (i = 0; i < request->remote_region_ndim; ++i)
+        nbytes *= request->remote_region_size[i];
+
+    return nbytes;
+}
+
+#ifdef ENABLE_MPI
+// Executed by the aggregator: sort and merge all requests of its group, then forward them to its data server
+static perr_t
+transfer_agg_issue_merged(struct _pdc_transfer_agg_batch *batch, pdc_transfer_agg_desc_t *descs, int ndesc)
+{
+    perr_t                   ret_value = SUCCEED;
+    pdc_transfer_agg_desc_t *cur;
+    uint64_t                 zero = 0, nelem;
+    char *                   new_buf;
+    int                      i, j, n;
+
+    FUNC_ENTER(NULL);
+
+    if (ndesc > 1)
+        qsort(descs, ndesc, sizeof(pdc_transfer_agg_desc_t), transfer_agg_desc_cmp);
+
+    // Merge in place
+    n = 0;
+    for (i = 0; i < ndesc; i++) {
+        if (n > 0 && transfer_agg_desc_can_merge(&descs[n - 1], &descs[i])) {
+            descs[n - 1].remote_size[0] += descs[i].remote_size[0];
+            descs[n - 1].nbytes += descs[i].nbytes;
+            continue;
+        }
+        if (n != i)
+            memcpy(&descs[n], &descs[i], sizeof(pdc_transfer_agg_desc_t));
+        n++;
+    }
+
+    batch->n_merged           = n;
+    batch->merged_metadata_id = (uint64_t *)calloc(n, sizeof(uint64_t));
+    batch->merged_offset      = (uint64_t *)calloc(n, sizeof(uint64_t));
+    batch->merged_nelem       = (uint64_t *)calloc(n, sizeof(uint64_t));
+    batch->merged_access_type = (int *)calloc(n, sizeof(int));
+    batch->merged_mem_type    = (pdc_var_type_t *)calloc(n, sizeof(pdc_var_type_t));
+
+    for (i = 0; i < n; i++) {
+        cur   = &descs[i];
+        nelem = 1;
+        for (j = 0; j < cur->remote_ndim; j++)
+            nelem *= cur->remote_size[j];
+
+        batch->merged_offset[i]      = cur->arena_offset;
+        batch->merged_nelem[i]       = nelem;
+        batch->merged_access_type[i] = cur->access_type;
+        batch->merged_mem_type[i]    = (pdc_var_type_t)cur->mem_type;
+
+        // The arena already holds packed data, so it is sent as a 1D local region without extra copy
+        if (PDC_Client_transfer_request(batch->shm_base + cur->arena_offset, cur->obj_id, cur->obj_ndim,
+                                        cur->obj_dims, 1, &zero, &nelem, cur->remote_ndim,
+                                        cur->remote_offset, cur->remote_size, (pdc_var_type_t)cur->mem_type,
+                                        (pdc_access_t)cur->access_type, &batch->merged_metadata_id[i],
+                                        &new_buf, NULL) != SUCCEED) {
+            printf("==PDC_CLIENT[%d]: %s - ERROR forwarding aggregated request %d\n", pdc_client_mpi_rank_g,
+                   __func__, i);
+            ret_value = FAIL;
+        }
+    }
+
+    if (is_client_debug_g == 1)
+        printf("==PDC_CLIENT[%d]: node aggregator merged %d requests into %d transfers\n",
+               pdc_client_mpi_rank_g, ndesc, n);
+
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+#endif
+
+int
+PDC_Client_transfer_request_agg_agree(int valid)
+{
+    int ret_value = valid;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MPI
+    if (pdc_client_same_server_size_g > 1)
+        MPI_Allreduce(&valid, &ret_value, 1, MPI_INT, MPI_MIN, PDC_SAME_SERVER_COMM_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Client_transfer_request_agg_start(pdc_transfer_request **requests, size_t n)
+{
+    perr_t ret_value = SUCCEED;
+    size_t i;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MPI
+    if (pdc_client_same_server_size_g > 1) {
+        struct _pdc_transfer_agg_batch *batch;
+        pdc_transfer_agg_desc_t *       my_descs, *all_descs = NULL;
+        uint64_t                        my_bytes = 0, cur_offset;
+        int *                           recvcounts = NULL, *displs = NULL;
+        int my_ndesc = (int)n, all_ndesc = 0, shm_fd, k, agg_ret, map_ok = 1, all_map_ok;
+
+        if (transfer_agg_batch_g != NULL)
+            printf("==PDC_CLIENT[%d]: %s - previous aggregated transfer has not been waited\n",
+                   pdc_client_mpi_rank_g, __func__);
+        if (PDC_Client_transfer_request_agg_agree(transfer_agg_batch_g == NULL) == 0)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: aggregated transfer rejected by a client of the group",
+                        pdc_client_mpi_rank_g);
+
+        batch = (struct _pdc_transfer_agg_batch *)calloc(1, sizeof(struct _pdc_transfer_agg_batch));
+        batch->n_request = (int)n;
+
+        for (i = 0; i < n; i++)
+            my_bytes += transfer_agg_request_nbytes(requests[i]);
+
+        // Each client owns a contiguous slice of the arena, in group rank order
+        MPI_Exscan(&my_bytes, &batch->my_offset, 1, MPI_UINT64_T, MPI_SUM, PDC_SAME_SERVER_COMM_g);
+        if (pdc_client_same_server_rank_g == 0)
+            batch->my_offset = 0;
+        MPI_Allreduce(&my_bytes, &batch->shm_size, 1, MPI_UINT64_T, MPI_SUM, PDC_SAME_SERVER_COMM_g);
+        if (batch->shm_size == 0)
+            batch->shm_size = PAGE_SIZE;
+
+        agg_ret = SUCCEED;
+        if (pdc_client_same_server_rank_g == 0)
+            agg_ret = PDC_create_shm_segment_ind(batch->shm_size, batch->shm_addr, (void **)&batch->shm_base);
+        MPI_Bcast(&agg_ret, 1, MPI_INT, 0, PDC_SAME_SERVER_COMM_g);
+        if (agg_ret != SUCCEED) {
+            free(batch);
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: node aggregator failed to create shared memory arena",
+                        pdc_client_mpi_rank_g);
+        }
+        MPI_Bcast(batch->shm_addr, ADDR_MAX, MPI_CHAR, 0, PDC_SAME_SERVER_COMM_g);
+
+        if (pdc_client_same_server_rank_g != 0) {
+            shm_fd = shm_open(batch->shm_addr, O_RDWR, 0666);
+            if (shm_fd == -1)
+                map_ok = 0;
+            else {
+                batch->shm_base = mmap(0, batch->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+                close(shm_fd);
+                if (batch->shm_base == MAP_FAILED)
+                    map_ok = 0;
+            }
+        }
+
+        // All clients must agree before anyone stages data
+        MPI_Allreduce(&map_ok, &all_map_ok, 1, MPI_INT, MPI_MIN, PDC_SAME_SERVER_COMM_g);
+        if (all_map_ok == 0) {
+            if (map_ok == 1)
+                munmap(batch->shm_base, batch->shm_size);
+            if (pdc_client_same_server_rank_g == 0)
+                shm_unlink(batch->shm_addr);
+            free(batch);
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: failed to map node aggregation arena",
+                        pdc_client_mpi_rank_g);
+        }
+        transfer_agg_batch_g = batch;
+
+        // Stage write data and describe every request
+        my_descs   = (pdc_transfer_agg_desc_t *)calloc(n + 1, sizeof(pdc_transfer_agg_desc_t));
+        cur_offset = batch->my_offset;
+        for (i = 0; i < n; i++) {
+            my_descs[i].obj_id       = requests[i]->obj_id;
+            my_descs[i].arena_offset = cur_offset;
+            my_descs[i].nbytes       = transfer_agg_request_nbytes(requests[i]);
+            my_descs[i].remote_ndim  = requests[i]->remote_region_ndim;
+            my_descs[i].obj_ndim     = requests[i]->obj_ndim;
+            my_descs[i].mem_type     = requests[i]->mem_type;
+            my_descs[i].access_type  = requests[i]->access_type;
+            memcpy(my_descs[i].remote_offset, requests[i]->remote_region_offset,
+                   sizeof(uint64_t) * requests[i]->remote_region_ndim);
+            memcpy(my_descs[i].remote_size, requests[i]->remote_region_size,
+                   sizeof(uint64_t) * requests[i]->remote_region_ndim);
+            memcpy(my_descs[i].obj_dims, requests[i]->obj_dims, sizeof(uint64_t) * requests[i]->obj_ndim);
+
+            if (requests[i]->access_type == PDC_WRITE)
+                copy_region_buffer(requests[i]->buf, batch->shm_base + cur_offset,
+                                   requests[i]->obj_dims, requests[i]->local_region_ndim,
+                                   requests[i]->local_region_offset, requests[i]->local_region_size,
+                                   PDC_get_var_type_size(requests[i]->mem_type), my_descs[i].nbytes, 1);
+
+            cur_offset += my_descs[i].nbytes;
+            requests[i]->agg_batch = batch;
+        }
+
+        // Gather all descriptors to the aggregator
+        if (pdc_client_same_server_rank_g == 0) {
+            recvcounts = (int *)malloc(sizeof(int) * pdc_client_same_server_size_g);
+            displs     = (int *)malloc(sizeof(int) * pdc_client_same_server_size_g);
+        }
+        MPI_Gather(&my_ndesc, 1, MPI_INT, recvcounts, 1, MPI_INT, 0, PDC_SAME_SERVER_COMM_g);
+        if (pdc_client_same_server_rank_g == 0) {
+            for (k = 0; k < pdc_client_same_server_size_g; k++) {
+                all_ndesc += recvcounts[k];
+                recvcounts[k] *= sizeof(pdc_transfer_agg_desc_t);
+                displs[k] = k == 0 ? 0 : displs[k - 1] + recvcounts[k - 1];
+            }
+            all_descs = (pdc_transfer_agg_desc_t *)calloc(all_ndesc + 1, sizeof(pdc_transfer_agg_desc_t));
+        }
+        MPI_Gatherv(my_descs, my_ndesc * sizeof(pdc_transfer_agg_desc_t), MPI_CHAR, all_descs, recvcounts,
+                    displs, MPI_CHAR, 0, PDC_SAME_SERVER_COMM_g);
+
+        if (pdc_client_same_server_rank_g == 0) {
+            agg_ret = transfer_agg_issue_merged(batch, all_descs, all_ndesc);
+            free(all_descs);
+            free(recvcounts);
+            free(displs);
+        }
+        free(my_descs);
+
+        // Fan the aggregated result back to all clients of the group
+        MPI_Bcast(&agg_ret, 1, MPI_INT, 0, PDC_SAME_SERVER_COMM_g);
+        ret_value = agg_ret;
+        goto done;
+    }
+#endif
+
+    // Single client for this data server on this node, nothing to aggregate
+    for (i = 0; i < n; i++) {
+        if (PDC_Client_transfer_request(requests[i]->buf, requests[i]->obj_id, requests[i]->obj_ndim,
+                                        requests[i]->obj_dims, requests[i]->local_region_ndim,
+                                        requests[i]->local_region_offset, requests[i]->local_region_size,
+                                        requests[i]->remote_region_ndim, requests[i]->remote_region_offset,
+                                        requests[i]->remote_region_size, requests[i]->mem_type,
+                                        requests[i]->access_type, &(requests[i]->metadata_id),
+                                        &(requests[i]->new_buf), NULL) != SUCCEED)
+            ret_value = FAIL;
+    }
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Client_transfer_request_agg_wait(pdc_transfer_request **requests, size_t n)
+{
+    perr_t                          ret_value = SUCCEED;
+    struct _pdc_transfer_agg_batch *batch     = NULL;
+    size_t                          i;
+
+    FUNC_ENTER(NULL);
+
+    batch = transfer_agg_batch_g;
+    for (i = 0; i < n; i++) {
+        if (requests[i]->agg_batch != batch)
+            break;
+    }
+    if (i < n)
+        printf("==PDC_CLIENT[%d]: %s - transfer request was not started with the current batch\n",
+               pdc_client_mpi_rank_g, __func__);
+    if (PDC_Client_transfer_request_agg_agree(i == n) == 0)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: aggregated wait rejected by a client of the group",
+                    pdc_client_mpi_rank_g);
+
+    if (batch == NULL) {
+        // Requests were issued directly by this client
+        for (i = 0; i < n; i++) {
+            if (requests[i]->metadata_id == 0) {
+                ret_value = FAIL;
+                continue;
+            }
+            if (PDC_Client_transfer_request_wait(
+                    requests[i]->metadata_id, requests[i]->access_type, requests[i]->buf,
+                    requests[i]->new_buf, requests[i]->obj_dims, requests[i]->local_region_ndim,
+                    requests[i]->local_region_offset, requests[i]->local_region_size,
+                    requests[i]->mem_type) != SUCCEED)
+                ret_value = FAIL;
+            requests[i]->metadata_id = 0;
+        }
+        goto done;
     }
-#endif
 
-    if (transfer_args.ret != 1)
-        PGOTO_ERROR(FAIL, "PDC_CLIENT: transfer request failed... @ line %d\n", __LINE__);
+#ifdef ENABLE_MPI
+    {
+        uint64_t zero = 0, cur_offset;
+        int      k, agg_ret = SUCCEED;
+
+        if (pdc_client_same_server_rank_g == 0) {
+            for (k = 0; k < batch->n_merged; k++) {
+                if (batch->merged_metadata_id[k] == 0) {
+                    agg_ret = FAIL;
+                    continue;
+                }
+                if (PDC_Client_transfer_request_wait(
+                        batch->merged_metadata_id[k], batch->merged_access_type[k],
+                        batch->shm_base + batch->merged_offset[k], batch->shm_base + batch->merged_offset[k],
+                        NULL, 1, &zero, &batch->merged_nelem[k], batch->merged_mem_type[k]) != SUCCEED)
+                    agg_ret = FAIL;
+            }
+        }
+        MPI_Bcast(&agg_ret, 1, MPI_INT, 0, PDC_SAME_SERVER_COMM_g);
+        ret_value = agg_ret;
+
+        // Scatter read data from the arena back to the application buffers
+        cur_offset = batch->my_offset;
+        for (i = 0; i < n; i++) {
+            if (requests[i]->access_type == PDC_READ && agg_ret == SUCCEED)
+                copy_region_buffer(requests[i]->buf, batch->shm_base + cur_offset,
+                                   requests[i]->obj_dims, requests[i]->local_region_ndim,
+                                   requests[i]->local_region_offset, requests[i]->local_region_size,
+                                   PDC_get_var_type_size(requests[i]->mem_type),
+                                   transfer_agg_request_nbytes(requests[i]), 0);
+            cur_offset += transfer_agg_request_nbytes(requests[i]);
+            requests[i]->agg_batch = NULL;
+        }
 
-    HG_Destroy(client_send_transfer_request_wait_handle);
+        // No one touches the arena after this point
+        MPI_Barrier(PDC_SAME_SERVER_COMM_g);
+        bulk_cache_invalidate(batch->shm_base, batch->shm_size);
+        munmap(batch->shm_base, batch->shm_size);
+        if (pdc_client_same_server_rank_g == 0) {
+            if (shm_unlink(batch->shm_addr) == -1)
+                printf("==PDC_CLIENT[%d]: Error removing %s\n", pdc_client_mpi_rank_g, batch->shm_addr);
+            free(batch->merged_metadata_id);
+            free(batch->merged_offset);
+            free(batch->merged_nelem);
+            free(batch->merged_access_type);
+            free(batch->merged_mem_type);
+        }
+        free(batch);
+        transfer_agg_batch_g = NULL;
+    }
+#endif
 
 done:
     fflush(stdout);
@@ -2882,6 +4291,7 @@ PDC_Client_buf_map(pdcid_t local_region_id, pdcid_t remote_obj_id, size_t ndim,
     size_t                   unit, unit_to;
     struct _pdc_buf_map_args map_args;
     hg_handle_t              client_send_buf_map_handle;
+    pdc_bulk_cache_map_t *   map;
 
     FUNC_ENTER(NULL);
 #ifdef PDC_TIMING
@@ -2999,8 +4409,20 @@ PDC_Client_buf_map(pdcid_t local_region_id, pdcid_t remote_obj_id, size_t ndim,
               &client_send_buf_map_handle);
 
     // Create bulk handle and release in PDC_Data_Server_buf_unmap()
-    hg_ret = HG_Bulk_create(hg_class, local_count, (void **)data_ptrs, (hg_size_t *)data_size,
-                            HG_BULK_READWRITE, &(in.local_bulk_handle));
+    if (local_count == 1) {
+        hg_ret = bulk_cache_acquire(hg_class, data_ptrs[0], data_size[0], HG_BULK_READWRITE,
+                                    &(in.local_bulk_handle));
+        if (hg_ret == HG_SUCCESS) {
+            map                = (pdc_bulk_cache_map_t *)calloc(1, sizeof(pdc_bulk_cache_map_t));
+            map->addr          = data_ptrs[0];
+            map->remote_obj_id = remote_obj_id;
+            map->remote_region = remote_region;
+            DL_APPEND(bulk_cache_maps_g, map);
+        }
+    }
+    else
+        hg_ret = HG_Bulk_create(hg_class, local_count, (void **)data_ptrs, (hg_size_t *)data_size,
+                                HG_BULK_READWRITE, &(in.local_bulk_handle));
     if (hg_ret != HG_SUCCESS)
         PGOTO_ERROR(FAIL, "PDC_Client_buf_map(): Could not create local bulk data handle");
 
@@ -3481,7 +4903,7 @@ update_metadata(struct _pdc_obj_info *object_info, pdc_var_type_t data_type, siz
 
     if (pdc_client_mpi_rank_g == 0) {
         PDC_metadata_init(&meta);
-        strcpy(meta.obj_name, object_info->obj_info_pub->name);
+        meta.obj_name  = object_info->obj_info_pub->name;
         meta.time_step = object_info->obj_pt->time_step;
         meta.obj_id    = object_info->obj_info_pub->meta_id;
         meta.cont_id   = object_info->cont->cont_info_pub->meta_id;
@@ -4381,8 +5803,7 @@ PDC_Client_data_server_write(struct pdc_request *request)
     // First check the obj ID are the same among the node local ranks
 
     // Normal send to server by each process
-    meta->data_location[0] = ' ';
-    meta->data_location[1] = 0;
+    meta->data_location = " ";
 
     in.client_id = pdc_client_mpi_rank_g;
     in.nclient   = n_client;
@@ -4707,6 +6128,196 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+static hg_return_t
+client_gen_obj_id_many_rpc_cb(const struct hg_cb_info *callback_info)
+{
+    hg_return_t                       ret_value = HG_SUCCESS;
+    hg_handle_t                       handle    = callback_info->info.forward.handle;
+    struct _pdc_obj_create_many_args *args;
+    gen_obj_id_many_out_t             output;
+
+    FUNC_ENTER(NULL);
+
+    args = (struct _pdc_obj_create_many_args *)callback_info->arg;
+
+    ret_value = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS) {
+        args->ret = -1;
+        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: %s - error with HG_Get_output", pdc_client_mpi_rank_g,
+                    __func__);
+    }
+    args->ret       = output.ret;
+    args->n_created = output.n_created;
+    HG_Free_output(handle, &output);
+
+done:
+    fflush(stdout);
+    work_todo_g--;
+
+    FUNC_LEAVE(ret_value);
+}
+
+// Send many names to their metadata servers, one RPC per server, and receive the obj ids
+perr_t
+PDC_Client_send_names_recv_ids(int n_obj, const char **obj_names, uint64_t cont_id, pdcid_t obj_create_prop,
+                               pdcid_t *meta_ids)
+{
+    perr_t                            ret_value = SUCCEED;
+    hg_return_t                       hg_ret;
+    struct _pdc_obj_prop *            create_prop = NULL;
+    gen_obj_id_many_in_t              in;
+    uint32_t *                        hash_values = NULL, *server_ids = NULL;
+    int *                             req_of_server = NULL;
+    struct _pdc_obj_create_many_args *reqs          = NULL;
+    int                               n_req = 0, n_sent = 0, i, r;
+    uint64_t *                        ids;
+    uint32_t *                        hashes;
+    char *                            names;
+
+    FUNC_ENTER(NULL);
+
+#ifdef PDC_TIMING
+    double start = MPI_Wtime(), end;
+#endif
+
+    if (n_obj <= 0)
+        PGOTO_DONE(SUCCEED);
+    if (obj_names == NULL || meta_ids == NULL)
+        PGOTO_ERROR(FAIL, "Cannot create objects with empty name list");
+
+    create_prop = PDC_obj_prop_get_info(obj_create_prop);
+
+    memset(&in, 0, sizeof(in));
+    PDC_Client_fill_obj_transfer(create_prop, cont_id, &in.data);
+    in.data.obj_name = " ";
+    in.data_type     = create_prop->obj_prop_pub->type;
+
+    hash_values   = (uint32_t *)malloc(n_obj * sizeof(uint32_t));
+    server_ids    = (uint32_t *)malloc(n_obj * sizeof(uint32_t));
+    req_of_server = (int *)malloc(pdc_server_num_g * sizeof(int));
+    reqs          = (struct _pdc_obj_create_many_args *)calloc(pdc_server_num_g, sizeof(*reqs));
+    if (hash_values == NULL || server_ids == NULL || req_of_server == NULL || reqs == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - cannot allocate request arrays", pdc_client_mpi_rank_g,
+                    __func__);
+
+    // Group the names by the metadata server that owns them
+    for (i = 0; i < pdc_server_num_g; i++)
+        req_of_server[i] = -1;
+    for (i = 0; i < n_obj; i++) {
+        meta_ids[i] = 0;
+        if (obj_names[i] == NULL)
+            PGOTO_ERROR(FAIL, "Cannot create object with empty object name");
+        hash_values[i] = PDC_get_hash_by_name(obj_names[i]);
+        server_ids[i]  = PDC_get_server_by_hash(hash_values[i] + in.data.time_step, pdc_server_num_g);
+        if (req_of_server[server_ids[i]] < 0) {
+            req_of_server[server_ids[i]] = n_req;
+            reqs[n_req].server_id        = server_ids[i];
+            n_req++;
+        }
+        r = req_of_server[server_ids[i]];
+        reqs[r].n_obj++;
+        reqs[r].nbytes += sizeof(uint64_t) + sizeof(uint32_t) + strlen(obj_names[i]) + 1;
+    }
+
+    // Lay out each request buffer as ids, hashes, then names, in the original order of the objects
+    for (r = 0; r < n_req; r++) {
+        reqs[r].buf = calloc(1, reqs[r].nbytes);
+        if (reqs[r].buf == NULL)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - cannot allocate request buffer", pdc_client_mpi_rank_g,
+                        __func__);
+    }
+    for (i = 0; i < n_obj; i++) {
+        r      = req_of_server[server_ids[i]];
+        ids    = (uint64_t *)reqs[r].buf;
+        hashes = (uint32_t *)(ids + reqs[r].n_obj);
+        names  = (char *)(hashes + reqs[r].n_obj) + reqs[r].name_off;
+
+        hashes[reqs[r].n_fill++] = hash_values[i];
+        strcpy(names, obj_names[i]);
+        reqs[r].name_off += strlen(obj_names[i]) + 1;
+    }
+
+    for (r = 0; r < n_req; r++) {
+        reqs[r].ret       = -1;
+        reqs[r].n_created = 0;
+
+        // Debug statistics for counting number of messages sent to each server.
+        debug_server_id_count[reqs[r].server_id]++;
+
+        if (PDC_Client_try_lookup_server(reqs[r].server_id) != SUCCEED) {
+            ret_value = FAIL;
+            break;
+        }
+        hg_ret = HG_Create(send_context_g, pdc_server_info_g[reqs[r].server_id].addr,
+                           gen_obj_many_register_id_g, &reqs[r].rpc_handle);
+        if (hg_ret != HG_SUCCESS) {
+            ret_value = FAIL;
+            break;
+        }
+        hg_ret = HG_Bulk_create(send_class_g, 1, &reqs[r].buf, &reqs[r].nbytes, HG_BULK_READWRITE,
+                                &reqs[r].bulk_handle);
+        if (hg_ret != HG_SUCCESS) {
+            HG_Destroy(reqs[r].rpc_handle);
+            ret_value = FAIL;
+            break;
+        }
+        in.n_obj       = reqs[r].n_obj;
+        in.bulk_handle = reqs[r].bulk_handle;
+
+        hg_ret = HG_Forward(reqs[r].rpc_handle, client_gen_obj_id_many_rpc_cb, &reqs[r], &in);
+        if (hg_ret != HG_SUCCESS) {
+            HG_Bulk_free(reqs[r].bulk_handle);
+            HG_Destroy(reqs[r].rpc_handle);
+            ret_value = FAIL;
+            break;
+        }
+        n_sent++;
+    }
+
+    // Wait for all servers to answer, they work on their batches concurrently
+    if (n_sent > 0) {
+        work_todo_g = n_sent;
+        PDC_Client_check_response(&send_context_g);
+    }
+
+    for (r = 0; r < n_sent; r++) {
+        HG_Bulk_free(reqs[r].bulk_handle);
+        HG_Destroy(reqs[r].rpc_handle);
+        if (reqs[r].ret != 1 || reqs[r].n_created != reqs[r].n_obj)
+            ret_value = FAIL;
+        reqs[r].n_fill = 0;
+    }
+
+    // The servers pushed the ids back to the head of each buffer
+    for (i = 0; i < n_obj; i++) {
+        r = req_of_server[server_ids[i]];
+        if (r >= n_sent || reqs[r].ret != 1)
+            continue;
+        meta_ids[i] = ((uint64_t *)reqs[r].buf)[reqs[r].n_fill++];
+    }
+
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - not all objects were created", pdc_client_mpi_rank_g,
+                    __func__);
+
+#ifdef PDC_TIMING
+    end = MPI_Wtime();
+    timings.PDCclient_obj_create_rpc += end - start;
+#endif
+
+done:
+    if (reqs != NULL) {
+        for (r = 0; r < n_req; r++)
+            free(reqs[r].buf);
+    }
+    free(reqs);
+    free(req_of_server);
+    free(server_ids);
+    free(hash_values);
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 static hg_return_t
 PDC_Client_add_del_objects_to_container_cb(const struct hg_cb_info *callback_info)
 {
@@ -4952,7 +6563,7 @@ PDC_Client_query_container_name(const char *cont_name, uint64_t *cont_meta_id)
 
     // Compute server id
     hash_name_value = PDC_get_hash_by_name(cont_name);
-    server_id       = hash_name_value % pdc_server_num_g;
+    server_id       = PDC_get_server_by_hash(hash_name_value, pdc_server_num_g);
 
     // Debug statistics for counting number of messages sent to each server.
     debug_server_id_count[server_id]++;
@@ -5338,6 +6949,77 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+static hg_return_t
+meta_store_stats_rpc_cb(const struct hg_cb_info *callback_info)
+{
+    hg_return_t                        ret_value = HG_SUCCESS;
+    struct _pdc_meta_store_stats_args *args      = (struct _pdc_meta_store_stats_args *)callback_info->arg;
+    hg_handle_t                        handle    = callback_info->info.forward.handle;
+    meta_store_stats_out_t             output;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS) {
+        args->ret = -1;
+        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: %s - error with HG_Get_output", pdc_client_mpi_rank_g,
+                    __func__);
+    }
+    args->ret    = 1;
+    *args->stats = output;
+
+done:
+    fflush(stdout);
+    work_todo_g--;
+    HG_Free_output(handle, &output);
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Client_server_meta_store_stats(uint32_t server_id, meta_store_stats_out_t *stats)
+{
+    perr_t                            ret_value = SUCCEED;
+    hg_return_t                       hg_ret;
+    pdc_int_send_t                    in;
+    struct _pdc_meta_store_stats_args args;
+    hg_handle_t                       rpc_handle;
+
+    FUNC_ENTER(NULL);
+
+    if (server_id >= (uint32_t)pdc_server_num_g || stats == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: invalid server %u", pdc_client_mpi_rank_g, server_id);
+
+    if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
+
+    hg_ret = HG_Create(send_context_g, pdc_server_info_g[server_id].addr, meta_store_stats_register_id_g,
+                       &rpc_handle);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Could not create handle", pdc_client_mpi_rank_g);
+
+    args.ret   = 0;
+    args.stats = stats;
+    in.origin  = pdc_client_mpi_rank_g;
+    hg_ret     = HG_Forward(rpc_handle, meta_store_stats_rpc_cb, &args, &in);
+    if (hg_ret != HG_SUCCESS) {
+        HG_Destroy(rpc_handle);
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Could not start forward to server", pdc_client_mpi_rank_g);
+    }
+
+    // Wait for response from server
+    work_todo_g = 1;
+    PDC_Client_check_response(&send_context_g);
+    HG_Destroy(rpc_handle);
+
+    if (args.ret != 1)
+        ret_value = FAIL;
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Client_all_server_checkpoint()
 {
@@ -5365,36 +7047,37 @@ perr_t
 PDC_Client_attach_metadata_to_local_obj(const char *obj_name, uint64_t obj_id, uint64_t cont_id,
                                         struct _pdc_obj_info *obj_info)
 {
-    perr_t ret_value = SUCCEED;
+    perr_t         ret_value = SUCCEED;
+    pdc_metadata_t meta;
 
     FUNC_ENTER(NULL);
 
-    obj_info->metadata                              = (pdc_metadata_t *)calloc(1, sizeof(pdc_metadata_t));
-    ((pdc_metadata_t *)obj_info->metadata)->user_id = obj_info->obj_pt->user_id;
-    if (NULL != obj_info->obj_pt->app_name)
-        strcpy(((pdc_metadata_t *)obj_info->metadata)->app_name, obj_info->obj_pt->app_name);
-    if (NULL != obj_name)
-        strcpy(((pdc_metadata_t *)obj_info->metadata)->obj_name, obj_name);
-    ((pdc_metadata_t *)obj_info->metadata)->time_step = obj_info->obj_pt->time_step;
-    ((pdc_metadata_t *)obj_info->metadata)->obj_id    = obj_id;
-    ((pdc_metadata_t *)obj_info->metadata)->cont_id   = cont_id;
-    if (NULL != obj_info->obj_pt->tags)
-        strcpy(((pdc_metadata_t *)obj_info->metadata)->tags, obj_info->obj_pt->tags);
-    if (NULL != obj_info->obj_pt->data_loc)
-
-        strcpy(((pdc_metadata_t *)obj_info->metadata)->data_location, obj_info->obj_pt->data_loc);
-    ((pdc_metadata_t *)obj_info->metadata)->ndim = obj_info->obj_pt->obj_prop_pub->ndim;
+    // The strings are copied into the same allocation, so freeing the metadata frees them
+    memset(&meta, 0, sizeof(pdc_metadata_t));
+    meta.user_id       = obj_info->obj_pt->user_id;
+    meta.app_name      = obj_info->obj_pt->app_name;
+    meta.obj_name      = obj_name;
+    meta.time_step     = obj_info->obj_pt->time_step;
+    meta.obj_id        = obj_id;
+    meta.cont_id       = cont_id;
+    meta.tags          = obj_info->obj_pt->tags;
+    meta.data_location = obj_info->obj_pt->data_loc;
+    meta.ndim          = obj_info->obj_pt->obj_prop_pub->ndim;
     if (NULL != obj_info->obj_pt->obj_prop_pub->dims)
-        memcpy(((pdc_metadata_t *)obj_info->metadata)->dims, obj_info->obj_pt->obj_prop_pub->dims,
+        memcpy(meta.dims, obj_info->obj_pt->obj_prop_pub->dims,
                sizeof(uint64_t) * obj_info->obj_pt->obj_prop_pub->ndim);
+    obj_info->metadata = PDC_metadata_dup(&meta);
+    if (obj_info->metadata == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot allocate object metadata", pdc_client_mpi_rank_g);
 
+done:
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDC_Client_send_client_shm_info(uint32_t server_id, char *shm_addr, uint64_t size)
+static perr_t
+PDC_Client_send_shm_rpc(uint32_t server_id, hg_id_t rpc_id, char *shm_addr, uint64_t size, uint64_t token)
 {
-    perr_t                         ret_value;
+    perr_t                         ret_value = SUCCEED;
     hg_return_t                    hg_ret;
     send_shm_in_t                  in;
     struct _pdc_client_lookup_args lookup_args;
@@ -5408,14 +7091,14 @@ PDC_Client_send_client_shm_info(uint32_t server_id, char *shm_addr, uint64_t siz
     if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
         PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
 
-    hg_ret =
-        HG_Create(send_context_g, pdc_server_info_g[server_id].addr, send_shm_register_id_g, &rpc_handle);
+    hg_ret = HG_Create(send_context_g, pdc_server_info_g[server_id].addr, rpc_id, &rpc_handle);
     if (hg_ret != HG_SUCCESS)
         PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Could not create handle", pdc_client_mpi_rank_g);
 
     in.client_id = pdc_client_mpi_rank_g;
     in.shm_addr  = shm_addr;
     in.size      = size;
+    in.token     = token;
 
     hg_ret = HG_Forward(rpc_handle, pdc_client_check_int_ret_cb, &lookup_args, &in);
     if (hg_ret != HG_SUCCESS)
@@ -5425,6 +7108,9 @@ PDC_Client_send_client_shm_info(uint32_t server_id, char *shm_addr, uint64_t siz
     work_todo_g = 1;
     PDC_Client_check_response(&send_context_g);
 
+    if (lookup_args.ret != 1)
+        ret_value = FAIL;
+
 done:
     fflush(stdout);
     HG_Destroy(rpc_handle);
@@ -5432,6 +7118,18 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+perr_t
+PDC_Client_send_client_shm_info(uint32_t server_id, char *shm_addr, uint64_t size, uint64_t token)
+{
+    return PDC_Client_send_shm_rpc(server_id, send_shm_register_id_g, shm_addr, size, token);
+}
+
+perr_t
+PDC_Client_detach_client_shm(uint32_t server_id, uint64_t token)
+{
+    return PDC_Client_send_shm_rpc(server_id, detach_shm_register_id_g, "", 0, token);
+}
+
 static region_list_t *
 PDC_get_storage_meta_from_io_list(pdc_data_server_io_list_t **list, region_storage_meta_t *storage_meta)
 {
@@ -6518,79 +8216,240 @@ PDC_get_kvtag(pdcid_t obj_id, char *tag_name, pdc_kvtag_t **kvtag, int is_cont)
     work_todo_g = 1;
     PDC_Client_check_response(&send_context_g);
 
-    if (lookup_args.ret != 1)
-        printf("PDC_CLIENT: get kvtag NOT successful ... ret_value = %d\n", lookup_args.ret);
+    if (lookup_args.ret != 1)
+        printf("PDC_CLIENT: get kvtag NOT successful ... ret_value = %d\n", lookup_args.ret);
+
+done:
+    fflush(stdout);
+    HG_Destroy(metadata_get_kvtag_handle);
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCtag_delete(pdcid_t obj_id, char *tag_name)
+{
+    perr_t                         ret_value = SUCCEED;
+    hg_return_t                    hg_ret    = 0;
+    uint64_t                       meta_id;
+    uint32_t                       server_id;
+    hg_handle_t                    metadata_del_kvtag_handle;
+    metadata_get_kvtag_in_t        in;
+    struct _pdc_obj_info *         obj_prop;
+    struct _pdc_client_lookup_args lookup_args;
+
+    FUNC_ENTER(NULL);
+
+    obj_prop  = PDC_obj_get_info(obj_id);
+    meta_id   = obj_prop->obj_info_pub->meta_id;
+    server_id = PDC_get_server_by_obj_id(meta_id, pdc_server_num_g);
+
+    debug_server_id_count[server_id]++;
+
+    if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
+
+    HG_Create(send_context_g, pdc_server_info_g[server_id].addr, metadata_del_kvtag_register_id_g,
+              &metadata_del_kvtag_handle);
+
+    // Fill input structure
+    in.obj_id     = meta_id;
+    in.hash_value = PDC_get_hash_by_name(obj_prop->obj_info_pub->name);
+    in.key        = tag_name;
+
+    hg_ret = HG_Forward(metadata_del_kvtag_handle, metadata_add_tag_rpc_cb /*reuse*/, &lookup_args, &in);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "PDC_Client_del_kvtag_metadata_with_name(): Could not start HG_Forward()");
+
+    // Wait for response from server
+    work_todo_g = 1;
+    PDC_Client_check_response(&send_context_g);
+
+    if (lookup_args.ret != 1)
+        printf("PDC_CLIENT: del kvtag NOT successful ... ret_value = %d\n", lookup_args.ret);
+
+done:
+    fflush(stdout);
+    HG_Destroy(metadata_del_kvtag_handle);
+
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Scatter/gather of one RPC over a set of servers. Every request is forwarded before any progress is
+ * made, so the caller waits for the slowest server instead of the sum of all of them. A target is
+ * finished once its callbacks call PDC_Client_scatter_done, which may be after a bulk pull.
+ */
+struct _pdc_scatter;
+
+struct _pdc_scatter_target {
+    struct _pdc_scatter *sg;
+    uint32_t             server_id;
+    hg_handle_t          handle;
+    void *               arg;
+    perr_t               ret;
+};
+
+struct _pdc_scatter {
+    int                         n_target;
+    int                         n_pending;
+    struct _pdc_scatter_target *target;
+    void *                      args;
+};
+
+// Set up n_target targets, each with arg_size zeroed bytes of caller state in target->arg
+static perr_t
+PDC_Client_scatter_init(struct _pdc_scatter *sg, int n_target, size_t arg_size)
+{
+    perr_t ret_value = SUCCEED;
+    int    i;
+
+    FUNC_ENTER(NULL);
+
+    memset(sg, 0, sizeof(struct _pdc_scatter));
+    if (n_target <= 0)
+        PGOTO_DONE(ret_value);
+
+    sg->target = (struct _pdc_scatter_target *)calloc(n_target, sizeof(struct _pdc_scatter_target));
+    if (arg_size > 0)
+        sg->args = calloc(n_target, arg_size);
+    if (sg->target == NULL || (arg_size > 0 && sg->args == NULL))
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error allocating %d scatter targets", pdc_client_mpi_rank_g,
+                    n_target);
+
+    sg->n_target = n_target;
+    for (i = 0; i < n_target; i++) {
+        sg->target[i].sg     = sg;
+        sg->target[i].handle = HG_HANDLE_NULL;
+        sg->target[i].arg    = arg_size > 0 ? (char *)sg->args + i * arg_size : NULL;
+        sg->target[i].ret    = SUCCEED;
+    }
 
 done:
     fflush(stdout);
-    HG_Destroy(metadata_get_kvtag_handle);
-
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDCtag_delete(pdcid_t obj_id, char *tag_name)
+// Forward the RPC of the idx-th target to its server without waiting for the response
+static perr_t
+PDC_Client_scatter_forward(struct _pdc_scatter *sg, int idx, uint32_t server_id, hg_id_t rpc_id, hg_cb_t cb,
+                           void *in)
 {
-    perr_t                         ret_value = SUCCEED;
-    hg_return_t                    hg_ret    = 0;
-    uint64_t                       meta_id;
-    uint32_t                       server_id;
-    hg_handle_t                    metadata_del_kvtag_handle;
-    metadata_get_kvtag_in_t        in;
-    struct _pdc_obj_info *         obj_prop;
-    struct _pdc_client_lookup_args lookup_args;
+    perr_t                      ret_value = SUCCEED;
+    struct _pdc_scatter_target *target    = &sg->target[idx];
 
     FUNC_ENTER(NULL);
 
-    obj_prop  = PDC_obj_get_info(obj_id);
-    meta_id   = obj_prop->obj_info_pub->meta_id;
-    server_id = PDC_get_server_by_obj_id(meta_id, pdc_server_num_g);
+    target->server_id = server_id;
 
+    // Debug statistics for counting number of messages sent to each server.
     debug_server_id_count[server_id]++;
 
     if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
-        PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
 
-    HG_Create(send_context_g, pdc_server_info_g[server_id].addr, metadata_del_kvtag_register_id_g,
-              &metadata_del_kvtag_handle);
+    if (HG_Create(send_context_g, pdc_server_info_g[server_id].addr, rpc_id, &target->handle) != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Could not create handle to server %u", pdc_client_mpi_rank_g,
+                    server_id);
 
-    // Fill input structure
-    in.obj_id     = meta_id;
-    in.hash_value = PDC_get_hash_by_name(obj_prop->obj_info_pub->name);
-    in.key        = tag_name;
+    // The input is encoded by HG_Forward, so the caller may change it for the next target
+    sg->n_pending++;
+    if (HG_Forward(target->handle, cb, target, in) != HG_SUCCESS) {
+        sg->n_pending--;
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Could not forward to server %u", pdc_client_mpi_rank_g,
+                    server_id);
+    }
 
-    hg_ret = HG_Forward(metadata_del_kvtag_handle, metadata_add_tag_rpc_cb /*reuse*/, &lookup_args, &in);
-    if (hg_ret != HG_SUCCESS)
-        PGOTO_ERROR(FAIL, "PDC_Client_del_kvtag_metadata_with_name(): Could not start HG_Forward()");
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
 
-    // Wait for response from server
-    work_todo_g = 1;
-    PDC_Client_check_response(&send_context_g);
+static void
+PDC_Client_scatter_done(struct _pdc_scatter_target *target, perr_t ret)
+{
+    FUNC_ENTER(NULL);
 
-    if (lookup_args.ret != 1)
-        printf("PDC_CLIENT: del kvtag NOT successful ... ret_value = %d\n", lookup_args.ret);
+    target->ret = ret;
+    target->sg->n_pending--;
+
+    FUNC_LEAVE_VOID;
+}
+
+// Progress all forwarded targets until they are finished, fails if any of them failed
+static perr_t
+PDC_Client_scatter_wait(struct _pdc_scatter *sg)
+{
+    perr_t       ret_value = SUCCEED;
+    hg_return_t  hg_ret;
+    unsigned int actual_count;
+    int          i;
+
+    FUNC_ENTER(NULL);
+
+    while (sg->n_pending > 0) {
+        do {
+            hg_ret = HG_Trigger(send_context_g, 0 /* timeout */, 1 /* max count */, &actual_count);
+        } while ((hg_ret == HG_SUCCESS) && actual_count);
+
+        if (sg->n_pending <= 0)
+            break;
+
+        hg_ret = HG_Progress(send_context_g, HG_MAX_IDLE_TIME);
+        if (hg_ret != HG_SUCCESS && hg_ret != HG_TIMEOUT)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with HG_Progress, %d requests pending",
+                        pdc_client_mpi_rank_g, sg->n_pending);
+    }
+
+    for (i = 0; i < sg->n_target; i++) {
+        if (sg->target[i].ret != SUCCEED)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: request to server %u failed", pdc_client_mpi_rank_g,
+                        sg->target[i].server_id);
+    }
 
 done:
     fflush(stdout);
-    HG_Destroy(metadata_del_kvtag_handle);
-
     FUNC_LEAVE(ret_value);
 }
 
+static void
+PDC_Client_scatter_free(struct _pdc_scatter *sg)
+{
+    int i;
+
+    FUNC_ENTER(NULL);
+
+    // Callbacks still in flight write to the target state
+    if (sg->n_pending > 0)
+        PDC_Client_scatter_wait(sg);
+
+    for (i = 0; i < sg->n_target; i++) {
+        if (sg->target[i].handle != HG_HANDLE_NULL)
+            HG_Destroy(sg->target[i].handle);
+    }
+    free(sg->target);
+    free(sg->args);
+    memset(sg, 0, sizeof(struct _pdc_scatter));
+
+    FUNC_LEAVE_VOID;
+}
+
 static hg_return_t
 kvtag_query_bulk_cb(const struct hg_cb_info *hg_cb_info)
 {
-    hg_return_t         ret_value = HG_SUCCESS;
-    struct bulk_args_t *bulk_args;
-    hg_bulk_t           origin_bulk_handle = hg_cb_info->info.bulk.origin_handle;
-    hg_bulk_t           local_bulk_handle  = hg_cb_info->info.bulk.local_handle;
-    void *              buf                = NULL;
-    uint32_t            n_meta, actual_cnt;
-    uint64_t            buf_sizes[1];
+    hg_return_t                 ret_value = HG_SUCCESS;
+    struct _pdc_scatter_target *target;
+    struct bulk_args_t *        bulk_args;
+    hg_bulk_t                   origin_bulk_handle = hg_cb_info->info.bulk.origin_handle;
+    hg_bulk_t                   local_bulk_handle  = hg_cb_info->info.bulk.local_handle;
+    void *                      buf                = NULL;
+    uint32_t                    n_meta, actual_cnt;
+    uint64_t                    buf_sizes[1];
 
     FUNC_ENTER(NULL);
 
-    bulk_args = (struct bulk_args_t *)hg_cb_info->arg;
+    target    = (struct _pdc_scatter_target *)hg_cb_info->arg;
+    bulk_args = (struct bulk_args_t *)target->arg;
 
     n_meta = bulk_args->n_meta;
 
@@ -6604,9 +8463,6 @@ kvtag_query_bulk_cb(const struct hg_cb_info *hg_cb_info)
     else
         PGOTO_ERROR(HG_PROTOCOL_ERROR, "==PDC_CLIENT[%d]: Error with bulk handle", pdc_client_mpi_rank_g);
 
-    bulk_todo_g--;
-    hg_atomic_set32(&bulk_transfer_done_g, 1);
-
     // Free local bulk handle
     ret_value = HG_Bulk_free(local_bulk_handle);
     if (ret_value != HG_SUCCESS)
@@ -6618,7 +8474,7 @@ kvtag_query_bulk_cb(const struct hg_cb_info *hg_cb_info)
 
 done:
     fflush(stdout);
-    HG_Destroy(bulk_args->handle);
+    PDC_Client_scatter_done(target, bulk_args->obj_ids != NULL ? SUCCEED : FAIL);
 
     FUNC_LEAVE(ret_value);
 }
@@ -6627,6 +8483,7 @@ static hg_return_t
 kvtag_query_forward_cb(const struct hg_cb_info *callback_info)
 {
     hg_return_t                   ret_value;
+    struct _pdc_scatter_target *  target;
     struct bulk_args_t *          bulk_arg;
     hg_handle_t                   handle;
     metadata_query_transfer_out_t output;
@@ -6635,10 +8492,12 @@ kvtag_query_forward_cb(const struct hg_cb_info *callback_info)
     hg_bulk_t                     local_bulk_handle  = HG_BULK_NULL;
     hg_bulk_t                     origin_bulk_handle = HG_BULK_NULL;
     const struct hg_info *        hg_info            = NULL;
+    int                           pulling            = 0;
 
     FUNC_ENTER(NULL);
 
-    bulk_arg = (struct bulk_args_t *)callback_info->arg;
+    target   = (struct _pdc_scatter_target *)callback_info->arg;
+    bulk_arg = (struct bulk_args_t *)target->arg;
     handle   = callback_info->info.forward.handle;
 
     // Get output from server
@@ -6647,12 +8506,8 @@ kvtag_query_forward_cb(const struct hg_cb_info *callback_info)
         PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error HG_Get_output", pdc_client_mpi_rank_g);
 
     if (output.bulk_handle == HG_BULK_NULL || output.ret == 0) {
-        bulk_todo_g = 0;
-        work_todo_g--;
         bulk_arg->n_meta  = 0;
         bulk_arg->obj_ids = NULL;
-        HG_Free_output(handle, &output);
-        HG_Destroy(handle);
         PGOTO_DONE(ret_value);
     }
 
@@ -6663,9 +8518,8 @@ kvtag_query_forward_cb(const struct hg_cb_info *callback_info)
     origin_bulk_handle = output.bulk_handle;
     hg_info            = HG_Get_info(handle);
 
-    bulk_arg->handle  = handle;
-    bulk_arg->nbytes  = HG_Bulk_get_size(origin_bulk_handle);
-    bulk_arg->obj_ids = bulk_arg->obj_ids;
+    bulk_arg->handle = handle;
+    bulk_arg->nbytes = HG_Bulk_get_size(origin_bulk_handle);
 
     /* Create a new bulk handle to read the data */
     HG_Bulk_create(hg_info->hg_class, 1, NULL, (hg_size_t *)&bulk_arg->nbytes, HG_BULK_READWRITE,
@@ -6673,77 +8527,99 @@ kvtag_query_forward_cb(const struct hg_cb_info *callback_info)
 
     /* Pull bulk data */
     ret_value =
-        HG_Bulk_transfer(hg_info->context, kvtag_query_bulk_cb, bulk_arg, HG_BULK_PULL, hg_info->addr,
+        HG_Bulk_transfer(hg_info->context, kvtag_query_bulk_cb, target, HG_BULK_PULL, hg_info->addr,
                          origin_bulk_handle, 0, local_bulk_handle, 0, bulk_arg->nbytes, &hg_bulk_op_id);
     if (ret_value != HG_SUCCESS)
         PGOTO_ERROR(FAIL, "Could not read bulk data");
+    pulling = 1;
 
 done:
     fflush(stdout);
-    work_todo_g--;
+    // The target finishes in kvtag_query_bulk_cb once the object IDs are pulled
+    if (!pulling)
+        PDC_Client_scatter_done(target, ret_value == HG_SUCCESS ? SUCCEED : FAIL);
     HG_Free_output(handle, &output);
 
     FUNC_LEAVE(ret_value);
 }
 
+// Query a set of servers at once and append the object IDs they return in server order
 static perr_t
-PDC_Client_query_kvtag_server(uint32_t server_id, const pdc_kvtag_t *kvtag, int *n_res, uint64_t **out)
+PDC_Client_query_kvtag_servers(int n_server, const uint32_t *server_ids, const pdc_kvtag_t *kvtag,
+                               pdc_kvtag_op_t op, pdc_var_type_t type, int *n_res, uint64_t **out)
 {
     perr_t              ret_value = SUCCEED;
-    hg_return_t         hg_ret;
-    hg_handle_t         query_kvtag_server_handle;
-    pdc_kvtag_t         in;
+    kvtag_query_in_t    in;
+    struct _pdc_scatter sg;
     struct bulk_args_t *bulk_arg;
+    int                 i, n_total = 0;
 
     FUNC_ENTER(NULL);
 
+    memset(&sg, 0, sizeof(struct _pdc_scatter));
+
     if (kvtag == NULL || n_res == NULL || out == NULL)
         PGOTO_ERROR(FAIL, "==CLIENT[%d]: input is NULL!", pdc_client_mpi_rank_g);
 
     if (kvtag->name == NULL)
-        in.name = " ";
+        in.kvtag.name = " ";
     else
-        in.name = kvtag->name;
+        in.kvtag.name = kvtag->name;
 
     if (kvtag->value == NULL) {
-        in.value = " ";
-        in.size  = 1;
+        in.kvtag.value = " ";
+        in.kvtag.size  = 1;
+        op             = PDC_KVTAG_EQ;
     }
     else {
-        in.value = kvtag->value;
-        in.size  = kvtag->size;
+        in.kvtag.value = kvtag->value;
+        in.kvtag.size  = kvtag->size;
     }
+    in.op   = op;
+    in.type = type;
 
     *out   = NULL;
     *n_res = 0;
 
-    if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
-        PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
-
-    hg_ret = HG_Create(send_context_g, pdc_server_info_g[server_id].addr, query_kvtag_register_id_g,
-                       &query_kvtag_server_handle);
+    if (PDC_Client_scatter_init(&sg, n_server, sizeof(struct bulk_args_t)) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_scatter_init", pdc_client_mpi_rank_g);
 
-    bulk_arg = (struct bulk_args_t *)calloc(1, sizeof(struct bulk_args_t));
-    if (query_kvtag_server_handle == NULL)
-        PGOTO_ERROR(FAIL, "==CLIENT[%d]: Error with query_kvtag_server_handle", pdc_client_mpi_rank_g);
-
-    hg_ret = HG_Forward(query_kvtag_server_handle, kvtag_query_forward_cb, bulk_arg, &in);
-    if (hg_ret != HG_SUCCESS)
-        PGOTO_ERROR(FAIL, "PDC_client_list_all(): Could not start HG_Forward()");
+    for (i = 0; i < n_server; i++) {
+        if (PDC_Client_scatter_forward(&sg, i, server_ids[i], query_kvtag_register_id_g,
+                                       kvtag_query_forward_cb, &in) != SUCCEED)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error sending kvtag query to server %u",
+                        pdc_client_mpi_rank_g, server_ids[i]);
+    }
 
-    hg_atomic_set32(&bulk_transfer_done_g, 0);
+    if (PDC_Client_scatter_wait(&sg) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with kvtag query", pdc_client_mpi_rank_g);
 
-    // Wait for response from server
-    bulk_todo_g = 1;
-    PDC_Client_check_bulk(send_context_g);
+    // Each server only returns its own objects, append them
+    for (i = 0; i < n_server; i++)
+        n_total += ((struct bulk_args_t *)sg.target[i].arg)->n_meta;
+    if (n_total == 0)
+        PGOTO_DONE(ret_value);
 
-    *n_res = bulk_arg->n_meta;
-    *out   = bulk_arg->obj_ids;
-    free(bulk_arg);
-    // TODO: need to be careful when freeing the lookup_args, as it include the results returned to user
+    *out = (uint64_t *)malloc(n_total * sizeof(uint64_t));
+    if (*out == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error allocating %d object IDs", pdc_client_mpi_rank_g,
+                    n_total);
+    for (i = 0; i < n_server; i++) {
+        bulk_arg = (struct bulk_args_t *)sg.target[i].arg;
+        if (bulk_arg->n_meta == 0)
+            continue;
+        memcpy(*out + *n_res, bulk_arg->obj_ids, bulk_arg->n_meta * sizeof(uint64_t));
+        *n_res += bulk_arg->n_meta;
+    }
 
 done:
     fflush(stdout);
+    if (sg.n_pending > 0)
+        PDC_Client_scatter_wait(&sg);
+    for (i = 0; i < sg.n_target; i++)
+        free(((struct bulk_args_t *)sg.target[i].arg)->obj_ids);
+    PDC_Client_scatter_free(&sg);
+
     FUNC_LEAVE(ret_value);
 }
 
@@ -6751,24 +8627,38 @@ done:
 perr_t
 PDC_Client_query_kvtag(const pdc_kvtag_t *kvtag, int *n_res, uint64_t **pdc_ids)
 {
-    perr_t  ret_value = SUCCEED;
-    int32_t i;
-    int     nmeta = 0;
+    perr_t ret_value;
 
     FUNC_ENTER(NULL);
 
-    *n_res = 0;
-    for (i = 0; i < pdc_server_num_g; i++) {
-        ret_value = PDC_Client_query_kvtag_server((uint32_t)i, kvtag, &nmeta, pdc_ids);
-        if (ret_value != SUCCEED)
-            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_query_kvtag_server to server %d",
-                        pdc_client_mpi_rank_g, i);
-    }
+    ret_value = PDC_Client_query_kvtag_op(kvtag, PDC_KVTAG_EQ, PDC_UNKNOWN, n_res, pdc_ids);
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Client_query_kvtag_op(const pdc_kvtag_t *kvtag, pdc_kvtag_op_t op, pdc_var_type_t type, int *n_res,
+                          uint64_t **pdc_ids)
+{
+    perr_t    ret_value = SUCCEED;
+    int32_t   i;
+    uint32_t *server_ids;
+
+    FUNC_ENTER(NULL);
+
+    server_ids = (uint32_t *)malloc(pdc_server_num_g * sizeof(uint32_t));
+    for (i = 0; i < pdc_server_num_g; i++)
+        server_ids[i] = (uint32_t)i;
 
-    *n_res = nmeta;
+    ret_value = PDC_Client_query_kvtag_servers(pdc_server_num_g, server_ids, kvtag, op, type, n_res, pdc_ids);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_query_kvtag_servers",
+                    pdc_client_mpi_rank_g);
 
 done:
     fflush(stdout);
+    free(server_ids);
+
     FUNC_LEAVE(ret_value);
 }
 
@@ -6792,6 +8682,7 @@ PDC_assign_server(uint32_t *my_server_start, uint32_t *my_server_end, uint32_t *
             *my_server_end = 0;
         }
     }
+    *my_server_count = *my_server_end > *my_server_start ? *my_server_end - *my_server_start : 0;
 
     FUNC_LEAVE_VOID;
 }
@@ -6800,44 +8691,88 @@ PDC_assign_server(uint32_t *my_server_start, uint32_t *my_server_end, uint32_t *
 perr_t
 PDC_Client_query_kvtag_col(const pdc_kvtag_t *kvtag, int *n_res, uint64_t **pdc_ids)
 {
-    perr_t  ret_value = SUCCEED;
-    int32_t my_server_start, my_server_end, my_server_count;
-    int32_t i;
-    int     nmeta = 0;
+    perr_t    ret_value = SUCCEED;
+    uint32_t  my_server_start, my_server_end, my_server_count;
+    uint32_t  i;
+    uint32_t *server_ids = NULL;
 
     FUNC_ENTER(NULL);
 
-    if (pdc_server_num_g > pdc_client_mpi_size_g) {
-        my_server_count = pdc_server_num_g / pdc_client_mpi_size_g;
-        my_server_start = pdc_client_mpi_rank_g * my_server_count;
-        my_server_end   = my_server_start + my_server_count;
-        if (pdc_client_mpi_rank_g == pdc_client_mpi_size_g - 1) {
-            my_server_end += pdc_server_num_g % pdc_client_mpi_size_g;
-        }
+    PDC_assign_server(&my_server_start, &my_server_end, &my_server_count);
+
+    if (my_server_count > 0) {
+        server_ids = (uint32_t *)malloc(my_server_count * sizeof(uint32_t));
+        for (i = 0; i < my_server_count; i++)
+            server_ids[i] = my_server_start + i;
     }
-    else {
-        my_server_start = pdc_client_mpi_rank_g;
-        my_server_end   = my_server_start + 1;
-        if (pdc_client_mpi_rank_g >= pdc_server_num_g) {
-            my_server_end = 0;
-        }
+
+    ret_value = PDC_Client_query_kvtag_servers((int)my_server_count, server_ids, kvtag, PDC_KVTAG_EQ,
+                                               PDC_UNKNOWN, n_res, pdc_ids);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_query_kvtag_servers",
+                    pdc_client_mpi_rank_g);
+
+done:
+    fflush(stdout);
+    free(server_ids);
+
+    FUNC_LEAVE(ret_value);
+}
+
+// All clients collectively query all servers and each gets the results of all of them
+perr_t
+PDC_Client_query_kvtag_mpi(const pdc_kvtag_t *kvtag, int *n_res, uint64_t **pdc_ids)
+{
+    perr_t ret_value = SUCCEED;
+#ifdef ENABLE_MPI
+    int       my_nres = 0, i;
+    uint64_t *my_ids  = NULL;
+    int *     counts = NULL, *displs = NULL;
+#endif
+
+    FUNC_ENTER(NULL);
+
+    *n_res   = 0;
+    *pdc_ids = NULL;
+
+#ifdef ENABLE_MPI
+    ret_value = PDC_Client_query_kvtag_col(kvtag, &my_nres, &my_ids);
+
+    // Every rank has to take part in the gather, so a failed rank contributes no results
+    if (ret_value != SUCCEED)
+        my_nres = 0;
+
+    counts = (int *)malloc(pdc_client_mpi_size_g * sizeof(int));
+    displs = (int *)malloc(pdc_client_mpi_size_g * sizeof(int));
+    MPI_Allgather(&my_nres, 1, MPI_INT, counts, 1, MPI_INT, PDC_CLIENT_COMM_WORLD_g);
+
+    for (i = 0; i < pdc_client_mpi_size_g; i++) {
+        displs[i] = *n_res;
+        *n_res += counts[i];
     }
 
-    *n_res = 0;
-    for (i = my_server_start; i < my_server_end; i++) {
-        if (i >= pdc_server_num_g) {
-            break;
-        }
-        ret_value = PDC_Client_query_kvtag_server((uint32_t)i, kvtag, &nmeta, pdc_ids);
-        if (ret_value != SUCCEED)
-            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_query_kvtag_server to server %u",
-                        pdc_client_mpi_rank_g, i);
+    if (*n_res > 0) {
+        *pdc_ids = (uint64_t *)malloc(*n_res * sizeof(uint64_t));
+        MPI_Allgatherv(my_ids, my_nres, MPI_UINT64_T, *pdc_ids, counts, displs, MPI_UINT64_T,
+                       PDC_CLIENT_COMM_WORLD_g);
     }
 
-    *n_res = nmeta;
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_query_kvtag_col", pdc_client_mpi_rank_g);
+#else
+    ret_value = PDC_Client_query_kvtag(kvtag, n_res, pdc_ids);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_query_kvtag", pdc_client_mpi_rank_g);
+#endif
 
 done:
     fflush(stdout);
+#ifdef ENABLE_MPI
+    free(my_ids);
+    free(counts);
+    free(displs);
+#endif
+
     FUNC_LEAVE(ret_value);
 }
 
@@ -6954,74 +8889,288 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDCcont_get_objids(pdcid_t cont_id ATTRIBUTE(unused), int *nobj ATTRIBUTE(unused),
-                   pdcid_t **obj_ids ATTRIBUTE(unused))
+perr_t
+PDCcont_get_objids(pdcid_t cont_id ATTRIBUTE(unused), int *nobj ATTRIBUTE(unused),
+                   pdcid_t **obj_ids ATTRIBUTE(unused))
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    // TODO
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCcont_put_tag(pdcid_t cont_id, char *tag_name, void *tag_value, psize_t value_size)
+{
+    perr_t      ret_value = SUCCEED;
+    pdc_kvtag_t kvtag;
+
+    FUNC_ENTER(NULL);
+
+    kvtag.name  = tag_name;
+    kvtag.value = (void *)tag_value;
+    kvtag.size  = (uint64_t)value_size;
+
+    ret_value = PDC_add_kvtag(cont_id, &kvtag, 1);
+    if (ret_value != SUCCEED)
+
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Error with PDCcont_put_tag", pdc_client_mpi_rank_g);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCcont_get_tag(pdcid_t cont_id, char *tag_name, void **tag_value, psize_t *value_size)
+{
+    perr_t       ret_value = SUCCEED;
+    pdc_kvtag_t *kvtag     = NULL;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_get_kvtag(cont_id, tag_name, &kvtag, 1);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Error with PDC_get_kvtag", pdc_client_mpi_rank_g);
+
+    *tag_value  = kvtag->value;
+    *value_size = kvtag->size;
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCcont_del_tag(pdcid_t cont_id, char *tag_name)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDCobj_del_tag(cont_id, tag_name);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDCobj_del_tag", pdc_client_mpi_rank_g);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+// State of a fused object data RPC
+struct _pdc_obj_data_args {
+    int32_t  ret;
+    uint64_t obj_id;
+    void *   dest;
+    uint64_t dest_size;
+};
+
+static hg_return_t
+obj_put_data_rpc_cb(const struct hg_cb_info *callback_info)
+{
+    hg_return_t                ret_value = HG_SUCCESS;
+    hg_handle_t                handle;
+    struct _pdc_obj_data_args *args;
+    obj_put_data_out_t         output;
+
+    FUNC_ENTER(NULL);
+
+    args   = (struct _pdc_obj_data_args *)callback_info->arg;
+    handle = callback_info->info.forward.handle;
+
+    ret_value = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS) {
+        args->ret = -1;
+        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: obj_put_data_rpc_cb error with HG_Get_output",
+                    pdc_client_mpi_rank_g);
+    }
+    args->ret    = output.ret;
+    args->obj_id = output.obj_id;
+
+done:
+    fflush(stdout);
+    work_todo_g--;
+    HG_Free_output(handle, &output);
+
+    FUNC_LEAVE(ret_value);
+}
+
+static hg_return_t
+obj_get_data_rpc_cb(const struct hg_cb_info *callback_info)
 {
-    perr_t ret_value = SUCCEED;
+    hg_return_t                ret_value = HG_SUCCESS;
+    hg_handle_t                handle;
+    struct _pdc_obj_data_args *args;
+    obj_get_data_out_t         output;
 
     FUNC_ENTER(NULL);
 
-    // TODO
+    args   = (struct _pdc_obj_data_args *)callback_info->arg;
+    handle = callback_info->info.forward.handle;
+
+    ret_value = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS) {
+        args->ret = -1;
+        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: obj_get_data_rpc_cb error with HG_Get_output",
+                    pdc_client_mpi_rank_g);
+    }
+    args->ret = output.ret;
+    // Small data came back with the response, larger data has already been pushed into dest
+    if (output.ret == 1 && output.inline_size > 0) {
+        if (output.inline_size != args->dest_size)
+            args->ret = -1;
+        else
+            memcpy(args->dest, output.inline_buf, output.inline_size);
+    }
+
+done:
+    fflush(stdout);
+    work_todo_g--;
+    HG_Free_output(handle, &output);
 
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDCcont_put_tag(pdcid_t cont_id, char *tag_name, void *tag_value, psize_t value_size)
+/*
+ * Create an object and write its data with one RPC to this client's data server, which is where region
+ * transfers of the object go. The object can only be created there if that server also holds its
+ * metadata, otherwise it is created by its metadata server first.
+ */
+static perr_t
+PDC_Client_put_obj_data(const char *obj_name, uint64_t cont_id, pdcid_t obj_create_prop, void *data,
+                        uint64_t size, uint64_t *meta_id)
 {
-    perr_t      ret_value = SUCCEED;
-    pdc_kvtag_t kvtag;
+    perr_t                    ret_value = SUCCEED;
+    hg_return_t               hg_ret;
+    struct _pdc_obj_prop *    create_prop = NULL;
+    obj_put_data_in_t         in;
+    struct _pdc_obj_data_args args;
+    uint32_t                  meta_server_id, data_server_id;
+    hg_size_t                 nbytes = size;
+    hg_handle_t               rpc_handle = NULL;
 
     FUNC_ENTER(NULL);
 
-    kvtag.name  = tag_name;
-    kvtag.value = (void *)tag_value;
-    kvtag.size  = (uint64_t)value_size;
+    *meta_id = 0;
+    memset(&in, 0, sizeof(in));
+    in.bulk_handle = HG_BULK_NULL;
 
-    ret_value = PDC_add_kvtag(cont_id, &kvtag, 1);
-    if (ret_value != SUCCEED)
+    create_prop = PDC_obj_prop_get_info(obj_create_prop);
+    PDC_Client_fill_obj_transfer(create_prop, cont_id, &in.create_in.data);
+    in.create_in.data.obj_name = obj_name;
+    in.create_in.data_type     = create_prop->obj_prop_pub->type;
+    in.create_in.hash_value    = PDC_get_hash_by_name(obj_name);
 
-        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Error with PDCcont_put_tag", pdc_client_mpi_rank_g);
+    meta_server_id = PDC_get_server_by_hash(in.create_in.hash_value + in.create_in.data.time_step,
+                                            pdc_server_num_g);
+    data_server_id = (pdc_client_mpi_rank_g / pdc_nclient_per_server_g) % pdc_server_num_g;
+    if (meta_server_id == data_server_id)
+        in.create = 1;
+    else if (PDC_Client_send_name_recv_id(obj_name, cont_id, obj_create_prop, &in.obj_id) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot create object [%s]", pdc_client_mpi_rank_g, obj_name);
 
-done:
-    fflush(stdout);
-    FUNC_LEAVE(ret_value);
-}
+    in.size = size;
+    if (size <= PDC_TRANSFER_INLINE_MAX) {
+        in.inline_size = size;
+        in.inline_buf  = (char *)data;
+    }
+    else {
+        hg_ret = HG_Bulk_create(send_class_g, 1, &data, &nbytes, HG_BULK_READ_ONLY, &in.bulk_handle);
+        if (hg_ret != HG_SUCCESS) {
+            in.bulk_handle = HG_BULK_NULL;
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: could not create bulk data handle", pdc_client_mpi_rank_g);
+        }
+    }
 
-perr_t
-PDCcont_get_tag(pdcid_t cont_id, char *tag_name, void **tag_value, psize_t *value_size)
-{
-    perr_t       ret_value = SUCCEED;
-    pdc_kvtag_t *kvtag     = NULL;
+    debug_server_id_count[data_server_id]++;
+    if (PDC_Client_try_lookup_server(data_server_id) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
 
-    FUNC_ENTER(NULL);
+    HG_Create(send_context_g, pdc_server_info_g[data_server_id].addr, obj_put_data_register_id_g,
+              &rpc_handle);
+    args.ret    = -1;
+    args.obj_id = 0;
+    hg_ret      = HG_Forward(rpc_handle, obj_put_data_rpc_cb, &args, &in);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: could not forward obj_put_data", pdc_client_mpi_rank_g);
 
-    ret_value = PDC_get_kvtag(cont_id, tag_name, &kvtag, 1);
-    if (ret_value != SUCCEED)
-        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Error with PDC_get_kvtag", pdc_client_mpi_rank_g);
+    work_todo_g = 1;
+    PDC_Client_check_response(&send_context_g);
 
-    *tag_value  = kvtag->value;
-    *value_size = kvtag->size;
+    if (args.ret != 1 || args.obj_id == 0)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot store data of object [%s]", pdc_client_mpi_rank_g,
+                    obj_name);
+    *meta_id = args.obj_id;
 
 done:
     fflush(stdout);
+    if (create_prop)
+        PDC_obj_prop_free(create_prop);
+    if (in.bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(in.bulk_handle);
+    if (rpc_handle)
+        HG_Destroy(rpc_handle);
+
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDCcont_del_tag(pdcid_t cont_id, char *tag_name)
-{
-    perr_t ret_value = SUCCEED;
+// Read the first size elements of a 1-D object with one RPC to this client's data server
+static perr_t
+PDC_Client_get_obj_data(uint64_t meta_id, uint64_t obj_dim0, size_t unit, void *data, uint64_t size)
+{
+    perr_t                    ret_value = SUCCEED;
+    hg_return_t               hg_ret;
+    obj_get_data_in_t         in;
+    struct _pdc_obj_data_args args;
+    uint32_t                  data_server_id;
+    hg_size_t                 nbytes     = size * unit;
+    hg_handle_t               rpc_handle = NULL;
+
+    FUNC_ENTER(NULL);
+
+    in.obj_id      = meta_id;
+    in.obj_dim0    = obj_dim0;
+    in.size        = size;
+    in.unit        = unit;
+    in.bulk_handle = HG_BULK_NULL;
+    if (nbytes > PDC_TRANSFER_INLINE_MAX) {
+        hg_ret = HG_Bulk_create(send_class_g, 1, &data, &nbytes, HG_BULK_WRITE_ONLY, &in.bulk_handle);
+        if (hg_ret != HG_SUCCESS) {
+            in.bulk_handle = HG_BULK_NULL;
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: could not create bulk data handle", pdc_client_mpi_rank_g);
+        }
+    }
 
-    FUNC_ENTER(NULL);
+    data_server_id = (pdc_client_mpi_rank_g / pdc_nclient_per_server_g) % pdc_server_num_g;
+    debug_server_id_count[data_server_id]++;
+    if (PDC_Client_try_lookup_server(data_server_id) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
 
-    ret_value = PDCobj_del_tag(cont_id, tag_name);
-    if (ret_value != SUCCEED)
-        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDCobj_del_tag", pdc_client_mpi_rank_g);
+    HG_Create(send_context_g, pdc_server_info_g[data_server_id].addr, obj_get_data_register_id_g,
+              &rpc_handle);
+    args.ret       = -1;
+    args.dest      = data;
+    args.dest_size = nbytes;
+    hg_ret         = HG_Forward(rpc_handle, obj_get_data_rpc_cb, &args, &in);
+    if (hg_ret != HG_SUCCESS)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: could not forward obj_get_data", pdc_client_mpi_rank_g);
+
+    work_todo_g = 1;
+    PDC_Client_check_response(&send_context_g);
+
+    if (args.ret != 1)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot read object %" PRIu64, pdc_client_mpi_rank_g, meta_id);
 
 done:
     fflush(stdout);
+    if (in.bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(in.bulk_handle);
+    if (rpc_handle)
+        HG_Destroy(rpc_handle);
+
     FUNC_LEAVE(ret_value);
 }
 
@@ -7029,12 +9178,12 @@ pdcid_t
 PDCobj_put_data(const char *obj_name, void *data, uint64_t size, pdcid_t cont_id)
 {
     pdcid_t ret_value = 0;
-    pdcid_t obj_id, obj_prop, obj_region;
+    pdcid_t obj_id, obj_prop;
     perr_t  ret;
     // pdc_metadata_t *meta;
     struct _pdc_cont_info *info    = NULL;
     struct _pdc_id_info *  id_info = NULL;
-    pdcid_t                transfer_request;
+    uint64_t               meta_id;
 
     FUNC_ENTER(NULL);
 
@@ -7048,43 +9197,15 @@ PDCobj_put_data(const char *obj_name, void *data, uint64_t size, pdcid_t cont_id
     PDCprop_set_obj_user_id(obj_prop, getuid());
     PDCprop_set_obj_time_step(obj_prop, 0);
 
-    obj_id = PDCobj_create(cont_id, obj_name, obj_prop);
+    // The server creates the object and stores its data in one RPC, only the local object is built here
+    ret = PDC_Client_put_obj_data(obj_name, info->cont_info_pub->meta_id, obj_prop, data, size, &meta_id);
+    if (ret != SUCCEED)
+        PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error storing object [%s]", pdc_client_mpi_rank_g, obj_name);
+
+    obj_id = PDC_obj_create_with_meta_id(cont_id, obj_name, obj_prop, meta_id);
     if (obj_id <= 0)
         PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error creating object [%s]", pdc_client_mpi_rank_g, obj_name);
 
-    uint64_t offset = 0;
-    // size = ceil(size/sizeof(int));
-    obj_region = PDCregion_create(1, &offset, &size);
-
-    transfer_request = PDCregion_transfer_create(data, PDC_WRITE, obj_id, obj_region, obj_region);
-    if (transfer_request == 0) {
-        PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error with region transfer create for obj [%s]",
-                    pdc_client_mpi_rank_g, obj_name);
-    }
-
-    ret = PDCregion_transfer_start(transfer_request);
-    if (ret != SUCCEED) {
-        PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error with region transfer start for obj [%s]",
-                    pdc_client_mpi_rank_g, obj_name);
-    }
-    ret = PDCregion_transfer_wait(transfer_request);
-    if (ret != SUCCEED) {
-        PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error with region transfer wait for obj [%s]",
-                    pdc_client_mpi_rank_g, obj_name);
-    }
-
-    ret = PDCregion_transfer_close(transfer_request);
-    if (ret != SUCCEED) {
-        PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error with region transfer close for obj [%s]",
-                    pdc_client_mpi_rank_g, obj_name);
-    }
-
-    ret = PDCregion_close(obj_region);
-    if (ret != SUCCEED) {
-        PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error with PDCregion_close for obj [%s]", pdc_client_mpi_rank_g,
-                    obj_name);
-    }
-
     ret = PDCprop_close(obj_prop);
     if (ret != SUCCEED) {
         PGOTO_ERROR(0, "==PDC_CLIENT[%d]: Error with PDCprop_close for obj [%s]", pdc_client_mpi_rank_g,
@@ -7100,10 +9221,28 @@ done:
 perr_t
 PDCobj_get_data(pdcid_t obj_id, void *data, uint64_t size)
 {
-    perr_t   ret_value = SUCCEED;
-    uint64_t offset    = 0;
-    pdcid_t  reg;
-    pdcid_t  transfer_request;
+    perr_t                ret_value = SUCCEED;
+    uint64_t              offset    = 0;
+    pdcid_t               reg;
+    pdcid_t               transfer_request;
+    struct _pdc_id_info * id_info;
+    struct _pdc_obj_info *obj_info;
+
+    FUNC_ENTER(NULL);
+
+    id_info = PDC_find_id(obj_id);
+    if (id_info == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: cannot locate object ID", pdc_client_mpi_rank_g);
+    obj_info = (struct _pdc_obj_info *)(id_info->obj_ptr);
+
+    // A 1-D object is read with one RPC, the data comes back with the response when it is small
+    if (obj_info->obj_pt->obj_prop_pub->ndim == 1) {
+        ret_value = PDC_Client_get_obj_data(obj_info->obj_info_pub->meta_id,
+                                            obj_info->obj_pt->obj_prop_pub->dims[0],
+                                            PDC_get_var_type_size(obj_info->obj_pt->obj_prop_pub->type), data,
+                                            size);
+        PGOTO_DONE(ret_value);
+    }
 
     reg              = PDCregion_create(1, &offset, &size);
     transfer_request = PDCregion_transfer_create(data, PDC_READ, obj_id, reg, reg);
@@ -7163,6 +9302,285 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+// Initial room for each value of a batched get, a server whose values do not fit is asked again
+#define PDC_KVTAG_MANY_GET_GUESS 256
+
+// State of the bulk kvtag request sent to one metadata server
+struct _pdc_kvtag_many_args {
+    int       n_entry;
+    int *     entry;
+    char *    buf;
+    hg_size_t buf_size;
+    uint64_t  req_size;
+    hg_bulk_t bulk_handle;
+    int32_t   ret;
+    uint64_t  resp_size;
+};
+
+static hg_return_t
+kvtag_many_rpc_cb(const struct hg_cb_info *callback_info)
+{
+    hg_return_t                  ret_value;
+    struct _pdc_scatter_target * target = (struct _pdc_scatter_target *)callback_info->arg;
+    struct _pdc_kvtag_many_args *args   = (struct _pdc_kvtag_many_args *)target->arg;
+    hg_handle_t                  handle = callback_info->info.forward.handle;
+    kvtag_many_out_t             output;
+
+    FUNC_ENTER(NULL);
+
+    output.ret       = -1;
+    output.resp_size = 0;
+    ret_value        = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS)
+        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: error with HG_Get_output", pdc_client_mpi_rank_g);
+
+    if (output.ret < 0)
+        printf("==PDC_CLIENT[%d]: kvtag request to server %u failed\n", pdc_client_mpi_rank_g,
+               target->server_id);
+
+done:
+    fflush(stdout);
+    args->ret       = output.ret;
+    args->resp_size = output.resp_size;
+    PDC_Client_scatter_done(target, output.ret >= 0 ? SUCCEED : FAIL);
+    HG_Free_output(handle, &output);
+
+    FUNC_LEAVE(ret_value);
+}
+
+// Grow the buffer of a server request to hold resp_capacity bytes of responses and expose it to the server
+static perr_t
+PDC_kvtag_many_expose(struct _pdc_kvtag_many_args *args, uint64_t resp_capacity)
+{
+    perr_t ret_value = SUCCEED;
+    char * buf;
+
+    FUNC_ENTER(NULL);
+
+    if (args->bulk_handle != HG_BULK_NULL) {
+        HG_Bulk_free(args->bulk_handle);
+        args->bulk_handle = HG_BULK_NULL;
+    }
+
+    buf = (char *)realloc(args->buf, args->req_size + resp_capacity);
+    if (buf == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - cannot allocate request buffer", pdc_client_mpi_rank_g,
+                    __func__);
+    args->buf      = buf;
+    args->buf_size = args->req_size + resp_capacity;
+
+    if (HG_Bulk_create(send_class_g, 1, (void **)&args->buf, &args->buf_size, HG_BULK_READWRITE,
+                       &args->bulk_handle) != HG_SUCCESS) {
+        args->bulk_handle = HG_BULK_NULL;
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - could not create bulk handle", pdc_client_mpi_rank_g,
+                    __func__);
+    }
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Add, get or delete a tag on each of a set of objects. The entries are grouped by the metadata server of
+ * their object, and each server gets one bulk request that it applies under a single lock; the requests
+ * to all servers are in flight at once.
+ */
+static perr_t
+PDC_kvtag_many(int32_t op, int n, pdcid_t *obj_ids, char **tag_names, void **tag_values,
+               psize_t *value_sizes)
+{
+    perr_t                       ret_value = SUCCEED;
+    struct _pdc_scatter          sg;
+    struct _pdc_kvtag_many_args *args;
+    struct _pdc_obj_info *       obj_prop;
+    kvtag_many_in_t              in;
+    kvtag_many_entry_t *         hdr              = NULL;
+    uint32_t *                   server_ids       = NULL;
+    int *                        target_of_server = NULL, *entries = NULL;
+    int                          n_target = 0, n_retry = 0, i, k, t;
+    uint64_t                     resp_entry_size;
+    uint32_t                     value_size;
+    int32_t                      status;
+    char *                       pos;
+
+    FUNC_ENTER(NULL);
+
+    memset(&sg, 0, sizeof(struct _pdc_scatter));
+
+    if (n <= 0)
+        PGOTO_DONE(ret_value);
+    if (obj_ids == NULL || tag_names == NULL ||
+        (op != PDC_KVTAG_MANY_DEL && (tag_values == NULL || value_sizes == NULL)))
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - invalid tag arrays", pdc_client_mpi_rank_g, __func__);
+
+    hdr              = (kvtag_many_entry_t *)malloc(n * sizeof(kvtag_many_entry_t));
+    server_ids       = (uint32_t *)malloc(n * sizeof(uint32_t));
+    entries          = (int *)malloc(n * sizeof(int));
+    target_of_server = (int *)malloc(pdc_server_num_g * sizeof(int));
+    if (hdr == NULL || server_ids == NULL || entries == NULL || target_of_server == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - cannot allocate request arrays", pdc_client_mpi_rank_g,
+                    __func__);
+
+    // Find the metadata server of each entry
+    for (i = 0; i < pdc_server_num_g; i++)
+        target_of_server[i] = -1;
+    for (i = 0; i < n; i++) {
+        if (op == PDC_KVTAG_MANY_GET) {
+            tag_values[i]  = NULL;
+            value_sizes[i] = 0;
+        }
+        obj_prop = PDC_obj_get_info(obj_ids[i]);
+        if (obj_prop == NULL || tag_names[i] == NULL)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - invalid object or tag name of entry %d",
+                        pdc_client_mpi_rank_g, __func__, i);
+        if (op == PDC_KVTAG_MANY_ADD &&
+            (tag_values[i] == NULL || value_sizes[i] == 0 || value_sizes[i] > UINT32_MAX))
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - invalid tag content of entry %d", pdc_client_mpi_rank_g,
+                        __func__, i);
+
+        memset(&hdr[i], 0, sizeof(kvtag_many_entry_t));
+        hdr[i].obj_id     = obj_prop->obj_info_pub->meta_id;
+        hdr[i].hash_value = PDC_get_hash_by_name(obj_prop->obj_info_pub->name);
+        hdr[i].name_len   = strlen(tag_names[i]) + 1;
+        hdr[i].value_size = op == PDC_KVTAG_MANY_ADD ? (uint32_t)value_sizes[i] : 0;
+        server_ids[i]     = PDC_get_server_by_obj_id(hdr[i].obj_id, pdc_server_num_g);
+        if (target_of_server[server_ids[i]] < 0)
+            target_of_server[server_ids[i]] = n_target++;
+    }
+
+    if (PDC_Client_scatter_init(&sg, n_target, sizeof(struct _pdc_kvtag_many_args)) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_scatter_init", pdc_client_mpi_rank_g);
+
+    // Give each server a slice of the entry indices, in the original order of the entries
+    for (i = 0; i < n; i++) {
+        t    = target_of_server[server_ids[i]];
+        args = (struct _pdc_kvtag_many_args *)sg.target[t].arg;
+        args->n_entry++;
+        args->req_size += sizeof(kvtag_many_entry_t) + hdr[i].name_len + hdr[i].value_size;
+    }
+    for (t = 0, k = 0; t < n_target; t++) {
+        args              = (struct _pdc_kvtag_many_args *)sg.target[t].arg;
+        args->entry       = entries + k;
+        args->bulk_handle = HG_BULK_NULL;
+        k += args->n_entry;
+        args->n_entry = 0;
+    }
+    for (i = 0; i < n; i++) {
+        t                            = target_of_server[server_ids[i]];
+        args                         = (struct _pdc_kvtag_many_args *)sg.target[t].arg;
+        args->entry[args->n_entry++] = i;
+    }
+
+    if (op == PDC_KVTAG_MANY_GET)
+        resp_entry_size = sizeof(int32_t) + sizeof(uint32_t) + PDC_KVTAG_MANY_GET_GUESS;
+    else
+        resp_entry_size = sizeof(int32_t);
+
+    memset(&in, 0, sizeof(in));
+    in.op = op;
+    for (t = 0; t < n_target; t++) {
+        args = (struct _pdc_kvtag_many_args *)sg.target[t].arg;
+        if (PDC_kvtag_many_expose(args, args->n_entry * resp_entry_size) != SUCCEED)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_kvtag_many_expose", pdc_client_mpi_rank_g);
+
+        pos = args->buf;
+        for (k = 0; k < args->n_entry; k++) {
+            i = args->entry[k];
+            memcpy(pos, &hdr[i], sizeof(kvtag_many_entry_t));
+            pos += sizeof(kvtag_many_entry_t);
+            memcpy(pos, tag_names[i], hdr[i].name_len);
+            pos += hdr[i].name_len;
+            if (hdr[i].value_size > 0)
+                memcpy(pos, tag_values[i], hdr[i].value_size);
+            pos += hdr[i].value_size;
+        }
+
+        in.n_entry     = args->n_entry;
+        in.req_size    = args->req_size;
+        in.bulk_handle = args->bulk_handle;
+        if (PDC_Client_scatter_forward(&sg, t, server_ids[args->entry[0]], kvtag_many_register_id_g,
+                                       kvtag_many_rpc_cb, &in) != SUCCEED)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error sending kvtags to server %u", pdc_client_mpi_rank_g,
+                        server_ids[args->entry[0]]);
+    }
+
+    if (PDC_Client_scatter_wait(&sg) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with kvtag request", pdc_client_mpi_rank_g);
+
+    // Gets whose values did not fit are sent again with the size the server asked for
+    for (t = 0; t < n_target; t++) {
+        args = (struct _pdc_kvtag_many_args *)sg.target[t].arg;
+        if (args->ret != 0)
+            continue;
+        HG_Destroy(sg.target[t].handle);
+        sg.target[t].handle = HG_HANDLE_NULL;
+        if (PDC_kvtag_many_expose(args, args->resp_size) != SUCCEED)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_kvtag_many_expose", pdc_client_mpi_rank_g);
+
+        in.n_entry     = args->n_entry;
+        in.req_size    = args->req_size;
+        in.bulk_handle = args->bulk_handle;
+        if (PDC_Client_scatter_forward(&sg, t, sg.target[t].server_id, kvtag_many_register_id_g,
+                                       kvtag_many_rpc_cb, &in) != SUCCEED)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error sending kvtags to server %u", pdc_client_mpi_rank_g,
+                        sg.target[t].server_id);
+        n_retry++;
+    }
+    if (n_retry > 0 && PDC_Client_scatter_wait(&sg) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with kvtag request", pdc_client_mpi_rank_g);
+
+    // The servers pushed the responses right after the requests
+    for (t = 0; t < n_target; t++) {
+        args = (struct _pdc_kvtag_many_args *)sg.target[t].arg;
+        if (args->ret != 1)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: kvtag responses of server %u do not fit",
+                        pdc_client_mpi_rank_g, sg.target[t].server_id);
+        pos = args->buf + args->req_size;
+        for (k = 0; k < args->n_entry; k++) {
+            i = args->entry[k];
+            memcpy(&status, pos, sizeof(int32_t));
+            pos += sizeof(int32_t);
+            if (status < 0) {
+                printf("==PDC_CLIENT[%d]: kvtag entry %d NOT successful, object not found\n",
+                       pdc_client_mpi_rank_g, i);
+                ret_value = FAIL;
+            }
+            if (op != PDC_KVTAG_MANY_GET)
+                continue;
+            memcpy(&value_size, pos, sizeof(uint32_t));
+            pos += sizeof(uint32_t);
+            if (status == 1 && value_size > 0) {
+                tag_values[i] = malloc(value_size);
+                if (tag_values[i] == NULL)
+                    PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: %s - cannot allocate tag value",
+                                pdc_client_mpi_rank_g, __func__);
+                memcpy(tag_values[i], pos, value_size);
+                value_sizes[i] = value_size;
+            }
+            pos += value_size;
+        }
+    }
+
+done:
+    fflush(stdout);
+    if (sg.n_pending > 0)
+        PDC_Client_scatter_wait(&sg);
+    for (t = 0; t < sg.n_target; t++) {
+        args = (struct _pdc_kvtag_many_args *)sg.target[t].arg;
+        if (args->bulk_handle != HG_BULK_NULL)
+            HG_Bulk_free(args->bulk_handle);
+        free(args->buf);
+    }
+    PDC_Client_scatter_free(&sg);
+    free(target_of_server);
+    free(entries);
+    free(server_ids);
+    free(hdr);
+
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDCobj_put_tag(pdcid_t obj_id, char *tag_name, void *tag_value, psize_t value_size)
 {
@@ -7220,6 +9638,54 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+perr_t
+PDCobj_put_tag_many(int n, pdcid_t *obj_ids, char **tag_names, void **tag_values, psize_t *value_sizes)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_kvtag_many(PDC_KVTAG_MANY_ADD, n, obj_ids, tag_names, tag_values, value_sizes);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Error with PDC_kvtag_many", pdc_client_mpi_rank_g);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCobj_get_tag_many(int n, pdcid_t *obj_ids, char **tag_names, void **tag_values, psize_t *value_sizes)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_kvtag_many(PDC_KVTAG_MANY_GET, n, obj_ids, tag_names, tag_values, value_sizes);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Error with PDC_kvtag_many", pdc_client_mpi_rank_g);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCobj_del_tag_many(int n, pdcid_t *obj_ids, char **tag_names)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_kvtag_many(PDC_KVTAG_MANY_DEL, n, obj_ids, tag_names, NULL, NULL);
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: Error with PDC_kvtag_many", pdc_client_mpi_rank_g);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 void
 PDC_get_server_from_query(pdc_query_t *query, uint32_t *servers, int32_t *n)
 {
@@ -7292,21 +9758,48 @@ PDC_recv_nhits(const struct hg_cb_info *callback_info)
     FUNC_LEAVE(ret_value);
 }
 
+static hg_return_t
+data_query_forward_cb(const struct hg_cb_info *callback_info)
+{
+    hg_return_t                 ret_value;
+    struct _pdc_scatter_target *target = (struct _pdc_scatter_target *)callback_info->arg;
+    hg_handle_t                 handle = callback_info->info.forward.handle;
+    pdc_int_ret_t               output;
+
+    FUNC_ENTER(NULL);
+
+    output.ret = 0;
+    ret_value  = HG_Get_output(handle, &output);
+    if (ret_value != HG_SUCCESS)
+        PGOTO_ERROR(ret_value, "==PDC_CLIENT[%d]: error with HG_Get_output", pdc_client_mpi_rank_g);
+
+    if (output.ret != 1)
+        printf("==PDC_CLIENT[%d]: send data query to server %u failed ... ret_value = %d\n",
+               pdc_client_mpi_rank_g, target->server_id, output.ret);
+
+done:
+    fflush(stdout);
+    PDC_Client_scatter_done(target, output.ret == 1 ? SUCCEED : FAIL);
+    HG_Free_output(handle, &output);
+
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_send_data_query(pdc_query_t *query, pdc_query_get_op_t get_op, uint64_t *nhits, pdc_selection_t *sel,
                     void *data ATTRIBUTE(unused))
 {
     perr_t                         ret_value      = SUCCEED;
-    hg_return_t                    hg_ret         = 0;
     uint32_t *                     target_servers = NULL;
     int                            i, server_id, next_server = 0, prev_server = 0, ntarget = 0;
-    hg_handle_t                    handle;
     pdc_query_xfer_t *             query_xfer;
-    struct _pdc_client_lookup_args lookup_args;
+    struct _pdc_scatter            sg;
     struct _pdc_query_result_list *result;
 
     FUNC_ENTER(NULL);
 
+    memset(&sg, 0, sizeof(struct _pdc_scatter));
+
     query_xfer = PDC_serialize_query(query);
     if (query_xfer == NULL)
         PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_serialize_query", pdc_client_mpi_rank_g);
@@ -7324,10 +9817,14 @@ PDC_send_data_query(pdc_query_t *query, pdc_query_get_op_t get_op, uint64_t *nhi
     result->query_id = query_xfer->query_id;
     DL_APPEND(pdcquery_result_list_head_g, result);
 
-    // Send query to all servers
-    for (server_id = 0; server_id < pdc_server_num_g; server_id++) {
-        debug_server_id_count[server_id]++;
+    // The manager may send the result back while the other servers are still acknowledging the query
+    work_todo_g = 1;
 
+    // Send query to all servers at once
+    if (PDC_Client_scatter_init(&sg, pdc_server_num_g, 0) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with PDC_Client_scatter_init", pdc_client_mpi_rank_g);
+
+    for (server_id = 0; server_id < pdc_server_num_g; server_id++) {
         for (i = 0; i < ntarget; i++) {
             if ((uint32_t)server_id == target_servers[i]) {
                 if (i > 0)
@@ -7342,28 +9839,16 @@ PDC_send_data_query(pdc_query_t *query, pdc_query_get_op_t get_op, uint64_t *nhi
         query_xfer->next_server_id = next_server;
         query_xfer->prev_server_id = prev_server;
 
-        if (PDC_Client_try_lookup_server(server_id) != SUCCEED)
-            PGOTO_ERROR(FAIL, "==CLIENT[%d]: ERROR with PDC_Client_try_lookup_server", pdc_client_mpi_rank_g);
-
-        HG_Create(send_context_g, pdc_server_info_g[server_id].addr, send_data_query_register_id_g, &handle);
-
-        hg_ret = HG_Forward(handle, pdc_client_check_int_ret_cb, &lookup_args, query_xfer);
-        if (hg_ret != HG_SUCCESS)
-            PGOTO_ERROR(FAIL, "PDC_Client_del_kvtag_metadata_with_name(): Could not start HG_Forward()");
-
-        // Wait for response from server
-        work_todo_g = 1;
-        PDC_Client_check_response(&send_context_g);
-
-        if (lookup_args.ret != 1)
-            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: send data query to server %u failed ... ret_value = %d",
-                        pdc_client_mpi_rank_g, server_id, lookup_args.ret);
-
-        HG_Destroy(handle);
+        if (PDC_Client_scatter_forward(&sg, server_id, (uint32_t)server_id, send_data_query_register_id_g,
+                                       data_query_forward_cb, query_xfer) != SUCCEED)
+            PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error sending data query to server %d",
+                        pdc_client_mpi_rank_g, server_id);
     }
 
+    if (PDC_Client_scatter_wait(&sg) != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_CLIENT[%d]: error with data query", pdc_client_mpi_rank_g);
+
     // Wait for server to send query result
-    work_todo_g = 1;
     PDC_Client_check_response(&send_context_g);
 
     if (nhits)
@@ -7378,6 +9863,7 @@ PDC_send_data_query(pdc_query_t *query, pdc_query_get_op_t get_op, uint64_t *nhi
 
 done:
     fflush(stdout);
+    PDC_Client_scatter_free(&sg);
     if (target_servers)
         free(target_servers);
 
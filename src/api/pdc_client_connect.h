@@ -88,8 +88,45 @@ struct _pdc_container_query_args {
 struct _pdc_transfer_request_args {
     uint64_t metadata_id;
     int32_t  ret;
+    /* Destination of a small read returned inline with the response */
+    char *   inline_dest;
+    uint64_t inline_size;
 };
 
+/* A transfer request start forwarded by the client progress thread */
+struct _pdc_transfer_request_async {
+    hg_handle_t                       handle;
+    struct _pdc_transfer_request_args args;
+    int                               completed;
+    int                               use_shm;
+    char *                            new_buf;
+};
+
+/* Statistics of the client bulk registration cache */
+typedef struct pdc_bulk_cache_stats_t {
+    uint64_t n_hit;
+    uint64_t n_miss;
+    uint64_t n_evict;
+    uint64_t max_pinned_size;
+} pdc_bulk_cache_stats_t;
+
+/* Statistics of the client metadata cache */
+typedef struct pdc_metadata_cache_stats_t {
+    uint64_t n_hit;
+    uint64_t n_miss;
+    uint64_t n_expire;
+    uint64_t n_invalidate;
+    uint64_t n_evict;
+} pdc_metadata_cache_stats_t;
+
+/* Position of a paged partial query, start from all zeros */
+typedef struct pdc_query_cursor_t {
+    uint32_t server_id; // server the next page comes from
+    uint64_t pos;       // position on that server
+    uint64_t pos_minor; // second part of the position, for time step queries
+    int      done;      // set once all servers have been read
+} pdc_query_cursor_t;
+
 struct _pdc_transfer_request_status_args {
     uint32_t status;
     int32_t  ret;
@@ -100,10 +137,39 @@ struct _pdc_transfer_request_wait_args {
     int32_t  ret;
 };
 
+/* A batch of transfer requests staged in a node-local shared memory arena */
+struct _pdc_transfer_agg_batch {
+    char     shm_addr[ADDR_MAX];
+    char *   shm_base;
+    uint64_t shm_size;
+    uint64_t my_offset;
+    int      n_request;
+    /* Merged transfers issued by the aggregator */
+    int             n_merged;
+    uint64_t *      merged_metadata_id;
+    uint64_t *      merged_offset;
+    uint64_t *      merged_nelem;
+    int *           merged_access_type;
+    pdc_var_type_t *merged_mem_type;
+};
+
 struct _pdc_buf_map_args {
     int32_t ret;
 };
 
+struct _pdc_obj_create_many_args {
+    uint32_t    server_id;
+    uint32_t    n_obj;
+    void *      buf;
+    hg_size_t   nbytes;
+    hg_bulk_t   bulk_handle;
+    hg_handle_t rpc_handle;
+    uint32_t    n_fill;
+    hg_size_t   name_off;
+    int32_t     ret;
+    uint32_t    n_created;
+};
+
 struct _pdc_region_lock_args {
     pbool_t *status;
     int      ret;
@@ -114,6 +180,11 @@ struct _pdc_get_kvtag_args {
     pdc_kvtag_t *kvtag;
 };
 
+struct _pdc_meta_store_stats_args {
+    int                     ret;
+    meta_store_stats_out_t *stats;
+};
+
 struct _pdc_query_result_list {
     uint32_t  ndim;
     int       query_id;
@@ -153,11 +224,46 @@ perr_t PDC_Client_read_server_addr_from_file();
 perr_t PDC_Client_send_name_recv_id(const char *obj_name, uint64_t cont_id, pdcid_t obj_create_prop,
                                     pdcid_t *meta_id);
 
+/**
+ * Client request of many obj ids sharing one property, with one RPC per metadata server
+ *
+ * \param n_obj [IN]            Number of objects
+ * \param obj_names [IN]        Names of the objects
+ * \param cont_id[IN]           Container ID (obtained from metadata server)
+ * \param obj_create_prop [IN]  ID of the object property
+ * \param meta_ids [OUT]        Metadata ids, 0 for objects that were not created
+ *
+ * \return Non-negative if all objects were created/Negative otherwise
+ */
+perr_t PDC_Client_send_names_recv_ids(int n_obj, const char **obj_names, uint64_t cont_id,
+                                      pdcid_t obj_create_prop, pdcid_t *meta_ids);
+
 perr_t PDC_Client_transfer_request(void *buf, pdcid_t obj_id, int obj_ndim, uint64_t *obj_dims,
                                    int local_ndim, uint64_t *local_offset, uint64_t *local_size,
                                    int remote_ndim, uint64_t *remote_offset, uint64_t *remote_size,
                                    pdc_var_type_t mem_type, pdc_access_t access_type, uint64_t *metadata_id,
-                                   char **new_buf);
+                                   char **new_buf, struct _pdc_transfer_request_async **async);
+
+/**
+ * Check whether the server acknowledged a transfer request started in the background
+ *
+ * \param async [IN]            Pending start returned by PDC_Client_transfer_request
+ *
+ * \return 1 if the acknowledgement arrived/0 otherwise
+ */
+int PDC_Client_transfer_request_async_test(struct _pdc_transfer_request_async *async);
+
+/**
+ * Wait for the acknowledgement of a transfer request started in the background and release it
+ *
+ * \param async [IN]            Pending start returned by PDC_Client_transfer_request
+ * \param metadata_id [OUT]     Server side ID of the transfer request
+ * \param new_buf [OUT]         Buffer staged for the transfer
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_transfer_request_async_complete(struct _pdc_transfer_request_async *async,
+                                                  uint64_t *metadata_id, char **new_buf);
 
 perr_t PDC_Client_transfer_request_status(pdcid_t transfer_request_id, pdc_transfer_status_t *completed,
                                           char *buf, char *new_buf, uint64_t *obj_dims, int local_ndim,
@@ -168,6 +274,38 @@ perr_t PDC_Client_transfer_request_wait(pdcid_t transfer_request_id, int access_
                                         uint64_t *local_offset, uint64_t *local_size,
                                         pdc_var_type_t mem_type);
 
+/**
+ * Agree on the validity of transfer requests before aggregating them, so that a request rejected by one
+ * client fails the whole group instead of leaving the others in the collectives (collective over the
+ * clients of this client's data server on this node)
+ *
+ * \param valid [IN]            Whether this client's requests can be started or waited
+ *
+ * \return 1 if every client of the group is valid/0 otherwise
+ */
+int PDC_Client_transfer_request_agg_agree(int valid);
+
+/**
+ * Start transfer requests through the node-local aggregator of this client's data server (collective over
+ * the clients of that data server on this node)
+ *
+ * \param requests [IN]         Array of transfer requests
+ * \param n [IN]                Number of transfer requests
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_transfer_request_agg_start(pdc_transfer_request **requests, size_t n);
+
+/**
+ * Wait for transfer requests started with PDC_Client_transfer_request_agg_start (collective)
+ *
+ * \param requests [IN]         Array of transfer requests
+ * \param n [IN]                Number of transfer requests
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_transfer_request_agg_wait(pdc_transfer_request **requests, size_t n);
+
 /**
  * Apply a map from buffer to an object
  *
@@ -425,6 +563,28 @@ perr_t PDC_partial_query(int is_list_all, int user_id, const char *app_name, con
                          int time_step_from, int time_step_to, int ndim, const char *tags, int *n_res,
                          pdc_metadata_t ***out);
 
+/**
+ * Get the next page of a partial query, with pages of at most PDC_QUERY_PAGE_SIZE_KB of serialized
+ * metadata. Unlike PDC_partial_query, every server is queried
+ *
+ * \param is_list_all [IN]      List all objects and ignore the other constraints if 1
+ * \param user_id [IN]          User ID to match
+ * \param app_name [IN]         Application name to match, NULL for any
+ * \param obj_name [IN]         Object name to match, NULL for any
+ * \param time_step_from [IN]   First time step to match
+ * \param time_step_to [IN]     Last time step to match
+ * \param ndim [IN]             Number of dimensions to match
+ * \param tags [IN]             Tag to match, NULL for any
+ * \param cursor [IN/OUT]       Position of the query, advanced past the returned page
+ * \param n_res [OUT]           Number of metadata in the page, 0 once cursor->done is set
+ * \param out [OUT]             Metadata of the page, free (*out)[0] and then *out
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_partial_query_page(int is_list_all, int user_id, const char *app_name, const char *obj_name,
+                              int time_step_from, int time_step_to, int ndim, const char *tags,
+                              pdc_query_cursor_t *cursor, int *n_res, pdc_metadata_t ***out);
+
 /**
  * Client request server to collectively write a region of an object
  * and wait for server's push notification
@@ -554,6 +714,22 @@ perr_t PDC_Client_create_cont_id_mpi(const char *cont_name, pdcid_t cont_create_
  */
 perr_t PDC_Client_query_kvtag(const pdc_kvtag_t *kvtag, int *n_res, uint64_t **pdc_ids);
 
+/**
+ * Client queries all servers for objects with a kvtag whose value satisfies the match condition.
+ * Range conditions compare numerically when type is a numeric type of kvtag->size bytes and in
+ * byte order otherwise. For PDC_KVTAG_PREFIX, kvtag->size is the length of the prefix.
+ *
+ * \param kvtag [IN]            Tag name (NULL for any name) and value to compare with
+ * \param op [IN]               Match condition
+ * \param type [IN]             Type of the value, PDC_UNKNOWN for byte order
+ * \param n_res [OUT]           Number of matching objects
+ * \param pdc_ids [OUT]         IDs of the matching objects, to be freed by the caller
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_query_kvtag_op(const pdc_kvtag_t *kvtag, pdc_kvtag_op_t op, pdc_var_type_t type, int *n_res,
+                                 uint64_t **pdc_ids);
+
 /**
  * Client sends query requests to server (used by MPI mode)
  *
@@ -565,6 +741,18 @@ perr_t PDC_Client_query_kvtag(const pdc_kvtag_t *kvtag, int *n_res, uint64_t **p
  */
 perr_t PDC_Client_query_kvtag_col(const pdc_kvtag_t *kvtag, int *n_res, uint64_t **pdc_ids);
 
+/**
+ * All clients collectively query all servers, each client queries its share of the servers at once and
+ * the results are gathered on every client (falls back to PDC_Client_query_kvtag without MPI)
+ *
+ * \param kvtag [IN]            Pointer to the kvtag to match
+ * \param n_res [OUT]           Number of matching objects over all servers
+ * \param pdc_ids [OUT]         IDs of the matching objects, to be freed by the caller
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_query_kvtag_mpi(const pdc_kvtag_t *kvtag, int *n_res, uint64_t **pdc_ids);
+
 /**
  * Client sends query requests to server (used by MPI mode)
  *
@@ -641,6 +829,53 @@ perr_t PDC_obj_prop_free(struct _pdc_obj_prop *cp);
  */
 hg_return_t PDC_Client_get_data_from_server_shm_cb(const struct hg_cb_info *callback_info);
 
+/**
+ * Get the statistics of the bulk registration cache, enabled with PDC_BULK_CACHE_SIZE_MB
+ *
+ * \param stats [OUT]           Hits, misses, evictions and largest registered size
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_bulk_cache_get_stats(pdc_bulk_cache_stats_t *stats);
+
+/**
+ * Get the statistics of the metadata cache, enabled with PDC_METADATA_CACHE_LEASE in seconds
+ *
+ * \param stats [OUT]           Hits, misses, expired leases, invalidations and evictions
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_metadata_cache_get_stats(pdc_metadata_cache_stats_t *stats);
+
+/**
+ * Drop all entries of the metadata cache, so the next queries go to the servers
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_metadata_cache_clear();
+
+/**
+ * Register a client shared memory segment with a server, which maps it if it runs on the same node
+ *
+ * \param server_id [IN]        Server ID
+ * \param shm_addr [IN]         Name of the shared memory segment
+ * \param size [IN]             Size of the shared memory segment
+ * \param token [IN]            Token unique to this client process, also written in the segment header
+ *
+ * \return Non-negative if the server mapped the segment/Negative otherwise
+ */
+perr_t PDC_Client_send_client_shm_info(uint32_t server_id, char *shm_addr, uint64_t size, uint64_t token);
+
+/**
+ * Ask a server to unmap a client shared memory segment registered with PDC_Client_send_client_shm_info
+ *
+ * \param server_id [IN]        Server ID
+ * \param token [IN]            Token the segment was registered with
+ *
+ * \return Non-negative if the server unmapped the segment/Negative otherwise
+ */
+perr_t PDC_Client_detach_client_shm(uint32_t server_id, uint64_t token);
+
 /**
  * ********
  *
@@ -712,6 +947,16 @@ perr_t PDC_Client_write_id(pdcid_t local_obj_id, struct pdc_region_info *region,
  */
 perr_t PDC_Client_all_server_checkpoint();
 
+/**
+ * Get the occupancy of the kvtag store of a server, enabled with PDC_METADATA_STORE_CACHE_MB
+ *
+ * \param server_id [IN]        Server ID
+ * \param stats [OUT]           Objects, resident lists and bytes, cache size, loads and evictions
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Client_server_meta_store_stats(uint32_t server_id, meta_store_stats_out_t *stats);
+
 /**
  * Request of PDC client to delete metadata by object name
  *
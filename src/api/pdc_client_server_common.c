@@ -34,6 +34,7 @@
 #include "../server/pdc_utlist.h"
 #include "../server/pdc_server.h"
 #include "../server/pdc_server_data.h"
+#include "../server/pdc_server_meta_store.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -477,9 +478,6 @@ hg_thread_pool_t *hg_test_thread_pool_g    = NULL;
 hg_thread_pool_t *hg_test_thread_pool_fs_g = NULL;
 #endif
 
-uint64_t pdc_id_seq_g = PDC_SERVER_ID_INTERVEL;
-// actual value for each server is set by PDC_Server_init()
-
 hg_return_t
 hg_proc_pdc_query_xfer_t(hg_proc_t proc, void *data)
 {
@@ -585,6 +583,10 @@ hg_proc_send_shm_in_t(hg_proc_t proc, void *data)
     if (ret_value != HG_SUCCESS)
         PGOTO_ERROR(ret_value, "Proc error");
 
+    ret_value = hg_proc_uint64_t(proc, &struct_data->token);
+    if (ret_value != HG_SUCCESS)
+        PGOTO_ERROR(ret_value, "Proc error");
+
 done:
     fflush(stdout);
     FUNC_LEAVE(ret_value);
@@ -632,16 +634,164 @@ PDC_get_local_server_id(int my_rank, int n_client_per_server, int n_server)
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Consistent hashing ring for metadata placement. Each server owns PDC_HASH_RING_NVNODE points of a
+ * 32-bit ring, and a key belongs to the server of the first point at or after it. Keys are grouped in
+ * PDC_HASH_RING_NBUCKET buckets so a lookup is a table read. Changing the number of servers only
+ * moves the buckets whose owning point changed.
+ */
+typedef struct pdc_hash_ring_point_t {
+    uint32_t pos;
+    uint32_t server;
+} pdc_hash_ring_point_t;
+
+static int       pdc_hash_ring_nserver_g = 0;
+static uint32_t *pdc_hash_ring_owner_g   = NULL;
+
+static uint32_t
+pdc_hash_mix32(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+static int
+pdc_hash_ring_point_cmp(const void *a, const void *b)
+{
+    uint32_t pa = ((const pdc_hash_ring_point_t *)a)->pos;
+    uint32_t pb = ((const pdc_hash_ring_point_t *)b)->pos;
+
+    return pa < pb ? -1 : (pa > pb ? 1 : 0);
+}
+
+perr_t
+PDC_hash_ring_init(int n_server)
+{
+    perr_t                 ret_value = SUCCEED;
+    pdc_hash_ring_point_t *points    = NULL;
+    uint32_t *             owner     = NULL;
+    uint32_t               n_point, i, bucket, pos;
+
+    FUNC_ENTER(NULL);
+
+    if (n_server <= 0)
+        PGOTO_ERROR(FAIL, "== invalid number of servers %d", n_server);
+    if (n_server == pdc_hash_ring_nserver_g)
+        PGOTO_DONE(SUCCEED);
+
+    n_point = (uint32_t)n_server * PDC_HASH_RING_NVNODE;
+    points  = (pdc_hash_ring_point_t *)malloc(sizeof(pdc_hash_ring_point_t) * n_point);
+    owner   = (uint32_t *)malloc(sizeof(uint32_t) * PDC_HASH_RING_NBUCKET);
+    if (points == NULL || owner == NULL)
+        PGOTO_ERROR(FAIL, "== cannot allocate hash ring");
+
+    // The mix is a bijection, so the points of different servers never collide
+    for (i = 0; i < n_point; i++) {
+        points[i].pos    = pdc_hash_mix32(i);
+        points[i].server = i / PDC_HASH_RING_NVNODE;
+    }
+    qsort(points, n_point, sizeof(pdc_hash_ring_point_t), pdc_hash_ring_point_cmp);
+
+    for (bucket = 0, i = 0; bucket < PDC_HASH_RING_NBUCKET; bucket++) {
+        pos = bucket << (32 - PDC_HASH_RING_BUCKET_BITS);
+        while (i < n_point && points[i].pos < pos)
+            i++;
+        owner[bucket] = i < n_point ? points[i].server : points[0].server;
+    }
+
+    free(pdc_hash_ring_owner_g);
+    pdc_hash_ring_owner_g   = owner;
+    pdc_hash_ring_nserver_g = n_server;
+    owner                   = NULL;
+
+done:
+    free(points);
+    free(owner);
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_hash_ring_free()
+{
+    FUNC_ENTER(NULL);
+
+    free(pdc_hash_ring_owner_g);
+    pdc_hash_ring_owner_g   = NULL;
+    pdc_hash_ring_nserver_g = 0;
+
+    FUNC_LEAVE_VOID;
+}
+
+uint32_t
+PDC_get_bucket_by_hash(uint32_t key)
+{
+    uint32_t ret_value;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = pdc_hash_mix32(key) >> (32 - PDC_HASH_RING_BUCKET_BITS);
+
+    FUNC_LEAVE(ret_value);
+}
+
+uint32_t
+PDC_get_bucket_by_obj_id(uint64_t obj_id)
+{
+    uint32_t ret_value = 0;
+
+    FUNC_ENTER(NULL);
+
+    // IDs of a bucket are interleaved with a stride of PDC_HASH_RING_NBUCKET
+    if (obj_id >= PDC_SERVER_ID_INTERVEL)
+        ret_value = (uint32_t)((obj_id - PDC_SERVER_ID_INTERVEL) % PDC_HASH_RING_NBUCKET);
+
+    FUNC_LEAVE(ret_value);
+}
+
+uint32_t
+PDC_get_server_by_bucket(uint32_t bucket, int n_server)
+{
+    uint32_t ret_value = 0;
+
+    FUNC_ENTER(NULL);
+
+    if (n_server <= 1)
+        PGOTO_DONE(0);
+    // The ring is built at init, this only happens if a caller passes another server count
+    if (n_server != pdc_hash_ring_nserver_g && PDC_hash_ring_init(n_server) != SUCCEED)
+        PGOTO_DONE(bucket % n_server);
+
+    ret_value = pdc_hash_ring_owner_g[bucket % PDC_HASH_RING_NBUCKET];
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+uint32_t
+PDC_get_server_by_hash(uint32_t key, int n_server)
+{
+    uint32_t ret_value = 0;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_get_server_by_bucket(PDC_get_bucket_by_hash(key), n_server);
+
+    FUNC_LEAVE(ret_value);
+}
+
 uint32_t
 PDC_get_server_by_obj_id(uint64_t obj_id, int n_server)
 {
-    // TODO: need a smart way to deal with server number change
     uint32_t ret_value = 0;
 
     FUNC_ENTER(NULL);
 
-    ret_value = (uint32_t)(obj_id / PDC_SERVER_ID_INTERVEL) - 1;
-    ret_value %= n_server;
+    // An ID carries the bucket of the key it was created for, so it resolves to the same server
+    ret_value = PDC_get_server_by_bucket(PDC_get_bucket_by_obj_id(obj_id), n_server);
 
     FUNC_LEAVE(ret_value);
 }
@@ -750,16 +900,241 @@ PDC_get_hash_by_name(const char *name)
 uint32_t
 PDC_get_server_by_name(char *name, int n_server)
 {
-    // TODO: need a smart way to deal with server number change
     uint32_t ret_value;
 
     FUNC_ENTER(NULL);
 
-    ret_value = PDC_get_hash_by_name(name) % n_server;
+    ret_value = PDC_get_server_by_hash(PDC_get_hash_by_name(name), n_server);
+
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * String arena for the app names and data locations of pdc_metadata_t. Strings are interned, so
+ * all objects of one application or data location share a single copy, and are never freed
+ * individually. Object names and tags are mostly unique and are not kept here.
+ */
+#define PDC_STR_ARENA_CHUNK_SIZE (1 << 20)
+
+typedef struct pdc_str_arena_chunk_t {
+    struct pdc_str_arena_chunk_t *next;
+    size_t                        size;
+    size_t                        used;
+    char                          data[];
+} pdc_str_arena_chunk_t;
+
+static pdc_str_arena_chunk_t *pdc_str_arena_g          = NULL;
+static const char **          pdc_str_intern_slots_g   = NULL;
+static size_t                 pdc_str_intern_n_slots_g = 0;
+static size_t                 pdc_str_intern_n_g       = 0;
+#ifdef ENABLE_MULTITHREAD
+static hg_thread_mutex_t pdc_str_intern_mutex_g = HG_THREAD_MUTEX_INITIALIZER;
+#endif
+
+static size_t
+pdc_str_hash(const char *str)
+{
+    size_t hash = 5381;
+
+    while (*str != 0)
+        hash = hash * 33 + (unsigned char)*str++;
+
+    return hash;
+}
+
+static char *
+pdc_str_arena_alloc(size_t size)
+{
+    pdc_str_arena_chunk_t *chunk = pdc_str_arena_g;
+    size_t                 chunk_size;
+    char *                 ret_value;
+
+    if (chunk == NULL || chunk->size - chunk->used < size) {
+        chunk_size = size > PDC_STR_ARENA_CHUNK_SIZE ? size : PDC_STR_ARENA_CHUNK_SIZE;
+        chunk      = (pdc_str_arena_chunk_t *)malloc(sizeof(pdc_str_arena_chunk_t) + chunk_size);
+        if (chunk == NULL)
+            return NULL;
+        chunk->size     = chunk_size;
+        chunk->used     = 0;
+        chunk->next     = pdc_str_arena_g;
+        pdc_str_arena_g = chunk;
+    }
+    ret_value = chunk->data + chunk->used;
+    chunk->used += size;
+
+    return ret_value;
+}
+
+static int
+pdc_str_intern_grow()
+{
+    const char **slots;
+    size_t       n_slots, i, j;
+
+    n_slots = pdc_str_intern_n_slots_g == 0 ? 1024 : pdc_str_intern_n_slots_g * 2;
+    slots   = (const char **)calloc(n_slots, sizeof(const char *));
+    if (slots == NULL)
+        return -1;
+
+    for (i = 0; i < pdc_str_intern_n_slots_g; i++) {
+        if (pdc_str_intern_slots_g[i] == NULL)
+            continue;
+        j = pdc_str_hash(pdc_str_intern_slots_g[i]) & (n_slots - 1);
+        while (slots[j] != NULL)
+            j = (j + 1) & (n_slots - 1);
+        slots[j] = pdc_str_intern_slots_g[i];
+    }
+    free(pdc_str_intern_slots_g);
+    pdc_str_intern_slots_g   = slots;
+    pdc_str_intern_n_slots_g = n_slots;
+
+    return 0;
+}
+
+static const char *
+pdc_str_intern_locked(const char *str)
+{
+    size_t slot, len;
+    char * copy;
+
+    if (2 * (pdc_str_intern_n_g + 1) > pdc_str_intern_n_slots_g && pdc_str_intern_grow() != 0)
+        return NULL;
+
+    slot = pdc_str_hash(str) & (pdc_str_intern_n_slots_g - 1);
+    while (pdc_str_intern_slots_g[slot] != NULL) {
+        if (strcmp(pdc_str_intern_slots_g[slot], str) == 0)
+            return pdc_str_intern_slots_g[slot];
+        slot = (slot + 1) & (pdc_str_intern_n_slots_g - 1);
+    }
+
+    len  = strlen(str) + 1;
+    copy = pdc_str_arena_alloc(len);
+    if (copy == NULL)
+        return NULL;
+    memcpy(copy, str, len);
+    pdc_str_intern_slots_g[slot] = copy;
+    pdc_str_intern_n_g++;
+
+    return copy;
+}
+
+const char *
+PDC_str_intern(const char *str)
+{
+    const char *ret_value = "";
+
+    FUNC_ENTER(NULL);
+
+    if (str == NULL || str[0] == 0)
+        PGOTO_DONE(ret_value);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_str_intern_mutex_g);
+#endif
+    ret_value = pdc_str_intern_locked(str);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_str_intern_mutex_g);
+#endif
+    if (ret_value == NULL)
+        PGOTO_ERROR(NULL, "==PDC: cannot allocate string arena");
 
+done:
     FUNC_LEAVE(ret_value);
 }
 
+void
+PDC_str_arena_free()
+{
+    pdc_str_arena_chunk_t *chunk, *next;
+
+    FUNC_ENTER(NULL);
+
+    for (chunk = pdc_str_arena_g; chunk != NULL; chunk = next) {
+        next = chunk->next;
+        free(chunk);
+    }
+    free(pdc_str_intern_slots_g);
+    pdc_str_arena_g          = NULL;
+    pdc_str_intern_slots_g   = NULL;
+    pdc_str_intern_n_slots_g = 0;
+    pdc_str_intern_n_g       = 0;
+
+    FUNC_LEAVE_VOID;
+}
+
+// Serialized pdc_metadata_t: the struct followed by its NUL-terminated strings
+size_t
+PDC_metadata_serialize(pdc_metadata_t *meta, void *buf)
+{
+    const char *strs[4] = {meta->app_name, meta->obj_name, meta->tags, meta->data_location};
+    size_t      size    = sizeof(pdc_metadata_t), len;
+    int         i;
+
+    if (buf != NULL)
+        memcpy(buf, meta, sizeof(pdc_metadata_t));
+    for (i = 0; i < 4; i++) {
+        len = strs[i] == NULL ? 1 : strlen(strs[i]) + 1;
+        if (buf != NULL)
+            memcpy((char *)buf + size, strs[i] == NULL ? "" : strs[i], len);
+        size += len;
+    }
+
+    return size;
+}
+
+size_t
+PDC_metadata_deserialize(const void *buf, pdc_metadata_t *meta)
+{
+    const char *str  = (const char *)buf + sizeof(pdc_metadata_t);
+    size_t      size = sizeof(pdc_metadata_t);
+
+    memcpy(meta, buf, sizeof(pdc_metadata_t));
+    meta->app_name = str;
+    size += strlen(str) + 1;
+    meta->obj_name = (const char *)buf + size;
+    size += strlen((const char *)buf + size) + 1;
+    meta->tags = (const char *)buf + size;
+    size += strlen((const char *)buf + size) + 1;
+    meta->data_location = (const char *)buf + size;
+    size += strlen((const char *)buf + size) + 1;
+
+    return size;
+}
+
+pdc_metadata_t *
+PDC_metadata_dup(const pdc_metadata_t *meta)
+{
+    const char *    strs[4] = {meta->app_name, meta->obj_name, meta->tags, meta->data_location};
+    const char **   dst[4];
+    pdc_metadata_t *ret_value;
+    size_t          size = sizeof(pdc_metadata_t), len;
+    char *          pos;
+    int             i;
+
+    for (i = 0; i < 4; i++)
+        size += (strs[i] == NULL ? 0 : strlen(strs[i])) + 1;
+
+    ret_value = (pdc_metadata_t *)malloc(size);
+    if (ret_value == NULL)
+        return NULL;
+    memcpy(ret_value, meta, sizeof(pdc_metadata_t));
+    dst[0] = &ret_value->app_name;
+    dst[1] = &ret_value->obj_name;
+    dst[2] = &ret_value->tags;
+    dst[3] = &ret_value->data_location;
+
+    // The strings follow the struct, so freeing the struct frees them
+    pos = (char *)(ret_value + 1);
+    for (i = 0; i < 4; i++) {
+        len = strs[i] == NULL ? 1 : strlen(strs[i]) + 1;
+        memcpy(pos, strs[i] == NULL ? "" : strs[i], len);
+        *dst[i] = pos;
+        pos += len;
+    }
+
+    return ret_value;
+}
+
 int
 PDC_metadata_cmp(pdc_metadata_t *a, pdc_metadata_t *b)
 {
@@ -775,7 +1150,7 @@ PDC_metadata_cmp(pdc_metadata_t *a, pdc_metadata_t *b)
         PGOTO_DONE(ret_value);
 
     // Object name
-    if (a->obj_name[0] != '\0' && b->obj_name[0] != '\0') {
+    if (a->obj_name != NULL && b->obj_name != NULL && a->obj_name[0] != '\0' && b->obj_name[0] != '\0') {
         ret_value = strcmp(a->obj_name, b->obj_name);
     }
     if (ret_value != 0)
@@ -789,7 +1164,7 @@ PDC_metadata_cmp(pdc_metadata_t *a, pdc_metadata_t *b)
         PGOTO_DONE(ret_value);
 
     // Application name
-    if (a->app_name[0] != '\0' && b->app_name[0] != '\0') {
+    if (a->app_name != NULL && b->app_name != NULL && a->app_name[0] != '\0' && b->app_name[0] != '\0') {
         ret_value = strcmp(a->app_name, b->app_name);
     }
 
@@ -874,10 +1249,10 @@ PDC_metadata_init(pdc_metadata_t *a)
     a->last_modified_time = 0;
     a->ndim               = 0;
 
-    memset(a->app_name, 0, sizeof(char) * ADDR_MAX);
-    memset(a->obj_name, 0, sizeof(char) * ADDR_MAX);
-    memset(a->tags, 0, sizeof(char) * TAG_LEN_MAX);
-    memset(a->data_location, 0, sizeof(char) * ADDR_MAX);
+    a->app_name      = "";
+    a->obj_name      = "";
+    a->tags          = "";
+    a->data_location = "";
     memset(a->dims, 0, sizeof(uint64_t) * DIM_MAX);
 
     a->storage_region_list_head = NULL;
@@ -1439,10 +1814,11 @@ PDC_transfer_t_to_metadata_t(pdc_metadata_transfer_t *transfer, pdc_metadata_t *
     meta->dims[2]   = transfer->dims2;
     meta->dims[3]   = transfer->dims3;
 
-    strcpy(meta->app_name, transfer->app_name);
-    strcpy(meta->obj_name, transfer->obj_name);
-    strcpy(meta->tags, transfer->tags);
-    strcpy(meta->data_location, transfer->data_location);
+    // Names and tags are mostly unique, so they are not interned and stay in the transfer struct
+    meta->app_name      = PDC_str_intern(transfer->app_name);
+    meta->obj_name      = transfer->obj_name == NULL ? "" : transfer->obj_name;
+    meta->tags          = transfer->tags == NULL ? "" : transfer->tags;
+    meta->data_location = PDC_str_intern(transfer->data_location);
 
     if ((meta->transform_state = transfer->current_state) == 0) {
         memset(&meta->current_state, 0, sizeof(struct _pdc_transform_state));
@@ -1483,6 +1859,27 @@ PDC_insert_metadata_to_hash_table(gen_obj_id_in_t *in   ATTRIBUTE(unused),
     return SUCCEED;
 }
 perr_t
+PDC_Server_create_objs_batch(gen_obj_id_many_in_t *in ATTRIBUTE(unused), uint32_t n_obj ATTRIBUTE(unused),
+                             const uint32_t *hash_values ATTRIBUTE(unused),
+                             char **obj_names ATTRIBUTE(unused), uint64_t *obj_ids ATTRIBUTE(unused),
+                             uint32_t *n_created ATTRIBUTE(unused))
+{
+    return SUCCEED;
+}
+perr_t
+PDC_Server_kvtag_many(int32_t op ATTRIBUTE(unused), uint32_t n_entry ATTRIBUTE(unused),
+                      const char *req ATTRIBUTE(unused), uint64_t req_size ATTRIBUTE(unused),
+                      char *resp ATTRIBUTE(unused), uint64_t resp_capacity ATTRIBUTE(unused),
+                      uint32_t *n_done ATTRIBUTE(unused), uint64_t *resp_size ATTRIBUTE(unused))
+{
+    return SUCCEED;
+}
+void
+PDC_Server_meta_store_get_stats(pdc_meta_store_stats_t *stats)
+{
+    memset(stats, 0, sizeof(pdc_meta_store_stats_t));
+}
+perr_t
 PDC_Server_search_with_name_hash(const char *obj_name ATTRIBUTE(unused), uint32_t hash_key ATTRIBUTE(unused),
                                  pdc_metadata_t **out ATTRIBUTE(unused))
 {
@@ -1579,13 +1976,17 @@ PDC_Server_local_region_lock_status(PDC_mapping_info_t *mapped_region ATTRIBUTE(
     return SUCCEED;
 }
 perr_t
-PDC_Server_get_partial_query_result(metadata_query_transfer_in_t *in ATTRIBUTE(unused),
-                                    uint32_t *n_meta ATTRIBUTE(unused), void ***buf_ptrs ATTRIBUTE(unused))
+PDC_Server_get_partial_query_page(metadata_query_transfer_in_t *in ATTRIBUTE(unused),
+                                  uint64_t cursor ATTRIBUTE(unused), uint64_t cursor_minor ATTRIBUTE(unused),
+                                  char *buf ATTRIBUTE(unused), uint64_t buf_size ATTRIBUTE(unused),
+                                  uint32_t *n_meta ATTRIBUTE(unused), uint64_t *nbytes ATTRIBUTE(unused),
+                                  uint64_t *next_cursor ATTRIBUTE(unused),
+                                  uint64_t *next_cursor_minor ATTRIBUTE(unused))
 {
     return SUCCEED;
 }
 perr_t
-PDC_Server_get_kvtag_query_result(pdc_kvtag_t *in ATTRIBUTE(unused), uint32_t *n_meta ATTRIBUTE(unused),
+PDC_Server_get_kvtag_query_result(kvtag_query_in_t *in ATTRIBUTE(unused), uint32_t *n_meta ATTRIBUTE(unused),
                                   uint64_t **buf_ptrs ATTRIBUTE(unused))
 {
     return SUCCEED;
@@ -1706,6 +2107,22 @@ PDC_Server_recv_shm_cb(const struct hg_cb_info *callback_info ATTRIBUTE(unused))
 {
     return HG_SUCCESS;
 }
+perr_t
+PDC_Server_attach_client_shm(pdc_shm_info_t *shm_info ATTRIBUTE(unused))
+{
+    return SUCCEED;
+}
+char *
+PDC_Server_get_client_shm_buf(uint64_t token ATTRIBUTE(unused), uint64_t offset ATTRIBUTE(unused),
+                              uint64_t size ATTRIBUTE(unused))
+{
+    return NULL;
+}
+perr_t
+PDC_Server_detach_client_shm(uint64_t token ATTRIBUTE(unused))
+{
+    return SUCCEED;
+}
 
 data_server_region_t *
 PDC_Server_get_obj_region(pdcid_t obj_id ATTRIBUTE(unused))
@@ -1933,6 +2350,333 @@ HG_TEST_RPC_CB(gen_obj_id, handle)
     FUNC_LEAVE(ret_value);
 }
 
+// Finish a batched object creation: release the transfer resources and answer the client
+static void
+gen_obj_id_many_finish(struct gen_obj_id_many_args_t *args)
+{
+    FUNC_ENTER(NULL);
+
+    if (args->local_bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(args->local_bulk_handle);
+    HG_Respond(args->handle, NULL, NULL, &args->out);
+    HG_Free_input(args->handle, &args->in);
+    HG_Destroy(args->handle);
+    free(args->buf);
+    free(args);
+
+    FUNC_LEAVE_VOID;
+}
+
+// The generated IDs have been pushed back to the client
+static hg_return_t
+gen_obj_id_many_push_cb(const struct hg_cb_info *hg_cb_info)
+{
+    hg_return_t                    ret_value = HG_SUCCESS;
+    struct gen_obj_id_many_args_t *args      = (struct gen_obj_id_many_args_t *)hg_cb_info->arg;
+
+    FUNC_ENTER(NULL);
+
+    if (hg_cb_info->ret != HG_SUCCESS) {
+        args->out.ret = -1;
+        printf("==PDC_SERVER[%d]: %s - error pushing object IDs\n", pdc_server_rank_g, __func__);
+    }
+    gen_obj_id_many_finish(args);
+
+    FUNC_LEAVE(ret_value);
+}
+
+// The names have been pulled from the client, insert them and push the IDs back
+static hg_return_t
+gen_obj_id_many_pull_cb(const struct hg_cb_info *hg_cb_info)
+{
+    hg_return_t                    ret_value = HG_SUCCESS;
+    struct gen_obj_id_many_args_t *args      = (struct gen_obj_id_many_args_t *)hg_cb_info->arg;
+    const struct hg_info *         hg_info;
+    uint32_t                       n_obj, i;
+    uint64_t *                     obj_ids;
+    uint32_t *                     hash_values;
+    char **                        obj_names = NULL;
+    char *                         name, *end;
+
+    FUNC_ENTER(NULL);
+
+    if (hg_cb_info->ret != HG_SUCCESS)
+        PGOTO_ERROR(HG_PROTOCOL_ERROR, "==PDC_SERVER[%d]: %s - error pulling object names", pdc_server_rank_g,
+                    __func__);
+
+    n_obj       = args->in.n_obj;
+    obj_ids     = (uint64_t *)args->buf;
+    hash_values = (uint32_t *)(obj_ids + n_obj);
+    name        = (char *)(hash_values + n_obj);
+    end         = (char *)args->buf + args->nbytes;
+
+    obj_names = (char **)malloc(n_obj * sizeof(char *));
+    if (obj_names == NULL)
+        PGOTO_ERROR(HG_NOMEM_ERROR, "==PDC_SERVER[%d]: %s - cannot allocate name array", pdc_server_rank_g,
+                    __func__);
+
+    for (i = 0; i < n_obj; i++) {
+        obj_names[i] = name;
+        name         = memchr(name, 0, end - name);
+        if (name == NULL)
+            PGOTO_ERROR(HG_INVALID_ARG, "==PDC_SERVER[%d]: %s - truncated object name", pdc_server_rank_g,
+                        __func__);
+        name++;
+    }
+
+    PDC_Server_create_objs_batch(&args->in, n_obj, hash_values, obj_names, obj_ids, &args->out.n_created);
+    args->out.ret = 1;
+
+    // Only the ID array at the head of the buffer goes back
+    hg_info   = HG_Get_info(args->handle);
+    ret_value = HG_Bulk_transfer(hg_info->context, gen_obj_id_many_push_cb, args, HG_BULK_PUSH,
+                                 hg_info->addr, args->in.bulk_handle, 0, args->local_bulk_handle, 0,
+                                 n_obj * sizeof(uint64_t), HG_OP_ID_IGNORE);
+    if (ret_value != HG_SUCCESS)
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not push object IDs", pdc_server_rank_g,
+                    __func__);
+
+done:
+    free(obj_names);
+    if (ret_value != HG_SUCCESS) {
+        args->out.ret       = -1;
+        args->out.n_created = 0;
+        gen_obj_id_many_finish(args);
+    }
+    fflush(stdout);
+
+    FUNC_LEAVE(ret_value);
+}
+
+/* gen_obj_id_many_cb(hg_handle_t handle) */
+HG_TEST_RPC_CB(gen_obj_id_many, handle)
+{
+    hg_return_t                    ret_value = HG_SUCCESS;
+    const struct hg_info *         hg_info;
+    struct gen_obj_id_many_args_t *args;
+
+    FUNC_ENTER(NULL);
+
+    args = (struct gen_obj_id_many_args_t *)calloc(1, sizeof(struct gen_obj_id_many_args_t));
+    if (args == NULL)
+        PGOTO_ERROR(HG_NOMEM_ERROR, "==PDC_SERVER[%d]: %s - cannot allocate args", pdc_server_rank_g,
+                    __func__);
+    args->handle            = handle;
+    args->local_bulk_handle = HG_BULK_NULL;
+    args->out.ret           = -1;
+
+    ret_value = HG_Get_input(handle, &args->in);
+    if (ret_value != HG_SUCCESS) {
+        HG_Respond(handle, NULL, NULL, &args->out);
+        HG_Destroy(handle);
+        free(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not get input", pdc_server_rank_g, __func__);
+    }
+
+    args->nbytes = HG_Bulk_get_size(args->in.bulk_handle);
+    if (args->nbytes < args->in.n_obj * (sizeof(uint64_t) + sizeof(uint32_t) + 1)) {
+        gen_obj_id_many_finish(args);
+        PGOTO_ERROR(HG_INVALID_ARG, "==PDC_SERVER[%d]: %s - bulk buffer too small", pdc_server_rank_g,
+                    __func__);
+    }
+
+    args->buf = malloc(args->nbytes);
+    hg_info   = HG_Get_info(handle);
+    ret_value = HG_Bulk_create(hg_info->hg_class, 1, &args->buf, &args->nbytes, HG_BULK_READWRITE,
+                               &args->local_bulk_handle);
+    if (ret_value != HG_SUCCESS) {
+        args->local_bulk_handle = HG_BULK_NULL;
+        gen_obj_id_many_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not create bulk handle", pdc_server_rank_g,
+                    __func__);
+    }
+
+    // Pull the names and hashes, the IDs are pushed back into the same buffer
+    ret_value = HG_Bulk_transfer(hg_info->context, gen_obj_id_many_pull_cb, args, HG_BULK_PULL,
+                                 hg_info->addr, args->in.bulk_handle, 0, args->local_bulk_handle, 0,
+                                 args->nbytes, HG_OP_ID_IGNORE);
+    if (ret_value != HG_SUCCESS) {
+        gen_obj_id_many_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not pull object names", pdc_server_rank_g,
+                    __func__);
+    }
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+// Finish a batched kvtag request: release the transfer resources and answer the client
+static void
+kvtag_many_finish(struct kvtag_many_args_t *args)
+{
+    FUNC_ENTER(NULL);
+
+    if (args->local_bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(args->local_bulk_handle);
+    HG_Respond(args->handle, NULL, NULL, &args->out);
+    HG_Free_input(args->handle, &args->in);
+    HG_Destroy(args->handle);
+    free(args->buf);
+    free(args);
+
+    FUNC_LEAVE_VOID;
+}
+
+// The responses have been pushed back to the client
+static hg_return_t
+kvtag_many_push_cb(const struct hg_cb_info *hg_cb_info)
+{
+    hg_return_t               ret_value = HG_SUCCESS;
+    struct kvtag_many_args_t *args      = (struct kvtag_many_args_t *)hg_cb_info->arg;
+
+    FUNC_ENTER(NULL);
+
+    if (hg_cb_info->ret != HG_SUCCESS) {
+        args->out.ret = -1;
+        printf("==PDC_SERVER[%d]: %s - error pushing kvtag responses\n", pdc_server_rank_g, __func__);
+    }
+    kvtag_many_finish(args);
+
+    FUNC_LEAVE(ret_value);
+}
+
+// The entries have been pulled from the client, apply them and push the responses back
+static hg_return_t
+kvtag_many_pull_cb(const struct hg_cb_info *hg_cb_info)
+{
+    hg_return_t               ret_value = HG_SUCCESS;
+    struct kvtag_many_args_t *args      = (struct kvtag_many_args_t *)hg_cb_info->arg;
+    const struct hg_info *    hg_info;
+    uint64_t                  req_size, resp_capacity;
+
+    FUNC_ENTER(NULL);
+
+    if (hg_cb_info->ret != HG_SUCCESS)
+        PGOTO_ERROR(HG_PROTOCOL_ERROR, "==PDC_SERVER[%d]: %s - error pulling kvtags", pdc_server_rank_g,
+                    __func__);
+
+    req_size      = args->in.req_size;
+    resp_capacity = args->nbytes - req_size;
+    if (PDC_Server_kvtag_many(args->in.op, args->in.n_entry, (char *)args->buf, req_size,
+                              (char *)args->buf + req_size, resp_capacity, &args->out.n_done,
+                              &args->out.resp_size) != SUCCEED)
+        PGOTO_ERROR(HG_INVALID_ARG, "==PDC_SERVER[%d]: %s - error with PDC_Server_kvtag_many",
+                    pdc_server_rank_g, __func__);
+
+    // The client retries a get with a larger buffer, adds and deletes always fit
+    if (args->out.resp_size > resp_capacity) {
+        args->out.ret = 0;
+        kvtag_many_finish(args);
+        PGOTO_DONE(ret_value);
+    }
+
+    args->out.ret = 1;
+    hg_info       = HG_Get_info(args->handle);
+    ret_value     = HG_Bulk_transfer(hg_info->context, kvtag_many_push_cb, args, HG_BULK_PUSH, hg_info->addr,
+                                 args->in.bulk_handle, req_size, args->local_bulk_handle, req_size,
+                                 args->out.resp_size, HG_OP_ID_IGNORE);
+    if (ret_value != HG_SUCCESS)
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not push kvtag responses", pdc_server_rank_g,
+                    __func__);
+
+done:
+    if (ret_value != HG_SUCCESS) {
+        args->out.ret    = -1;
+        args->out.n_done = 0;
+        kvtag_many_finish(args);
+    }
+    fflush(stdout);
+
+    FUNC_LEAVE(ret_value);
+}
+
+/* kvtag_many_cb(hg_handle_t handle) */
+HG_TEST_RPC_CB(kvtag_many, handle)
+{
+    hg_return_t               ret_value = HG_SUCCESS;
+    const struct hg_info *    hg_info;
+    struct kvtag_many_args_t *args;
+
+    FUNC_ENTER(NULL);
+
+    args = (struct kvtag_many_args_t *)calloc(1, sizeof(struct kvtag_many_args_t));
+    if (args == NULL)
+        PGOTO_ERROR(HG_NOMEM_ERROR, "==PDC_SERVER[%d]: %s - cannot allocate args", pdc_server_rank_g,
+                    __func__);
+    args->handle            = handle;
+    args->local_bulk_handle = HG_BULK_NULL;
+    args->out.ret           = -1;
+
+    ret_value = HG_Get_input(handle, &args->in);
+    if (ret_value != HG_SUCCESS) {
+        HG_Respond(handle, NULL, NULL, &args->out);
+        HG_Destroy(handle);
+        free(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not get input", pdc_server_rank_g, __func__);
+    }
+
+    args->nbytes = HG_Bulk_get_size(args->in.bulk_handle);
+    if (args->in.req_size == 0 || args->nbytes < args->in.req_size) {
+        kvtag_many_finish(args);
+        PGOTO_ERROR(HG_INVALID_ARG, "==PDC_SERVER[%d]: %s - bulk buffer too small", pdc_server_rank_g,
+                    __func__);
+    }
+
+    args->buf = malloc(args->nbytes);
+    hg_info   = HG_Get_info(handle);
+    ret_value = HG_Bulk_create(hg_info->hg_class, 1, &args->buf, &args->nbytes, HG_BULK_READWRITE,
+                               &args->local_bulk_handle);
+    if (ret_value != HG_SUCCESS) {
+        args->local_bulk_handle = HG_BULK_NULL;
+        kvtag_many_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not create bulk handle", pdc_server_rank_g,
+                    __func__);
+    }
+
+    // Only the requests are pulled, the responses are pushed back right after them
+    ret_value = HG_Bulk_transfer(hg_info->context, kvtag_many_pull_cb, args, HG_BULK_PULL, hg_info->addr,
+                                 args->in.bulk_handle, 0, args->local_bulk_handle, 0, args->in.req_size,
+                                 HG_OP_ID_IGNORE);
+    if (ret_value != HG_SUCCESS) {
+        kvtag_many_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not pull kvtags", pdc_server_rank_g,
+                    __func__);
+    }
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+/* meta_store_stats_cb(hg_handle_t handle) */
+HG_TEST_RPC_CB(meta_store_stats, handle)
+{
+    hg_return_t            ret_value = HG_SUCCESS;
+    pdc_int_send_t         in;
+    meta_store_stats_out_t out;
+    pdc_meta_store_stats_t stats;
+
+    FUNC_ENTER(NULL);
+
+    HG_Get_input(handle, &in);
+
+    PDC_Server_meta_store_get_stats(&stats);
+    out.n_obj          = stats.n_obj;
+    out.n_resident     = stats.n_resident;
+    out.mem_size       = stats.mem_size;
+    out.cache_size     = stats.cache_size;
+    out.n_load         = stats.n_load;
+    out.n_evict        = stats.n_evict;
+    out.total_mem_size = stats.total_mem_size;
+    ret_value          = HG_Respond(handle, NULL, NULL, &out);
+
+    HG_Free_input(handle, &in);
+    HG_Destroy(handle);
+
+    FUNC_LEAVE(ret_value);
+}
+
 /* static hg_return_t */
 /* gen_cont_id_cb(hg_handle_t handle) */
 HG_TEST_RPC_CB(gen_cont_id, handle)
@@ -2193,6 +2937,9 @@ HG_TEST_RPC_CB(metadata_get_kvtag, handle)
     HG_Get_input(handle, &in);
     PDC_Server_get_kvtag(&in, &out);
     ret_value = HG_Respond(handle, NULL, NULL, &out);
+    // The server gives a copy of the tag
+    free(out.kvtag.name);
+    free(out.kvtag.value);
 
     HG_Free_input(handle, &in);
     HG_Destroy(handle);
@@ -5020,25 +5767,18 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
-hg_return_t
-transfer_request_bulk_transfer_write_cb(const struct hg_cb_info *info)
+/*
+ * Write the data of a region transfer request, received either with a bulk transfer or in shared memory.
+ */
+static perr_t
+transfer_request_data_write(struct transfer_request_local_bulk_args *local_bulk_args)
 {
-    struct transfer_request_local_bulk_args *local_bulk_args = info->arg;
-    hg_return_t                              ret             = HG_SUCCESS;
-    struct pdc_region_info *                 remote_reg_info;
-    uint64_t                                 obj_dims[3];
+    perr_t                  ret_value = SUCCEED;
+    struct pdc_region_info *remote_reg_info;
+    uint64_t                obj_dims[3];
 
     FUNC_ENTER(NULL);
 
-#ifdef PDC_TIMING
-    double end = MPI_Wtime(), start;
-    server_timings->PDCreg_transfer_request_wait_write_bulk_rpc += end - local_bulk_args->start_time;
-    pdc_timestamp_register(transfer_request_wait_write_bulk_timestamps, local_bulk_args->start_time, end);
-    start = MPI_Wtime();
-#endif
-
-    // printf("entering transfer bulk callback\n");
-
     remote_reg_info = (struct pdc_region_info *)malloc(sizeof(struct pdc_region_info));
 
     remote_reg_info->ndim   = (local_bulk_args->in.remote_region).ndim;
@@ -5072,12 +5812,35 @@ transfer_request_bulk_transfer_write_cb(const struct hg_cb_info *info)
                                    remote_reg_info, (void *)local_bulk_args->data_buf,
                                    local_bulk_args->in.remote_unit, 1);
 #endif
+    free(remote_reg_info->offset);
+    free(remote_reg_info->size);
+    free(remote_reg_info);
+
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+hg_return_t
+transfer_request_bulk_transfer_write_cb(const struct hg_cb_info *info)
+{
+    struct transfer_request_local_bulk_args *local_bulk_args = info->arg;
+    hg_return_t                              ret             = HG_SUCCESS;
+
+    FUNC_ENTER(NULL);
+
+#ifdef PDC_TIMING
+    double end = MPI_Wtime(), start;
+    server_timings->PDCreg_transfer_request_wait_write_bulk_rpc += end - local_bulk_args->start_time;
+    pdc_timestamp_register(transfer_request_wait_write_bulk_timestamps, local_bulk_args->start_time, end);
+    start = MPI_Wtime();
+#endif
+
+    transfer_request_data_write(local_bulk_args);
 
     pthread_mutex_lock(&transfer_request_status_mutex);
     PDC_finish_request(local_bulk_args->transfer_request_id);
     pthread_mutex_unlock(&transfer_request_status_mutex);
     free(local_bulk_args->data_buf);
-    free(remote_reg_info);
 
     HG_Bulk_free(local_bulk_args->bulk_handle);
 
@@ -5230,6 +5993,9 @@ HG_TEST_RPC_CB(transfer_request, handle)
 
     info = HG_Get_info(handle);
 
+    out.inline_size = 0;
+    out.inline_buf  = NULL;
+
     total_mem_size = in.remote_unit;
     if (in.remote_region.ndim >= 1) {
         total_mem_size *= in.remote_region.count_0;
@@ -5240,16 +6006,50 @@ HG_TEST_RPC_CB(transfer_request, handle)
     if (in.remote_region.ndim >= 3) {
         total_mem_size *= in.remote_region.count_2;
     }
+
+    local_bulk_args =
+        (struct transfer_request_local_bulk_args *)malloc(sizeof(struct transfer_request_local_bulk_args));
+    if (in.use_shm) {
+        // Same-node client, the data lives in the client's shared memory arena
+        local_bulk_args->data_buf =
+            PDC_Server_get_client_shm_buf(in.shm_token, in.shm_offset, total_mem_size);
+        if (local_bulk_args->data_buf == NULL) {
+            printf("==PDC_SERVER[%d]: no shared memory arena with token %" PRIx64 "\n", get_server_rank(),
+                   in.shm_token);
+            free(local_bulk_args);
+            out.metadata_id = 0;
+            out.ret         = 0;
+            ret_value       = HG_Respond(handle, NULL, NULL, &out);
+            HG_Free_input(handle, &in);
+            HG_Destroy(handle);
+            goto done;
+        }
+    }
+    else if (in.use_inline && in.access_type == PDC_WRITE) {
+        // Small write, the data came with the request
+        if (in.inline_size != total_mem_size) {
+            printf("==PDC_SERVER[%d]: inline data size %u does not match region size %zu\n",
+                   get_server_rank(), in.inline_size, total_mem_size);
+            free(local_bulk_args);
+            out.metadata_id = 0;
+            out.ret         = 0;
+            ret_value       = HG_Respond(handle, NULL, NULL, &out);
+            HG_Free_input(handle, &in);
+            HG_Destroy(handle);
+            goto done;
+        }
+        local_bulk_args->data_buf = in.inline_buf;
+    }
+    else
+        local_bulk_args->data_buf = malloc(total_mem_size);
+
     out.metadata_id = PDC_transfer_request_id_register();
     pthread_mutex_lock(&transfer_request_status_mutex);
     PDC_commit_request(out.metadata_id);
     pthread_mutex_unlock(&transfer_request_status_mutex);
 
-    local_bulk_args =
-        (struct transfer_request_local_bulk_args *)malloc(sizeof(struct transfer_request_local_bulk_args));
     local_bulk_args->handle              = handle;
     local_bulk_args->total_mem_size      = total_mem_size;
-    local_bulk_args->data_buf            = malloc(total_mem_size);
     local_bulk_args->in                  = in;
     local_bulk_args->transfer_request_id = out.metadata_id;
 #ifdef PDC_TIMING
@@ -5260,9 +6060,19 @@ HG_TEST_RPC_CB(transfer_request, handle)
                in.obj_dim0, in.obj_dim1, in.obj_dim2);
     */
     // printf("HG_TEST_RPC_CB(transfer_request, handle) checkpoint @ line %d\n", __LINE__);
-    out.ret   = 1;
-    ret_value = HG_Respond(handle, NULL, NULL, &out);
-    if (in.access_type == PDC_WRITE) {
+    out.ret = 1;
+    // Small reads are answered once the data is available
+    if (!(in.use_inline && in.access_type == PDC_READ))
+        ret_value = HG_Respond(handle, NULL, NULL, &out);
+    if ((in.use_shm || in.use_inline) && in.access_type == PDC_WRITE) {
+        // Consume the data in place, no bulk transfer needed
+        transfer_request_data_write(local_bulk_args);
+        pthread_mutex_lock(&transfer_request_status_mutex);
+        PDC_finish_request(local_bulk_args->transfer_request_id);
+        pthread_mutex_unlock(&transfer_request_status_mutex);
+        free(local_bulk_args);
+    }
+    else if (in.access_type == PDC_WRITE) {
         ret_value = HG_Bulk_create(info->hg_class, 1, &(local_bulk_args->data_buf),
                                    &(local_bulk_args->total_mem_size), HG_BULK_READWRITE,
                                    &(local_bulk_args->bulk_handle));
@@ -5333,18 +6143,38 @@ HG_TEST_RPC_CB(transfer_request, handle)
                 printf("Server transfer request at read branch index 1 value is %d\n",
                        *((int *)(local_bulk_args->data_buf + sizeof(int))));
         */
-        ret_value = HG_Bulk_create(info->hg_class, 1, &(local_bulk_args->data_buf),
-                                   &(local_bulk_args->total_mem_size), HG_BULK_READWRITE,
-                                   &(local_bulk_args->bulk_handle));
-        if (ret_value != HG_SUCCESS) {
-            printf("Error at HG_TEST_RPC_CB(transfer_request, handle): @ line %d ", __LINE__);
+        if (in.use_shm) {
+            // Data has been read directly into the client's arena
+            pthread_mutex_lock(&transfer_request_status_mutex);
+            PDC_finish_request(local_bulk_args->transfer_request_id);
+            pthread_mutex_unlock(&transfer_request_status_mutex);
+            free(local_bulk_args);
+        }
+        else if (in.use_inline) {
+            // Return the data with the response, no bulk transfer needed
+            pthread_mutex_lock(&transfer_request_status_mutex);
+            PDC_finish_request(local_bulk_args->transfer_request_id);
+            pthread_mutex_unlock(&transfer_request_status_mutex);
+            out.inline_size = total_mem_size;
+            out.inline_buf  = local_bulk_args->data_buf;
+            ret_value       = HG_Respond(handle, NULL, NULL, &out);
+            free(local_bulk_args->data_buf);
+            free(local_bulk_args);
         }
+        else {
+            ret_value = HG_Bulk_create(info->hg_class, 1, &(local_bulk_args->data_buf),
+                                       &(local_bulk_args->total_mem_size), HG_BULK_READWRITE,
+                                       &(local_bulk_args->bulk_handle));
+            if (ret_value != HG_SUCCESS) {
+                printf("Error at HG_TEST_RPC_CB(transfer_request, handle): @ line %d ", __LINE__);
+            }
 
-        // This is the actual data transfer. When transfer is finished, we are heading our way to the function
-        // transfer_request_bulk_transfer_cb.
-        ret_value = HG_Bulk_transfer(info->context, transfer_request_bulk_transfer_read_cb, local_bulk_args,
-                                     HG_BULK_PUSH, info->addr, in.local_bulk_handle, 0,
-                                     local_bulk_args->bulk_handle, 0, total_mem_size, HG_OP_ID_IGNORE);
+            // This is the actual data transfer. When transfer is finished, we are heading our way to the
+            // function transfer_request_bulk_transfer_cb.
+            ret_value = HG_Bulk_transfer(info->context, transfer_request_bulk_transfer_read_cb,
+                                         local_bulk_args, HG_BULK_PUSH, info->addr, in.local_bulk_handle, 0,
+                                         local_bulk_args->bulk_handle, 0, total_mem_size, HG_OP_ID_IGNORE);
+        }
         free(remote_reg_info);
     }
     if (ret_value != HG_SUCCESS) {
@@ -5366,6 +6196,279 @@ HG_TEST_RPC_CB(transfer_request, handle)
     }
 #endif
 
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Write or read the first size elements of a 1-D object, the same way region transfer requests do so
+ * the data is found by either path
+ */
+static perr_t
+obj_data_io(uint64_t obj_id, uint64_t obj_dim0, uint64_t size, size_t unit, void *buf, int is_write)
+{
+    perr_t                 ret_value = SUCCEED;
+    struct pdc_region_info region_info;
+    uint64_t               offset = 0;
+
+    FUNC_ENTER(NULL);
+
+    memset(&region_info, 0, sizeof(struct pdc_region_info));
+    region_info.ndim   = 1;
+    region_info.offset = &offset;
+    region_info.size   = &size;
+    region_info.unit   = unit;
+
+#ifdef PDC_SERVER_CACHE
+    if (is_write)
+        ret_value = PDC_transfer_request_data_write_out(obj_id, 1, &obj_dim0, &region_info, buf, unit);
+    else
+        ret_value = PDC_transfer_request_data_read_from(obj_id, 1, &obj_dim0, &region_info, buf, unit);
+#else
+    ret_value = PDC_Server_transfer_request_io(obj_id, 1, &obj_dim0, &region_info, buf, unit, is_write);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+// Finish a fused create-and-write: release the transfer resources and answer the client
+static void
+obj_put_data_finish(struct obj_put_data_args_t *args)
+{
+    FUNC_ENTER(NULL);
+
+    if (args->local_bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(args->local_bulk_handle);
+    HG_Respond(args->handle, NULL, NULL, &args->out);
+    HG_Free_input(args->handle, &args->in);
+    HG_Destroy(args->handle);
+    free(args->buf);
+    free(args);
+
+    FUNC_LEAVE_VOID;
+}
+
+// Create the object if asked to and write its data, the client is answered once the data is stored
+static void
+obj_put_data_apply(struct obj_put_data_args_t *args, void *buf)
+{
+    gen_obj_id_out_t create_out;
+
+    FUNC_ENTER(NULL);
+
+    args->out.obj_id = args->in.obj_id;
+    if (args->in.create) {
+        create_out.obj_id = 0;
+        PDC_insert_metadata_to_hash_table(&args->in.create_in, &create_out);
+        args->out.obj_id = create_out.obj_id;
+    }
+
+    if (args->out.obj_id == 0) {
+        printf("==PDC_SERVER[%d]: %s - cannot create object [%s]\n", get_server_rank(), __func__,
+               args->in.create_in.data.obj_name);
+        args->out.ret = -1;
+    }
+    else if (obj_data_io(args->out.obj_id, args->in.size, args->in.size, 1, buf, 1) != SUCCEED)
+        args->out.ret = -1;
+    else
+        args->out.ret = 1;
+
+    obj_put_data_finish(args);
+
+    FUNC_LEAVE_VOID;
+}
+
+// The data has been pulled from the client
+static hg_return_t
+obj_put_data_pull_cb(const struct hg_cb_info *hg_cb_info)
+{
+    hg_return_t                 ret_value = HG_SUCCESS;
+    struct obj_put_data_args_t *args      = (struct obj_put_data_args_t *)hg_cb_info->arg;
+
+    FUNC_ENTER(NULL);
+
+    if (hg_cb_info->ret != HG_SUCCESS) {
+        printf("==PDC_SERVER[%d]: %s - error pulling object data\n", get_server_rank(), __func__);
+        obj_put_data_finish(args);
+        PGOTO_DONE(HG_PROTOCOL_ERROR);
+    }
+    obj_put_data_apply(args, args->buf);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+/* obj_put_data_cb(hg_handle_t handle) */
+HG_TEST_RPC_CB(obj_put_data, handle)
+{
+    hg_return_t                 ret_value = HG_SUCCESS;
+    const struct hg_info *      hg_info;
+    struct obj_put_data_args_t *args;
+
+    FUNC_ENTER(NULL);
+
+    args = (struct obj_put_data_args_t *)calloc(1, sizeof(struct obj_put_data_args_t));
+    if (args == NULL)
+        PGOTO_ERROR(HG_NOMEM_ERROR, "==PDC_SERVER[%d]: %s - cannot allocate args", get_server_rank(),
+                    __func__);
+    args->handle            = handle;
+    args->local_bulk_handle = HG_BULK_NULL;
+    args->out.ret           = -1;
+
+    ret_value = HG_Get_input(handle, &args->in);
+    if (ret_value != HG_SUCCESS) {
+        HG_Respond(handle, NULL, NULL, &args->out);
+        HG_Destroy(handle);
+        free(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not get input", get_server_rank(), __func__);
+    }
+
+    // Small data came with the request
+    if (args->in.bulk_handle == HG_BULK_NULL) {
+        if (args->in.inline_size != args->in.size) {
+            obj_put_data_finish(args);
+            PGOTO_ERROR(HG_INVALID_ARG, "==PDC_SERVER[%d]: %s - inline data size does not match",
+                        get_server_rank(), __func__);
+        }
+        obj_put_data_apply(args, args->in.inline_buf);
+        PGOTO_DONE(ret_value);
+    }
+
+    args->nbytes = args->in.size;
+    args->buf    = malloc(args->nbytes);
+    hg_info      = HG_Get_info(handle);
+    ret_value    = HG_Bulk_create(hg_info->hg_class, 1, &args->buf, &args->nbytes, HG_BULK_READWRITE,
+                               &args->local_bulk_handle);
+    if (ret_value != HG_SUCCESS) {
+        args->local_bulk_handle = HG_BULK_NULL;
+        obj_put_data_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not create bulk handle", get_server_rank(),
+                    __func__);
+    }
+
+    ret_value = HG_Bulk_transfer(hg_info->context, obj_put_data_pull_cb, args, HG_BULK_PULL, hg_info->addr,
+                                 args->in.bulk_handle, 0, args->local_bulk_handle, 0, args->nbytes,
+                                 HG_OP_ID_IGNORE);
+    if (ret_value != HG_SUCCESS) {
+        obj_put_data_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not pull object data", get_server_rank(),
+                    __func__);
+    }
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+// Finish a fused read: release the transfer resources and answer the client
+static void
+obj_get_data_finish(struct obj_get_data_args_t *args)
+{
+    FUNC_ENTER(NULL);
+
+    if (args->local_bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(args->local_bulk_handle);
+    HG_Respond(args->handle, NULL, NULL, &args->out);
+    HG_Free_input(args->handle, &args->in);
+    HG_Destroy(args->handle);
+    free(args->buf);
+    free(args);
+
+    FUNC_LEAVE_VOID;
+}
+
+// The data has been pushed to the client
+static hg_return_t
+obj_get_data_push_cb(const struct hg_cb_info *hg_cb_info)
+{
+    hg_return_t                 ret_value = HG_SUCCESS;
+    struct obj_get_data_args_t *args      = (struct obj_get_data_args_t *)hg_cb_info->arg;
+
+    FUNC_ENTER(NULL);
+
+    if (hg_cb_info->ret != HG_SUCCESS) {
+        args->out.ret = -1;
+        printf("==PDC_SERVER[%d]: %s - error pushing object data\n", get_server_rank(), __func__);
+    }
+    obj_get_data_finish(args);
+
+    FUNC_LEAVE(ret_value);
+}
+
+/* obj_get_data_cb(hg_handle_t handle) */
+HG_TEST_RPC_CB(obj_get_data, handle)
+{
+    hg_return_t                 ret_value = HG_SUCCESS;
+    const struct hg_info *      hg_info;
+    struct obj_get_data_args_t *args;
+
+    FUNC_ENTER(NULL);
+
+    args = (struct obj_get_data_args_t *)calloc(1, sizeof(struct obj_get_data_args_t));
+    if (args == NULL)
+        PGOTO_ERROR(HG_NOMEM_ERROR, "==PDC_SERVER[%d]: %s - cannot allocate args", get_server_rank(),
+                    __func__);
+    args->handle            = handle;
+    args->local_bulk_handle = HG_BULK_NULL;
+    args->out.ret           = -1;
+
+    ret_value = HG_Get_input(handle, &args->in);
+    if (ret_value != HG_SUCCESS) {
+        HG_Respond(handle, NULL, NULL, &args->out);
+        HG_Destroy(handle);
+        free(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not get input", get_server_rank(), __func__);
+    }
+
+    args->nbytes = args->in.size * args->in.unit;
+    if (args->nbytes == 0 ||
+        (args->in.bulk_handle == HG_BULK_NULL && args->nbytes > PDC_TRANSFER_INLINE_MAX)) {
+        obj_get_data_finish(args);
+        PGOTO_ERROR(HG_INVALID_ARG, "==PDC_SERVER[%d]: %s - invalid read size", get_server_rank(), __func__);
+    }
+
+    args->buf = malloc(args->nbytes);
+    if (args->buf == NULL ||
+        obj_data_io(args->in.obj_id, args->in.obj_dim0, args->in.size, args->in.unit, args->buf, 0) !=
+            SUCCEED) {
+        obj_get_data_finish(args);
+        PGOTO_ERROR(HG_OTHER_ERROR, "==PDC_SERVER[%d]: %s - cannot read object %" PRIu64, get_server_rank(),
+                    __func__, args->in.obj_id);
+    }
+    args->out.ret = 1;
+
+    // Small data goes back with the response
+    if (args->in.bulk_handle == HG_BULK_NULL) {
+        args->out.inline_size = args->nbytes;
+        args->out.inline_buf  = args->buf;
+        obj_get_data_finish(args);
+        PGOTO_DONE(ret_value);
+    }
+
+    hg_info   = HG_Get_info(handle);
+    ret_value = HG_Bulk_create(hg_info->hg_class, 1, &args->buf, &args->nbytes, HG_BULK_READWRITE,
+                               &args->local_bulk_handle);
+    if (ret_value != HG_SUCCESS) {
+        args->local_bulk_handle = HG_BULK_NULL;
+        args->out.ret           = -1;
+        obj_get_data_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not create bulk handle", get_server_rank(),
+                    __func__);
+    }
+
+    ret_value = HG_Bulk_transfer(hg_info->context, obj_get_data_push_cb, args, HG_BULK_PUSH, hg_info->addr,
+                                 args->in.bulk_handle, 0, args->local_bulk_handle, 0, args->nbytes,
+                                 HG_OP_ID_IGNORE);
+    if (ret_value != HG_SUCCESS) {
+        args->out.ret = -1;
+        obj_get_data_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not push object data", get_server_rank(),
+                    __func__);
+    }
+
+done:
     fflush(stdout);
     FUNC_LEAVE(ret_value);
 }
@@ -5449,93 +6552,197 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
-// Bulk
-/* static hg_return_t */
+/*
+ * Page buffers are kept for reuse once their results have been pushed, so paging through a large
+ * query does not allocate per page or per metadata
+ */
+#define PDC_QUERY_PAGE_MAX_SIZE  (64 * 1048576)
+#define PDC_QUERY_PAGE_POOL_SIZE 8
+
+typedef struct query_page_buf_t {
+    char *                   buf;
+    uint64_t                 size;
+    struct query_page_buf_t *next;
+} query_page_buf_t;
+
+static query_page_buf_t *query_page_pool_g   = NULL;
+static int               n_query_page_pool_g = 0;
+#ifdef ENABLE_MULTITHREAD
+static hg_thread_mutex_t query_page_pool_mutex_g = HG_THREAD_MUTEX_INITIALIZER;
+#endif
+
+static query_page_buf_t *
+query_page_buf_get(uint64_t size)
+{
+    query_page_buf_t *page = NULL, *elt;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&query_page_pool_mutex_g);
+#endif
+    LL_FOREACH(query_page_pool_g, elt)
+    {
+        if (elt->size >= size) {
+            page = elt;
+            break;
+        }
+    }
+    if (page != NULL) {
+        LL_DELETE(query_page_pool_g, page);
+        n_query_page_pool_g--;
+    }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&query_page_pool_mutex_g);
+#endif
+
+    if (page == NULL) {
+        page = (query_page_buf_t *)malloc(sizeof(query_page_buf_t));
+        if (page == NULL)
+            return NULL;
+        page->buf  = (char *)malloc(size);
+        page->size = size;
+        if (page->buf == NULL) {
+            free(page);
+            return NULL;
+        }
+    }
+
+    return page;
+}
+
+static void
+query_page_buf_put(query_page_buf_t *page)
+{
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&query_page_pool_mutex_g);
+#endif
+    if (n_query_page_pool_g < PDC_QUERY_PAGE_POOL_SIZE) {
+        LL_PREPEND(query_page_pool_g, page);
+        n_query_page_pool_g++;
+        page = NULL;
+    }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&query_page_pool_mutex_g);
+#endif
+
+    if (page != NULL) {
+        free(page->buf);
+        free(page);
+    }
+}
+
+// Finish a page of a partial query: release the transfer resources and answer the client
+static void
+query_partial_finish(struct query_partial_args_t *args)
+{
+    FUNC_ENTER(NULL);
+
+    if (args->local_bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(args->local_bulk_handle);
+    if (args->page != NULL)
+        query_page_buf_put(args->page);
+    HG_Respond(args->handle, NULL, NULL, &args->out);
+    HG_Free_input(args->handle, &args->in);
+    HG_Destroy(args->handle);
+    free(args);
+
+    FUNC_LEAVE_VOID;
+}
+
+// The page has been pushed to the client
+static hg_return_t
+query_partial_push_cb(const struct hg_cb_info *hg_cb_info)
+{
+    hg_return_t                  ret_value = HG_SUCCESS;
+    struct query_partial_args_t *args      = (struct query_partial_args_t *)hg_cb_info->arg;
+
+    FUNC_ENTER(NULL);
+
+    if (hg_cb_info->ret != HG_SUCCESS) {
+        args->out.ret = -1;
+        printf("==PDC_SERVER[%d]: %s - error pushing query results\n", pdc_server_rank_g, __func__);
+    }
+    query_partial_finish(args);
+
+    FUNC_LEAVE(ret_value);
+}
+
 /* query_partial_cb(hg_handle_t handle) */
 // Server execute
 HG_TEST_RPC_CB(query_partial, handle)
 {
-    hg_return_t                   ret_value = HG_SUCCESS;
-    hg_return_t                   hg_ret;
-    hg_bulk_t                     bulk_handle = HG_BULK_NULL;
-    uint32_t                      i;
-    void **                       buf_ptrs;
-    size_t *                      buf_sizes;
-    uint32_t *                    n_meta_ptr, n_buf;
-    metadata_query_transfer_in_t  in;
-    metadata_query_transfer_out_t out;
+    hg_return_t                  ret_value = HG_SUCCESS;
+    const struct hg_info *       hg_info;
+    struct query_partial_args_t *args;
+    uint64_t                     page_size;
+    uint32_t                     n_meta = 0;
+    hg_size_t                    nbytes;
 
     FUNC_ENTER(NULL);
 
-    // Decode input
-    HG_Get_input(handle, &in);
-
-    out.ret = -1;
+    args = (struct query_partial_args_t *)calloc(1, sizeof(struct query_partial_args_t));
+    if (args == NULL)
+        PGOTO_ERROR(HG_NOMEM_ERROR, "==PDC_SERVER[%d]: %s - cannot allocate args", pdc_server_rank_g,
+                    __func__);
+    args->handle            = handle;
+    args->local_bulk_handle = HG_BULK_NULL;
+    args->out.ret           = -1;
 
-    n_meta_ptr = (uint32_t *)malloc(sizeof(uint32_t));
+    ret_value = HG_Get_input(handle, &args->in);
+    if (ret_value != HG_SUCCESS) {
+        HG_Respond(handle, NULL, NULL, &args->out);
+        HG_Destroy(handle);
+        free(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not get input", pdc_server_rank_g, __func__);
+    }
 
-    PDC_Server_get_partial_query_result(&in, n_meta_ptr, &buf_ptrs);
+    // The page is sized by the client buffer, up to a limit so one query cannot hold too much memory
+    page_size = HG_Bulk_get_size(args->in.bulk_handle);
+    if (page_size > PDC_QUERY_PAGE_MAX_SIZE)
+        page_size = PDC_QUERY_PAGE_MAX_SIZE;
+    args->page = query_page_buf_get(page_size);
+    if (args->page == NULL) {
+        query_partial_finish(args);
+        PGOTO_ERROR(HG_NOMEM_ERROR, "==PDC_SERVER[%d]: %s - cannot allocate page buffer", pdc_server_rank_g,
+                    __func__);
+    }
 
-    // No result found
-    if (*n_meta_ptr == 0) {
-        out.bulk_handle = HG_BULK_NULL;
-        out.ret         = 0;
-        ret_value       = HG_Respond(handle, NULL, NULL, &out);
+    if (PDC_Server_get_partial_query_page(&args->in.query, args->in.cursor, args->in.cursor_minor,
+                                          args->page->buf, page_size, &n_meta, &args->out.nbytes,
+                                          &args->out.next_cursor, &args->out.next_cursor_minor) != SUCCEED) {
+        query_partial_finish(args);
         PGOTO_DONE(ret_value);
     }
+    args->out.ret = n_meta;
 
-    n_buf = *n_meta_ptr;
-
-    buf_sizes = (size_t *)malloc((n_buf + 1) * sizeof(size_t));
-    for (i = 0; i < *n_meta_ptr; i++) {
-        buf_sizes[i] = sizeof(pdc_metadata_t);
-    }
-    // TODO: free buf_sizes
-
-    // Note: it seems Mercury bulk transfer has issues if the total transfer size is less
-    //       than 3862 bytes in Eager Bulk mode, so need to add some padding data
-    /* pdc_metadata_t *padding; */
-    /* if (*n_meta_ptr < 11) { */
-    /*     size_t padding_size; */
-    /*     /1* padding_size = (10 - *n_meta_ptr) * sizeof(pdc_metadata_t); *1/ */
-    /*     padding_size = 5000 * sizeof(pdc_metadata_t); */
-    /*     padding = malloc(padding_size); */
-    /*     memcpy(padding, buf_ptrs[0], sizeof(pdc_metadata_t)); */
-    /*     buf_ptrs[*n_meta_ptr] = padding; */
-    /*     buf_sizes[*n_meta_ptr] = padding_size; */
-    /*     n_buf++; */
-    /* } */
-
-    // Fix when Mercury output in HG_Respond gets too large and cannot be transfered
-    // hg_set_output(): Output size exceeds NA expected message size
-    pdc_metadata_t *large_serial_meta_buf;
-    if (*n_meta_ptr > 80) {
-        large_serial_meta_buf = (pdc_metadata_t *)malloc(sizeof(pdc_metadata_t) * (*n_meta_ptr));
-        for (i = 0; i < *n_meta_ptr; i++) {
-            memcpy(&large_serial_meta_buf[i], buf_ptrs[i], sizeof(pdc_metadata_t));
-        }
-        buf_ptrs[0]  = large_serial_meta_buf;
-        buf_sizes[0] = sizeof(pdc_metadata_t) * (*n_meta_ptr);
-        n_buf        = 1;
+    // No result in this page
+    if (n_meta == 0) {
+        query_partial_finish(args);
+        PGOTO_DONE(ret_value);
     }
 
-    // Create bulk handle
-    hg_ret =
-        HG_Bulk_create(hg_class_g, n_buf, buf_ptrs, (hg_size_t *)buf_sizes, HG_BULK_READ_ONLY, &bulk_handle);
-    if (hg_ret != HG_SUCCESS)
-        PGOTO_ERROR(HG_OTHER_ERROR, "Could not create bulk data handle");
-
-    // Fill bulk handle and return number of metadata that satisfy the query
-    out.bulk_handle = bulk_handle;
-    out.ret         = *n_meta_ptr;
+    nbytes    = args->out.nbytes;
+    ret_value = HG_Bulk_create(hg_class_g, 1, (void **)&args->page->buf, &nbytes, HG_BULK_READ_ONLY,
+                               &args->local_bulk_handle);
+    if (ret_value != HG_SUCCESS) {
+        args->out.ret = -1;
+        query_partial_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not create bulk handle", pdc_server_rank_g,
+                    __func__);
+    }
 
-    // Send bulk handle to client
-    ret_value = HG_Respond(handle, NULL, NULL, &out);
+    hg_info   = HG_Get_info(handle);
+    ret_value = HG_Bulk_transfer(hg_info->context, query_partial_push_cb, args, HG_BULK_PUSH, hg_info->addr,
+                                 args->in.bulk_handle, 0, args->local_bulk_handle, 0, nbytes,
+                                 HG_OP_ID_IGNORE);
+    if (ret_value != HG_SUCCESS) {
+        args->out.ret = -1;
+        query_partial_finish(args);
+        PGOTO_ERROR(ret_value, "==PDC_SERVER[%d]: %s - could not push query results", pdc_server_rank_g,
+                    __func__);
+    }
 
 done:
     fflush(stdout);
-    HG_Free_input(handle, &in);
-    HG_Destroy(handle);
 
     FUNC_LEAVE(ret_value);
 }
@@ -5550,7 +6757,7 @@ HG_TEST_RPC_CB(query_kvtag, handle)
     uint64_t *                    buf_ptr;
     size_t                        buf_size[1];
     uint32_t                      nmeta;
-    pdc_kvtag_t                   in;
+    kvtag_query_in_t              in;
     metadata_query_transfer_out_t out;
 
     FUNC_ENTER(NULL);
@@ -5706,6 +6913,36 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * IO info of a data server request. The request is served after its RPC input is freed, so the object
+ * name and tags of its metadata are copied after the struct.
+ */
+static data_server_io_info_t *
+data_server_io_info_new(pdc_metadata_transfer_t *transfer)
+{
+    data_server_io_info_t *io_info;
+    pdc_metadata_t         meta;
+    size_t                 name_len, tags_len;
+    char *                 strs;
+
+    PDC_metadata_init(&meta);
+    PDC_transfer_t_to_metadata_t(transfer, &meta);
+    name_len = strlen(meta.obj_name) + 1;
+    tags_len = strlen(meta.tags) + 1;
+
+    io_info = (data_server_io_info_t *)malloc(sizeof(data_server_io_info_t) + name_len + tags_len);
+    if (io_info == NULL)
+        return NULL;
+    strs = (char *)(io_info + 1);
+    memcpy(strs, meta.obj_name, name_len);
+    memcpy(strs + name_len, meta.tags, tags_len);
+    io_info->meta          = meta;
+    io_info->meta.obj_name = strs;
+    io_info->meta.tags     = strs + name_len;
+
+    return io_info;
+}
+
 // READ
 /* static hg_return_t */
 // data_server_read_cb(hg_handle_t handle)
@@ -5720,7 +6957,7 @@ HG_TEST_RPC_CB(data_server_read, handle)
     // Decode input
     HG_Get_input(handle, &in);
 
-    data_server_io_info_t *io_info = (data_server_io_info_t *)malloc(sizeof(data_server_io_info_t));
+    data_server_io_info_t *io_info = data_server_io_info_new(&in.meta);
 
     io_info->io_type          = PDC_READ;
     io_info->client_id        = in.client_id;
@@ -5728,9 +6965,6 @@ HG_TEST_RPC_CB(data_server_read, handle)
     io_info->nbuffer_request  = in.nupdate;
     io_info->cache_percentage = in.cache_percentage;
 
-    PDC_metadata_init(&io_info->meta);
-    PDC_transfer_t_to_metadata_t(&(in.meta), &(io_info->meta));
-
     PDC_init_region_list(&(io_info->region));
     PDC_region_transfer_t_to_list_t(&(in.region), &(io_info->region));
 
@@ -5765,16 +6999,13 @@ HG_TEST_RPC_CB(data_server_write, handle)
 
     HG_Get_input(handle, &in);
 
-    data_server_io_info_t *io_info = (data_server_io_info_t *)malloc(sizeof(data_server_io_info_t));
+    data_server_io_info_t *io_info = data_server_io_info_new(&in.meta);
 
     io_info->io_type         = PDC_WRITE;
     io_info->client_id       = in.client_id;
     io_info->nclient         = in.nclient;
     io_info->nbuffer_request = in.nupdate;
 
-    PDC_metadata_init(&io_info->meta);
-    PDC_transfer_t_to_metadata_t(&(in.meta), &(io_info->meta));
-
     PDC_init_region_list(&(io_info->region));
     PDC_region_transfer_t_to_list_t(&(in.region), &(io_info->region));
 
@@ -6798,9 +8029,14 @@ HG_TEST_RPC_CB(send_shm, handle)
     shm_info            = (pdc_shm_info_t *)calloc(sizeof(pdc_shm_info_t), 1);
     shm_info->client_id = in.client_id;
     shm_info->size      = in.size;
-    strcpy(shm_info->shm_addr, in.shm_addr);
+    shm_info->token     = in.token;
+    strncpy(shm_info->shm_addr, in.shm_addr, ADDR_MAX - 1);
 
-    out.ret   = 1;
+    // Map the arena before acknowledging, so the client knows whether it can use it
+    if (PDC_Server_attach_client_shm(shm_info) == SUCCEED)
+        out.ret = 1;
+    else
+        out.ret = 0;
     ret_value = HG_Respond(handle, PDC_Server_recv_shm_cb, shm_info, &out);
 
     ret_value = HG_Free_input(handle, &in);
@@ -6809,6 +8045,26 @@ HG_TEST_RPC_CB(send_shm, handle)
     FUNC_LEAVE(ret_value);
 }
 
+/* detach_shm_cb(hg_handle_t handle) */
+HG_TEST_RPC_CB(detach_shm, handle)
+{
+    hg_return_t   ret_value = HG_SUCCESS;
+    send_shm_in_t in;
+    pdc_int_ret_t out;
+
+    FUNC_ENTER(NULL);
+
+    HG_Get_input(handle, &in);
+
+    out.ret   = PDC_Server_detach_client_shm(in.token) == SUCCEED ? 1 : 0;
+    ret_value = HG_Respond(handle, NULL, NULL, &out);
+
+    HG_Free_input(handle, &in);
+    HG_Destroy(handle);
+
+    FUNC_LEAVE(ret_value);
+}
+
 static hg_return_t
 query_read_obj_name_client_bulk_cb(const struct hg_cb_info *hg_cb_info)
 {
@@ -7304,6 +8560,9 @@ done:
 
 HG_TEST_THREAD_CB(server_lookup_client)
 HG_TEST_THREAD_CB(gen_obj_id)
+HG_TEST_THREAD_CB(gen_obj_id_many)
+HG_TEST_THREAD_CB(kvtag_many)
+HG_TEST_THREAD_CB(meta_store_stats)
 HG_TEST_THREAD_CB(gen_cont_id)
 HG_TEST_THREAD_CB(cont_add_del_objs_rpc)
 HG_TEST_THREAD_CB(cont_add_tags_rpc)
@@ -7313,6 +8572,7 @@ HG_TEST_THREAD_CB(get_storage_meta_name_query_bulk_result_rpc)
 HG_TEST_THREAD_CB(notify_client_multi_io_complete_rpc)
 HG_TEST_THREAD_CB(server_checkpoint_rpc)
 HG_TEST_THREAD_CB(send_shm)
+HG_TEST_THREAD_CB(detach_shm)
 HG_TEST_THREAD_CB(client_test_connect)
 HG_TEST_THREAD_CB(metadata_query)
 HG_TEST_THREAD_CB(container_query)
@@ -7346,6 +8606,8 @@ HG_TEST_THREAD_CB(buf_map)
 HG_TEST_THREAD_CB(transfer_request)
 HG_TEST_THREAD_CB(transfer_request_status)
 HG_TEST_THREAD_CB(transfer_request_wait)
+HG_TEST_THREAD_CB(obj_put_data)
+HG_TEST_THREAD_CB(obj_get_data)
 HG_TEST_THREAD_CB(get_remote_metadata)
 HG_TEST_THREAD_CB(buf_map_server)
 HG_TEST_THREAD_CB(buf_unmap_server)
@@ -7381,6 +8643,8 @@ HG_TEST_THREAD_CB(send_read_sel_obj_id_rpc)
     }
 
 PDC_FUNC_DECLARE_REGISTER(gen_obj_id)
+PDC_FUNC_DECLARE_REGISTER(gen_obj_id_many)
+PDC_FUNC_DECLARE_REGISTER(kvtag_many)
 PDC_FUNC_DECLARE_REGISTER(gen_cont_id)
 PDC_FUNC_DECLARE_REGISTER(server_lookup_client)
 PDC_FUNC_DECLARE_REGISTER(server_lookup_remote_server)
@@ -7403,6 +8667,8 @@ PDC_FUNC_DECLARE_REGISTER(close_server)
 PDC_FUNC_DECLARE_REGISTER(transfer_request)
 PDC_FUNC_DECLARE_REGISTER(transfer_request_wait)
 PDC_FUNC_DECLARE_REGISTER(transfer_request_status)
+PDC_FUNC_DECLARE_REGISTER(obj_put_data)
+PDC_FUNC_DECLARE_REGISTER(obj_get_data)
 PDC_FUNC_DECLARE_REGISTER(buf_map)
 PDC_FUNC_DECLARE_REGISTER(get_remote_metadata)
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(buf_map_server, buf_map_in_t, buf_map_out_t)
@@ -7414,8 +8680,8 @@ PDC_FUNC_DECLARE_REGISTER_IN_OUT(transform_region_release, region_transform_and_
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(region_transform_release, region_transform_and_lock_in_t, region_lock_out_t)
 
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(region_analysis_release, region_analysis_and_lock_in_t, region_lock_out_t)
-PDC_FUNC_DECLARE_REGISTER_IN_OUT(query_partial, metadata_query_transfer_in_t, metadata_query_transfer_out_t)
-PDC_FUNC_DECLARE_REGISTER_IN_OUT(query_kvtag, pdc_kvtag_t, metadata_query_transfer_out_t)
+PDC_FUNC_DECLARE_REGISTER_IN_OUT(query_partial, metadata_query_page_in_t, metadata_query_page_out_t)
+PDC_FUNC_DECLARE_REGISTER_IN_OUT(query_kvtag, kvtag_query_in_t, metadata_query_transfer_out_t)
 PDC_FUNC_DECLARE_REGISTER(bulk_rpc)
 PDC_FUNC_DECLARE_REGISTER(data_server_read)
 PDC_FUNC_DECLARE_REGISTER(data_server_write)
@@ -7430,7 +8696,9 @@ PDC_FUNC_DECLARE_REGISTER_IN_OUT(storage_meta_name_query_rpc, storage_meta_name_
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(get_storage_meta_name_query_bulk_result_rpc, bulk_rpc_in_t, pdc_int_ret_t)
 
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(server_checkpoint_rpc, pdc_int_send_t, pdc_int_ret_t)
+PDC_FUNC_DECLARE_REGISTER_IN_OUT(meta_store_stats, pdc_int_send_t, meta_store_stats_out_t)
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(send_shm, send_shm_in_t, pdc_int_ret_t)
+PDC_FUNC_DECLARE_REGISTER_IN_OUT(detach_shm, send_shm_in_t, pdc_int_ret_t)
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(cont_add_tags_rpc, cont_add_tags_rpc_in_t, pdc_int_ret_t)
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(notify_client_multi_io_complete_rpc, bulk_rpc_in_t, pdc_int_ret_t)
 PDC_FUNC_DECLARE_REGISTER_IN_OUT(send_client_storage_meta_rpc, bulk_rpc_in_t, pdc_int_ret_t)
@@ -7682,10 +8950,11 @@ PDC_create_shm_segment_ind(uint64_t size, char *shm_addr, void **buf)
 
     /* create the shared memory segment as if it was a file */
     retry = 0;
-    srand(time(0));
+    // Clients on the same node start at the same time, mix in the pid so they do not pick the same name
+    srand(time(0) ^ getpid());
     while (retry < PDC_MAX_TRIAL_NUM) {
         snprintf(shm_addr, ADDR_MAX, "/PDCshm%d", rand());
-        shm_fd = shm_open(shm_addr, O_CREAT | O_RDWR, 0666);
+        shm_fd = shm_open(shm_addr, O_CREAT | O_EXCL | O_RDWR, 0666);
         if (shm_fd != -1)
             break;
         retry++;
@@ -7696,14 +8965,18 @@ PDC_create_shm_segment_ind(uint64_t size, char *shm_addr, void **buf)
 
     /* configure the size of the shared memory segment */
     if (ftruncate(shm_fd, size) != 0) {
+        close(shm_fd);
+        shm_unlink(shm_addr);
         PGOTO_ERROR(FAIL, "== Truncate memory failed");
     }
 
     /* map the shared memory segment to the address space of the process */
     *buf = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
-    if (*buf == MAP_FAILED)
+    close(shm_fd);
+    if (*buf == MAP_FAILED) {
+        shm_unlink(shm_addr);
         PGOTO_ERROR(FAIL, "== Shared memory mmap failed [%s]\n", shm_addr);
-    // close and shm_unlink?
+    }
 
 done:
     fflush(stdout);
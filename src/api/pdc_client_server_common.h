@@ -76,6 +76,13 @@ hg_thread_mutex_t meta_obj_map_mutex_g;
 #define PDC_SEQ_ID_INIT_VALUE        1000
 #define PDC_UPDATE_CACHE             111
 #define PDC_UPDATE_STORAGE           101
+#define PDC_SHM_ARENA_MAGIC          0x504443534841524eULL
+#define PDC_SHM_ARENA_ALIGN          64
+#define PDC_SHM_ARENA_DEFAULT_MB     128
+#define PDC_TRANSFER_INLINE_MAX      2048
+#define PDC_HASH_RING_NVNODE         128
+#define PDC_HASH_RING_BUCKET_BITS    16
+#define PDC_HASH_RING_NBUCKET        (1 << PDC_HASH_RING_BUCKET_BITS)
 
 #define pdc_server_cfg_name_g "server.cfg"
 
@@ -85,7 +92,6 @@ hg_thread_mutex_t meta_obj_map_mutex_g;
 /*******************/
 /* Local Variables */
 /*******************/
-extern uint64_t          pdc_id_seq_g;
 extern int               pdc_server_rank_g;
 extern hg_atomic_int32_t close_server_g;
 
@@ -248,6 +254,19 @@ typedef struct region_list_t {
     // NOTE: when modified, need to change init and deep_cp routines
 } region_list_t;
 
+// Compact record of a region stored in a server data file, region_list_t carries the I/O state
+typedef struct region_extent_t {
+    size_t   ndim;
+    uint64_t start[DIM_MAX];
+    uint64_t count[DIM_MAX];
+    uint64_t offset;    // in the data file
+    uint64_t data_size; // in bytes
+    uint32_t file_id;   // index into the server's file table
+
+    struct region_extent_t *prev;
+    struct region_extent_t *next;
+} region_extent_t;
+
 // Similar structure PDC_region_info_t defined in pdc_obj_pkg.h
 // TODO: currently only support upto four dimensions
 typedef struct region_info_transfer_t {
@@ -375,7 +394,7 @@ typedef struct data_server_region_t {
     // For region map
     region_map_t *region_map_head;
     // For region storage
-    region_list_t *region_storage_head;
+    region_extent_t *region_storage_head;
     // For non-mapped object analysis
     // Used primarily as a local_temp
     void *                       obj_data_ptr;
@@ -395,11 +414,14 @@ typedef struct data_server_region_unmap_t {
 } data_server_region_unmap_t;
 
 // For storing metadata
+// The app name and data location are interned with PDC_str_intern and must not be freed. The object
+// name and tags are owned by the record on the server (see PDC_Server_metadata_set_strings) and follow
+// the struct in the same allocation on the client (see PDC_metadata_dup)
 typedef struct pdc_metadata_t {
-    int  user_id; // Both server and client gets it and do security check
-    char app_name[ADDR_MAX];
-    char obj_name[ADDR_MAX];
-    int  time_step;
+    int         user_id; // Both server and client gets it and do security check
+    const char *app_name;
+    const char *obj_name;
+    int         time_step;
     // Above four are the unique identifier for objects
 
     pdc_var_type_t data_type;
@@ -408,9 +430,9 @@ typedef struct pdc_metadata_t {
     time_t         create_time;
     time_t         last_modified_time;
 
-    char              tags[TAG_LEN_MAX];
+    const char *      tags;
     pdc_kvtag_list_t *kvtag_list_head;
-    char              data_location[ADDR_MAX];
+    const char *      data_location;
 
     size_t   ndim;
     uint64_t dims[DIM_MAX];
@@ -511,6 +533,23 @@ typedef struct {
     pdc_kvtag_t kvtag;
 } metadata_add_kvtag_in_t;
 
+/* Match condition of a kvtag query */
+typedef enum {
+    PDC_KVTAG_EQ     = 0, /* value is equal, any value if the query value is " " */
+    PDC_KVTAG_PREFIX = 1, /* value starts with the query bytes                   */
+    PDC_KVTAG_LT     = 2, /* value is less than the query value                  */
+    PDC_KVTAG_LTE    = 3, /* value is less than or equal to the query value      */
+    PDC_KVTAG_GT     = 4, /* value is greater than the query value               */
+    PDC_KVTAG_GTE    = 5  /* value is greater than or equal to the query value   */
+} pdc_kvtag_op_t;
+
+/* Define kvtag_query_in_t */
+typedef struct {
+    pdc_kvtag_t kvtag;
+    int32_t     op;
+    int32_t     type;
+} kvtag_query_in_t;
+
 /* Define metadata_del_kvtag_in_t */
 typedef struct {
     uint64_t    obj_id;
@@ -563,13 +602,22 @@ typedef struct {
     uint32_t client_id;
     char     shm_addr[ADDR_MAX];
     uint64_t size;
+    uint64_t token;
 } pdc_shm_info_t;
 
+/* Header at the start of a client shared memory arena, checked by the server when it is attached */
+typedef struct {
+    uint64_t magic;
+    uint64_t size;
+    uint64_t token;
+} pdc_shm_arena_header_t;
+
 /* Define send_shm_in_t */
 typedef struct {
     uint32_t    client_id;
     hg_string_t shm_addr;
     uint64_t    size;
+    uint64_t    token; // identifies the arena of one client process, MPI ranks repeat across applications
 } send_shm_in_t;
 
 /* Define region_lock_in_t */
@@ -654,6 +702,22 @@ typedef struct {
     hg_bulk_t bulk_handle;
 } metadata_query_transfer_out_t;
 
+/* Define metadata_query_page_in_t */
+typedef struct {
+    metadata_query_transfer_in_t query;
+    uint64_t                     cursor;       // position to resume from, 0 for the first page
+    uint64_t                     cursor_minor; // second part of a position made of two keys
+    hg_bulk_t                    bulk_handle;  // client page buffer the results are pushed into
+} metadata_query_page_in_t;
+
+/* Define metadata_query_page_out_t */
+typedef struct {
+    int32_t  ret; // number of metadata in the page, -1 on error
+    uint64_t nbytes;
+    uint64_t next_cursor; // 0 once the server has no more results
+    uint64_t next_cursor_minor;
+} metadata_query_page_out_t;
+
 /* Define gen_obj_id_in_t */
 typedef struct {
     pdc_metadata_transfer_t data;
@@ -666,6 +730,68 @@ typedef struct {
     uint64_t obj_id;
 } gen_obj_id_out_t;
 
+/* Define gen_obj_id_many_in_t */
+/* The bulk buffer holds n_obj uint64_t IDs filled by the server, n_obj uint32_t name hashes and the
+ * NUL-terminated names back to back; all objects share the properties in data */
+typedef struct {
+    pdc_metadata_transfer_t data;
+    int8_t                  data_type;
+    uint32_t                n_obj;
+    hg_bulk_t               bulk_handle;
+} gen_obj_id_many_in_t;
+
+/* Define gen_obj_id_many_out_t */
+typedef struct {
+    int32_t  ret;
+    uint32_t n_created;
+} gen_obj_id_many_out_t;
+
+/* Operations of a kvtag_many request */
+#define PDC_KVTAG_MANY_ADD 0
+#define PDC_KVTAG_MANY_GET 1
+#define PDC_KVTAG_MANY_DEL 2
+
+/* Header of each entry of a kvtag_many request, followed by the NUL-terminated name of name_len bytes
+ * and, for an add, the value of value_size bytes */
+typedef struct {
+    uint64_t obj_id;
+    uint32_t hash_value;
+    uint32_t name_len;
+    uint32_t value_size;
+} kvtag_many_entry_t;
+
+/* Define kvtag_many_in_t */
+/* The first req_size bytes of the bulk buffer hold the n_entry requests back to back, the server writes
+ * the responses after them: an int32_t status per entry, 1 on success, 0 for a get of a missing tag and
+ * -1 if the object is not found, followed for a get by the uint32_t value size and the value */
+typedef struct {
+    int32_t   op;
+    uint32_t  n_entry;
+    uint64_t  req_size;
+    hg_bulk_t bulk_handle;
+} kvtag_many_in_t;
+
+/* Define kvtag_many_out_t */
+/* ret is 0 if the responses need resp_size bytes and did not fit after the requests */
+typedef struct {
+    int32_t  ret;
+    uint32_t n_done;
+    uint64_t resp_size;
+} kvtag_many_out_t;
+
+/* Define meta_store_stats_out_t */
+/* Occupancy of the kvtag store of a server, see pdc_meta_store_stats_t, all 0 but total_mem_size if the
+ * store is disabled */
+typedef struct {
+    uint64_t n_obj;
+    uint64_t n_resident;
+    uint64_t mem_size;
+    uint64_t cache_size;
+    uint64_t n_load;
+    uint64_t n_evict;
+    uint64_t total_mem_size;
+} meta_store_stats_out_t;
+
 /* Define server_lookup_client_in_t */
 typedef struct {
     int32_t     server_id;
@@ -775,15 +901,60 @@ typedef struct {
     size_t                 remote_unit;
     int32_t                obj_ndim;
     uint32_t               meta_server_id;
+    uint64_t               shm_token;
+    uint64_t               shm_offset;
+    uint32_t               inline_size;
+    char *                 inline_buf;
 
     uint8_t access_type;
+    uint8_t use_shm;
+    uint8_t use_inline;
 } transfer_request_in_t;
 /* Define transfer_request_out_t */
 typedef struct {
     uint64_t metadata_id;
     int32_t  ret;
+    uint32_t inline_size;
+    char *   inline_buf;
 } transfer_request_out_t;
 
+/* Define obj_put_data_in_t */
+/* Writes the whole data of a 1-D PDC_CHAR object of size bytes in one request to the data server of the
+ * client. If create is set that server also holds the metadata of the name and first creates the object
+ * from create_in, otherwise obj_id is the existing object. Up to PDC_TRANSFER_INLINE_MAX bytes travel
+ * in inline_buf, larger data is pulled through bulk_handle */
+typedef struct {
+    gen_obj_id_in_t create_in;
+    uint8_t         create;
+    uint64_t        obj_id;
+    uint64_t        size;
+    hg_bulk_t       bulk_handle;
+    uint32_t        inline_size;
+    char *          inline_buf;
+} obj_put_data_in_t;
+/* Define obj_put_data_out_t */
+typedef struct {
+    uint64_t obj_id;
+    int32_t  ret;
+} obj_put_data_out_t;
+
+/* Define obj_get_data_in_t */
+/* Reads the first size elements of unit bytes of a 1-D object in one request. The data comes back in
+ * the response if bulk_handle is HG_BULK_NULL, otherwise it is pushed through bulk_handle */
+typedef struct {
+    uint64_t  obj_id;
+    uint64_t  obj_dim0;
+    uint64_t  size;
+    uint32_t  unit;
+    hg_bulk_t bulk_handle;
+} obj_get_data_in_t;
+/* Define obj_get_data_out_t */
+typedef struct {
+    int32_t  ret;
+    uint32_t inline_size;
+    char *   inline_buf;
+} obj_get_data_out_t;
+
 /* Define buf_map_in_t */
 typedef struct {
     uint32_t               meta_server_id;
@@ -1482,6 +1653,66 @@ hg_proc_metadata_query_transfer_out_t(hg_proc_t proc, void *data)
     return ret;
 }
 
+/* Define hg_proc_metadata_query_page_in_t */
+static HG_INLINE hg_return_t
+hg_proc_metadata_query_page_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t               ret;
+    metadata_query_page_in_t *struct_data = (metadata_query_page_in_t *)data;
+
+    ret = hg_proc_metadata_query_transfer_in_t(proc, &struct_data->query);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->cursor);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->cursor_minor);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_hg_bulk_t(proc, &struct_data->bulk_handle);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
+/* Define hg_proc_metadata_query_page_out_t */
+static HG_INLINE hg_return_t
+hg_proc_metadata_query_page_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t                ret;
+    metadata_query_page_out_t *struct_data = (metadata_query_page_out_t *)data;
+
+    ret = hg_proc_int32_t(proc, &struct_data->ret);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->nbytes);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->next_cursor);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->next_cursor_minor);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
 /* Define hg_proc_pdc_metadata_transfer_t */
 static hg_return_t
 hg_proc_pdc_metadata_transfer_t(hg_proc_t proc, void *data)
@@ -1695,6 +1926,32 @@ hg_proc_metadata_get_kvtag_out_t(hg_proc_t proc, void *data)
     return ret;
 }
 
+/* Define hg_proc_kvtag_query_in_t */
+static HG_INLINE hg_return_t
+hg_proc_kvtag_query_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t       ret;
+    kvtag_query_in_t *struct_data = (kvtag_query_in_t *)data;
+
+    ret = hg_proc_pdc_kvtag_t(proc, &struct_data->kvtag);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_int32_t(proc, &struct_data->op);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_int32_t(proc, &struct_data->type);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+
+    return ret;
+}
+
 static HG_INLINE hg_return_t
 hg_proc_metadata_add_kvtag_in_t(hg_proc_t proc, void *data)
 {
@@ -1945,6 +2202,156 @@ hg_proc_gen_obj_id_out_t(hg_proc_t proc, void *data)
     return ret;
 }
 
+/* Define hg_proc_gen_obj_id_many_in_t */
+static HG_INLINE hg_return_t
+hg_proc_gen_obj_id_many_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t           ret;
+    gen_obj_id_many_in_t *struct_data = (gen_obj_id_many_in_t *)data;
+
+    ret = hg_proc_pdc_metadata_transfer_t(proc, &struct_data->data);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_int8_t(proc, &struct_data->data_type);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->n_obj);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_hg_bulk_t(proc, &struct_data->bulk_handle);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
+/* Define hg_proc_gen_obj_id_many_out_t */
+static HG_INLINE hg_return_t
+hg_proc_gen_obj_id_many_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t            ret;
+    gen_obj_id_many_out_t *struct_data = (gen_obj_id_many_out_t *)data;
+
+    ret = hg_proc_int32_t(proc, &struct_data->ret);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->n_created);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
+/* Define hg_proc_kvtag_many_in_t */
+static HG_INLINE hg_return_t
+hg_proc_kvtag_many_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t      ret;
+    kvtag_many_in_t *struct_data = (kvtag_many_in_t *)data;
+
+    ret = hg_proc_int32_t(proc, &struct_data->op);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->n_entry);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->req_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_hg_bulk_t(proc, &struct_data->bulk_handle);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
+/* Define hg_proc_kvtag_many_out_t */
+static HG_INLINE hg_return_t
+hg_proc_kvtag_many_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t       ret;
+    kvtag_many_out_t *struct_data = (kvtag_many_out_t *)data;
+
+    ret = hg_proc_int32_t(proc, &struct_data->ret);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->n_done);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->resp_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
+/* Define hg_proc_meta_store_stats_out_t */
+static HG_INLINE hg_return_t
+hg_proc_meta_store_stats_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t             ret;
+    meta_store_stats_out_t *struct_data = (meta_store_stats_out_t *)data;
+
+    ret = hg_proc_uint64_t(proc, &struct_data->n_obj);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->n_resident);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->mem_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->cache_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->n_load);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->n_evict);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->total_mem_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
 /* Define hg_proc_server_lookup_remote_server_in_t */
 static HG_INLINE hg_return_t
 hg_proc_server_lookup_remote_server_in_t(hg_proc_t proc, void *data)
@@ -2404,11 +2811,50 @@ hg_proc_transfer_request_in_t(hg_proc_t proc, void *data)
         // HG_LOG_ERROR("Proc error");
         return ret;
     }
+    ret = hg_proc_uint64_t(proc, &struct_data->shm_token);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->shm_offset);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
     ret = hg_proc_uint8_t(proc, &struct_data->access_type);
     if (ret != HG_SUCCESS) {
         // HG_LOG_ERROR("Proc error");
         return ret;
     }
+    ret = hg_proc_uint8_t(proc, &struct_data->use_shm);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint8_t(proc, &struct_data->use_inline);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->inline_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    if (struct_data->inline_size) {
+        switch (hg_proc_get_op(proc)) {
+            case HG_DECODE:
+                struct_data->inline_buf = malloc(struct_data->inline_size);
+                /* FALLTHRU */
+            case HG_ENCODE:
+                ret = hg_proc_raw(proc, struct_data->inline_buf, struct_data->inline_size);
+                break;
+            case HG_FREE:
+                free(struct_data->inline_buf);
+            default:
+                break;
+        }
+    }
     return ret;
 }
 
@@ -2429,6 +2875,168 @@ hg_proc_transfer_request_out_t(hg_proc_t proc, void *data)
         // HG_LOG_ERROR("Proc error");
         return ret;
     }
+    ret = hg_proc_uint32_t(proc, &struct_data->inline_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    if (struct_data->inline_size) {
+        switch (hg_proc_get_op(proc)) {
+            case HG_DECODE:
+                struct_data->inline_buf = malloc(struct_data->inline_size);
+                /* FALLTHRU */
+            case HG_ENCODE:
+                ret = hg_proc_raw(proc, struct_data->inline_buf, struct_data->inline_size);
+                break;
+            case HG_FREE:
+                free(struct_data->inline_buf);
+            default:
+                break;
+        }
+    }
+    return ret;
+}
+
+/* Define hg_proc_obj_put_data_in_t */
+static HG_INLINE hg_return_t
+hg_proc_obj_put_data_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t        ret;
+    obj_put_data_in_t *struct_data = (obj_put_data_in_t *)data;
+
+    ret = hg_proc_gen_obj_id_in_t(proc, &struct_data->create_in);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint8_t(proc, &struct_data->create);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->obj_id);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_hg_bulk_t(proc, &struct_data->bulk_handle);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->inline_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    if (struct_data->inline_size) {
+        switch (hg_proc_get_op(proc)) {
+            case HG_DECODE:
+                struct_data->inline_buf = malloc(struct_data->inline_size);
+                /* FALLTHRU */
+            case HG_ENCODE:
+                ret = hg_proc_raw(proc, struct_data->inline_buf, struct_data->inline_size);
+                break;
+            case HG_FREE:
+                free(struct_data->inline_buf);
+            default:
+                break;
+        }
+    }
+    return ret;
+}
+
+/* Define hg_proc_obj_put_data_out_t */
+static HG_INLINE hg_return_t
+hg_proc_obj_put_data_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t         ret;
+    obj_put_data_out_t *struct_data = (obj_put_data_out_t *)data;
+
+    ret = hg_proc_uint64_t(proc, &struct_data->obj_id);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_int32_t(proc, &struct_data->ret);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
+/* Define hg_proc_obj_get_data_in_t */
+static HG_INLINE hg_return_t
+hg_proc_obj_get_data_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t        ret;
+    obj_get_data_in_t *struct_data = (obj_get_data_in_t *)data;
+
+    ret = hg_proc_uint64_t(proc, &struct_data->obj_id);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->obj_dim0);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint64_t(proc, &struct_data->size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->unit);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_hg_bulk_t(proc, &struct_data->bulk_handle);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    return ret;
+}
+
+/* Define hg_proc_obj_get_data_out_t */
+static HG_INLINE hg_return_t
+hg_proc_obj_get_data_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t         ret;
+    obj_get_data_out_t *struct_data = (obj_get_data_out_t *)data;
+
+    ret = hg_proc_int32_t(proc, &struct_data->ret);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    ret = hg_proc_uint32_t(proc, &struct_data->inline_size);
+    if (ret != HG_SUCCESS) {
+        // HG_LOG_ERROR("Proc error");
+        return ret;
+    }
+    if (struct_data->inline_size) {
+        switch (hg_proc_get_op(proc)) {
+            case HG_DECODE:
+                struct_data->inline_buf = malloc(struct_data->inline_size);
+                /* FALLTHRU */
+            case HG_ENCODE:
+                ret = hg_proc_raw(proc, struct_data->inline_buf, struct_data->inline_size);
+                break;
+            case HG_FREE:
+                free(struct_data->inline_buf);
+            default:
+                break;
+        }
+    }
     return ret;
 }
 
@@ -3377,6 +3985,32 @@ struct bulk_args_t {
     hg_atomic_int32_t completed_transfers;
 };
 
+struct gen_obj_id_many_args_t {
+    hg_handle_t           handle;
+    gen_obj_id_many_in_t  in;
+    gen_obj_id_many_out_t out;
+    hg_bulk_t             local_bulk_handle;
+    void *                buf;
+    hg_size_t             nbytes;
+};
+
+struct kvtag_many_args_t {
+    hg_handle_t      handle;
+    kvtag_many_in_t  in;
+    kvtag_many_out_t out;
+    hg_bulk_t        local_bulk_handle;
+    void *           buf;
+    hg_size_t        nbytes;
+};
+
+struct query_partial_args_t {
+    hg_handle_t               handle;
+    metadata_query_page_in_t  in;
+    metadata_query_page_out_t out;
+    hg_bulk_t                 local_bulk_handle;
+    struct query_page_buf_t * page;
+};
+
 struct buf_map_release_bulk_args {
 #ifdef PDC_TIMING
     double start_time;
@@ -3477,6 +4111,24 @@ struct transfer_request_local_bulk_args {
 #endif
 };
 
+struct obj_put_data_args_t {
+    hg_handle_t        handle;
+    obj_put_data_in_t  in;
+    obj_put_data_out_t out;
+    hg_bulk_t          local_bulk_handle;
+    void *             buf;
+    hg_size_t          nbytes;
+};
+
+struct obj_get_data_args_t {
+    hg_handle_t        handle;
+    obj_get_data_in_t  in;
+    obj_get_data_out_t out;
+    hg_bulk_t          local_bulk_handle;
+    void *             buf;
+    hg_size_t          nbytes;
+};
+
 struct region_update_bulk_args {
     hg_atomic_int32_t      refcount; // to track how many unlocked mapped region for data transfer
     hg_handle_t            handle;
@@ -3550,6 +4202,9 @@ typedef struct storage_regions_args_t {
 /* Library-private Function Prototypes */
 /***************************************/
 hg_id_t PDC_gen_obj_id_register(hg_class_t *hg_class);
+hg_id_t PDC_gen_obj_id_many_register(hg_class_t *hg_class);
+hg_id_t PDC_kvtag_many_register(hg_class_t *hg_class);
+hg_id_t PDC_meta_store_stats_register(hg_class_t *hg_class);
 hg_id_t PDC_client_test_connect_register(hg_class_t *hg_class);
 hg_id_t PDC_get_remote_metadata_register(hg_class_t *hg_class_g);
 hg_id_t PDC_server_lookup_client_register(hg_class_t *hg_class);
@@ -3567,6 +4222,8 @@ hg_id_t PDC_metadata_get_kvtag_register(hg_class_t *hg_class);
 hg_id_t PDC_transfer_request_register(hg_class_t *hg_class);
 hg_id_t PDC_transfer_request_status_register(hg_class_t *hg_class);
 hg_id_t PDC_transfer_request_wait_register(hg_class_t *hg_class);
+hg_id_t PDC_obj_put_data_register(hg_class_t *hg_class);
+hg_id_t PDC_obj_get_data_register(hg_class_t *hg_class);
 hg_id_t PDC_buf_map_register(hg_class_t *hg_class);
 hg_id_t PDC_buf_unmap_register(hg_class_t *hg_class);
 hg_id_t PDC_region_lock_register(hg_class_t *hg_class);
@@ -3590,6 +4247,7 @@ hg_id_t PDC_cont_add_del_objs_rpc_register(hg_class_t *hg_class);
 hg_id_t PDC_query_read_obj_name_rpc_register(hg_class_t *hg_class);
 hg_id_t PDC_server_checkpoint_rpc_register(hg_class_t *hg_class);
 hg_id_t PDC_send_shm_register(hg_class_t *hg_class);
+hg_id_t PDC_detach_shm_register(hg_class_t *hg_class);
 hg_id_t PDC_send_shm_bulk_rpc_register(hg_class_t *hg_class);
 hg_id_t PDC_query_read_obj_name_client_rpc_register(hg_class_t *hg_class);
 hg_id_t PDC_container_query_register(hg_class_t *hg_class);
@@ -3672,6 +4330,58 @@ perr_t PDC_Server_add_tag_metadata(metadata_add_tag_in_t *in, metadata_add_tag_o
  */
 perr_t PDC_get_self_addr(hg_class_t *hg_class, char *self_addr_string);
 
+/**
+ * Build the consistent hashing ring that places metadata on servers
+ *
+ * \param n_server [IN]         Total number of server
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_hash_ring_init(int n_server);
+
+/**
+ * Free the consistent hashing ring
+ */
+void PDC_hash_ring_free();
+
+/**
+ * Get the ring bucket of a placement key
+ *
+ * \param key [IN]              Placement key, the name hash plus the time step
+ *
+ * \return Bucket
+ */
+uint32_t PDC_get_bucket_by_hash(uint32_t key);
+
+/**
+ * Get the ring bucket an object ID was allocated in
+ *
+ * \param obj_id [IN]           Object ID
+ *
+ * \return Bucket
+ */
+uint32_t PDC_get_bucket_by_obj_id(uint64_t obj_id);
+
+/**
+ * Get the server that owns a ring bucket
+ *
+ * \param bucket [IN]           Bucket
+ * \param n_server [IN]         Total number of server
+ *
+ * \return Server ID
+ */
+uint32_t PDC_get_server_by_bucket(uint32_t bucket, int n_server);
+
+/**
+ * Get the server that owns a placement key
+ *
+ * \param key [IN]              Placement key, the name hash plus the time step
+ * \param n_server [IN]         Total number of server
+ *
+ * \return Server ID
+ */
+uint32_t PDC_get_server_by_hash(uint32_t key, int n_server);
+
 /**
  * Get the server ID
  *
@@ -3712,6 +4422,50 @@ uint32_t PDC_get_server_by_name(char *name, int n_server);
  */
 uint32_t PDC_get_local_server_id(int my_rank, int client_per_server, int n_server);
 
+/**
+ * Return the shared copy of a string, adding it to the string arena if needed
+ *
+ * \param str [IN]              String to intern, NULL is treated as ""
+ *
+ * \return Interned string that lives until PDC_str_arena_free/NULL on failure
+ */
+const char *PDC_str_intern(const char *str);
+
+/**
+ * Free the string arena and all interned strings
+ */
+void PDC_str_arena_free();
+
+/**
+ * Serialize a metadata struct and its strings into a contiguous buffer
+ *
+ * \param meta [IN]             Metadata struct
+ * \param buf [OUT]             Buffer to write to, NULL to only compute the size
+ *
+ * \return Number of bytes of the serialized metadata
+ */
+size_t PDC_metadata_serialize(pdc_metadata_t *meta, void *buf);
+
+/**
+ * Deserialize a metadata struct written by PDC_metadata_serialize. Its strings point into buf, which
+ * must outlive it or be copied with PDC_metadata_dup
+ *
+ * \param buf [IN]              Serialized metadata
+ * \param meta [OUT]            Metadata struct
+ *
+ * \return Number of bytes consumed from buf
+ */
+size_t PDC_metadata_deserialize(const void *buf, pdc_metadata_t *meta);
+
+/**
+ * Copy a metadata struct along with its strings into a single allocation
+ *
+ * \param meta [IN]             Metadata struct
+ *
+ * \return Copy to release with free/NULL on failure
+ */
+pdc_metadata_t *PDC_metadata_dup(const pdc_metadata_t *meta);
+
 /**
  * Compare two metadata struct
  *
@@ -3801,7 +4555,8 @@ int PDC_is_same_region_transfer(region_info_transfer_t *a, region_info_transfer_
 perr_t PDC_metadata_t_to_transfer_t(pdc_metadata_t *meta, pdc_metadata_transfer_t *transfer);
 
 /**
- * Metadata type conversion
+ * Metadata type conversion. The object name and tags of meta point into transfer, use PDC_metadata_dup
+ * for a metadata that outlives it
  *
  * \param meta [IN]             Metadata to convert
  * \param transfer [OUT]        Converted metadata
@@ -4166,4 +4921,33 @@ perr_t PDC_Server_transfer_request_io(uint64_t obj_id, int obj_ndim, const uint6
                                       struct pdc_region_info *region_info, void *buf, size_t unit,
                                       int is_write);
 
+/**
+ * Map a shared memory arena registered by a client on the same node
+ *
+ * \param shm_info [IN]          Client id, shm name and size of the arena
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_attach_client_shm(pdc_shm_info_t *shm_info);
+
+/**
+ * Get a pointer into the shared memory arena of a client
+ *
+ * \param token [IN]             Token of the arena given when it was attached
+ * \param offset [IN]            Offset of the data in the arena
+ * \param size [IN]              Size of the data
+ *
+ * \return Pointer to the data on success/NULL if no arena or out of bound
+ */
+char *PDC_Server_get_client_shm_buf(uint64_t token, uint64_t offset, uint64_t size);
+
+/**
+ * Unmap the shared memory arena of a client that is done with it
+ *
+ * \param token [IN]             Token of the arena given when it was attached
+ *
+ * \return Non-negative on success/Negative if no arena has the token
+ */
+perr_t PDC_Server_detach_client_shm(uint64_t token);
+
 #endif /* PDC_CLIENT_SERVER_COMMON_H */
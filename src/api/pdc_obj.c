@@ -39,6 +39,8 @@
 #include <unistd.h>
 
 static perr_t PDC_obj_close(struct _pdc_obj_info *op);
+static pdcid_t PDC_obj_create_local(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id,
+                                    _pdc_obj_location_t location, const pdcid_t *obj_meta_id);
 
 perr_t
 PDC_obj_init()
@@ -176,8 +178,78 @@ PDCobj_create(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id)
     FUNC_LEAVE(ret_value);
 }
 
+perr_t
+PDCobj_create_many(pdcid_t cont_id, int n_obj, const char **obj_names, pdcid_t obj_prop_id, pdcid_t *obj_ids)
+{
+    perr_t                 ret_value = SUCCEED;
+    struct _pdc_id_info *  id_info;
+    struct _pdc_cont_info *cont_info;
+    pdcid_t *              meta_ids = NULL;
+    int                    i;
+
+    FUNC_ENTER(NULL);
+
+    if (n_obj <= 0)
+        PGOTO_DONE(SUCCEED);
+    if (obj_names == NULL || obj_ids == NULL)
+        PGOTO_ERROR(FAIL, "object names and ids cannot be NULL");
+
+    id_info = PDC_find_id(cont_id);
+    if (id_info == NULL)
+        PGOTO_ERROR(FAIL, "cannot locate container ID");
+    cont_info = (struct _pdc_cont_info *)(id_info->obj_ptr);
+
+    meta_ids = (pdcid_t *)malloc(n_obj * sizeof(pdcid_t));
+    if (meta_ids == NULL)
+        PGOTO_ERROR(FAIL, "PDC object id array allocation failed");
+
+    // One RPC per metadata server creates all objects, the local objects are built from the returned ids
+    ret_value = PDC_Client_send_names_recv_ids(n_obj, obj_names, cont_info->cont_info_pub->meta_id,
+                                               obj_prop_id, meta_ids);
+
+    for (i = 0; i < n_obj; i++) {
+        obj_ids[i] = 0;
+        if (meta_ids[i] == 0)
+            continue;
+        obj_ids[i] = PDC_obj_create_local(cont_id, obj_names[i], obj_prop_id, PDC_OBJ_GLOBAL, &meta_ids[i]);
+        if (obj_ids[i] == 0)
+            ret_value = FAIL;
+    }
+
+done:
+    free(meta_ids);
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 pdcid_t
 PDC_obj_create(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id, _pdc_obj_location_t location)
+{
+    pdcid_t ret_value = 0;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_obj_create_local(cont_id, obj_name, obj_prop_id, location, NULL);
+
+    FUNC_LEAVE(ret_value);
+}
+
+pdcid_t
+PDC_obj_create_with_meta_id(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id, uint64_t meta_id)
+{
+    pdcid_t ret_value = 0;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = PDC_obj_create_local(cont_id, obj_name, obj_prop_id, PDC_OBJ_GLOBAL, &meta_id);
+
+    FUNC_LEAVE(ret_value);
+}
+
+// Build the local object, obj_meta_id is the server id when it is already known
+static pdcid_t
+PDC_obj_create_local(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id, _pdc_obj_location_t location,
+                     const pdcid_t *obj_meta_id)
 {
     pdcid_t                ret_value = 0;
     struct _pdc_obj_info * p         = NULL;
@@ -282,7 +354,10 @@ PDC_obj_create(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id, _pdc_
     p->obj_info_pub->local_id  = PDC_id_register(PDC_OBJ, p);
     p->obj_info_pub->meta_id   = 0;
     p->obj_info_pub->server_id = 0;
-    if (location == PDC_OBJ_GLOBAL) {
+    if (obj_meta_id != NULL) {
+        p->obj_info_pub->meta_id = *obj_meta_id;
+    }
+    else if (location == PDC_OBJ_GLOBAL) {
         ret = PDC_Client_send_name_recv_id(obj_name, p->cont->cont_info_pub->meta_id, obj_prop_id,
                                            &(p->obj_info_pub->meta_id));
         if (ret == FAIL)
@@ -446,6 +521,8 @@ PDCobj_open_common(const char *obj_name, pdcid_t pdc, int is_col)
 
     if (ret == FAIL)
         PGOTO_ERROR(0, "query object failed");
+    if (out == NULL)
+        PGOTO_ERROR(0, "object %s not found", obj_name);
 
     obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
     PDCprop_set_obj_dims(obj_prop, out->ndim, out->dims);
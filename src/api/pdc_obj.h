@@ -60,6 +60,21 @@ struct pdc_obj_info {
  */
 pdcid_t PDCobj_create(pdcid_t cont_id, const char *obj_name, pdcid_t obj_create_prop);
 
+/**
+ * Create many objects sharing one property, with one request per metadata server
+ *
+ * \param cont_id [IN]          ID of the container
+ * \param n_obj [IN]            Number of objects
+ * \param obj_names [IN]        Names of the objects
+ * \param obj_create_prop [IN]  ID of object property,
+ *                              returned by PDCprop_create(PDC_OBJ_CREATE)
+ * \param obj_ids [OUT]         Object ids, zero for objects that were not created
+ *
+ * \return Non-negative if all objects were created/Negative otherwise
+ */
+perr_t PDCobj_create_many(pdcid_t cont_id, int n_obj, const char **obj_names, pdcid_t obj_create_prop,
+                          pdcid_t *obj_ids);
+
 /**
  * Open an object within a container
  *
@@ -268,24 +283,23 @@ struct pdc_obj_info *PDCobj_iter_get_info(obj_handle *ohandle);
 obj_handle *PDCview_iter_start(pdcid_t view_id);
 
 /**
- * ***********
+ * Create a 1-D PDC_CHAR object and write its data, small data is sent with the create request
  *
  * \param obj_name [IN]         Object name
- * \param data [IN]             *********
- * \param size [IN]             *********
- * \param n_res [IN]            *********
- * \param cont_id [IN]          *********
+ * \param data [IN]             Data to write
+ * \param size [IN]             Size of the data in bytes
+ * \param cont_id [IN]          Container ID
  *
- * \return Non-negative on success/Negative on failure
+ * \return Object ID on success/Zero on failure
  */
 pdcid_t PDCobj_put_data(const char *obj_name, void *data, uint64_t size, pdcid_t cont_id);
 
 /**
- * ***********
+ * Read the beginning of an object, a 1-D object is read with a single request
  *
  * \param obj_id [IN]           Object ID
- * \param data [IN]             *********
- * \param size [IN]             *********
+ * \param data [OUT]            Buffer receiving the data
+ * \param size [IN]             Number of elements to read
  *
  * \return Non-negative on success/Negative on failure
  */
@@ -334,4 +348,44 @@ perr_t PDCobj_get_tag(pdcid_t obj_id, char *tag_name, void **tag_value, psize_t
  */
 perr_t PDCobj_del_tag(pdcid_t obj_id, char *tag_name);
 
+/**
+ * Add a tag to each of a set of objects, with one request per metadata server
+ *
+ * \param n [IN]                Number of tags
+ * \param obj_ids [IN]          Object ID of each tag
+ * \param tag_names [IN]        Name of each tag
+ * \param tag_values [IN]       Value of each tag
+ * \param value_sizes [IN]      Size of each value in bytes
+ *
+ * \return Non-negative on success/Negative if any of the tags was not added
+ */
+perr_t PDCobj_put_tag_many(int n, pdcid_t *obj_ids, char **tag_names, void **tag_values,
+                           psize_t *value_sizes);
+
+/**
+ * Get a tag of each of a set of objects, with one request per metadata server
+ *
+ * \param n [IN]                Number of tags
+ * \param obj_ids [IN]          Object ID of each tag
+ * \param tag_names [IN]        Name of each tag
+ * \param tag_values [OUT]      Value of each tag, allocated and to be freed by the caller, NULL if the
+ *                              object has no such tag
+ * \param value_sizes [OUT]     Size of each value in bytes
+ *
+ * \return Non-negative on success/Negative if any of the objects was not found
+ */
+perr_t PDCobj_get_tag_many(int n, pdcid_t *obj_ids, char **tag_names, void **tag_values,
+                           psize_t *value_sizes);
+
+/**
+ * Delete a tag from each of a set of objects, with one request per metadata server
+ *
+ * \param n [IN]                Number of tags
+ * \param obj_ids [IN]          Object ID of each tag
+ * \param tag_names [IN]        Name of each tag
+ *
+ * \return Non-negative on success/Negative if any of the objects was not found
+ */
+perr_t PDCobj_del_tag_many(int n, pdcid_t *obj_ids, char **tag_names);
+
 #endif /* PDC_OBJ_H */
@@ -70,6 +70,19 @@ perr_t PDC_obj_init();
 pdcid_t PDC_obj_create(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id,
                        _pdc_obj_location_t location);
 
+/**
+ * Build the local object of a global object already created on the server
+ *
+ * \param cont_id [IN]          ID of the container
+ * \param obj_name [IN]         Name of the object
+ * \param obj_prop_id [IN]      ID of the property the object was created with
+ * \param meta_id [IN]          ID of the object returned by the server
+ *
+ * \return Object id on success/Zero on failure
+ */
+pdcid_t PDC_obj_create_with_meta_id(pdcid_t cont_id, const char *obj_name, pdcid_t obj_prop_id,
+                                    uint64_t meta_id);
+
 /**
  * Get object information
  *
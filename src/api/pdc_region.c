@@ -180,6 +180,8 @@ PDCregion_transfer_create(void *buf, pdc_access_t access_type, pdcid_t obj_id, p
     p->access_type = access_type;
     p->buf         = buf;
     p->metadata_id = 0;
+    p->agg_batch   = NULL;
+    p->async       = NULL;
     /*
         printf("creating a request from obj %s metadata id = %llu, access_type = %d\n",
        obj2->obj_info_pub->name, (long long unsigned)obj2->obj_info_pub->meta_id, access_type);
@@ -222,6 +224,23 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+// Wait until the server acknowledged a start forwarded by the progress thread
+static perr_t
+pdc_transfer_request_start_complete(pdc_transfer_request *transfer_request)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (transfer_request->async != NULL) {
+        ret_value = PDC_Client_transfer_request_async_complete(
+            transfer_request->async, &(transfer_request->metadata_id), &(transfer_request->new_buf));
+        transfer_request->async = NULL;
+    }
+
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDCregion_transfer_close(pdcid_t transfer_request_id)
 {
@@ -233,6 +252,7 @@ PDCregion_transfer_close(pdcid_t transfer_request_id)
     transferinfo     = PDC_find_id(transfer_request_id);
     transfer_request = (pdc_transfer_request *)(transferinfo->obj_ptr);
 
+    pdc_transfer_request_start_complete(transfer_request);
     free(transfer_request->local_region_offset);
     free(transfer_request);
 
@@ -269,14 +289,14 @@ PDCregion_transfer_start(pdcid_t transfer_request_id)
 
     transferinfo     = PDC_find_id(transfer_request_id);
     transfer_request = (pdc_transfer_request *)(transferinfo->obj_ptr);
-    if (transfer_request->metadata_id == 0) {
+    if (transfer_request->metadata_id == 0 && transfer_request->async == NULL) {
         ret_value = PDC_Client_transfer_request(
             transfer_request->buf, transfer_request->obj_id, transfer_request->obj_ndim,
             transfer_request->obj_dims, transfer_request->local_region_ndim,
             transfer_request->local_region_offset, transfer_request->local_region_size,
             transfer_request->remote_region_ndim, transfer_request->remote_region_offset,
             transfer_request->remote_region_size, transfer_request->mem_type, transfer_request->access_type,
-            &(transfer_request->metadata_id), &(transfer_request->new_buf));
+            &(transfer_request->metadata_id), &(transfer_request->new_buf), &(transfer_request->async));
     }
     else {
         printf("PDC Client PDCregion_transfer_start attempt to start existing transfer request @ line %d\n",
@@ -298,6 +318,14 @@ PDCregion_transfer_status(pdcid_t transfer_request_id, pdc_transfer_status_t *co
 
     transferinfo     = PDC_find_id(transfer_request_id);
     transfer_request = (pdc_transfer_request *)(transferinfo->obj_ptr);
+    if (transfer_request->async != NULL) {
+        // The start has not been acknowledged yet, so the transfer cannot have completed
+        if (!PDC_Client_transfer_request_async_test(transfer_request->async)) {
+            *completed = PDC_TRANSFER_STATUS_PENDING;
+            goto done;
+        }
+        ret_value = pdc_transfer_request_start_complete(transfer_request);
+    }
     if (transfer_request->metadata_id != 0) {
         ret_value = PDC_Client_transfer_request_status(
             transfer_request->metadata_id, completed, transfer_request->buf, transfer_request->new_buf,
@@ -311,6 +339,7 @@ PDCregion_transfer_status(pdcid_t transfer_request_id, pdc_transfer_status_t *co
     else {
         *completed = PDC_TRANSFER_STATUS_NOT_FOUND;
     }
+done:
     fflush(stdout);
     FUNC_LEAVE(ret_value);
 }
@@ -331,6 +360,85 @@ PDCregion_transfer_wait_all(pdcid_t *transfer_request_id, size_t size)
     FUNC_LEAVE(ret_value);
 }
 
+static perr_t
+pdc_transfer_request_get_all(pdcid_t *transfer_request_id, size_t size, pdc_transfer_request ***requests)
+{
+    perr_t               ret_value = SUCCEED;
+    struct _pdc_id_info *transferinfo;
+    size_t               i;
+
+    FUNC_ENTER(NULL);
+
+    *requests = (pdc_transfer_request **)malloc(sizeof(pdc_transfer_request *) * (size + 1));
+    for (i = 0; i < size; ++i) {
+        transferinfo = PDC_find_id(transfer_request_id[i]);
+        if (transferinfo == NULL) {
+            free(*requests);
+            *requests = NULL;
+            PGOTO_ERROR(FAIL, "cannot locate transfer request ID");
+        }
+        (*requests)[i] = (pdc_transfer_request *)(transferinfo->obj_ptr);
+    }
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCregion_transfer_start_all_agg(pdcid_t *transfer_request_id, size_t size)
+{
+    perr_t                 ret_value = SUCCEED;
+    pdc_transfer_request **requests  = NULL;
+    size_t                 i;
+    int                    valid;
+
+    FUNC_ENTER(NULL);
+
+    valid = pdc_transfer_request_get_all(transfer_request_id, size, &requests) == SUCCEED;
+    for (i = 0; valid && i < size; ++i) {
+        if (requests[i]->metadata_id != 0 || requests[i]->agg_batch != NULL || requests[i]->async != NULL) {
+            printf("PDC Client PDCregion_transfer_start_all_agg: transfer request already started\n");
+            valid = 0;
+        }
+    }
+
+    // The other clients of the group would wait in the collectives of a start this client gives up on
+    if (PDC_Client_transfer_request_agg_agree(valid) == 0) {
+        free(requests);
+        PGOTO_ERROR(FAIL, "PDC Client PDCregion_transfer_start_all_agg: invalid transfer request");
+    }
+
+    ret_value = PDC_Client_transfer_request_agg_start(requests, size);
+    free(requests);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDCregion_transfer_wait_all_agg(pdcid_t *transfer_request_id, size_t size)
+{
+    perr_t                 ret_value = SUCCEED;
+    pdc_transfer_request **requests  = NULL;
+
+    FUNC_ENTER(NULL);
+
+    if (PDC_Client_transfer_request_agg_agree(
+            pdc_transfer_request_get_all(transfer_request_id, size, &requests) == SUCCEED) == 0) {
+        free(requests);
+        PGOTO_ERROR(FAIL, "PDC Client PDCregion_transfer_wait_all_agg: invalid transfer request");
+    }
+
+    ret_value = PDC_Client_transfer_request_agg_wait(requests, size);
+    free(requests);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDCregion_transfer_wait(pdcid_t transfer_request_id)
 {
@@ -342,6 +450,8 @@ PDCregion_transfer_wait(pdcid_t transfer_request_id)
 
     transferinfo     = PDC_find_id(transfer_request_id);
     transfer_request = (pdc_transfer_request *)(transferinfo->obj_ptr);
+    if (transfer_request->async != NULL)
+        ret_value = pdc_transfer_request_start_complete(transfer_request);
     if (transfer_request->metadata_id != 0) {
         ret_value = PDC_Client_transfer_request_wait(
             transfer_request->metadata_id, transfer_request->access_type, transfer_request->buf,
@@ -64,6 +64,10 @@ typedef struct pdc_transfer_request {
     int       obj_ndim;
     uint64_t *obj_dims;
 
+    /* Used internally for node-local aggregation */
+    struct _pdc_transfer_agg_batch *agg_batch;
+    /* Used internally while the start is being acknowledged in the background */
+    struct _pdc_transfer_request_async *async;
 } pdc_transfer_request;
 
 typedef enum {
@@ -106,6 +110,8 @@ pdcid_t PDCregion_transfer_create(void *buf, pdc_access_t access_type, pdcid_t o
                                   pdcid_t remote_reg);
 /**
  * Start a region transfer from local region to remote region for an object on buf.
+ * When the client runs a progress thread (PDC_CLIENT_PROGRESS_THREAD=1), the call returns without waiting
+ * for the server to acknowledge the request.
  *
  * \param buf [IN]              Start point of an application buffer
  * \param obj_id [IN]           ID of the target object
@@ -125,6 +131,30 @@ perr_t PDCregion_transfer_wait(pdcid_t transfer_request_id);
 
 perr_t PDCregion_transfer_wait_all(pdcid_t *transfer_request_id, size_t size);
 
+/**
+ * Start a set of region transfers through the node-local aggregator. Must be called collectively by all
+ * client processes on the same node. Clients of the node are grouped by data server; each group stages
+ * its data in a shared memory segment and one elected process per group forwards the (merged) transfers
+ * to that data server.
+ *
+ * \param transfer_request_id [IN] Array of transfer request IDs
+ * \param size [IN]                Number of transfer requests
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDCregion_transfer_start_all_agg(pdcid_t *transfer_request_id, size_t size);
+
+/**
+ * Wait for a set of region transfers started with PDCregion_transfer_start_all_agg. Must be called
+ * collectively by all client processes on the same node, with the same transfer requests.
+ *
+ * \param transfer_request_id [IN] Array of transfer request IDs
+ * \param size [IN]                Number of transfer requests
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDCregion_transfer_wait_all_agg(pdcid_t *transfer_request_id, size_t size);
+
 perr_t PDCregion_transfer_close(pdcid_t transfer_request_id);
 /**
  * Map an application buffer to an object
@@ -12,6 +12,9 @@
 /* Define if you want to enable checkpoint */
 #cmakedefine ENABLE_CHECKPOINT
 
+/* Define if you want to look up metadata names in the chained hash table */
+#cmakedefine DISABLE_SWISS_TABLE
+
 /* Define if you want to enable profiling */
 #cmakedefine ENABLE_PROFILING
 
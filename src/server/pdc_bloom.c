@@ -0,0 +1,283 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "pdc_bloom.h"
+
+#define BLOOM_BLOCK_WORDS 8
+#define BLOOM_BLOCK_BITS  (BLOOM_BLOCK_WORDS * 32)
+#define BLOOM_MAX_STAGE   32
+// Each new stage holds BLOOM_GROWTH times the keys of the previous one at BLOOM_TIGHTEN times its
+// error rate, so the stage error rates sum to at most 1 / (1 - BLOOM_TIGHTEN) times the first one
+#define BLOOM_GROWTH  2
+#define BLOOM_TIGHTEN 0.5
+
+typedef struct pdc_bloom_block_t {
+    uint32_t word[BLOOM_BLOCK_WORDS];
+} __attribute__((aligned(32))) pdc_bloom_block_t;
+
+typedef struct pdc_bloom_stage_t {
+    pdc_bloom_block_t *blocks;
+    uint64_t           n_block;
+    uint64_t           capacity;
+    uint64_t           n_key;
+    double             error_rate;
+} pdc_bloom_stage_t;
+
+struct pdc_bloom {
+    pdc_bloom_stage_t stage[BLOOM_MAX_STAGE];
+    uint32_t          n_stage;
+    uint64_t          n_key;
+    uint64_t          n_removed;
+};
+
+// Odd multipliers picking the bit of each word, from the Parquet split block bloom filter
+static const uint32_t bloom_salt_g[BLOOM_BLOCK_WORDS] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                                         0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                                         0x9efc4947U, 0x5c6bfb31U};
+
+static inline uint64_t
+bloom_block_index(const pdc_bloom_stage_t *stage, uint64_t hash)
+{
+    // Multiply-shift maps the high half of the hash to [0, n_block) without a division
+    return ((hash >> 32) * stage->n_block) >> 32;
+}
+
+static inline void
+bloom_block_mask(uint64_t hash, uint32_t *mask)
+{
+    uint32_t key = (uint32_t)hash;
+    int      i;
+
+    for (i = 0; i < BLOOM_BLOCK_WORDS; i++)
+        mask[i] = 1U << ((key * bloom_salt_g[i]) >> 27);
+}
+
+static inline int
+bloom_block_check(const pdc_bloom_block_t *block, uint64_t hash)
+{
+#ifdef __AVX2__
+    const __m256i salt = _mm256_loadu_si256((const __m256i *)bloom_salt_g);
+    __m256i       mask, bits;
+
+    mask = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)(uint32_t)hash), salt), 27);
+    mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), mask);
+    bits = _mm256_load_si256((const __m256i *)block->word);
+
+    return _mm256_testc_si256(bits, mask);
+#else
+    uint32_t mask[BLOOM_BLOCK_WORDS], miss = 0;
+    int      i;
+
+    bloom_block_mask(hash, mask);
+    for (i = 0; i < BLOOM_BLOCK_WORDS; i++)
+        miss |= mask[i] & ~block->word[i];
+
+    return miss == 0;
+#endif
+}
+
+static inline void
+bloom_block_add(pdc_bloom_block_t *block, uint64_t hash)
+{
+    uint32_t mask[BLOOM_BLOCK_WORDS];
+    int      i;
+
+    bloom_block_mask(hash, mask);
+    for (i = 0; i < BLOOM_BLOCK_WORDS; i++)
+        block->word[i] |= mask[i];
+}
+
+/*
+ * False positive rate of a split block filter whose blocks hold lambda keys on average. The keys per
+ * block are Poisson distributed and a block with i keys has each bit of a word set with probability
+ * 1 - (31/32)^i
+ */
+static double
+bloom_block_fpp(double lambda)
+{
+    double pois = exp(-lambda), fpp = 0.0;
+    int    i, n = (int)(lambda + 10.0 * sqrt(lambda)) + 10;
+
+    for (i = 0; i <= n; i++) {
+        fpp += pois * pow(1.0 - pow(1.0 - 1.0 / 32, i), BLOOM_BLOCK_WORDS);
+        pois *= lambda / (i + 1);
+    }
+
+    return fpp;
+}
+
+/*
+ * Number of blocks for a stage. The standard bound -8 * capacity / ln(1 - error_rate^(1/8)) bits
+ * ignores that some blocks get more keys than others, so it is grown until the per-block estimate
+ * meets the error rate.
+ */
+static uint64_t
+bloom_n_block(uint64_t capacity, double error_rate)
+{
+    double n_bit = -8.0 * (double)capacity / log(1.0 - pow(error_rate, 1.0 / BLOOM_BLOCK_WORDS));
+
+    while (n_bit < (double)UINT32_MAX * BLOOM_BLOCK_BITS &&
+           bloom_block_fpp((double)capacity * BLOOM_BLOCK_BITS / n_bit) > error_rate)
+        n_bit *= 1.05;
+    if (!(n_bit < (double)UINT32_MAX * BLOOM_BLOCK_BITS))
+        return UINT32_MAX;
+
+    return (uint64_t)n_bit / BLOOM_BLOCK_BITS + 1;
+}
+
+static int
+bloom_add_stage(pdc_bloom_t *bloom, uint64_t capacity, double error_rate)
+{
+    pdc_bloom_stage_t *stage = &bloom->stage[bloom->n_stage];
+
+    stage->n_block = bloom_n_block(capacity, error_rate);
+    if (posix_memalign((void **)&stage->blocks, 64, stage->n_block * sizeof(pdc_bloom_block_t)) != 0)
+        return 0;
+    memset(stage->blocks, 0, stage->n_block * sizeof(pdc_bloom_block_t));
+    stage->capacity   = capacity;
+    stage->n_key      = 0;
+    stage->error_rate = error_rate;
+    bloom->n_stage++;
+
+    return 1;
+}
+
+pdc_bloom_t *
+pdc_bloom_new(uint64_t capacity, double error_rate)
+{
+    pdc_bloom_t *bloom;
+
+    if (capacity == 0)
+        capacity = 1;
+    if (!(error_rate > 0.0 && error_rate < 1.0))
+        return NULL;
+
+    bloom = (pdc_bloom_t *)calloc(1, sizeof(pdc_bloom_t));
+    if (bloom == NULL)
+        return NULL;
+    if (!bloom_add_stage(bloom, capacity, error_rate * (1.0 - BLOOM_TIGHTEN))) {
+        free(bloom);
+        return NULL;
+    }
+
+    return bloom;
+}
+
+void
+pdc_bloom_free(pdc_bloom_t *bloom)
+{
+    uint32_t i;
+
+    if (bloom == NULL)
+        return;
+    for (i = 0; i < bloom->n_stage; i++)
+        free(bloom->stage[i].blocks);
+    free(bloom);
+}
+
+int
+pdc_bloom_add(pdc_bloom_t *bloom, uint64_t hash)
+{
+    pdc_bloom_stage_t *stage = &bloom->stage[bloom->n_stage - 1];
+
+    // Once the stages run out the last one keeps taking keys at a growing error rate
+    if (stage->n_key >= stage->capacity && bloom->n_stage < BLOOM_MAX_STAGE) {
+        if (!bloom_add_stage(bloom, stage->capacity * BLOOM_GROWTH, stage->error_rate * BLOOM_TIGHTEN))
+            return 0;
+        stage++;
+    }
+
+    bloom_block_add(&stage->blocks[bloom_block_index(stage, hash)], hash);
+    stage->n_key++;
+    bloom->n_key++;
+
+    return 1;
+}
+
+int
+pdc_bloom_check(const pdc_bloom_t *bloom, uint64_t hash)
+{
+    const pdc_bloom_stage_t *stage;
+    uint32_t                 i;
+
+    // The newest stage is the largest and holds the most recent keys
+    for (i = bloom->n_stage; i > 0; i--) {
+        stage = &bloom->stage[i - 1];
+        if (bloom_block_check(&stage->blocks[bloom_block_index(stage, hash)], hash))
+            return 1;
+    }
+
+    return 0;
+}
+
+void
+pdc_bloom_remove(pdc_bloom_t *bloom)
+{
+    if (bloom->n_key > 0) {
+        bloom->n_key--;
+        bloom->n_removed++;
+    }
+}
+
+uint64_t
+pdc_bloom_n_removed(const pdc_bloom_t *bloom)
+{
+    return bloom->n_removed;
+}
+
+void
+pdc_bloom_get_stats(const pdc_bloom_t *bloom, pdc_bloom_stats_t *stats)
+{
+    const pdc_bloom_stage_t *stage;
+    uint64_t                 j, n_set;
+    uint32_t                 i;
+    int                      k;
+    double                   pass = 1.0;
+
+    memset(stats, 0, sizeof(pdc_bloom_stats_t));
+    stats->n_key     = bloom->n_key;
+    stats->n_removed = bloom->n_removed;
+    stats->n_stage   = bloom->n_stage;
+
+    for (i = 0; i < bloom->n_stage; i++) {
+        stage = &bloom->stage[i];
+        n_set = 0;
+        for (j = 0; j < stage->n_block; j++)
+            for (k = 0; k < BLOOM_BLOCK_WORDS; k++)
+                n_set += __builtin_popcount(stage->blocks[j].word[k]);
+        stats->n_bit += stage->n_block * BLOOM_BLOCK_BITS;
+        stats->n_bit_set += n_set;
+        stats->mem_size += stage->n_block * sizeof(pdc_bloom_block_t);
+        // A random key passes a stage if the bit it needs in each word is set
+        pass *= 1.0 - pow((double)n_set / (double)(stage->n_block * BLOOM_BLOCK_BITS), BLOOM_BLOCK_WORDS);
+    }
+    stats->est_fpp = 1.0 - pass;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+/*
+ * Scalable split-block bloom filter over 64-bit key hashes. A key sets one bit in each of the 8 32-bit
+ * words of a single 256-bit block, so an add or a check touches one cache line and the 8 word tests
+ * are independent. The filter starts at the given capacity and adds a stage twice as large with half
+ * the error rate whenever the newest stage is full, which keeps the overall error rate under the
+ * requested one. Bits cannot be cleared, removed keys are only counted so the owner can rebuild.
+ */
+
+#ifndef PDC_BLOOM_H
+#define PDC_BLOOM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct pdc_bloom pdc_bloom_t;
+
+typedef struct pdc_bloom_stats_t {
+    uint64_t n_key;       // keys added and not removed
+    uint64_t n_removed;   // removed keys whose bits are still set
+    uint32_t n_stage;     // number of stages
+    uint64_t n_bit;       // bits over all stages
+    uint64_t n_bit_set;   // bits set over all stages
+    size_t   mem_size;    // bytes of bit blocks
+    double   est_fpp;     // false positive rate estimated from the bits set
+} pdc_bloom_stats_t;
+
+/**
+ * Create a filter
+ *
+ * \param capacity [IN]          Number of keys the first stage is sized for
+ * \param error_rate [IN]        Target false positive rate of the whole filter, in (0, 1)
+ *
+ * \return Pointer to the filter on success/NULL on failure
+ */
+pdc_bloom_t *pdc_bloom_new(uint64_t capacity, double error_rate);
+
+/**
+ * Free a filter
+ *
+ * \param bloom [IN]             Filter to free
+ */
+void pdc_bloom_free(pdc_bloom_t *bloom);
+
+/**
+ * Add a key, a new stage is allocated if the newest one is full
+ *
+ * \param bloom [IN]             Filter
+ * \param hash [IN]              64-bit hash of the key
+ *
+ * \return 1 on success/0 on memory allocation failure
+ */
+int pdc_bloom_add(pdc_bloom_t *bloom, uint64_t hash);
+
+/**
+ * Check if a key may have been added
+ *
+ * \param bloom [IN]             Filter
+ * \param hash [IN]              64-bit hash of the key
+ *
+ * \return 1 if the key may be in the filter/0 if it is certainly not
+ */
+int pdc_bloom_check(const pdc_bloom_t *bloom, uint64_t hash);
+
+/**
+ * Record that an added key was removed, its bits stay set
+ *
+ * \param bloom [IN]             Filter
+ */
+void pdc_bloom_remove(pdc_bloom_t *bloom);
+
+/**
+ * Number of removed keys whose bits are still set
+ *
+ * \param bloom [IN]             Filter
+ *
+ * \return Number of removed keys
+ */
+uint64_t pdc_bloom_n_removed(const pdc_bloom_t *bloom);
+
+/**
+ * Get the occupancy of a filter
+ *
+ * \param bloom [IN]             Filter
+ * \param stats [OUT]            Statistics
+ */
+void pdc_bloom_get_stats(const pdc_bloom_t *bloom, pdc_bloom_stats_t *stats);
+
+#endif /* PDC_BLOOM_H */
@@ -401,6 +401,12 @@ hash_table_num_entries(HashTable *hash_table)
 
 void
 hash_table_iterate(HashTable *hash_table, HashTableIterator *iterator)
+{
+    hash_table_iterate_from(hash_table, iterator, 0);
+}
+
+void
+hash_table_iterate_from(HashTable *hash_table, HashTableIterator *iterator, unsigned int start_chain)
 {
     unsigned int chain;
 
@@ -409,8 +415,8 @@ hash_table_iterate(HashTable *hash_table, HashTableIterator *iterator)
     /* Default value of next if no entries are found. */
     iterator->next_entry = NULL;
 
-    /* Find the first entry */
-    for (chain = 0; chain < hash_table->table_size; ++chain) {
+    /* Find the first entry at or after the start chain */
+    for (chain = start_chain; chain < hash_table->table_size; ++chain) {
 
         if (hash_table->table[chain] != NULL) {
             iterator->next_entry = hash_table->table[chain];
@@ -227,6 +227,20 @@ unsigned int hash_table_num_entries(HashTable *hash_table);
 
 void hash_table_iterate(HashTable *hash_table, HashTableIterator *iter);
 
+/**
+ * Initialise a @ref HashTableIterator to iterate over a hash table,
+ * starting at a given chain. The chain of the next entry is in the
+ * next_chain field of the iterator, so an iteration can be resumed
+ * there without walking the chains before it.
+ *
+ * @param hash_table          The hash table.
+ * @param iter                Pointer to an iterator structure to
+ *                            initialise.
+ * @param start_chain         Index of the first chain to iterate over.
+ */
+
+void hash_table_iterate_from(HashTable *hash_table, HashTableIterator *iter, unsigned int start_chain);
+
 /**
  * Determine if there are more keys in the hash table to iterate
  * over.
@@ -34,9 +34,11 @@
 #include <fcntl.h>
 #include <inttypes.h>
 #include <math.h>
+#include <limits.h>
 
 #include <sys/shm.h>
 #include <sys/mman.h>
+#include <sys/wait.h>
 
 #include "mercury.h"
 #include "mercury_macros.h"
@@ -53,6 +55,8 @@
 #include "pdc_server.h"
 #include "pdc_server_metadata.h"
 #include "pdc_server_data.h"
+#include "pdc_server_wal.h"
+#include "pdc_server_meta_store.h"
 #include "pdc_timing.h"
 #include "pdc_region_cache.h"
 
@@ -60,8 +64,87 @@
 #include <rdmacred.h>
 #endif
 
-#define PDC_CHECKPOINT_INTERVAL         200
-#define PDC_CHECKPOINT_MIN_INTERVAL_SEC 300
+// Checkpoint file format, a header followed by independently checksummed blocks
+#define PDC_CHECKPOINT_MAGIC      "PDCCKPT"
+#define PDC_CHECKPOINT_VERSION    2
+#define PDC_CHECKPOINT_BLOCK_SIZE (4 << 20)
+#define PDC_RESTART_MAX_NTHREAD   8
+
+typedef enum {
+    PDC_CHECKPOINT_BLOCK_CONT = 1,
+    PDC_CHECKPOINT_BLOCK_FILE = 2,
+    PDC_CHECKPOINT_BLOCK_META = 3
+} pdc_checkpoint_block_type_t;
+
+typedef struct pdc_checkpoint_header_t {
+    char     magic[8];
+    uint32_t version;
+    uint32_t n_block;
+    uint64_t wal_lsn;
+    uint64_t n_cont;
+    uint64_t n_obj;
+    uint32_t n_server;
+    uint32_t reserved;
+} pdc_checkpoint_header_t;
+
+typedef struct pdc_checkpoint_block_header_t {
+    uint32_t type;
+    uint32_t n_entry;
+    uint32_t n_record;
+    uint32_t checksum;
+    uint64_t size;
+} pdc_checkpoint_block_header_t;
+
+// Builds a block in memory so it can be checksummed before it is written
+typedef struct pdc_checkpoint_writer_t {
+    FILE *   file;
+    char *   buf;
+    size_t   size;
+    size_t   alloc;
+    uint32_t type;
+    uint32_t n_entry;
+    uint32_t n_record;
+    uint32_t n_block;
+    perr_t   status;
+} pdc_checkpoint_writer_t;
+
+typedef struct pdc_restart_cursor_t {
+    const char *pos;
+    const char *end;
+    int         error;
+} pdc_restart_cursor_t;
+
+// A metadata block being restored, decoded into its slice of the restart arrays
+typedef struct pdc_restart_block_t {
+    const char *                  payload;
+    pdc_checkpoint_block_header_t header;
+    pdc_metadata_t *              metadata;
+    data_server_region_t **       obj_regions;
+    const uint32_t *              file_map;
+    uint32_t                      n_file;
+    uint32_t *                    entry_keys;
+    int *                         entry_counts;
+    int                           n_region;
+    perr_t                        status;
+} pdc_restart_block_t;
+
+typedef struct pdc_restart_worker_t {
+    pdc_restart_block_t *blocks;
+    int                  n_block;
+    int                  first;
+    int                  stride;
+    int                  started;
+} pdc_restart_worker_t;
+
+// Counts of a restart, and the records queued for other servers when the number of servers changed
+typedef struct pdc_restart_state_t {
+    int                      migrate;
+    int                      n_cont;
+    int                      n_obj;
+    int                      n_region;
+    pdc_checkpoint_writer_t *cont_out;
+    pdc_checkpoint_writer_t *meta_out;
+} pdc_restart_state_t;
 
 // Global debug variable to control debug printfs
 int is_debug_g       = 0;
@@ -140,6 +223,17 @@ double server_total_io_time_g               = 0.0;
 double server_update_region_location_time_g = 0.0;
 double server_io_elapsed_time_g             = 0.0;
 
+// Background snapshot, written by a forked child from its copy-on-write view of the metadata
+static pid_t          pdc_snapshot_pid_g = 0;
+static struct timeval pdc_snapshot_start_g;
+#ifdef ENABLE_MULTITHREAD
+// The progress loop starts and polls snapshots while a checkpoint request may be waiting for one
+static hg_thread_mutex_t pdc_snapshot_mutex_g;
+#endif
+int                   server_snapshot_count_g = 0;
+double                server_snapshot_time_g  = 0.0;
+uint64_t              server_snapshot_bytes_g = 0;
+
 // Debug var
 volatile int dbg_sleep_g = 1;
 
@@ -718,8 +812,12 @@ PDC_Server_init(int port, hg_class_t **hg_class, hg_context_t **hg_context)
 
     FUNC_ENTER(NULL);
 
-    // set server id start
-    pdc_id_seq_g = pdc_id_seq_g * (pdc_server_rank_g + 1);
+    // Metadata placement and ID allocation depend on the server count
+    ret_value = PDC_hash_ring_init(pdc_server_size_g);
+    if (ret_value != SUCCEED) {
+        printf("==PDC_SERVER[%d]: error with PDC_hash_ring_init\n", pdc_server_rank_g);
+        goto done;
+    }
 
     // Create server tmp dir
     PDC_mkdir(pdc_server_tmp_dir_g);
@@ -839,8 +937,9 @@ drc_access_again:
         printf("\n==PDC_SERVER[%d]: Starting server with %d threads...\n", pdc_server_rank_g, n_thread);
     hg_thread_mutex_init(&hash_table_new_mutex_g);
     hg_thread_mutex_init(&pdc_client_info_mutex_g);
-    hg_thread_mutex_init(&pdc_metadata_hash_table_mutex_g);
-    hg_thread_mutex_init(&pdc_container_hash_table_mutex_g);
+    hg_thread_rwlock_init(&pdc_metadata_hash_table_rwlock_g);
+    hg_thread_rwlock_init(&pdc_container_hash_table_rwlock_g);
+    hg_thread_mutex_init(&pdc_kvtag_index_mutex_g);
     hg_thread_mutex_init(&pdc_client_addr_mutex_g);
     hg_thread_mutex_init(&pdc_time_mutex_g);
     hg_thread_mutex_init(&pdc_bloom_time_mutex_g);
@@ -851,6 +950,7 @@ drc_access_again:
     hg_thread_mutex_init(&data_write_list_mutex_g);
     hg_thread_mutex_init(&pdc_server_task_mutex_g);
     hg_thread_mutex_init(&region_struct_mutex_g);
+    hg_thread_mutex_init(&pdc_snapshot_mutex_g);
     hg_thread_mutex_init(&data_buf_map_mutex_g);
     hg_thread_mutex_init(&data_buf_unmap_mutex_g);
     hg_thread_mutex_init(&meta_buf_map_mutex_g);
@@ -861,6 +961,7 @@ drc_access_again:
     hg_thread_mutex_init(&lock_request_mutex_g);
     hg_thread_mutex_init(&addr_valid_mutex_g);
     hg_thread_mutex_init(&update_remote_server_addr_mutex_g);
+    hg_thread_mutex_init(&client_shm_arena_mutex_g);
 #else
     if (pdc_server_rank_g == 0)
         printf("==PDC_SERVER[%d]: without multi-thread!\n", pdc_server_rank_g);
@@ -871,13 +972,25 @@ drc_access_again:
         printf("==PDC_SERVER[%d]: Read cache enabled!\n", pdc_server_rank_g);
 #endif
 
-    // TODO: support restart with different number of servers than previous run
-    char checkpoint_file[ADDR_MAX + sizeof(int) + 1];
-    if (is_restart_g == 1) {
-        snprintf(checkpoint_file, ADDR_MAX + sizeof(int), "%s%s%d", pdc_server_tmp_dir_g,
-                 "metadata_checkpoint.", pdc_server_rank_g);
+    // Kvtag lists beyond the cache size are spilled to a log in the tmp dir, restored ones included. The
+    // cache only bounds the lists, the kvtag index is kept in memory and counted in total_mem_usage_g
+    char *store_cache = getenv("PDC_METADATA_STORE_CACHE_MB");
+    if (store_cache != NULL && atol(store_cache) > 0) {
+        char store_file[ADDR_MAX + sizeof(int) + 1];
+        snprintf(store_file, ADDR_MAX + sizeof(int), "%s%s%d", pdc_server_tmp_dir_g, "metadata_store.",
+                 pdc_server_rank_g);
+        ret_value = PDC_Server_meta_store_open(store_file, (size_t)atol(store_cache) << 20);
+        if (ret_value != SUCCEED) {
+            printf("==PDC_SERVER[%d]: error with PDC_Server_meta_store_open\n", pdc_server_rank_g);
+            goto done;
+        }
+        if (pdc_server_rank_g == 0)
+            printf("==PDC_SERVER[%d]: metadata store enabled with a %s MB cache\n", pdc_server_rank_g,
+                   store_cache);
+    }
 
-        ret_value = PDC_Server_restart(checkpoint_file);
+    if (is_restart_g == 1) {
+        ret_value = PDC_Server_restart();
         if (ret_value != SUCCEED) {
             printf("==PDC_SERVER[%d]: error with PDC_Server_restart\n", pdc_server_rank_g);
             goto done;
@@ -907,6 +1020,23 @@ drc_access_again:
 
     n_metadata_g = 0;
 
+#ifndef DISABLE_CHECKPOINT
+    // Changes since the last checkpoint are in the write-ahead log
+    char *disable_checkpoint = getenv("PDC_DISABLE_CHECKPOINT");
+    if (disable_checkpoint == NULL || strcmp(disable_checkpoint, "TRUE") != 0) {
+        char wal_file[ADDR_MAX + sizeof(int) + 1];
+        snprintf(wal_file, ADDR_MAX + sizeof(int), "%s%s%d", pdc_server_tmp_dir_g, "metadata_wal.",
+                 pdc_server_rank_g);
+        if (is_restart_g == 1 && PDC_Server_wal_replay(wal_file) != SUCCEED)
+            printf("==PDC_SERVER[%d]: error with PDC_Server_wal_replay\n", pdc_server_rank_g);
+        ret_value = PDC_Server_wal_open(wal_file, is_restart_g != 1);
+        if (ret_value != SUCCEED) {
+            printf("==PDC_SERVER[%d]: error with PDC_Server_wal_open\n", pdc_server_rank_g);
+            goto done;
+        }
+    }
+#endif
+
     // PDC transfer_request infrastructures
     transfer_request_status_list = NULL;
     pthread_mutex_init(&transfer_request_status_mutex, NULL);
@@ -992,9 +1122,20 @@ PDC_Server_finalize()
         io_elt->region_list_head = NULL;
     }
 
-    // Free hash table
+    // Free hash table, the ID index only references metadata owned by metadata_hash_table_g
+    if (metadata_id_hash_table_g != NULL)
+        hash_table_free(metadata_id_hash_table_g);
     if (metadata_hash_table_g != NULL)
         hash_table_free(metadata_hash_table_g);
+    PDC_Server_name_index_free();
+    PDC_Server_kvtag_index_free();
+    PDC_Server_query_index_free();
+    PDC_Server_meta_store_close();
+    PDC_Server_wal_close();
+    PDC_Server_file_table_free();
+    PDC_hash_ring_free();
+    // All metadata strings and file paths are gone with the tables above
+    PDC_str_arena_free();
 
     ret_value = PDC_Server_destroy_client_info(pdc_client_info_g);
     if (ret_value != SUCCEED) {
@@ -1053,8 +1194,9 @@ PDC_Server_finalize()
     hg_thread_mutex_destroy(&hash_table_new_mutex_g);
     hg_thread_mutex_destroy(&pdc_client_info_mutex_g);
     hg_thread_mutex_destroy(&pdc_time_mutex_g);
-    hg_thread_mutex_destroy(&pdc_metadata_hash_table_mutex_g);
-    hg_thread_mutex_destroy(&pdc_container_hash_table_mutex_g);
+    hg_thread_rwlock_destroy(&pdc_metadata_hash_table_rwlock_g);
+    hg_thread_rwlock_destroy(&pdc_container_hash_table_rwlock_g);
+    hg_thread_mutex_destroy(&pdc_kvtag_index_mutex_g);
     hg_thread_mutex_destroy(&pdc_client_addr_mutex_g);
     hg_thread_mutex_destroy(&pdc_bloom_time_mutex_g);
     hg_thread_mutex_destroy(&n_metadata_mutex_g);
@@ -1064,6 +1206,7 @@ PDC_Server_finalize()
     hg_thread_mutex_destroy(&data_write_list_mutex_g);
     hg_thread_mutex_destroy(&pdc_server_task_mutex_g);
     hg_thread_mutex_destroy(&region_struct_mutex_g);
+    hg_thread_mutex_destroy(&pdc_snapshot_mutex_g);
     hg_thread_mutex_destroy(&data_buf_map_mutex_g);
     hg_thread_mutex_destroy(&data_buf_unmap_mutex_g);
     hg_thread_mutex_destroy(&meta_buf_map_mutex_g);
@@ -1074,7 +1217,9 @@ PDC_Server_finalize()
     hg_thread_mutex_destroy(&lock_request_mutex_g);
     hg_thread_mutex_destroy(&addr_valid_mutex_g);
     hg_thread_mutex_destroy(&update_remote_server_addr_mutex_g);
+    hg_thread_mutex_destroy(&client_shm_arena_mutex_g);
 #endif
+    PDC_Server_detach_all_client_shm();
     PDC_Server_clear_obj_region();
     pthread_mutex_destroy(&transfer_request_status_mutex);
     pthread_mutex_destroy(&transfer_request_id_mutex);
@@ -1106,9 +1251,11 @@ PDC_Server_recv_shm_cb(const struct hg_cb_info *callback_info)
 
     shm_info = (pdc_shm_info_t *)callback_info->arg;
 
-    printf("==PDC_SERVER[%d]: recv shm from %d: [%s], %" PRIu64 "\n", pdc_server_rank_g, shm_info->client_id,
-           shm_info->shm_addr, shm_info->size);
-    // TODO
+    // The arena has been attached before responding, see PDC_Server_attach_client_shm
+    if (is_debug_g == 1)
+        printf("==PDC_SERVER[%d]: recv shm from %d: [%s], %" PRIu64 "\n", pdc_server_rank_g,
+               shm_info->client_id, shm_info->shm_addr, shm_info->size);
+    free(shm_info);
 
     return HG_SUCCESS;
 }
@@ -1122,469 +1269,1661 @@ PDC_Server_checkpoint_cb()
 }
 
 /*
- * Checkpoint in-memory metadata to persistant storage, each server writes to one file
+ * Append data to the checkpoint block being built
  *
- * \param  filename[IN]     Checkpoint file name
+ * \param  writer[IN/OUT]   Checkpoint writer
+ * \param  src[IN]          Data
+ * \param  size[IN]         Data size
+ */
+static void
+PDC_Server_checkpoint_put(pdc_checkpoint_writer_t *writer, const void *src, size_t size)
+{
+    size_t new_alloc;
+    char * new_buf;
+
+    FUNC_ENTER(NULL);
+
+    if (writer->size + size > writer->alloc) {
+        new_alloc = writer->alloc == 0 ? PDC_CHECKPOINT_BLOCK_SIZE : writer->alloc;
+        while (new_alloc < writer->size + size)
+            new_alloc *= 2;
+        new_buf = (char *)realloc(writer->buf, new_alloc);
+        if (new_buf == NULL) {
+            writer->status = FAIL;
+            goto done;
+        }
+        writer->buf   = new_buf;
+        writer->alloc = new_alloc;
+    }
+    memcpy(writer->buf + writer->size, src, size);
+    writer->size += size;
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Append a length-prefixed string to the checkpoint block being built
+ *
+ * \param  writer[IN/OUT]   Checkpoint writer
+ * \param  str[IN]          String to write
+ */
+static void
+PDC_Server_checkpoint_put_str(pdc_checkpoint_writer_t *writer, const char *str)
+{
+    int len;
+
+    FUNC_ENTER(NULL);
+
+    len = strlen(str) + 1;
+    PDC_Server_checkpoint_put(writer, &len, sizeof(int));
+    PDC_Server_checkpoint_put(writer, str, len);
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Write the block being built with its header and checksum, and start a new one of the given type
+ *
+ * \param  writer[IN/OUT]   Checkpoint writer
+ * \param  type[IN]         Type of the next block
+ */
+static void
+PDC_Server_checkpoint_flush_block(pdc_checkpoint_writer_t *writer, uint32_t type)
+{
+    pdc_checkpoint_block_header_t header;
+
+    FUNC_ENTER(NULL);
+
+    if (writer->n_entry > 0 && writer->status == SUCCEED) {
+        header.type     = writer->type;
+        header.n_entry  = writer->n_entry;
+        header.n_record = writer->n_record;
+        header.checksum = PDC_Server_checksum(writer->buf, writer->size);
+        header.size     = writer->size;
+        if (fwrite(&header, sizeof(header), 1, writer->file) != 1 ||
+            fwrite(writer->buf, 1, writer->size, writer->file) != writer->size)
+            writer->status = FAIL;
+        writer->n_block++;
+    }
+    writer->type     = type;
+    writer->size     = 0;
+    writer->n_entry  = 0;
+    writer->n_record = 0;
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Count an entry added to the block being built, and write the block once it is full. Blocks only end
+ * between entries so restart can decode them independently.
+ *
+ * \param  writer[IN/OUT]   Checkpoint writer
+ */
+static void
+PDC_Server_checkpoint_end_entry(pdc_checkpoint_writer_t *writer)
+{
+    FUNC_ENTER(NULL);
+
+    writer->n_entry++;
+    if (writer->size >= PDC_CHECKPOINT_BLOCK_SIZE)
+        PDC_Server_checkpoint_flush_block(writer, writer->type);
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Append one metadata record with its kv tags and regions to the checkpoint block being built
+ *
+ * \param  writer[IN/OUT]   Checkpoint writer
+ * \param  elt[IN]          Metadata
+ * \param  region[IN]       Storage region of the object on this data server, or NULL
+ *
+ * \return Number of regions written
+ */
+static int
+PDC_Server_checkpoint_put_metadata(pdc_checkpoint_writer_t *writer, pdc_metadata_t *elt,
+                                   data_server_region_t *region)
+{
+    int               ret_value = 0;
+    region_list_t *   region_elt;
+    region_extent_t * extent_elt;
+    pdc_kvtag_list_t *kvlist_elt, *kvlist_head;
+    region_extent_t   extent;
+    int               n_region, n_kvtag, key_len, has_hist, is_copy;
+
+    FUNC_ENTER(NULL);
+
+    // Write entire metadata structure, followed by the strings it points to
+    PDC_Server_checkpoint_put(writer, elt, sizeof(pdc_metadata_t));
+    PDC_Server_checkpoint_put_str(writer, elt->app_name);
+    PDC_Server_checkpoint_put_str(writer, elt->obj_name);
+    PDC_Server_checkpoint_put_str(writer, elt->tags);
+    PDC_Server_checkpoint_put_str(writer, elt->data_location);
+
+    // Write kv tags, including the ones spilled to the metadata store
+    kvlist_head = PDC_Server_meta_store_peek(elt, &is_copy);
+    DL_COUNT(kvlist_head, kvlist_elt, n_kvtag);
+    PDC_Server_checkpoint_put(writer, &n_kvtag, sizeof(int));
+    DL_FOREACH(kvlist_head, kvlist_elt)
+    {
+        key_len = strlen(kvlist_elt->kvtag->name) + 1;
+        PDC_Server_checkpoint_put(writer, &key_len, sizeof(int));
+        PDC_Server_checkpoint_put(writer, kvlist_elt->kvtag->name, key_len);
+        PDC_Server_checkpoint_put(writer, &kvlist_elt->kvtag->size, sizeof(uint32_t));
+        PDC_Server_checkpoint_put(writer, kvlist_elt->kvtag->value, kvlist_elt->kvtag->size);
+    }
+    if (is_copy)
+        PDC_Server_meta_store_free_list(kvlist_head);
+
+    // Write region info
+    DL_COUNT(elt->storage_region_list_head, region_elt, n_region);
+    PDC_Server_checkpoint_put(writer, &n_region, sizeof(int));
+    DL_FOREACH(elt->storage_region_list_head, region_elt)
+    {
+        // Only the extent is persistent, the rest of region_list_t is I/O state
+        memset(&extent, 0, sizeof(region_extent_t));
+        extent.ndim = region_elt->ndim;
+        memcpy(extent.start, region_elt->start, sizeof(uint64_t) * DIM_MAX);
+        memcpy(extent.count, region_elt->count, sizeof(uint64_t) * DIM_MAX);
+        extent.offset    = region_elt->offset;
+        extent.data_size = region_elt->data_size;
+        extent.file_id   = PDC_Server_file_table_find_id(region_elt->storage_location);
+        PDC_Server_checkpoint_put(writer, &extent, sizeof(region_extent_t));
+        has_hist = region_elt->region_hist != NULL ? 1 : 0;
+        PDC_Server_checkpoint_put(writer, &has_hist, sizeof(int));
+        if (has_hist == 1) {
+            PDC_Server_checkpoint_put(writer, &region_elt->region_hist->dtype, sizeof(int));
+            PDC_Server_checkpoint_put(writer, &region_elt->region_hist->nbin, sizeof(int));
+            PDC_Server_checkpoint_put(writer, region_elt->region_hist->range,
+                                      sizeof(double) * region_elt->region_hist->nbin * 2);
+            PDC_Server_checkpoint_put(writer, region_elt->region_hist->bin,
+                                      sizeof(uint64_t) * region_elt->region_hist->nbin);
+            PDC_Server_checkpoint_put(writer, &region_elt->region_hist->incr, sizeof(double));
+        }
+    }
+    ret_value += n_region;
+
+    // Write storage region info
+    n_region = 0;
+    if (region)
+        DL_COUNT(region->region_storage_head, extent_elt, n_region);
+    PDC_Server_checkpoint_put(writer, &n_region, sizeof(int));
+    if (region) {
+        DL_FOREACH(region->region_storage_head, extent_elt)
+        PDC_Server_checkpoint_put(writer, extent_elt, sizeof(region_extent_t));
+    }
+    ret_value += n_region;
+
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Add the data files of the stored regions of every object to the file table, before the checkpoint is
+ * written with the tables locked. The writer only looks their IDs up, so that a snapshot child neither
+ * allocates table entries nor takes locks that are not held across the fork.
+ */
+static void
+PDC_Server_checkpoint_add_files()
+{
+    pdc_metadata_t *           elt;
+    region_list_t *            region_elt;
+    pdc_hash_table_entry_head *head;
+    HashTablePair              pair;
+    HashTableIterator          hash_table_iter;
+
+    FUNC_ENTER(NULL);
+
+    hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
+    while (hash_table_iter_has_more(&hash_table_iter)) {
+        pair = hash_table_iter_next(&hash_table_iter);
+        head = pair.value;
+        DL_FOREACH(head->metadata, elt)
+        {
+            DL_FOREACH(elt->storage_region_list_head, region_elt)
+            PDC_Server_file_table_get_id(region_elt->storage_location);
+        }
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Write this server's checkpoint file. The file is written under a temporary name and renamed, so a
+ * crash leaves the previous checkpoint intact. Only reads the metadata, the data-server regions and the
+ * file table, which PDC_Server_checkpoint_add_files must have filled, so a snapshot child can call it.
+ *
+ * The file is a pdc_checkpoint_header_t followed by blocks, each a pdc_checkpoint_block_header_t and
+ * its payload: container blocks, then the file table, then metadata blocks of whole hash entries.
+ *
+ * \param  n_obj[OUT]       Number of objects written
+ * \param  n_reg[OUT]       Number of regions written
  *
  * \return Non-negative on success/Negative on failure
  */
-perr_t
-PDC_Server_checkpoint()
+static perr_t
+PDC_Server_checkpoint_write(int *n_obj, int *n_reg)
 {
     perr_t                       ret_value = SUCCEED;
     pdc_metadata_t *             elt;
-    region_list_t *              region_elt;
-    pdc_kvtag_list_t *           kvlist_elt;
     pdc_hash_table_entry_head *  head;
     pdc_cont_hash_table_entry_t *cont_head;
-    int      n_entry, metadata_size = 0, region_count = 0, n_region, n_write_region = 0, n_kvtag, key_len;
-    uint32_t hash_key;
-    HashTablePair     pair;
-    char              checkpoint_file[ADDR_MAX];
-    HashTableIterator hash_table_iter;
+    int                          metadata_size = 0, region_count = 0;
+    uint32_t                     hash_key, n_file, i;
+    HashTablePair                pair;
+    char                         checkpoint_file[ADDR_MAX], tmp_file[ADDR_MAX + 4];
+    HashTableIterator            hash_table_iter;
+    pdc_checkpoint_header_t      header;
+    pdc_checkpoint_writer_t      writer;
 
     FUNC_ENTER(NULL);
 
-#ifdef ENABLE_TIMING
-    // Timing
-    struct timeval pdc_timer_start;
-    struct timeval pdc_timer_end;
-    double         checkpoint_time;
-    gettimeofday(&pdc_timer_start, 0);
-#endif
-
-    // TODO: instead of checkpoint at app finalize time, try checkpoint with a time countdown or # of objects
+    memset(&writer, 0, sizeof(writer));
     snprintf(checkpoint_file, ADDR_MAX, "%s%s%d", pdc_server_tmp_dir_g, "metadata_checkpoint.",
              pdc_server_rank_g);
-    if (pdc_server_rank_g == 0) {
-        printf("\n\n==PDC_SERVER[%d]: Checkpoint file [%s]\n", pdc_server_rank_g, checkpoint_file);
-        fflush(stdout);
-    }
+    snprintf(tmp_file, ADDR_MAX + 4, "%s.tmp", checkpoint_file);
 
-    FILE *file = fopen(checkpoint_file, "w+");
-    if (file == NULL) {
+    writer.file = fopen(tmp_file, "w+");
+    if (writer.file == NULL) {
         printf("==PDC_SERVER[%d]: %s - Checkpoint file open error", pdc_server_rank_g, __func__);
         ret_value = FAIL;
         goto done;
     }
 
-    // Checkpoint containers
-    n_entry = hash_table_num_entries(container_hash_table_g);
-    fwrite(&n_entry, sizeof(int), 1, file);
+    // Log records up to this one are in the checkpoint, restart only replays the later ones
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PDC_CHECKPOINT_MAGIC, sizeof(PDC_CHECKPOINT_MAGIC));
+    header.version  = PDC_CHECKPOINT_VERSION;
+    header.wal_lsn  = PDC_Server_wal_lsn();
+    header.n_server = pdc_server_size_g;
+    // Rewritten with the counts once the blocks are written
+    fwrite(&header, sizeof(header), 1, writer.file);
 
+    // Checkpoint containers
+    PDC_Server_checkpoint_flush_block(&writer, PDC_CHECKPOINT_BLOCK_CONT);
     hash_table_iterate(container_hash_table_g, &hash_table_iter);
-    while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
+    while (hash_table_iter_has_more(&hash_table_iter)) {
         pair      = hash_table_iter_next(&hash_table_iter);
         cont_head = pair.value;
 
         hash_key = PDC_get_hash_by_name(cont_head->cont_name);
-        fwrite(&hash_key, sizeof(uint32_t), 1, file);
-        fwrite(cont_head, sizeof(pdc_cont_hash_table_entry_t), 1, file);
+        PDC_Server_checkpoint_put(&writer, &hash_key, sizeof(uint32_t));
+        PDC_Server_checkpoint_put(&writer, cont_head, sizeof(pdc_cont_hash_table_entry_t));
+        // Container members, obj_ids is kept compact
+        PDC_Server_checkpoint_put(&writer, cont_head->obj_ids, sizeof(uint64_t) * cont_head->n_obj);
+        PDC_Server_checkpoint_end_entry(&writer);
+        header.n_cont++;
     }
 
-    // DHT
-    n_entry = hash_table_num_entries(metadata_hash_table_g);
-    fwrite(&n_entry, sizeof(int), 1, file);
+    // File table, region extents below refer to data files by their index in it
+    PDC_Server_checkpoint_flush_block(&writer, PDC_CHECKPOINT_BLOCK_FILE);
+    n_file = PDC_Server_file_table_size();
+    for (i = 0; i < n_file; i++) {
+        PDC_Server_checkpoint_put_str(&writer, PDC_Server_file_table_get_path(i));
+        writer.n_entry++;
+    }
 
+    // DHT, one entry per hash value
+    PDC_Server_checkpoint_flush_block(&writer, PDC_CHECKPOINT_BLOCK_META);
     hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
-
-    while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
+    while (hash_table_iter_has_more(&hash_table_iter)) {
         pair = hash_table_iter_next(&hash_table_iter);
         head = pair.value;
 
-        fwrite(&head->n_obj, sizeof(int), 1, file);
+        PDC_Server_checkpoint_put(&writer, &head->n_obj, sizeof(int));
         hash_key = PDC_get_hash_by_name(head->metadata->obj_name);
-        fwrite(&hash_key, sizeof(uint32_t), 1, file);
+        PDC_Server_checkpoint_put(&writer, &hash_key, sizeof(uint32_t));
 
         // Iterate every metadata structure in current entry
         DL_FOREACH(head->metadata, elt)
         {
-            // Write entire metadata structure
-            fwrite(elt, sizeof(pdc_metadata_t), 1, file);
-
-            // Write kv tags
-            DL_COUNT(elt->kvtag_list_head, kvlist_elt, n_kvtag);
-            fwrite(&n_kvtag, sizeof(int), 1, file);
-            DL_FOREACH(elt->kvtag_list_head, kvlist_elt)
-            {
-                key_len = strlen(kvlist_elt->kvtag->name) + 1;
-                fwrite(&key_len, sizeof(int), 1, file);
-                fwrite(kvlist_elt->kvtag->name, key_len, 1, file);
-                fwrite(&kvlist_elt->kvtag->size, sizeof(uint32_t), 1, file);
-                fwrite(kvlist_elt->kvtag->value, kvlist_elt->kvtag->size, 1, file);
-            }
-
-            // Write region info
-            DL_COUNT(elt->storage_region_list_head, region_elt, n_region);
-            fwrite(&n_region, sizeof(int), 1, file);
-            n_write_region = 0;
-            DL_FOREACH(elt->storage_region_list_head, region_elt)
-            {
-                fwrite(region_elt, sizeof(region_list_t), 1, file);
-                n_write_region++;
-                int has_hist = 0;
-                if (region_elt->region_hist != NULL)
-                    has_hist = 1;
-                fwrite(&has_hist, sizeof(int), 1, file);
-                if (has_hist == 1) {
-                    fwrite(&region_elt->region_hist->dtype, sizeof(int), 1, file);
-                    fwrite(&region_elt->region_hist->nbin, sizeof(int), 1, file);
-                    fwrite(region_elt->region_hist->range, sizeof(double), region_elt->region_hist->nbin * 2,
-                           file);
-                    fwrite(region_elt->region_hist->bin, sizeof(uint64_t), region_elt->region_hist->nbin,
-                           file);
-                    fwrite(&region_elt->region_hist->incr, sizeof(double), 1, file);
-                }
-            }
-
-            region_count += n_region;
-            if (n_write_region != n_region) {
-                printf("==PDC_SERVER[%d]: %s - ERROR with number of regions", pdc_server_rank_g, __func__);
-                ret_value = FAIL;
-                goto done;
-            }
-
-            // Write storage region info
-            data_server_region_t *region = NULL;
-            region                       = PDC_Server_get_obj_region(elt->obj_id);
-            if (region) {
-                DL_COUNT(region->region_storage_head, region_elt, n_region);
-                fwrite(&n_region, sizeof(int), 1, file);
-                DL_FOREACH(region->region_storage_head, region_elt)
-                {
-                    fwrite(region_elt, sizeof(region_list_t), 1, file);
-                }
-            }
-            else {
-                fwrite(&n_region, sizeof(int), 1, file);
-            }
-
+            region_count +=
+                PDC_Server_checkpoint_put_metadata(&writer, elt, PDC_Server_get_obj_region(elt->obj_id));
             metadata_size++;
-            region_count += n_region;
+            writer.n_record++;
         }
+        PDC_Server_checkpoint_end_entry(&writer);
     }
+    PDC_Server_checkpoint_flush_block(&writer, 0);
 
-    fclose(file);
-    file = NULL;
+    header.n_block = writer.n_block;
+    header.n_obj   = metadata_size;
+    rewind(writer.file);
+    fwrite(&header, sizeof(header), 1, writer.file);
 
-    int all_metadata_size, all_region_count;
-#ifdef ENABLE_MPI
-    MPI_Reduce(&metadata_size, &all_metadata_size, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&region_count, &all_region_count, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-#else
-    all_metadata_size = metadata_size;
-    all_region_count  = region_count;
-#endif
-    if (pdc_server_rank_g == 0) {
-        printf("==PDC_SERVER: checkpointed %d objects, with %d regions \n", all_metadata_size,
-               all_region_count);
-    }
+    fflush(writer.file);
+    fsync(fileno(writer.file));
+    fclose(writer.file);
+    writer.file = NULL;
 
-#ifdef ENABLE_TIMING
-    // Timing
-    gettimeofday(&pdc_timer_end, 0);
-    checkpoint_time = PDC_get_elapsed_time_double(&pdc_timer_start, &pdc_timer_end);
-    if (pdc_server_rank_g == 0) {
-        printf("==PDC_SERVER: total checkpoint time = %.6f\n", checkpoint_time);
+    if (writer.status != SUCCEED) {
+        printf("==PDC_SERVER[%d]: %s - error writing checkpoint file\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
     }
-#endif
+    if (rename(tmp_file, checkpoint_file) != 0) {
+        printf("==PDC_SERVER[%d]: %s - cannot rename checkpoint file\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    *n_obj = metadata_size;
+    *n_reg = region_count;
 
 done:
+    free(writer.buf);
     FUNC_LEAVE(ret_value);
 }
 
-int
-region_cmp(region_list_t *a, region_list_t *b)
+/*
+ * Hold off metadata and container updates while a checkpoint is taken, so that the tables it reads match
+ * the log position it records. The handlers of those updates wait on the table locks.
+ */
+static void
+PDC_Server_checkpoint_lock()
 {
-    int unit_size = a->ndim * sizeof(uint64_t);
-    return memcmp(a->start, b->start, unit_size);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
+    hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
+}
+
+static void
+PDC_Server_checkpoint_unlock()
+{
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
 }
 
 /*
- * Load metadata from checkpoint file in persistant storage
- *
- * \param  filename[IN]     Checkpoint file name
+ * Checkpoint synchronously in place of a snapshot that could not be taken in the background
  *
  * \return Non-negative on success/Negative on failure
  */
+static perr_t
+PDC_Server_snapshot_fallback()
+{
+    perr_t ret_value = SUCCEED;
+    int    n_obj, n_reg;
+
+    FUNC_ENTER(NULL);
+
+    PDC_Server_checkpoint_lock();
+    PDC_Server_checkpoint_add_files();
+    ret_value = PDC_Server_checkpoint_write(&n_obj, &n_reg);
+    if (ret_value == SUCCEED)
+        ret_value = PDC_Server_wal_truncate();
+    PDC_Server_checkpoint_unlock();
+
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
-PDC_Server_restart(char *filename)
+PDC_Server_snapshot_start()
 {
     perr_t ret_value = SUCCEED;
-    int    n_entry, count, i, j, nobj = 0, all_nobj = 0, all_n_region, n_region, total_region = 0, n_kvtag,
-                              key_len;
-    int                          n_cont, all_cont;
-    pdc_metadata_t *             metadata, *elt;
-    region_list_t *              region_list;
-    pdc_hash_table_entry_head *  entry;
-    pdc_cont_hash_table_entry_t *cont_entry;
-    uint32_t *                   hash_key;
-    unsigned                     idx;
+    pid_t  pid;
+    int    n_obj, n_reg;
 
     FUNC_ENTER(NULL);
 
-    // init hash table
-    ret_value = PDC_Server_init_hash_table();
-    if (ret_value != SUCCEED) {
-        printf("==PDC_SERVER[%d]: %s - PDC_Server_init_hash_table FAILED!", pdc_server_rank_g, __func__);
-        ret_value = FAIL;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_snapshot_mutex_g);
+#endif
+    if (pdc_snapshot_pid_g > 0)
         goto done;
-    }
 
-    FILE *file = fopen(filename, "r");
-    if (file == NULL) {
-        printf("==PDC_SERVER[%d]: %s -  Checkpoint file open FAILED [%s]!", pdc_server_rank_g, __func__,
-               filename);
-        ret_value = FAIL;
+    fflush(stdout);
+    gettimeofday(&pdc_snapshot_start_g, 0);
+
+    // No update may land between the rotation and the fork, or it would be in neither the snapshot nor
+    // the new segment
+    PDC_Server_checkpoint_lock();
+
+    // Records logged from now on go to a new segment, the snapshot covers the retired one
+    if (PDC_Server_wal_rotate() != SUCCEED) {
+        PDC_Server_checkpoint_unlock();
+        ret_value = PDC_Server_snapshot_fallback();
         goto done;
     }
 
-    char *slurm_jobid = getenv("SLURM_JOB_ID");
-    if (slurm_jobid == NULL) {
-        printf("Error getting slurm job id from SLURM_JOB_ID!\n");
+    PDC_Server_checkpoint_add_files();
+
+    // The child only has a copy of this thread, so no other thread may hold a lock it needs at the fork
+    // or be changing what it reads. It does not intern strings or add files, so it needs no other lock.
+    PDC_Server_data_fork_prepare();
+    PDC_Server_meta_store_fork_prepare();
+    PDC_Server_wal_fork_prepare();
+    pid = fork();
+    PDC_Server_wal_fork_done();
+    PDC_Server_meta_store_fork_done();
+    PDC_Server_data_fork_done();
+    if (pid == 0) {
+        // Child: write the checkpoint and leave without running the parent's exit handlers
+        _exit(PDC_Server_checkpoint_write(&n_obj, &n_reg) == SUCCEED ? 0 : 1);
     }
+    PDC_Server_checkpoint_unlock();
 
-    // init hash table
-    PDC_Server_init_hash_table();
-
-    if (fread(&n_cont, sizeof(int), 1, file) != 1) {
-        printf("Read failed for n_count\n");
+    if (pid < 0) {
+        printf("==PDC_SERVER[%d]: %s - fork failed, checkpointing in place\n", pdc_server_rank_g, __func__);
+        ret_value = PDC_Server_snapshot_fallback();
+        goto done;
     }
-    all_cont = n_cont;
-    while (n_cont > 0) {
-        hash_key = (uint32_t *)malloc(sizeof(uint32_t));
-        if (fread(hash_key, sizeof(uint32_t), 1, file) != 1) {
-            printf("Read failed for hash_key\n");
-        }
-        total_mem_usage_g += sizeof(uint32_t);
+    pdc_snapshot_pid_g = pid;
 
-        // Reconstruct hash table
-        cont_entry = (pdc_cont_hash_table_entry_t *)malloc(sizeof(pdc_cont_hash_table_entry_t));
-        total_mem_usage_g += sizeof(pdc_cont_hash_table_entry_t);
-        if (fread(cont_entry, sizeof(pdc_cont_hash_table_entry_t), 1, file) != 1) {
-            printf("Read failed for cont_entry\n");
-        }
-
-#ifdef ENABLE_MULTITHREAD
-        hg_thread_mutex_lock(&pdc_container_hash_table_mutex_g);
-#endif
-        if (hash_table_insert(container_hash_table_g, hash_key, cont_entry) != 1) {
-            printf("==PDC_SERVER[%d]: %s - hash table insert failed\n", pdc_server_rank_g, __func__);
-            ret_value = FAIL;
-        }
+done:
 #ifdef ENABLE_MULTITHREAD
-        hg_thread_mutex_unlock(&pdc_container_hash_table_mutex_g);
+    hg_thread_mutex_unlock(&pdc_snapshot_mutex_g);
 #endif
+    FUNC_LEAVE(ret_value);
+}
 
-        n_cont--;
-    } // End while
-
-    if (fread(&n_entry, sizeof(int), 1, file) != 1) {
-        printf("Read failed for n_entry\n");
-    }
-    while (n_entry > 0) {
-        if (fread(&count, sizeof(int), 1, file) != 1) {
-            printf("Read failed for count\n");
-        }
+/*
+ * Reap the background snapshot if it is done, called with the snapshot lock held
+ *
+ * \param  wait[IN]         Block until the snapshot is done when set
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+PDC_Server_snapshot_reap(int wait)
+{
+    perr_t         ret_value = SUCCEED;
+    int            status;
+    pid_t          pid;
+    char           checkpoint_file[ADDR_MAX];
+    struct stat    st;
+    struct timeval now;
+    double         elapsed;
+    uint64_t       bytes;
 
-        hash_key = (uint32_t *)malloc(sizeof(uint32_t));
-        if (fread(hash_key, sizeof(uint32_t), 1, file) != 1) {
-            printf("Read failed for hash_key\n");
-        }
-        total_mem_usage_g += sizeof(uint32_t);
-
-        // Reconstruct hash table
-        entry           = (pdc_hash_table_entry_head *)malloc(sizeof(pdc_hash_table_entry_head));
-        entry->n_obj    = 0;
-        entry->bloom    = NULL;
-        entry->metadata = NULL;
-        // Init hash table metadata (w/ bloom) with first obj
-        PDC_Server_hash_table_list_init(entry, hash_key);
-
-        metadata = (pdc_metadata_t *)calloc(sizeof(pdc_metadata_t), count);
-        for (i = 0; i < count; i++) {
-            if (fread(metadata + i, sizeof(pdc_metadata_t), 1, file) != 1) {
-                printf("Read failed for metadata\n");
-            }
+    FUNC_ENTER(NULL);
 
-            (metadata + i)->storage_region_list_head       = NULL;
-            (metadata + i)->region_lock_head               = NULL;
-            (metadata + i)->region_map_head                = NULL;
-            (metadata + i)->region_buf_map_head            = NULL;
-            (metadata + i)->bloom                          = NULL;
-            (metadata + i)->prev                           = NULL;
-            (metadata + i)->next                           = NULL;
-            (metadata + i)->kvtag_list_head                = NULL;
-            (metadata + i)->all_storage_region_distributed = 0;
+    if (pdc_snapshot_pid_g <= 0)
+        goto done;
 
-            // Read kv tags
-            if (fread(&n_kvtag, sizeof(int), 1, file) != 1) {
-                printf("Read failed for n_kvtag\n");
-            }
-            for (j = 0; j < n_kvtag; j++) {
-                pdc_kvtag_list_t *kvtag_list = (pdc_kvtag_list_t *)calloc(1, sizeof(pdc_kvtag_list_t));
-                kvtag_list->kvtag            = (pdc_kvtag_t *)malloc(sizeof(pdc_kvtag_t));
-                if (fread(&key_len, sizeof(int), 1, file) != 1) {
-                    printf("Read failed for key_len\n");
-                }
-                kvtag_list->kvtag->name = malloc(key_len);
-                if (fread((void *)(kvtag_list->kvtag->name), key_len, 1, file) != 1) {
-                    printf("Read failed for kvtag_list->kvtag->name\n");
-                }
-                if (fread(&kvtag_list->kvtag->size, sizeof(uint32_t), 1, file) != 1) {
-                    printf("Read failed for kvtag_list->kvtag->size\n");
-                }
-                kvtag_list->kvtag->value = malloc(kvtag_list->kvtag->size);
-                if (fread(kvtag_list->kvtag->value, kvtag_list->kvtag->size, 1, file) != 1) {
-                    printf("Read failed for kvtag_list->kvtag->value\n");
-                }
-                DL_APPEND((metadata + i)->kvtag_list_head, kvtag_list);
-            }
+    pid = waitpid(pdc_snapshot_pid_g, &status, wait ? 0 : WNOHANG);
+    if (pid == 0)
+        goto done;
+    pdc_snapshot_pid_g = 0;
+
+    gettimeofday(&now, 0);
+    elapsed = PDC_get_elapsed_time_double(&pdc_snapshot_start_g, &now);
+    if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("==PDC_SERVER[%d]: %s - snapshot failed, checkpointing in place\n", pdc_server_rank_g,
+               __func__);
+        ret_value = PDC_Server_snapshot_fallback();
+        goto done;
+    }
+    PDC_Server_wal_remove_old();
 
-            if (fread(&n_region, sizeof(int), 1, file) != 1) {
-                printf("Read failed for n_region\n");
-            }
-            if (n_region < 0) {
-                printf("==PDC_SERVER[%d]: %s -  Checkpoint file region number ERROR!", pdc_server_rank_g,
-                       __func__);
-                ret_value = FAIL;
-                goto done;
-            }
+    snprintf(checkpoint_file, ADDR_MAX, "%s%s%d", pdc_server_tmp_dir_g, "metadata_checkpoint.",
+             pdc_server_rank_g);
+    bytes = stat(checkpoint_file, &st) == 0 ? (uint64_t)st.st_size : 0;
+    server_snapshot_bytes_g += bytes;
+    server_snapshot_time_g += elapsed;
+    server_snapshot_count_g++;
+    printf("==PDC_SERVER[%d]: snapshot %d took %.4f s, %" PRIu64 " bytes\n", pdc_server_rank_g,
+           server_snapshot_count_g, elapsed, bytes);
+    fflush(stdout);
 
-            /* if (n_region == 0) */
-            /*     continue; */
+done:
+    FUNC_LEAVE(ret_value);
+}
 
-            total_region += n_region;
+perr_t
+PDC_Server_snapshot_poll(int wait)
+{
+    perr_t ret_value = SUCCEED;
 
-            for (j = 0; j < n_region; j++) {
-                region_list = (region_list_t *)malloc(sizeof(region_list_t));
-                if (fread(region_list, sizeof(region_list_t), 1, file) != 1) {
-                    printf("Read failed for region_list\n");
-                }
+    FUNC_ENTER(NULL);
 
-                int has_hist = 0;
-                if (fread(&has_hist, sizeof(int), 1, file) != 1) {
-                    printf("Read failed for has_list\n");
-                }
-                if (has_hist == 1) {
-                    region_list->region_hist = (pdc_histogram_t *)malloc(sizeof(pdc_histogram_t));
-                    if (fread(&region_list->region_hist->dtype, sizeof(int), 1, file) != 1) {
-                        printf("Read failed for region_list->region_hist->dtype\n");
-                    }
-                    if (fread(&region_list->region_hist->nbin, sizeof(int), 1, file) != 1) {
-                        printf("Read failed for region_list->region_hist->nbin\n");
-                    }
-                    if (region_list->region_hist->nbin == 0) {
-                        printf("==PDC_SERVER[%d]: %s -  Checkpoint file histogram size is 0!",
-                               pdc_server_rank_g, __func__);
-                    }
-
-                    region_list->region_hist->range =
-                        (double *)malloc(sizeof(double) * region_list->region_hist->nbin * 2);
-                    region_list->region_hist->bin =
-                        (uint64_t *)malloc(sizeof(uint64_t) * region_list->region_hist->nbin);
-
-                    if (fread(region_list->region_hist->range, sizeof(double),
-                              region_list->region_hist->nbin * 2, file) != 1) {
-                        printf("Read failed for region_list->region_hist->range\n");
-                    }
-                    if (fread(region_list->region_hist->bin, sizeof(uint64_t), region_list->region_hist->nbin,
-                              file) != 1) {
-                        printf("Read failed for region_list->region_hist->bin\n");
-                    }
-                    if (fread(&region_list->region_hist->incr, sizeof(double), 1, file) != 1) {
-                        printf("Read failed for region_list->region_hist->incr\n");
-                    }
-                }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_snapshot_mutex_g);
+#endif
+    ret_value = PDC_Server_snapshot_reap(wait);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_snapshot_mutex_g);
+#endif
 
-                region_list->buf       = NULL;
-                region_list->data_size = 1;
-                for (idx = 0; idx < region_list->ndim; idx++)
-                    region_list->data_size *= region_list->count[idx];
-                region_list->is_data_ready            = 0;
-                region_list->shm_fd                   = 0;
-                region_list->meta                     = (metadata + i);
-                region_list->prev                     = NULL;
-                region_list->next                     = NULL;
-                region_list->overlap_storage_regions  = NULL;
-                region_list->n_overlap_storage_region = 0;
-                hg_atomic_init32(&(region_list->buf_map_refcount), 0);
-                region_list->reg_dirty_from_buf = 0;
-                region_list->access_type        = PDC_NA;
-                region_list->bulk_handle        = NULL;
-                region_list->lock_handle        = NULL;
-                region_list->addr               = NULL;
-                region_list->obj_id             = (metadata + i)->obj_id;
-                region_list->reg_id             = 0;
-                region_list->from_obj_id        = 0;
-                region_list->client_id          = 0;
-                region_list->is_io_done         = 0;
-                region_list->is_shm_closed      = 0;
-                region_list->seq_id             = 0;
-                region_list->sent_to_server     = 0;
-                region_list->io_cache_region    = NULL;
-
-                memset(region_list->shm_addr, 0, ADDR_MAX);
-                memset(region_list->client_ids, 0, PDC_SERVER_MAX_PROC_PER_NODE * sizeof(uint32_t));
-
-                if (strstr(region_list->storage_location, "/global/cscratch") != NULL) {
-                    region_list->data_loc_type = PDC_LUSTRE;
-                }
+    FUNC_LEAVE(ret_value);
+}
 
-                DL_APPEND((metadata + i)->storage_region_list_head, region_list);
-            } // For j
+/*
+ * Checkpoint in-memory metadata to persistant storage, each server writes to one file
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t
+PDC_Server_checkpoint()
+{
+    perr_t ret_value     = SUCCEED;
+    int    metadata_size = 0, region_count = 0;
 
-            // read storage region info
-            if (fread(&n_region, sizeof(int), 1, file) != 1) {
-                printf("Read failed for n_region\n");
-            }
-            data_server_region_t *new_obj_reg =
-                (data_server_region_t *)calloc(1, sizeof(struct data_server_region_t));
-            new_obj_reg->fd               = -1;
-            new_obj_reg->storage_location = (char *)malloc(sizeof(char) * ADDR_MAX);
-            DL_APPEND(dataserver_region_g, new_obj_reg);
-            new_obj_reg->obj_id = (metadata + i)->obj_id;
-            for (j = 0; j < n_region; j++) {
-                region_list_t *new_region_list = (region_list_t *)malloc(sizeof(region_list_t));
-                if (fread(new_region_list, sizeof(region_list_t), 1, file) != 1) {
-                    printf("Read failed for new_region_list\n");
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_TIMING
+    // Timing
+    struct timeval pdc_timer_start;
+    struct timeval pdc_timer_end;
+    double         checkpoint_time;
+    gettimeofday(&pdc_timer_start, 0);
+#endif
+
+    if (pdc_server_rank_g == 0) {
+        printf("\n\n==PDC_SERVER[%d]: Checkpoint file [%s%s%d]\n", pdc_server_rank_g, pdc_server_tmp_dir_g,
+               "metadata_checkpoint.", pdc_server_rank_g);
+        fflush(stdout);
+    }
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_snapshot_mutex_g);
+#endif
+    // A snapshot still being written would race with this checkpoint for the file
+    if (pdc_snapshot_pid_g > 0)
+        PDC_Server_snapshot_reap(1);
+
+    PDC_Server_checkpoint_lock();
+    PDC_Server_checkpoint_add_files();
+    ret_value = PDC_Server_checkpoint_write(&metadata_size, &region_count);
+    if (ret_value == SUCCEED)
+        ret_value = PDC_Server_wal_truncate();
+    PDC_Server_checkpoint_unlock();
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_snapshot_mutex_g);
+#endif
+
+    int all_metadata_size, all_region_count;
+#ifdef ENABLE_MPI
+    MPI_Reduce(&metadata_size, &all_metadata_size, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&region_count, &all_region_count, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+#else
+    all_metadata_size = metadata_size;
+    all_region_count  = region_count;
+#endif
+    if (pdc_server_rank_g == 0) {
+        printf("==PDC_SERVER: checkpointed %d objects, with %d regions \n", all_metadata_size,
+               all_region_count);
+    }
+
+#ifdef ENABLE_TIMING
+    // Timing
+    gettimeofday(&pdc_timer_end, 0);
+    checkpoint_time = PDC_get_elapsed_time_double(&pdc_timer_start, &pdc_timer_end);
+    if (pdc_server_rank_g == 0) {
+        printf("==PDC_SERVER: total checkpoint time = %.6f\n", checkpoint_time);
+    }
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+int
+region_cmp(region_list_t *a, region_list_t *b)
+{
+    int unit_size = a->ndim * sizeof(uint64_t);
+    return memcmp(a->start, b->start, unit_size);
+}
+
+/*
+ * Read data from a checkpoint block, marking the cursor bad if the block is too short
+ *
+ * \param  cursor[IN/OUT]   Read position in the block
+ * \param  dst[OUT]         Destination
+ * \param  size[IN]         Data size
+ */
+static void
+PDC_Server_restart_get(pdc_restart_cursor_t *cursor, void *dst, size_t size)
+{
+    FUNC_ENTER(NULL);
+
+    if (cursor->error || (size_t)(cursor->end - cursor->pos) < size) {
+        cursor->error = 1;
+        memset(dst, 0, size);
+        goto done;
+    }
+    memcpy(dst, cursor->pos, size);
+    cursor->pos += size;
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Read a length-prefixed string from a checkpoint block
+ *
+ * \param  cursor[IN/OUT]   Read position in the block
+ *
+ * \return Pointer to the string in the mapped checkpoint, "" if it is malformed
+ */
+static const char *
+PDC_Server_restart_get_str(pdc_restart_cursor_t *cursor)
+{
+    const char *ret_value = "";
+    int         len;
+
+    FUNC_ENTER(NULL);
+
+    PDC_Server_restart_get(cursor, &len, sizeof(int));
+    if (cursor->error || len <= 0 || cursor->end - cursor->pos < len || cursor->pos[len - 1] != '\0') {
+        cursor->error = 1;
+        goto done;
+    }
+    ret_value = cursor->pos;
+    cursor->pos += len;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Create the storage region of an object from its checkpointed extent
+ *
+ * \param  extent[IN]       Extent of the region
+ * \param  meta[IN]         Metadata of the object
+ *
+ * \return Region/NULL on failure
+ */
+static region_list_t *
+PDC_Server_restart_region(region_extent_t *extent, pdc_metadata_t *meta)
+{
+    region_list_t *ret_value = NULL;
+    const char *   path;
+    unsigned       idx;
+
+    FUNC_ENTER(NULL);
+
+    ret_value = (region_list_t *)malloc(sizeof(region_list_t));
+    if (ret_value == NULL)
+        goto done;
+    PDC_init_region_list(ret_value);
+
+    ret_value->ndim = extent->ndim;
+    memcpy(ret_value->start, extent->start, sizeof(uint64_t) * DIM_MAX);
+    memcpy(ret_value->count, extent->count, sizeof(uint64_t) * DIM_MAX);
+    ret_value->offset = extent->offset;
+    path              = PDC_Server_file_table_get_path(extent->file_id);
+    if (path != NULL)
+        snprintf(ret_value->storage_location, ADDR_MAX, "%s", path);
+    ret_value->data_size = 1;
+    for (idx = 0; idx < ret_value->ndim; idx++)
+        ret_value->data_size *= ret_value->count[idx];
+    ret_value->meta   = meta;
+    ret_value->obj_id = meta->obj_id;
+
+    if (strstr(ret_value->storage_location, "/global/cscratch") != NULL)
+        ret_value->data_loc_type = PDC_LUSTRE;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Read the histogram of a checkpointed region
+ *
+ * \param  cursor[IN/OUT]   Read position in the block
+ *
+ * \return Histogram/NULL on failure
+ */
+static pdc_histogram_t *
+PDC_Server_restart_hist(pdc_restart_cursor_t *cursor)
+{
+    pdc_histogram_t *ret_value = NULL;
+    int              dtype, nbin;
+
+    FUNC_ENTER(NULL);
+
+    PDC_Server_restart_get(cursor, &dtype, sizeof(int));
+    PDC_Server_restart_get(cursor, &nbin, sizeof(int));
+    if (cursor->error || nbin <= 0 ||
+        (size_t)(cursor->end - cursor->pos) < (sizeof(double) * 2 + sizeof(uint64_t)) * nbin) {
+        printf("==PDC_SERVER[%d]: %s -  Checkpoint file histogram size is 0!", pdc_server_rank_g, __func__);
+        cursor->error = 1;
+        goto done;
+    }
+
+    ret_value        = (pdc_histogram_t *)malloc(sizeof(pdc_histogram_t));
+    ret_value->dtype = dtype;
+    ret_value->nbin  = nbin;
+    ret_value->range = (double *)malloc(sizeof(double) * nbin * 2);
+    ret_value->bin   = (uint64_t *)malloc(sizeof(uint64_t) * nbin);
+    PDC_Server_restart_get(cursor, ret_value->range, sizeof(double) * nbin * 2);
+    PDC_Server_restart_get(cursor, ret_value->bin, sizeof(uint64_t) * nbin);
+    PDC_Server_restart_get(cursor, &ret_value->incr, sizeof(double));
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Map a file ID of a checkpoint block to the file table of this server
+ *
+ * \param  block[IN]        Block being decoded
+ * \param  file_id[IN]      File ID in the checkpoint
+ *
+ * \return File ID in this server's file table
+ */
+static uint32_t
+PDC_Server_restart_file_id(pdc_restart_block_t *block, uint32_t file_id)
+{
+    uint32_t ret_value = file_id;
+
+    FUNC_ENTER(NULL);
+
+    if (block->file_map != NULL && file_id < block->n_file)
+        ret_value = block->file_map[file_id];
+
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Decode the metadata records of one checkpoint block into their arena slots. Runs on a restart thread,
+ * so it only allocates and reads the file table; the records are indexed afterwards.
+ *
+ * \param  block[IN/OUT]    Block to decode
+ */
+static void
+PDC_Server_restart_decode_block(pdc_restart_block_t *block)
+{
+    pdc_restart_cursor_t  cursor;
+    pdc_metadata_t *      meta;
+    pdc_kvtag_list_t *    kvtag_list;
+    region_list_t *       region_list;
+    region_extent_t       extent, *new_extent;
+    data_server_region_t *obj_reg;
+    uint32_t              e, rec = 0;
+    int                   count, i, j, n_kvtag, n_region, key_len, has_hist;
+
+    FUNC_ENTER(NULL);
+
+    block->status = FAIL;
+    if (PDC_Server_checksum(block->payload, block->header.size) != block->header.checksum) {
+        printf("==PDC_SERVER[%d]: %s - checkpoint block checksum mismatch\n", pdc_server_rank_g, __func__);
+        goto done;
+    }
+
+    cursor.pos          = block->payload;
+    cursor.end          = block->payload + block->header.size;
+    cursor.error        = 0;
+    block->entry_keys   = (uint32_t *)malloc(sizeof(uint32_t) * block->header.n_entry);
+    block->entry_counts = (int *)malloc(sizeof(int) * block->header.n_entry);
+    if (block->entry_keys == NULL || block->entry_counts == NULL)
+        goto done;
+
+    for (e = 0; e < block->header.n_entry && !cursor.error; e++) {
+        PDC_Server_restart_get(&cursor, &count, sizeof(int));
+        PDC_Server_restart_get(&cursor, &block->entry_keys[e], sizeof(uint32_t));
+        if (count <= 0 || rec + count > block->header.n_record)
+            goto done;
+        block->entry_counts[e] = count;
+
+        for (i = 0; i < count && !cursor.error; i++, rec++) {
+            meta = block->metadata + rec;
+            PDC_Server_restart_get(&cursor, meta, sizeof(pdc_metadata_t));
+            // Strings point into the mapped file until the record is indexed
+            meta->app_name      = PDC_Server_restart_get_str(&cursor);
+            meta->obj_name      = PDC_Server_restart_get_str(&cursor);
+            meta->tags          = PDC_Server_restart_get_str(&cursor);
+            meta->data_location = PDC_Server_restart_get_str(&cursor);
+
+            meta->storage_region_list_head       = NULL;
+            meta->region_lock_head               = NULL;
+            meta->region_map_head                = NULL;
+            meta->region_buf_map_head            = NULL;
+            meta->obj_hist                       = NULL;
+            meta->bloom                          = NULL;
+            meta->prev                           = NULL;
+            meta->next                           = NULL;
+            meta->kvtag_list_head                = NULL;
+            meta->all_storage_region_distributed = 0;
+
+            // Read kv tags
+            PDC_Server_restart_get(&cursor, &n_kvtag, sizeof(int));
+            for (j = 0; j < n_kvtag && !cursor.error; j++) {
+                PDC_Server_restart_get(&cursor, &key_len, sizeof(int));
+                if (key_len <= 0 || cursor.end - cursor.pos < key_len) {
+                    cursor.error = 1;
+                    break;
                 }
-                DL_APPEND(new_obj_reg->region_storage_head, new_region_list);
+                kvtag_list              = (pdc_kvtag_list_t *)calloc(1, sizeof(pdc_kvtag_list_t));
+                kvtag_list->kvtag       = (pdc_kvtag_t *)malloc(sizeof(pdc_kvtag_t));
+                kvtag_list->kvtag->name = (char *)malloc(key_len);
+                PDC_Server_restart_get(&cursor, kvtag_list->kvtag->name, key_len);
+                kvtag_list->kvtag->name[key_len - 1] = '\0';
+                PDC_Server_restart_get(&cursor, &kvtag_list->kvtag->size, sizeof(uint32_t));
+                if ((size_t)(cursor.end - cursor.pos) < kvtag_list->kvtag->size)
+                    kvtag_list->kvtag->size = 0;
+                kvtag_list->kvtag->value = malloc(kvtag_list->kvtag->size);
+                PDC_Server_restart_get(&cursor, kvtag_list->kvtag->value, kvtag_list->kvtag->size);
+                DL_APPEND(meta->kvtag_list_head, kvtag_list);
             }
 
-            total_region += n_region;
+            // Read region info
+            PDC_Server_restart_get(&cursor, &n_region, sizeof(int));
+            for (j = 0; j < n_region && !cursor.error; j++) {
+                PDC_Server_restart_get(&cursor, &extent, sizeof(region_extent_t));
+                PDC_Server_restart_get(&cursor, &has_hist, sizeof(int));
+                if (cursor.error || extent.ndim > DIM_MAX)
+                    goto done;
+                extent.file_id = PDC_Server_restart_file_id(block, extent.file_id);
+                region_list = PDC_Server_restart_region(&extent, meta);
+                if (region_list == NULL)
+                    goto done;
+                if (has_hist == 1)
+                    region_list->region_hist = PDC_Server_restart_hist(&cursor);
+                DL_APPEND(meta->storage_region_list_head, region_list);
+            }
+            block->n_region += n_region;
+            DL_SORT(meta->storage_region_list_head, region_cmp);
+
+            // Read storage region info, all extents of an object are in the object's data file
+            PDC_Server_restart_get(&cursor, &n_region, sizeof(int));
+            obj_reg = NULL;
+            if (n_region > 0) {
+                obj_reg                   = (data_server_region_t *)calloc(1, sizeof(data_server_region_t));
+                obj_reg->fd               = -1;
+                obj_reg->obj_id           = meta->obj_id;
+                obj_reg->storage_location = (char *)calloc(ADDR_MAX, sizeof(char));
+            }
+            for (j = 0; j < n_region && !cursor.error; j++) {
+                new_extent = (region_extent_t *)malloc(sizeof(region_extent_t));
+                PDC_Server_restart_get(&cursor, new_extent, sizeof(region_extent_t));
+                new_extent->file_id = PDC_Server_restart_file_id(block, new_extent->file_id);
+                if (j == 0 && PDC_Server_file_table_get_path(new_extent->file_id) != NULL)
+                    snprintf(obj_reg->storage_location, ADDR_MAX, "%s",
+                             PDC_Server_file_table_get_path(new_extent->file_id));
+                DL_APPEND(obj_reg->region_storage_head, new_extent);
+            }
+            block->obj_regions[rec] = obj_reg;
+            block->n_region += n_region;
+        }
+    }
+
+    if (!cursor.error && rec == block->header.n_record && e == block->header.n_entry)
+        block->status = SUCCEED;
+
+done:
+    if (block->status != SUCCEED)
+        printf("==PDC_SERVER[%d]: %s - malformed checkpoint block\n", pdc_server_rank_g, __func__);
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Restart thread, decodes every stride-th metadata block starting at first
+ */
+static void *
+PDC_Server_restart_worker(void *arg)
+{
+    pdc_restart_worker_t *worker = (pdc_restart_worker_t *)arg;
+    int                   i;
+
+    for (i = worker->first; i < worker->n_block; i += worker->stride)
+        PDC_Server_restart_decode_block(&worker->blocks[i]);
+
+    return NULL;
+}
+
+/*
+ * Free a decoded record that was sent to the server that owns it now
+ *
+ * \param  meta[IN]         Decoded metadata, its slot in the restart array is not reused
+ * \param  obj_reg[IN]      Decoded storage region of the object, or NULL
+ */
+static void
+PDC_Server_restart_free_record(pdc_metadata_t *meta, data_server_region_t *obj_reg)
+{
+    pdc_kvtag_list_t *kvtag_elt, *kvtag_tmp;
+    region_list_t *   region_elt, *region_tmp;
+    region_extent_t * extent_elt, *extent_tmp;
+
+    FUNC_ENTER(NULL);
+
+    DL_FOREACH_SAFE(meta->kvtag_list_head, kvtag_elt, kvtag_tmp)
+    {
+        DL_DELETE(meta->kvtag_list_head, kvtag_elt);
+        free(kvtag_elt->kvtag->name);
+        free(kvtag_elt->kvtag->value);
+        free(kvtag_elt->kvtag);
+        free(kvtag_elt);
+    }
+    DL_FOREACH_SAFE(meta->storage_region_list_head, region_elt, region_tmp)
+    {
+        DL_DELETE(meta->storage_region_list_head, region_elt);
+        if (region_elt->region_hist != NULL) {
+            free(region_elt->region_hist->range);
+            free(region_elt->region_hist->bin);
+            free(region_elt->region_hist);
+        }
+        free(region_elt);
+    }
+    if (obj_reg != NULL) {
+        DL_FOREACH_SAFE(obj_reg->region_storage_head, extent_elt, extent_tmp)
+        {
+            DL_DELETE(obj_reg->region_storage_head, extent_elt);
+            free(extent_elt);
+        }
+        free(obj_reg->storage_location);
+        free(obj_reg);
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Restore the containers of one checkpoint block, or queue them for the server that owns them when
+ * the number of servers changed
+ *
+ * \param  payload[IN]      Block payload
+ * \param  header[IN]       Block header
+ * \param  state[IN/OUT]    Restart state
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+PDC_Server_restart_containers(const char *payload, pdc_checkpoint_block_header_t *header,
+                              pdc_restart_state_t *state)
+{
+    perr_t                       ret_value = SUCCEED;
+    pdc_restart_cursor_t         cursor;
+    pdc_cont_hash_table_entry_t *cont_entry;
+    pdc_checkpoint_writer_t *    out;
+    uint32_t *                   hash_key, i, owner;
+
+    FUNC_ENTER(NULL);
+
+    cursor.pos   = payload;
+    cursor.end   = payload + header->size;
+    cursor.error = 0;
+    for (i = 0; i < header->n_entry && !cursor.error; i++) {
+        hash_key   = (uint32_t *)malloc(sizeof(uint32_t));
+        cont_entry = (pdc_cont_hash_table_entry_t *)malloc(sizeof(pdc_cont_hash_table_entry_t));
+        PDC_Server_restart_get(&cursor, hash_key, sizeof(uint32_t));
+        PDC_Server_restart_get(&cursor, cont_entry, sizeof(pdc_cont_hash_table_entry_t));
+        if (cursor.error || cont_entry->n_obj < 0 ||
+            (size_t)(cursor.end - cursor.pos) < sizeof(uint64_t) * cont_entry->n_obj) {
+            free(hash_key);
+            free(cont_entry);
+            ret_value = FAIL;
+            goto done;
+        }
+
+        owner = PDC_get_server_by_obj_id(cont_entry->cont_id, pdc_server_size_g);
+        if (state->migrate && owner != (uint32_t)pdc_server_rank_g) {
+            // Forward the entry as it is, containers do not refer to the file table
+            out = &state->cont_out[owner];
+            PDC_Server_checkpoint_put(out, hash_key, sizeof(uint32_t));
+            PDC_Server_checkpoint_put(out, cont_entry, sizeof(pdc_cont_hash_table_entry_t));
+            PDC_Server_checkpoint_put(out, cursor.pos, sizeof(uint64_t) * cont_entry->n_obj);
+            out->n_entry++;
+            cursor.pos += sizeof(uint64_t) * cont_entry->n_obj;
+            free(hash_key);
+            free(cont_entry);
+            continue;
+        }
+        total_mem_usage_g += sizeof(uint32_t) + sizeof(pdc_cont_hash_table_entry_t);
+
+        cont_entry->kvtag_list_head = NULL;
+        cont_entry->n_deleted       = 0;
+        cont_entry->n_allocated     = cont_entry->n_obj;
+        cont_entry->obj_ids         = NULL;
+        if (cont_entry->n_obj > 0) {
+            cont_entry->obj_ids = (uint64_t *)malloc(sizeof(uint64_t) * cont_entry->n_obj);
+            PDC_Server_restart_get(&cursor, cont_entry->obj_ids, sizeof(uint64_t) * cont_entry->n_obj);
+            total_mem_usage_g += sizeof(uint64_t) * cont_entry->n_obj;
+        }
+
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
+        if (hash_table_insert(container_hash_table_g, hash_key, cont_entry) != 1) {
+            printf("==PDC_SERVER[%d]: %s - hash table insert failed\n", pdc_server_rank_g, __func__);
+            ret_value = FAIL;
+        }
+        else if (PDC_Server_container_restore(cont_entry) != SUCCEED) {
+            ret_value = FAIL;
+        }
+        PDC_Server_obj_id_seq_advance(cont_entry->cont_id);
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
+        state->n_cont++;
+    }
+    if (cursor.error)
+        ret_value = FAIL;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
 
-            DL_SORT((metadata + i)->storage_region_list_head, region_cmp);
-        } // For i
+/*
+ * Insert the decoded records of one metadata block into the hash table and the indexes. When the
+ * number of servers changed, records owned by another server are queued for it instead.
+ *
+ * \param  block[IN]        Decoded block
+ * \param  state[IN/OUT]    Restart state
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+PDC_Server_restart_index_block(pdc_restart_block_t *block, pdc_restart_state_t *state)
+{
+    perr_t                     ret_value = SUCCEED;
+    pdc_hash_table_entry_head *entry;
+    pdc_metadata_t *           elt;
+    pdc_checkpoint_writer_t *  out;
+    uint32_t *                 hash_key, e, rec = 0, owner;
+    int                        i, one = 1;
 
-        nobj += count;
-        total_mem_usage_g += sizeof(pdc_hash_table_entry_head);
-        total_mem_usage_g += (sizeof(pdc_metadata_t) * count);
+    FUNC_ENTER(NULL);
 
-        entry->metadata = NULL;
+    for (e = 0; e < block->header.n_entry; e++) {
+        for (i = 0; i < block->entry_counts[e]; i++, rec++) {
+            elt   = block->metadata + rec;
+            owner = PDC_get_server_by_obj_id(elt->obj_id, pdc_server_size_g);
+            if (state->migrate && owner != (uint32_t)pdc_server_rank_g) {
+                // Send as an entry of its own, records of one name may have moved to different servers
+                out = &state->meta_out[owner];
+                PDC_Server_checkpoint_put(out, &one, sizeof(int));
+                PDC_Server_checkpoint_put(out, &block->entry_keys[e], sizeof(uint32_t));
+                PDC_Server_checkpoint_put_metadata(out, elt, block->obj_regions[rec]);
+                out->n_entry++;
+                out->n_record++;
+                PDC_Server_restart_free_record(elt, block->obj_regions[rec]);
+                continue;
+            }
 
-        // Insert the previously read metadata to the linked list (hash table entry)
-        for (i = 0; i < count; i++) {
-            elt = metadata + i;
+            // The strings point into the mapped file, the record takes its own
+            if (PDC_Server_metadata_set_strings(elt, elt->app_name, elt->obj_name, elt->tags,
+                                                elt->data_location) != SUCCEED) {
+                ret_value = FAIL;
+                goto done;
+            }
+            PDC_Server_obj_id_seq_advance(elt->obj_id);
+
+            // Records of one name can come from several checkpoint files
+            entry = hash_table_lookup(metadata_hash_table_g, &block->entry_keys[e]);
+            if (entry == NULL) {
+                hash_key = (uint32_t *)malloc(sizeof(uint32_t));
+                entry    = (pdc_hash_table_entry_head *)calloc(1, sizeof(pdc_hash_table_entry_head));
+                if (hash_key == NULL || entry == NULL) {
+                    ret_value = FAIL;
+                    goto done;
+                }
+                *hash_key = block->entry_keys[e];
+                total_mem_usage_g += sizeof(uint32_t) + sizeof(pdc_hash_table_entry_head);
+                // Init hash table metadata (w/ bloom) with first obj
+                PDC_Server_hash_table_list_init(entry, hash_key);
+            }
             // Add to hash list and bloom filter
             ret_value = PDC_Server_hash_table_list_insert(entry, elt);
             if (ret_value != SUCCEED) {
                 printf("==PDC_SERVER: error with hash table recovering from checkpoint file\n");
                 goto done;
             }
+            if (block->obj_regions[rec] != NULL)
+                DL_APPEND(dataserver_region_g, block->obj_regions[rec]);
+            state->n_obj++;
+        }
+    }
+    state->n_region += block->n_region;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Decode metadata blocks, on several threads when there are enough blocks
+ *
+ * \param  blocks[IN/OUT]   Blocks to decode
+ * \param  n_block[IN]      Number of blocks
+ */
+static void
+PDC_Server_restart_decode(pdc_restart_block_t *blocks, int n_block)
+{
+    pdc_restart_worker_t *workers = NULL;
+    pthread_t *           threads = NULL;
+    char *                nthread_env;
+    int                   n_thread, i;
+
+    FUNC_ENTER(NULL);
+
+    nthread_env = getenv("PDC_SERVER_RESTART_NTHREAD");
+    n_thread    = nthread_env != NULL ? atoi(nthread_env) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_thread > PDC_RESTART_MAX_NTHREAD)
+        n_thread = PDC_RESTART_MAX_NTHREAD;
+    if (n_thread > n_block)
+        n_thread = n_block;
+    if (n_thread < 1)
+        n_thread = 1;
+    workers = (pdc_restart_worker_t *)calloc(n_thread, sizeof(pdc_restart_worker_t));
+    threads = (pthread_t *)calloc(n_thread, sizeof(pthread_t));
+    if (workers == NULL || threads == NULL) {
+        // Decode on this thread only
+        n_thread = 0;
+        for (i = 0; i < n_block; i++)
+            PDC_Server_restart_decode_block(&blocks[i]);
+    }
+    for (i = 0; i < n_thread; i++) {
+        workers[i].blocks  = blocks;
+        workers[i].n_block = n_block;
+        workers[i].first   = i;
+        workers[i].stride  = n_thread;
+    }
+    for (i = 1; i < n_thread; i++) {
+        // Decode on this thread instead if a thread cannot be started
+        workers[i].started = pthread_create(&threads[i], NULL, PDC_Server_restart_worker, &workers[i]) == 0;
+        if (!workers[i].started)
+            PDC_Server_restart_worker(&workers[i]);
+    }
+    if (n_thread > 0)
+        PDC_Server_restart_worker(&workers[0]);
+    for (i = 1; i < n_thread; i++) {
+        if (workers[i].started)
+            pthread_join(threads[i], NULL);
+    }
+
+    free(workers);
+    free(threads);
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Load one checkpoint file. The file is mapped, metadata records are allocated in one array, and
+ * metadata blocks are decoded by several threads before they are indexed.
+ *
+ * \param  filename[IN]     Checkpoint file name
+ * \param  is_own[IN]       Whether the file was written by this server rank, whose log follows it
+ * \param  state[IN/OUT]    Restart state
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+PDC_Server_restart_file(const char *filename, int is_own, pdc_restart_state_t *state)
+{
+    perr_t                        ret_value = SUCCEED;
+    int                           fd        = -1, n_meta_block = 0, i;
+    char *                        map       = NULL;
+    size_t                        map_size  = 0, pos;
+    uint64_t                      n_rec     = 0;
+    uint32_t                      b, *file_map = NULL, n_file = 0;
+    struct stat                   st;
+    pdc_checkpoint_header_t       header;
+    pdc_checkpoint_block_header_t block_header;
+    pdc_restart_block_t *         blocks      = NULL;
+    pdc_metadata_t *              metadata    = NULL;
+    data_server_region_t **       obj_regions = NULL;
+    pdc_restart_cursor_t          cursor;
+
+    FUNC_ENTER(NULL);
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(pdc_checkpoint_header_t)) {
+        printf("==PDC_SERVER[%d]: %s -  Checkpoint file open FAILED [%s]!", pdc_server_rank_g, __func__,
+               filename);
+        ret_value = FAIL;
+        goto done;
+    }
+    map_size = st.st_size;
+    map      = (char *)mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        map = NULL;
+        printf("==PDC_SERVER[%d]: %s - cannot map checkpoint file\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    memcpy(&header, map, sizeof(pdc_checkpoint_header_t));
+    if (memcmp(header.magic, PDC_CHECKPOINT_MAGIC, sizeof(PDC_CHECKPOINT_MAGIC)) != 0 ||
+        header.version != PDC_CHECKPOINT_VERSION) {
+        printf("==PDC_SERVER[%d]: %s - unsupported checkpoint file format\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+    if (is_own)
+        PDC_Server_wal_set_lsn(header.wal_lsn);
+
+    // Metadata records are allocated in one array, they are not freed one by one after a restart
+    blocks      = (pdc_restart_block_t *)calloc(header.n_block + 1, sizeof(pdc_restart_block_t));
+    metadata    = (pdc_metadata_t *)calloc(header.n_obj + 1, sizeof(pdc_metadata_t));
+    obj_regions = (data_server_region_t **)calloc(header.n_obj + 1, sizeof(data_server_region_t *));
+    if (blocks == NULL || metadata == NULL || obj_regions == NULL) {
+        ret_value = FAIL;
+        goto done;
+    }
+    total_mem_usage_g += sizeof(pdc_metadata_t) * header.n_obj;
+
+    // Containers and the file table are small and restored in order, metadata blocks are collected
+    pos = sizeof(pdc_checkpoint_header_t);
+    for (b = 0; b < header.n_block; b++) {
+        if (map_size - pos < sizeof(pdc_checkpoint_block_header_t)) {
+            ret_value = FAIL;
+            goto done;
+        }
+        memcpy(&block_header, map + pos, sizeof(pdc_checkpoint_block_header_t));
+        pos += sizeof(pdc_checkpoint_block_header_t);
+        if (block_header.size > map_size - pos) {
+            ret_value = FAIL;
+            goto done;
+        }
+        if (block_header.type != PDC_CHECKPOINT_BLOCK_META &&
+            PDC_Server_checksum(map + pos, block_header.size) != block_header.checksum) {
+            printf("==PDC_SERVER[%d]: %s - checkpoint block checksum mismatch\n", pdc_server_rank_g,
+                   __func__);
+            ret_value = FAIL;
+            goto done;
+        }
+
+        if (block_header.type == PDC_CHECKPOINT_BLOCK_CONT) {
+            ret_value = PDC_Server_restart_containers(map + pos, &block_header, state);
+            if (ret_value != SUCCEED)
+                goto done;
+        }
+        else if (block_header.type == PDC_CHECKPOINT_BLOCK_FILE && file_map == NULL) {
+            // File IDs of the checkpoint are mapped to the ones of this server's file table
+            file_map     = (uint32_t *)malloc(sizeof(uint32_t) * (block_header.n_entry + 1));
+            cursor.pos   = map + pos;
+            cursor.end   = map + pos + block_header.size;
+            cursor.error = 0;
+            for (n_file = 0; n_file < block_header.n_entry && !cursor.error; n_file++)
+                file_map[n_file] = PDC_Server_file_table_get_id(PDC_Server_restart_get_str(&cursor));
+        }
+        else if (block_header.type == PDC_CHECKPOINT_BLOCK_META) {
+            if (n_rec + block_header.n_record > header.n_obj) {
+                ret_value = FAIL;
+                goto done;
+            }
+            blocks[n_meta_block].payload     = map + pos;
+            blocks[n_meta_block].header      = block_header;
+            blocks[n_meta_block].metadata    = metadata + n_rec;
+            blocks[n_meta_block].obj_regions = obj_regions + n_rec;
+            n_rec += block_header.n_record;
+            n_meta_block++;
+        }
+        pos += block_header.size;
+    }
+
+    for (i = 0; i < n_meta_block; i++) {
+        blocks[i].file_map = file_map;
+        blocks[i].n_file   = n_file;
+    }
+    PDC_Server_restart_decode(blocks, n_meta_block);
+
+    // Index serially, the hash table, bloom filters and indexes are not safe for concurrent inserts
+    for (i = 0; i < n_meta_block; i++) {
+        if (blocks[i].status != SUCCEED || PDC_Server_restart_index_block(&blocks[i], state) != SUCCEED) {
+            ret_value = FAIL;
+            goto done;
+        }
+    }
+
+done:
+    if (blocks != NULL) {
+        for (i = 0; i < n_meta_block; i++) {
+            free(blocks[i].entry_keys);
+            free(blocks[i].entry_counts);
+        }
+    }
+    free(blocks);
+    free(obj_regions);
+    free(file_map);
+    // Interned strings were copied out of the mapping
+    if (map != NULL)
+        munmap(map, map_size);
+    if (fd >= 0)
+        close(fd);
+
+    FUNC_LEAVE(ret_value);
+}
+
+#ifdef ENABLE_MPI
+/*
+ * Send the records queued for other servers to them, and restore the ones received. Each server
+ * sends one message per peer: its file table, then the container entries and the metadata entries.
+ *
+ * \param  state[IN/OUT]    Restart state
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+PDC_Server_restart_exchange(pdc_restart_state_t *state)
+{
+    perr_t                        ret_value = SUCCEED;
+    pdc_checkpoint_writer_t       send;
+    pdc_checkpoint_block_header_t header;
+    pdc_restart_block_t           block;
+    pdc_restart_cursor_t          cursor;
+    int *                         send_counts = NULL, *send_displs = NULL, *recv_counts = NULL;
+    int *                         recv_displs = NULL;
+    char *                        recv_buf    = NULL;
+    uint32_t                      n_file, i, *file_map = NULL;
+    uint64_t                      recv_size = 0;
+    int                           peer, error = 0, all_error = 0;
+    const char *                  path;
+
+    FUNC_ENTER(NULL);
+
+    memset(&send, 0, sizeof(send));
+    memset(&block, 0, sizeof(block));
+    send_counts = (int *)calloc(pdc_server_size_g, sizeof(int));
+    send_displs = (int *)calloc(pdc_server_size_g, sizeof(int));
+    recv_counts = (int *)calloc(pdc_server_size_g, sizeof(int));
+    recv_displs = (int *)calloc(pdc_server_size_g, sizeof(int));
+    if (send_counts == NULL || send_displs == NULL || recv_counts == NULL || recv_displs == NULL)
+        error = 1;
+
+    n_file = PDC_Server_file_table_size();
+    for (peer = 0; peer < pdc_server_size_g && !error; peer++) {
+        if (state->cont_out[peer].n_entry == 0 && state->meta_out[peer].n_entry == 0)
+            continue;
+        send_displs[peer] = send.size;
+        PDC_Server_checkpoint_put(&send, &n_file, sizeof(uint32_t));
+        for (i = 0; i < n_file; i++)
+            PDC_Server_checkpoint_put_str(&send, PDC_Server_file_table_get_path(i));
+        memset(&header, 0, sizeof(header));
+        header.type    = PDC_CHECKPOINT_BLOCK_CONT;
+        header.n_entry = state->cont_out[peer].n_entry;
+        header.size    = state->cont_out[peer].size;
+        PDC_Server_checkpoint_put(&send, &header, sizeof(header));
+        PDC_Server_checkpoint_put(&send, state->cont_out[peer].buf, state->cont_out[peer].size);
+        header.type     = PDC_CHECKPOINT_BLOCK_META;
+        header.n_entry  = state->meta_out[peer].n_entry;
+        header.n_record = state->meta_out[peer].n_record;
+        header.size     = state->meta_out[peer].size;
+        header.checksum = PDC_Server_checksum(state->meta_out[peer].buf, state->meta_out[peer].size);
+        PDC_Server_checkpoint_put(&send, &header, sizeof(header));
+        PDC_Server_checkpoint_put(&send, state->meta_out[peer].buf, state->meta_out[peer].size);
+        if (send.size - send_displs[peer] > INT_MAX || send.size > INT_MAX) {
+            printf("==PDC_SERVER[%d]: %s - too many records to migrate\n", pdc_server_rank_g, __func__);
+            error = 1;
+        }
+        send_counts[peer] = send.size - send_displs[peer];
+    }
+    if (send.status != SUCCEED)
+        error = 1;
+
+    // Every server has to take the same path through the collectives
+    MPI_Allreduce(&error, &all_error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if (all_error) {
+        ret_value = FAIL;
+        goto done;
+    }
+
+    MPI_Alltoall(send_counts, 1, MPI_INT, recv_counts, 1, MPI_INT, MPI_COMM_WORLD);
+    for (peer = 0; peer < pdc_server_size_g; peer++) {
+        recv_displs[peer] = recv_size;
+        recv_size += recv_counts[peer];
+    }
+    if (recv_size > INT_MAX || (recv_buf = (char *)malloc(recv_size + 1)) == NULL)
+        error = 1;
+    MPI_Allreduce(&error, &all_error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if (all_error) {
+        printf("==PDC_SERVER[%d]: %s - cannot receive migrated records\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+    MPI_Alltoallv(send.buf, send_counts, send_displs, MPI_BYTE, recv_buf, recv_counts, recv_displs,
+                  MPI_BYTE, MPI_COMM_WORLD);
+
+    // Received records are owned here, restore them without forwarding
+    state->migrate = 0;
+    for (peer = 0; peer < pdc_server_size_g && ret_value == SUCCEED; peer++) {
+        if (recv_counts[peer] == 0)
+            continue;
+        cursor.pos   = recv_buf + recv_displs[peer];
+        cursor.end   = cursor.pos + recv_counts[peer];
+        cursor.error = 0;
+
+        PDC_Server_restart_get(&cursor, &n_file, sizeof(uint32_t));
+        if (cursor.error || n_file > (uint32_t)recv_counts[peer]) {
+            ret_value = FAIL;
+            break;
         }
-        n_entry--;
+        file_map = (uint32_t *)malloc(sizeof(uint32_t) * (n_file + 1));
+        for (i = 0; i < n_file; i++) {
+            path        = PDC_Server_restart_get_str(&cursor);
+            file_map[i] = PDC_Server_file_table_get_id(path);
+        }
+
+        PDC_Server_restart_get(&cursor, &header, sizeof(header));
+        if (cursor.error || header.size > (uint64_t)(cursor.end - cursor.pos) ||
+            PDC_Server_restart_containers(cursor.pos, &header, state) != SUCCEED) {
+            ret_value = FAIL;
+            break;
+        }
+        cursor.pos += header.size;
+
+        PDC_Server_restart_get(&cursor, &header, sizeof(header));
+        if (cursor.error || header.size > (uint64_t)(cursor.end - cursor.pos)) {
+            ret_value = FAIL;
+            break;
+        }
+        block.payload     = cursor.pos;
+        block.header      = header;
+        block.file_map    = file_map;
+        block.n_file      = n_file;
+        block.metadata    = (pdc_metadata_t *)calloc(header.n_record + 1, sizeof(pdc_metadata_t));
+        block.obj_regions =
+            (data_server_region_t **)calloc(header.n_record + 1, sizeof(data_server_region_t *));
+        total_mem_usage_g += sizeof(pdc_metadata_t) * header.n_record;
+        PDC_Server_restart_decode_block(&block);
+        if (block.status != SUCCEED || PDC_Server_restart_index_block(&block, state) != SUCCEED)
+            ret_value = FAIL;
+
+        free(block.obj_regions);
+        free(block.entry_keys);
+        free(block.entry_counts);
+        free(file_map);
+        memset(&block, 0, sizeof(block));
+        file_map = NULL;
     }
 
+done:
+    free(file_map);
+    free(send.buf);
+    free(recv_buf);
+    free(send_counts);
+    free(send_displs);
+    free(recv_counts);
+    free(recv_displs);
+    FUNC_LEAVE(ret_value);
+}
+#endif
+
+/*
+ * Get the name of the checkpoint or log file of a server rank
+ *
+ * \param  buf[OUT]         File name
+ * \param  size[IN]         Buffer size
+ * \param  base[IN]         "metadata_checkpoint." or "metadata_wal."
+ * \param  rank[IN]         Server rank
+ */
+static void
+PDC_Server_restart_file_name(char *buf, size_t size, const char *base, int rank)
+{
+    FUNC_ENTER(NULL);
+
+    snprintf(buf, size, "%s%s%d", pdc_server_tmp_dir_g, base, rank);
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Get the number of servers that wrote a checkpoint file
+ *
+ * \param  filename[IN]     Checkpoint file name
+ *
+ * \return Number of servers, 0 if the file is missing or unreadable
+ */
+static int
+PDC_Server_restart_peek_nserver(const char *filename)
+{
+    int                     ret_value = 0;
+    pdc_checkpoint_header_t header;
+    FILE *                  file;
+
+    FUNC_ENTER(NULL);
+
+    file = fopen(filename, "r");
+    if (file == NULL)
+        goto done;
+    if (fread(&header, sizeof(header), 1, file) == 1 &&
+        memcmp(header.magic, PDC_CHECKPOINT_MAGIC, sizeof(PDC_CHECKPOINT_MAGIC)) == 0 &&
+        header.version == PDC_CHECKPOINT_VERSION)
+        ret_value = header.n_server;
     fclose(file);
-    file = NULL;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Check that a server rank's write-ahead log has nothing to replay
+ *
+ * \param  rank[IN]         Server rank
+ *
+ * \return 1 if the log is empty or missing, 0 otherwise
+ */
+static int
+PDC_Server_restart_wal_empty(int rank)
+{
+    int         ret_value = 1;
+    char        wal_file[ADDR_MAX + 16];
+    struct stat st;
+
+    FUNC_ENTER(NULL);
+
+    PDC_Server_restart_file_name(wal_file, ADDR_MAX, "metadata_wal.", rank);
+    if (stat(wal_file, &st) == 0 && st.st_size > 0)
+        ret_value = 0;
+    strcat(wal_file, ".old");
+    if (stat(wal_file, &st) == 0 && st.st_size > 0)
+        ret_value = 0;
+
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Load metadata from the checkpoint files in persistant storage. If the number of servers changed
+ * since the checkpoint, each server also loads the files of the ranks that are gone, and records are
+ * sent to the server that owns their ring bucket now. Only the buckets that changed owner move.
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t
+PDC_Server_restart()
+{
+    perr_t              ret_value = SUCCEED;
+    int                 n_prev = 0, all_n_prev, rank, error = 0, all_error = 0;
+    int                 all_nobj = 0, all_n_region = 0, all_cont = 0;
+    char                checkpoint_file[ADDR_MAX + 16];
+    pdc_restart_state_t state;
+
+    FUNC_ENTER(NULL);
+
+    memset(&state, 0, sizeof(state));
+
+    // init hash table
+    ret_value = PDC_Server_init_hash_table();
+    if (ret_value != SUCCEED) {
+        printf("==PDC_SERVER[%d]: %s - PDC_Server_init_hash_table FAILED!", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    PDC_Server_restart_file_name(checkpoint_file, ADDR_MAX, "metadata_checkpoint.", pdc_server_rank_g);
+    n_prev = PDC_Server_restart_peek_nserver(checkpoint_file);
+#ifdef ENABLE_MPI
+    MPI_Allreduce(&n_prev, &all_n_prev, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#else
+    all_n_prev        = n_prev;
+#endif
+    if (all_n_prev == 0) {
+        printf("==PDC_SERVER[%d]: %s -  Checkpoint file open FAILED [%s]!", pdc_server_rank_g, __func__,
+               checkpoint_file);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    if (all_n_prev != pdc_server_size_g) {
+        if (pdc_server_rank_g == 0)
+            printf("==PDC_SERVER[0]: Checkpoint was taken by %d servers, migrating metadata to %d servers\n",
+                   all_n_prev, pdc_server_size_g);
+        state.migrate  = 1;
+        state.cont_out = (pdc_checkpoint_writer_t *)calloc(pdc_server_size_g, sizeof(*state.cont_out));
+        state.meta_out = (pdc_checkpoint_writer_t *)calloc(pdc_server_size_g, sizeof(*state.meta_out));
+        if (state.cont_out == NULL || state.meta_out == NULL)
+            error = 1;
+        // The logs are not migrated, they have to be replayed with the server count that wrote them
+        for (rank = pdc_server_rank_g; rank < all_n_prev; rank += pdc_server_size_g) {
+            if (!PDC_Server_restart_wal_empty(rank)) {
+                printf("==PDC_SERVER[%d]: %s - write-ahead log of server %d is not empty, restart with %d "
+                       "servers first\n",
+                       pdc_server_rank_g, __func__, rank, all_n_prev);
+                error = 1;
+            }
+        }
+    }
+
+    // Each server loads its own file first, then the ones of the ranks that are gone
+    for (rank = pdc_server_rank_g; rank < all_n_prev && !error; rank += pdc_server_size_g) {
+        PDC_Server_restart_file_name(checkpoint_file, ADDR_MAX, "metadata_checkpoint.", rank);
+        if (PDC_Server_restart_file(checkpoint_file, rank == pdc_server_rank_g, &state) != SUCCEED)
+            error = 1;
+    }
 
 #ifdef ENABLE_MPI
-    MPI_Reduce(&nobj, &all_nobj, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&total_region, &all_n_region, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Allreduce(&error, &all_error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if (all_error == 0 && state.migrate) {
+        if (PDC_Server_restart_exchange(&state) != SUCCEED)
+            error = 1;
+        MPI_Allreduce(&error, &all_error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    }
+#else
+    all_error         = error;
+#endif
+    if (all_error) {
+        ret_value = FAIL;
+        goto done;
+    }
+
+#ifndef DISABLE_CHECKPOINT
+    if (all_n_prev != pdc_server_size_g) {
+        int n_obj, n_reg;
+        // Persist the new placement before the files of the ranks that are gone are removed
+        PDC_Server_checkpoint_add_files();
+        if (PDC_Server_checkpoint_write(&n_obj, &n_reg) != SUCCEED)
+            error = 1;
+#ifdef ENABLE_MPI
+        MPI_Allreduce(&error, &all_error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#else
+        all_error = error;
+#endif
+        if (all_error) {
+            ret_value = FAIL;
+            goto done;
+        }
+        for (rank = pdc_server_rank_g + pdc_server_size_g; rank < all_n_prev; rank += pdc_server_size_g) {
+            PDC_Server_restart_file_name(checkpoint_file, ADDR_MAX, "metadata_checkpoint.", rank);
+            unlink(checkpoint_file);
+            PDC_Server_restart_file_name(checkpoint_file, ADDR_MAX, "metadata_wal.", rank);
+            unlink(checkpoint_file);
+            strcat(checkpoint_file, ".old");
+            unlink(checkpoint_file);
+        }
+    }
+#endif
+
+#ifdef ENABLE_MPI
+    MPI_Reduce(&state.n_obj, &all_nobj, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&state.n_region, &all_n_region, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&state.n_cont, &all_cont, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
 #else
-    all_nobj          = nobj;
-    all_n_region      = total_region;
+    all_nobj          = state.n_obj;
+    all_n_region      = state.n_region;
+    all_cont          = state.n_cont;
 #endif
 
     if (pdc_server_rank_g == 0) {
@@ -1594,6 +2933,14 @@ PDC_Server_restart(char *filename)
     }
 
 done:
+    for (rank = 0; rank < pdc_server_size_g; rank++) {
+        if (state.cont_out != NULL)
+            free(state.cont_out[rank].buf);
+        if (state.meta_out != NULL)
+            free(state.meta_out[rank].buf);
+    }
+    free(state.cont_out);
+    free(state.meta_out);
     fflush(stdout);
 
     FUNC_LEAVE(ret_value);
@@ -1650,6 +2997,15 @@ PDC_Server_multithread_loop(hg_context_t *context)
             break;
 
         ret = HG_Trigger(context, 0, 1, NULL);
+#ifndef DISABLE_CHECKPOINT
+        // Group commit the changes made by the triggered callbacks, like PDC_Server_loop
+        PDC_Server_wal_commit();
+        // Fold a long log into a new checkpoint so restart does not replay it all
+        if (pdc_snapshot_pid_g > 0)
+            PDC_Server_snapshot_poll(0);
+        else if (PDC_Server_wal_size() > PDC_WAL_CHECKPOINT_SIZE)
+            PDC_Server_snapshot_start();
+#endif
     } while (ret == HG_SUCCESS || ret == HG_TIMEOUT);
 
     hg_thread_join(progress_thread);
@@ -1674,32 +3030,26 @@ PDC_Server_loop(hg_context_t *hg_context)
     ;
     hg_return_t  hg_ret;
     unsigned int actual_count;
-    int          checkpoint_interval  = 1;
-    clock_t      last_checkpoint_time = 0, cur_time;
 
     FUNC_ENTER(NULL);
 
     /* Poke progress engine and check for events */
     do {
-#ifndef DISABLE_CHECKPOINT
-        checkpoint_interval++;
-        if (checkpoint_interval % PDC_CHECKPOINT_INTERVAL == 0) {
-            cur_time            = clock();
-            double elapsed_time = ((double)(cur_time - last_checkpoint_time)) / CLOCKS_PER_SEC;
-            // Do not checkpoint too often, has a min time interval between checkpoints
-            if (elapsed_time > PDC_CHECKPOINT_MIN_INTERVAL_SEC) {
-                PDC_Server_checkpoint();
-                last_checkpoint_time = clock();
-                checkpoint_interval  = 1;
-            }
-        }
-#endif
-
         actual_count = 0;
         do {
             hg_ret = HG_Trigger(hg_context, 0 /* timeout */, 1 /* max count */, &actual_count);
         } while ((hg_ret == HG_SUCCESS) && actual_count);
 
+#ifndef DISABLE_CHECKPOINT
+        // Group commit the changes made by the triggered callbacks
+        PDC_Server_wal_commit();
+        // Fold a long log into a new checkpoint so restart does not replay it all
+        if (pdc_snapshot_pid_g > 0)
+            PDC_Server_snapshot_poll(0);
+        else if (PDC_Server_wal_size() > PDC_WAL_CHECKPOINT_SIZE)
+            PDC_Server_snapshot_start();
+#endif
+
         /* Do not try to make progress anymore if we're done */
         if (hg_atomic_cas32(&close_server_g, 1, 1))
             break;
@@ -1816,6 +3166,9 @@ PDC_Server_mercury_register()
     // Register RPC, metadata related
     PDC_client_test_connect_register(hg_class_g);
     PDC_gen_obj_id_register(hg_class_g);
+    PDC_gen_obj_id_many_register(hg_class_g);
+    PDC_kvtag_many_register(hg_class_g);
+    PDC_meta_store_stats_register(hg_class_g);
     PDC_close_server_register(hg_class_g);
     PDC_metadata_query_register(hg_class_g);
     PDC_container_query_register(hg_class_g);
@@ -1842,6 +3195,8 @@ PDC_Server_mercury_register()
     // Mapping
     PDC_transfer_request_register(hg_class_g);
     PDC_transfer_request_wait_register(hg_class_g);
+    PDC_obj_put_data_register(hg_class_g);
+    PDC_obj_get_data_register(hg_class_g);
     PDC_transfer_request_status_register(hg_class_g);
     PDC_buf_map_register(hg_class_g);
     PDC_buf_unmap_register(hg_class_g);
@@ -1888,6 +3243,7 @@ PDC_Server_mercury_register()
     send_shm_register_id_g                     = PDC_send_shm_register(hg_class_g);
     send_client_storage_meta_rpc_register_id_g = PDC_send_client_storage_meta_rpc_register(hg_class_g);
     send_read_sel_obj_id_rpc_register_id_g     = PDC_send_read_sel_obj_id_rpc_register(hg_class_g);
+    PDC_detach_shm_register(hg_class_g);
 }
 
 static void
@@ -54,6 +54,7 @@
 #include "mercury_thread.h"
 #include "mercury_thread_pool.h"
 #include "mercury_thread_mutex.h"
+#include "mercury_thread_rwlock.h"
 #include "mercury_thread_condition.h"
 
 /*****************************/
@@ -61,8 +62,12 @@
 /*****************************/
 hg_thread_mutex_t hash_table_new_mutex_g;
 hg_thread_mutex_t pdc_client_addr_mutex_g;
-hg_thread_mutex_t pdc_metadata_hash_table_mutex_g;
-hg_thread_mutex_t pdc_container_hash_table_mutex_g;
+// Lookups of the metadata and container tables and their indexes share a read lock, updates take the
+// write lock
+hg_thread_rwlock_t pdc_metadata_hash_table_rwlock_g;
+hg_thread_rwlock_t pdc_container_hash_table_rwlock_g;
+// Serializes the lazy build of the numeric kvtag index keys, done under the metadata read lock
+hg_thread_mutex_t pdc_kvtag_index_mutex_g;
 hg_thread_mutex_t pdc_time_mutex_g;
 hg_thread_mutex_t pdc_bloom_time_mutex_g;
 hg_thread_mutex_t n_metadata_mutex_g;
@@ -79,6 +84,7 @@ hg_thread_mutex_t lock_request_mutex_g;
 hg_thread_mutex_t addr_valid_mutex_g;
 hg_thread_mutex_t update_remote_server_addr_mutex_g;
 hg_thread_mutex_t pdc_server_task_mutex_g;
+hg_thread_mutex_t client_shm_arena_mutex_g;
 #else
 #define hg_thread_mutex_t int
 hg_thread_mutex_t pdc_server_task_mutex_g;
@@ -86,6 +92,7 @@ hg_thread_mutex_t pdc_server_task_mutex_g;
 
 extern int      n_bloom_total_g;
 extern int      n_bloom_maybe_g;
+extern int      n_bloom_false_positive_g;
 extern double   server_bloom_check_time_g;
 extern double   server_bloom_insert_time_g;
 extern double   server_insert_time_g;
@@ -94,6 +101,10 @@ extern double   server_update_time_g;
 extern double   server_hash_insert_time_g;
 extern double   server_bloom_init_time_g;
 extern uint32_t n_metadata_g;
+// Number, total duration and total bytes of the background snapshots taken
+extern int      server_snapshot_count_g;
+extern double   server_snapshot_time_g;
+extern uint64_t server_snapshot_bytes_g;
 
 /***************************************/
 /* Library-private Function Prototypes */
@@ -131,13 +142,32 @@ perr_t PDC_Server_set_close(void);
 perr_t PDC_Server_checkpoint();
 
 /**
- * ***********
+ * Start a background snapshot. A forked child writes the checkpoint from its copy-on-write view of the
+ * metadata while this process keeps serving requests, and records logged meanwhile go to a new log
+ * segment. Metadata and container updates wait while the log is rotated and the process forks, and so do
+ * changes to the data-server regions and the file table. Checkpoints in place if the snapshot cannot be
+ * started.
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_snapshot_start();
+
+/**
+ * Check whether the background snapshot is done, and account its duration and size. Checkpoints in
+ * place if the snapshot failed.
  *
- * \param filename [IN]         File name
+ * \param wait [IN]             Block until the snapshot is done when set
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_snapshot_poll(int wait);
+
+/**
+ * Load metadata from the checkpoint files, migrating it when the number of servers changed
  *
  * \return Non-negative on success/Negative on failure
  */
-perr_t PDC_Server_restart(char *filename);
+perr_t PDC_Server_restart();
 
 /**
  * ***********
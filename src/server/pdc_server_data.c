@@ -51,6 +51,7 @@
 #include "pdc_client_server_common.h"
 #include "pdc_server_data.h"
 #include "pdc_server_metadata.h"
+#include "pdc_server_wal.h"
 #include "pdc_server.h"
 #include "pdc_hist_pkg.h"
 #include "pdc_timing.h"
@@ -78,6 +79,7 @@ char     pdc_cache_file_path_g[ADDR_MAX];
 
 query_task_t *          query_task_list_head_g      = NULL;
 cache_storage_region_t *cache_storage_region_head_g = NULL;
+client_shm_arena_t *    client_shm_arena_head_g     = NULL;
 
 static int
 fill_storage_path(char *storage_location, pdcid_t obj_id)
@@ -278,6 +280,222 @@ PDC_Server_region_lock_status(PDC_mapping_info_t *mapped_region, int *lock_statu
     FUNC_LEAVE(ret_value);
 }
 
+// File table: paths of the data files holding stored regions, region_extent_t refers to them by index
+static char **   pdc_file_table_g       = NULL;
+static uint32_t  pdc_file_table_n_g     = 0;
+static uint32_t  pdc_file_table_alloc_g = 0;
+static HashTable *pdc_file_table_index_g = NULL;
+#ifdef ENABLE_MULTITHREAD
+// Handler threads add files while writing regions out and read paths concurrently
+static hg_thread_mutex_t pdc_file_table_mutex_g = HG_THREAD_MUTEX_INITIALIZER;
+#endif
+
+static unsigned int
+PDC_Server_file_table_hash(HashTableKey path)
+{
+    return PDC_get_hash_by_name((const char *)path);
+}
+
+static int
+PDC_Server_file_table_equal(HashTableKey path1, HashTableKey path2)
+{
+    return strcmp((const char *)path1, (const char *)path2) == 0;
+}
+
+uint32_t
+PDC_Server_file_table_get_id(const char *path)
+{
+    uint32_t  ret_value = 0;
+    char *    copy;
+    uint32_t *id;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_file_table_mutex_g);
+#endif
+
+    if (pdc_file_table_index_g == NULL) {
+        pdc_file_table_index_g = hash_table_new(PDC_Server_file_table_hash, PDC_Server_file_table_equal);
+        hash_table_register_free_functions(pdc_file_table_index_g, NULL, free);
+    }
+
+    id = hash_table_lookup(pdc_file_table_index_g, (HashTableKey)path);
+    if (id != NULL)
+        PGOTO_DONE(*id);
+
+    if (pdc_file_table_n_g == pdc_file_table_alloc_g) {
+        if (pdc_file_table_alloc_g == 0)
+            pdc_file_table_alloc_g = PDC_ALLOC_BASE_NUM;
+        else
+            pdc_file_table_alloc_g *= 2;
+        pdc_file_table_g = (char **)realloc(pdc_file_table_g, pdc_file_table_alloc_g * sizeof(char *));
+    }
+    // The table owns its copy, the index is keyed by it
+    copy                                 = strdup(path);
+    pdc_file_table_g[pdc_file_table_n_g] = copy;
+
+    id  = (uint32_t *)malloc(sizeof(uint32_t));
+    *id = pdc_file_table_n_g++;
+    hash_table_insert(pdc_file_table_index_g, (HashTableKey)copy, id);
+    ret_value = *id;
+
+done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_file_table_mutex_g);
+#endif
+    FUNC_LEAVE(ret_value);
+}
+
+uint32_t
+PDC_Server_file_table_find_id(const char *path)
+{
+    uint32_t  ret_value = UINT32_MAX;
+    uint32_t *id;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_file_table_mutex_g);
+#endif
+
+    if (pdc_file_table_index_g != NULL) {
+        id = hash_table_lookup(pdc_file_table_index_g, (HashTableKey)path);
+        if (id != NULL)
+            ret_value = *id;
+    }
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_file_table_mutex_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+const char *
+PDC_Server_file_table_get_path(uint32_t file_id)
+{
+    const char *ret_value = NULL;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_file_table_mutex_g);
+#endif
+
+    // Paths are never removed, so the returned one stays valid after the lock is released
+    if (file_id < pdc_file_table_n_g)
+        ret_value = pdc_file_table_g[file_id];
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_file_table_mutex_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+uint32_t
+PDC_Server_file_table_size()
+{
+    uint32_t ret_value;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_file_table_mutex_g);
+#endif
+
+    ret_value = pdc_file_table_n_g;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_file_table_mutex_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_file_table_free()
+{
+    uint32_t i;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_file_table_index_g != NULL)
+        hash_table_free(pdc_file_table_index_g);
+    for (i = 0; i < pdc_file_table_n_g; i++)
+        free(pdc_file_table_g[i]);
+    free(pdc_file_table_g);
+    pdc_file_table_index_g = NULL;
+    pdc_file_table_g       = NULL;
+    pdc_file_table_n_g     = 0;
+    pdc_file_table_alloc_g = 0;
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_data_fork_prepare()
+{
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&region_struct_mutex_g);
+    hg_thread_mutex_lock(&pdc_file_table_mutex_g);
+#endif
+}
+
+void
+PDC_Server_data_fork_done()
+{
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_file_table_mutex_g);
+    hg_thread_mutex_unlock(&region_struct_mutex_g);
+#endif
+}
+
+perr_t
+PDC_Server_restore_region_extent(uint64_t obj_id, region_extent_t *extent, const char *path)
+{
+    perr_t                ret_value = SUCCEED;
+    data_server_region_t *obj_reg;
+    region_extent_t *     elt, *new_extent;
+
+    FUNC_ENTER(NULL);
+
+    obj_reg = PDC_Server_get_obj_region(obj_id);
+    if (obj_reg == NULL) {
+        obj_reg = (data_server_region_t *)calloc(1, sizeof(struct data_server_region_t));
+        if (obj_reg == NULL) {
+            ret_value = FAIL;
+            goto done;
+        }
+        obj_reg->obj_id           = obj_id;
+        obj_reg->fd               = -1;
+        obj_reg->storage_location = (char *)calloc(ADDR_MAX, sizeof(char));
+        snprintf(obj_reg->storage_location, ADDR_MAX, "%s", path);
+        DL_APPEND(dataserver_region_g, obj_reg);
+    }
+
+    DL_FOREACH(obj_reg->region_storage_head, elt)
+    {
+        if (elt->ndim == extent->ndim && elt->offset == extent->offset &&
+            memcmp(elt->start, extent->start, sizeof(uint64_t) * extent->ndim) == 0 &&
+            memcmp(elt->count, extent->count, sizeof(uint64_t) * extent->ndim) == 0)
+            goto done;
+    }
+
+    new_extent = (region_extent_t *)malloc(sizeof(region_extent_t));
+    if (new_extent == NULL) {
+        ret_value = FAIL;
+        goto done;
+    }
+    memcpy(new_extent, extent, sizeof(region_extent_t));
+    new_extent->file_id = PDC_Server_file_table_get_id(path);
+    DL_APPEND(obj_reg->region_storage_head, new_extent);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
 data_server_region_t *
 PDC_Server_get_obj_region(pdcid_t obj_id)
 {
@@ -302,7 +520,7 @@ PDC_Server_clear_obj_region()
 {
     perr_t                ret_value = SUCCEED;
     data_server_region_t *elt, *tmp;
-    region_list_t *       elt2, *tmp2;
+    region_extent_t *     elt2, *tmp2;
 
     FUNC_ENTER(NULL);
     if (dataserver_region_g != NULL) {
@@ -1949,6 +2167,161 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Map the shared memory arena of a same-node client. Region transfer data of that client is then read
+ * from and written to the arena in place, instead of going through Mercury bulk transfers.
+ *
+ * \param  shm_info[IN]         Client token, shm name and size of the arena
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t
+PDC_Server_attach_client_shm(pdc_shm_info_t *shm_info)
+{
+    perr_t                  ret_value = SUCCEED;
+    client_shm_arena_t *    arena = NULL, *elt, *tmp;
+    pdc_shm_arena_header_t *header;
+
+    FUNC_ENTER(NULL);
+
+    if (shm_info == NULL || shm_info->size < sizeof(pdc_shm_arena_header_t))
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: invalid client shm info", pdc_server_rank_g);
+
+    arena            = (client_shm_arena_t *)calloc(1, sizeof(client_shm_arena_t));
+    arena->token     = shm_info->token;
+    arena->client_id = shm_info->client_id;
+    arena->size      = shm_info->size;
+    strncpy(arena->shm_addr, shm_info->shm_addr, ADDR_MAX - 1);
+
+    // Fails if the client is not on the same node as this server
+    arena->shm_fd = shm_open(arena->shm_addr, O_RDWR, 0666);
+    if (arena->shm_fd == -1) {
+        if (is_debug_g == 1)
+            printf("==PDC_SERVER[%d]: cannot open shm [%s] of client %u\n", pdc_server_rank_g,
+                   arena->shm_addr, arena->client_id);
+        free(arena);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    arena->buf = mmap(0, arena->size, PROT_READ | PROT_WRITE, MAP_SHARED, arena->shm_fd, 0);
+    if (arena->buf == MAP_FAILED) {
+        close(arena->shm_fd);
+        free(arena);
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: shm mmap failed [%s]", pdc_server_rank_g, shm_info->shm_addr);
+    }
+
+    // Make sure this is the arena the client has just created, not a stale segment with the same name
+    header = (pdc_shm_arena_header_t *)arena->buf;
+    if (header->magic != PDC_SHM_ARENA_MAGIC || header->size != arena->size ||
+        header->token != arena->token) {
+        munmap(arena->buf, arena->size);
+        close(arena->shm_fd);
+        free(arena);
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: shm [%s] header mismatch", pdc_server_rank_g,
+                    shm_info->shm_addr);
+    }
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&client_shm_arena_mutex_g);
+#endif
+    // A client re-registering replaces its previous arena, and a new segment reusing the name of one
+    // whose client exited without detaching replaces the stale mapping
+    DL_FOREACH_SAFE(client_shm_arena_head_g, elt, tmp)
+    {
+        if (elt->token == arena->token || strcmp(elt->shm_addr, arena->shm_addr) == 0) {
+            DL_DELETE(client_shm_arena_head_g, elt);
+            munmap(elt->buf, elt->size);
+            close(elt->shm_fd);
+            free(elt);
+        }
+    }
+    DL_APPEND(client_shm_arena_head_g, arena);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&client_shm_arena_mutex_g);
+#endif
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+char *
+PDC_Server_get_client_shm_buf(uint64_t token, uint64_t offset, uint64_t size)
+{
+    char *              ret_value = NULL;
+    client_shm_arena_t *elt;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&client_shm_arena_mutex_g);
+#endif
+    DL_FOREACH(client_shm_arena_head_g, elt)
+    {
+        if (elt->token == token) {
+            if (offset >= sizeof(pdc_shm_arena_header_t) && offset + size <= elt->size)
+                ret_value = elt->buf + offset;
+            break;
+        }
+    }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&client_shm_arena_mutex_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_detach_client_shm(uint64_t token)
+{
+    perr_t              ret_value = FAIL;
+    client_shm_arena_t *elt, *tmp;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&client_shm_arena_mutex_g);
+#endif
+    DL_FOREACH_SAFE(client_shm_arena_head_g, elt, tmp)
+    {
+        if (elt->token == token) {
+            DL_DELETE(client_shm_arena_head_g, elt);
+            munmap(elt->buf, elt->size);
+            close(elt->shm_fd);
+            free(elt);
+            ret_value = SUCCEED;
+            break;
+        }
+    }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&client_shm_arena_mutex_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_detach_all_client_shm()
+{
+    perr_t              ret_value = SUCCEED;
+    client_shm_arena_t *elt, *tmp;
+
+    FUNC_ENTER(NULL);
+
+    // The clients own the segments and unlink them, we only unmap our view
+    DL_FOREACH_SAFE(client_shm_arena_head_g, elt, tmp)
+    {
+        DL_DELETE(client_shm_arena_head_g, elt);
+        if (munmap(elt->buf, elt->size) == -1)
+            ret_value = FAIL;
+        close(elt->shm_fd);
+        free(elt);
+    }
+
+    FUNC_LEAVE(ret_value);
+}
+
 /*
  * Callback function for IO complete notification send to client, gets output from client
  *
@@ -3368,6 +3741,10 @@ PDC_Server_update_local_region_storage_loc(region_list_t *region, uint64_t obj_i
         DL_APPEND(target_meta->storage_region_list_head, new_region);
     }
 
+    if (type == PDC_UPDATE_STORAGE)
+        PDC_Server_wal_log_region(PDC_WAL_REGION_STORAGE, obj_id, region->ndim, region->start, region->count,
+                                  region->offset, region->data_size, region->storage_location);
+
 done:
     fflush(stdout);
 
@@ -3651,6 +4028,9 @@ PDC_Server_update_region_storage_meta_bulk_local(update_region_storage_meta_bulk
 
         new_region->meta   = target_meta;
         new_region->obj_id = target_meta->obj_id;
+        PDC_Server_wal_log_region(PDC_WAL_REGION_STORAGE, obj_id, new_region->ndim, new_region->start,
+                                  new_region->count, new_region->offset, new_region->data_size,
+                                  new_region->storage_location);
 
         // Check if we can insert without duplicate check
         if (i == 1 && target_meta->storage_region_list_head == NULL)
@@ -4695,7 +5075,7 @@ PDC_Server_data_write_out(uint64_t obj_id, struct pdc_region_info *region_info,
 {
     perr_t                ret_value      = SUCCEED;
     data_server_region_t *region         = NULL;
-    region_list_t *       overlap_region = NULL;
+    region_extent_t *     overlap_region = NULL;
     int                   is_overlap     = 0;
     uint64_t              i, j, pos, overlap_start[DIM_MAX] = {0}, overlap_count[DIM_MAX] = {0},
                         overlap_start_local[DIM_MAX] = {0};
@@ -4721,14 +5101,13 @@ PDC_Server_data_write_out(uint64_t obj_id, struct pdc_region_info *region_info,
     if ((region->fd <= 0) && region->storage_location) {
         region->fd = open(region->storage_location, O_RDWR, 0666);
     }
-    region_list_t *request_region = (region_list_t *)calloc(1, sizeof(region_list_t));
+    region_extent_t *request_region = (region_extent_t *)calloc(1, sizeof(region_extent_t));
     for (i = 0; i < region_info->ndim; i++) {
         request_region->start[i] = region_info->offset[i];
         request_region->count[i] = region_info->size[i];
     }
-    request_region->ndim      = region_info->ndim;
-    request_region->unit_size = unit;
-    strcpy(request_region->storage_location, region->storage_location);
+    request_region->ndim    = region_info->ndim;
+    request_region->file_id = PDC_Server_file_table_get_id(region->storage_location);
 #ifdef ENABLE_TIMING
     struct timeval pdc_timer_start, pdc_timer_end;
     double         write_total_sec;
@@ -4736,10 +5115,12 @@ PDC_Server_data_write_out(uint64_t obj_id, struct pdc_region_info *region_info,
 #endif
 
     // Detect overwrite
-    region_list_t *elt;
+    region_extent_t *elt;
     DL_FOREACH(region->region_storage_head, elt)
     {
-        if (PDC_is_contiguous_region_overlap(elt, request_region) == 1) {
+        if (elt->ndim == request_region->ndim &&
+            PDC_is_contiguous_start_count_overlap(elt->ndim, elt->start, elt->count, request_region->start,
+                                                  request_region->count) == 1) {
             is_overlap++;
             overlap_region = elt;
 
@@ -4910,9 +5291,18 @@ PDC_Server_data_write_out(uint64_t obj_id, struct pdc_region_info *region_info,
             goto done;
         }
 
-        // Store storage information
+        // Store storage information, a snapshot may be copying the list
         request_region->data_size = write_size;
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_lock(&region_struct_mutex_g);
+#endif
         DL_APPEND(region->region_storage_head, request_region);
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_unlock(&region_struct_mutex_g);
+#endif
+        PDC_Server_wal_log_region(PDC_WAL_REGION_EXTENT, obj_id, request_region->ndim, request_region->start,
+                                  request_region->count, request_region->offset, request_region->data_size,
+                                  region->storage_location);
     }
     else {
         free(request_region);
@@ -4941,7 +5331,7 @@ PDC_Server_data_read_from(uint64_t obj_id, struct pdc_region_info *region_info,
     perr_t                       ret_value        = SUCCEED;
     ssize_t /*read_bytes = 0, */ total_read_bytes = 0, request_bytes = unit, my_read_bytes = 0;
     data_server_region_t *       region = NULL;
-    region_list_t *              elt;
+    region_extent_t *            elt;
     // int flag = 0;
     uint64_t i, j, pos, overlap_start[DIM_MAX] = {0}, overlap_count[DIM_MAX] = {0},
                         overlap_start_local[DIM_MAX] = {0};
@@ -4962,7 +5352,7 @@ PDC_Server_data_read_from(uint64_t obj_id, struct pdc_region_info *region_info,
         region->fd = open(region->storage_location, O_RDWR, 0666);
     }
 
-    region_list_t request_region;
+    region_extent_t request_region;
     request_region.ndim = region_info->ndim;
     for (i = 0; i < region_info->ndim; i++) {
         request_region.start[i] = region_info->offset[i];
@@ -4976,11 +5366,13 @@ PDC_Server_data_read_from(uint64_t obj_id, struct pdc_region_info *region_info,
     gettimeofday(&pdc_timer_start, 0);
 #endif
 
-    region_list_t *storage_region = NULL;
+    region_extent_t *storage_region = NULL;
     DL_FOREACH(region->region_storage_head, elt)
     {
         // flag = 0;
-        if (PDC_is_contiguous_region_overlap(elt, &request_region) == 1) {
+        if (elt->ndim == request_region.ndim &&
+            PDC_is_contiguous_start_count_overlap(elt->ndim, elt->start, elt->count, request_region.start,
+                                                  request_region.count) == 1) {
             storage_region = elt;
             // flag = 1;
 
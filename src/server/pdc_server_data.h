@@ -237,6 +237,19 @@ typedef struct cache_storage_region_t {
     struct cache_storage_region_t *next;
 } cache_storage_region_t;
 
+/* Shared memory arena of a client running on the same node as this server */
+typedef struct client_shm_arena_t {
+    uint64_t token; // per client process, the MPI rank is not unique across applications
+    uint32_t client_id;
+    char     shm_addr[ADDR_MAX];
+    int      shm_fd;
+    char *   buf;
+    uint64_t size;
+
+    struct client_shm_arena_t *prev;
+    struct client_shm_arena_t *next;
+} client_shm_arena_t;
+
 /*****************************/
 /* Library-private Variables */
 /*****************************/
@@ -427,6 +440,59 @@ perr_t PDC_Server_unregister_obj_region(pdcid_t obj_id);
  * \return SUCCEED/FAIL
  */
 perr_t PDC_Server_clear_obj_region();
+/**
+ * Get the ID of a data file in the server file table, adding the file if needed
+ *
+ * \param path [IN]             Path of the data file
+ *
+ * \return File ID
+ */
+uint32_t PDC_Server_file_table_get_id(const char *path);
+/**
+ * Get the ID of a data file already in the server file table, without adding it
+ *
+ * \param path [IN]             Path of the data file
+ *
+ * \return File ID/UINT32_MAX if the file is not in the table
+ */
+uint32_t PDC_Server_file_table_find_id(const char *path);
+/**
+ * Get the path of a data file in the server file table
+ *
+ * \param file_id [IN]          File ID
+ *
+ * \return Path/NULL if the ID is not in the table
+ */
+const char *PDC_Server_file_table_get_path(uint32_t file_id);
+/**
+ * Get the number of files in the server file table
+ *
+ * \return Number of files
+ */
+uint32_t PDC_Server_file_table_size();
+/**
+ * Free the server file table
+ */
+void PDC_Server_file_table_free();
+/**
+ * Hold the data-server region and file table locks across a fork, so the child does not copy a region
+ * list or the table while another thread changes it
+ */
+void PDC_Server_data_fork_prepare();
+/**
+ * Release the locks taken by PDC_Server_data_fork_prepare, in the parent and in the child
+ */
+void PDC_Server_data_fork_done();
+/**
+ * Add a stored extent of an object logged in the write-ahead log, unless the same extent is there
+ *
+ * \param obj_id [IN]           Object ID
+ * \param extent [IN]           Extent, its file ID is set from path
+ * \param path [IN]             Path of the data file
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_restore_region_extent(uint64_t obj_id, region_extent_t *extent, const char *path);
 
 /**
  * ***********
@@ -645,6 +711,13 @@ perr_t PDC_Server_update_region_storage_meta_bulk_mpi(bulk_xfer_data_t *bulk_dat
  */
 perr_t PDC_Server_close_shm(region_list_t *region, int is_remove);
 
+/**
+ * Unmap all client shared memory arenas attached with PDC_Server_attach_client_shm
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_detach_all_client_shm();
+
 /**
  * Update the storage location information of the corresponding metadata that may be stored in a
  * remote server, using Mercury bulk transfer.
@@ -0,0 +1,732 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <inttypes.h>
+
+#include "pdc_config.h"
+#include "pdc_utlist.h"
+#include "pdc_hash-table.h"
+#include "pdc_client_server_common.h"
+#include "pdc_server_wal.h"
+#include "pdc_server_meta_store.h"
+#include "pdc_server.h"
+
+// Every record is this header followed by size bytes of payload, encoded like the kvtags of a checkpoint
+typedef struct pdc_meta_store_record_header_t {
+    uint64_t obj_id;
+    uint32_t size;
+    uint32_t checksum; // of the payload
+} pdc_meta_store_record_header_t;
+
+typedef struct pdc_meta_store_entry_t {
+    uint64_t        obj_id;
+    pdc_metadata_t *meta;
+    uint64_t        offset;     // of the latest record in the log
+    uint32_t        size;       // of the latest record, 0 if the list was never written or changed since
+    size_t          mem_size;   // bytes of the list while it is resident
+    int             resident;
+
+    // LRU of resident lists, most recent first
+    struct pdc_meta_store_entry_t *prev;
+    struct pdc_meta_store_entry_t *next;
+} pdc_meta_store_entry_t;
+
+static int                     pdc_meta_store_fd_g = -1;
+static char                    pdc_meta_store_path_g[ADDR_MAX];
+static size_t                  pdc_meta_store_cache_size_g = 0;
+static HashTable *             pdc_meta_store_dir_g        = NULL;
+static pdc_meta_store_entry_t *pdc_meta_store_lru_g        = NULL;
+static pdc_meta_store_stats_t  pdc_meta_store_stats_g;
+#ifdef ENABLE_MULTITHREAD
+static hg_thread_mutex_t pdc_meta_store_mutex_g;
+#endif
+
+static int
+meta_store_id_equal(void *vlocation1, void *vlocation2)
+{
+    return *((uint64_t *)vlocation1) == *((uint64_t *)vlocation2);
+}
+
+static unsigned int
+meta_store_id_hash(void *vlocation)
+{
+    uint64_t obj_id = *((uint64_t *)vlocation);
+
+    return (unsigned int)(obj_id ^ (obj_id >> 32));
+}
+
+static void
+meta_store_entry_free(void *value)
+{
+    free(value);
+}
+
+// Resident lists are also charged to the server memory usage
+static void
+meta_store_mem_add(pdc_meta_store_entry_t *entry)
+{
+    pdc_meta_store_stats_g.mem_size += entry->mem_size;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&total_mem_usage_mutex_g);
+#endif
+    total_mem_usage_g += entry->mem_size;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&total_mem_usage_mutex_g);
+#endif
+}
+
+static void
+meta_store_mem_sub(pdc_meta_store_entry_t *entry)
+{
+    pdc_meta_store_stats_g.mem_size -= entry->mem_size;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&total_mem_usage_mutex_g);
+#endif
+    total_mem_usage_g -= entry->mem_size;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&total_mem_usage_mutex_g);
+#endif
+}
+
+static size_t
+meta_store_list_mem_size(pdc_kvtag_list_t *list)
+{
+    pdc_kvtag_list_t *elt;
+    size_t            size = 0;
+
+    DL_FOREACH(list, elt)
+    {
+        size += sizeof(pdc_kvtag_list_t) + sizeof(pdc_kvtag_t) + strlen(elt->kvtag->name) + 1 +
+                elt->kvtag->size;
+    }
+    return size;
+}
+
+/*
+ * Encode a kvtag list as a log record
+ *
+ * \param  obj_id[IN]       Object ID
+ * \param  list[IN]         Head of the list
+ * \param  size[OUT]        Record size, with its header
+ *
+ * \return Pointer to the record, to be freed by the caller/NULL on failure
+ */
+static char *
+meta_store_encode(uint64_t obj_id, pdc_kvtag_list_t *list, size_t *size)
+{
+    pdc_meta_store_record_header_t *header;
+    pdc_kvtag_list_t *              elt;
+    char *                          buf, *pos;
+    int                             n_kvtag = 0, key_len;
+
+    *size = sizeof(pdc_meta_store_record_header_t) + sizeof(int);
+    DL_FOREACH(list, elt)
+    {
+        *size += sizeof(int) + strlen(elt->kvtag->name) + 1 + sizeof(uint32_t) + elt->kvtag->size;
+        n_kvtag++;
+    }
+
+    buf = (char *)malloc(*size);
+    if (buf == NULL)
+        return NULL;
+
+    header = (pdc_meta_store_record_header_t *)buf;
+    pos    = (char *)(header + 1);
+    memcpy(pos, &n_kvtag, sizeof(int));
+    pos += sizeof(int);
+    DL_FOREACH(list, elt)
+    {
+        key_len = strlen(elt->kvtag->name) + 1;
+        memcpy(pos, &key_len, sizeof(int));
+        pos += sizeof(int);
+        memcpy(pos, elt->kvtag->name, key_len);
+        pos += key_len;
+        memcpy(pos, &elt->kvtag->size, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+        memcpy(pos, elt->kvtag->value, elt->kvtag->size);
+        pos += elt->kvtag->size;
+    }
+
+    header->obj_id   = obj_id;
+    header->size     = (uint32_t)(*size - sizeof(pdc_meta_store_record_header_t));
+    header->checksum = PDC_Server_checksum(header + 1, header->size);
+
+    return buf;
+}
+
+/*
+ * Read the record of an entry back from the log and decode its kvtag list
+ *
+ * \param  entry[IN]        Directory entry, with a record in the log
+ * \param  list[OUT]        Head of the decoded list
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+meta_store_read(pdc_meta_store_entry_t *entry, pdc_kvtag_list_t **list)
+{
+    perr_t                          ret_value = SUCCEED;
+    pdc_meta_store_record_header_t *header;
+    pdc_kvtag_list_t *              elt;
+    char *                          buf = NULL, *pos, *end;
+    int                             n_kvtag = 0, key_len, i;
+
+    FUNC_ENTER(NULL);
+
+    *list = NULL;
+    buf   = (char *)malloc(entry->size);
+    if (buf == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot allocate a store record", pdc_server_rank_g);
+    if (pread(pdc_meta_store_fd_g, buf, entry->size, entry->offset) != (ssize_t)entry->size)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot read the store record of %" PRIu64, pdc_server_rank_g,
+                    entry->obj_id);
+
+    header = (pdc_meta_store_record_header_t *)buf;
+    pos    = (char *)(header + 1);
+    end    = buf + entry->size;
+    if (header->obj_id != entry->obj_id ||
+        header->size != entry->size - sizeof(pdc_meta_store_record_header_t) ||
+        header->checksum != PDC_Server_checksum(pos, header->size))
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: corrupted store record of %" PRIu64, pdc_server_rank_g,
+                    entry->obj_id);
+
+    memcpy(&n_kvtag, pos, sizeof(int));
+    pos += sizeof(int);
+    for (i = 0; i < n_kvtag; i++) {
+        if (end - pos < (ssize_t)sizeof(int))
+            PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed store record", pdc_server_rank_g);
+        memcpy(&key_len, pos, sizeof(int));
+        pos += sizeof(int);
+        if (key_len <= 0 || end - pos < key_len + (ssize_t)sizeof(uint32_t))
+            PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed store record", pdc_server_rank_g);
+
+        elt              = (pdc_kvtag_list_t *)calloc(1, sizeof(pdc_kvtag_list_t));
+        elt->kvtag       = (pdc_kvtag_t *)malloc(sizeof(pdc_kvtag_t));
+        elt->kvtag->name = (char *)malloc(key_len);
+        memcpy(elt->kvtag->name, pos, key_len);
+        elt->kvtag->name[key_len - 1] = '\0';
+        pos += key_len;
+        memcpy(&elt->kvtag->size, pos, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+        if (end - pos < (ssize_t)elt->kvtag->size)
+            elt->kvtag->size = 0;
+        elt->kvtag->value = malloc(elt->kvtag->size);
+        memcpy(elt->kvtag->value, pos, elt->kvtag->size);
+        pos += elt->kvtag->size;
+        DL_APPEND(*list, elt);
+    }
+
+done:
+    if (ret_value != SUCCEED) {
+        PDC_Server_meta_store_free_list(*list);
+        *list = NULL;
+    }
+    free(buf);
+    FUNC_LEAVE(ret_value);
+}
+
+// Mark the record of an entry as dead, the list has changed or the object is gone
+static void
+meta_store_drop_record(pdc_meta_store_entry_t *entry)
+{
+    if (entry->size > 0) {
+        pdc_meta_store_stats_g.dead_size += entry->size;
+        entry->size = 0;
+    }
+}
+
+/*
+ * Rewrite the log with only the live records. The new log is written next to the old one and renamed over
+ * it, so a forked checkpoint still reading the old one is not disturbed.
+ *
+ * \return Non-negative on success/Negative on failure, the old log is kept
+ */
+static perr_t
+meta_store_compact()
+{
+    perr_t                  ret_value = SUCCEED;
+    char                    path[ADDR_MAX + 8];
+    HashTableIterator       iter;
+    pdc_meta_store_entry_t *entry;
+    uint64_t *              offsets = NULL, offset = 0;
+    char *                  buf     = NULL;
+    size_t                  buf_size = 0, i = 0;
+    int                     fd       = -1;
+
+    FUNC_ENTER(NULL);
+
+    snprintf(path, sizeof(path), "%s.compact", pdc_meta_store_path_g);
+    fd      = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    offsets = (uint64_t *)malloc(sizeof(uint64_t) * (hash_table_num_entries(pdc_meta_store_dir_g) + 1));
+    if (fd < 0 || offsets == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot create %s", pdc_server_rank_g, path);
+
+    // The table does not change during the two passes, so they visit the entries in the same order
+    hash_table_iterate(pdc_meta_store_dir_g, &iter);
+    while (hash_table_iter_has_more(&iter)) {
+        entry = (pdc_meta_store_entry_t *)hash_table_iter_next(&iter).value;
+        if (entry->size == 0)
+            continue;
+        if (entry->size > buf_size) {
+            free(buf);
+            buf_size = entry->size * 2;
+            buf      = (char *)malloc(buf_size);
+            if (buf == NULL)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot allocate a store record", pdc_server_rank_g);
+        }
+        if (pread(pdc_meta_store_fd_g, buf, entry->size, entry->offset) != (ssize_t)entry->size ||
+            pwrite(fd, buf, entry->size, offset) != (ssize_t)entry->size)
+            PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot copy the store record of %" PRIu64,
+                        pdc_server_rank_g, entry->obj_id);
+        offsets[i++] = offset;
+        offset += entry->size;
+    }
+
+    if (rename(path, pdc_meta_store_path_g) != 0)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot rename %s", pdc_server_rank_g, path);
+
+    i = 0;
+    hash_table_iterate(pdc_meta_store_dir_g, &iter);
+    while (hash_table_iter_has_more(&iter)) {
+        entry = (pdc_meta_store_entry_t *)hash_table_iter_next(&iter).value;
+        if (entry->size > 0)
+            entry->offset = offsets[i++];
+    }
+
+    close(pdc_meta_store_fd_g);
+    pdc_meta_store_fd_g              = fd;
+    fd                               = -1;
+    pdc_meta_store_stats_g.log_size  = offset;
+    pdc_meta_store_stats_g.dead_size = 0;
+    pdc_meta_store_stats_g.n_compact++;
+
+done:
+    if (fd >= 0) {
+        close(fd);
+        unlink(path);
+    }
+    free(offsets);
+    free(buf);
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Write the list of an entry to the log if it has no live record, then drop it from memory
+ *
+ * \param  entry[IN]        Resident entry
+ *
+ * \return Non-negative on success/Negative on failure, the list stays resident
+ */
+static perr_t
+meta_store_evict(pdc_meta_store_entry_t *entry)
+{
+    perr_t ret_value = SUCCEED;
+    char * record    = NULL;
+    size_t size;
+
+    FUNC_ENTER(NULL);
+
+    if (entry->size == 0) {
+        record = meta_store_encode(entry->obj_id, entry->meta->kvtag_list_head, &size);
+        if (record == NULL)
+            PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot encode a store record", pdc_server_rank_g);
+        if (pwrite(pdc_meta_store_fd_g, record, size, pdc_meta_store_stats_g.log_size) != (ssize_t)size)
+            PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot write the store record of %" PRIu64,
+                        pdc_server_rank_g, entry->obj_id);
+        entry->offset = pdc_meta_store_stats_g.log_size;
+        entry->size   = (uint32_t)size;
+        pdc_meta_store_stats_g.log_size += size;
+    }
+
+    PDC_Server_meta_store_free_list(entry->meta->kvtag_list_head);
+    entry->meta->kvtag_list_head = NULL;
+    entry->resident              = 0;
+    DL_DELETE(pdc_meta_store_lru_g, entry);
+    meta_store_mem_sub(entry);
+    pdc_meta_store_stats_g.n_resident--;
+    pdc_meta_store_stats_g.n_evict++;
+
+done:
+    free(record);
+    FUNC_LEAVE(ret_value);
+}
+
+// Drop the coldest lists while the cache is over its size, but never the one of keep
+static void
+meta_store_shrink(pdc_meta_store_entry_t *keep)
+{
+    while (pdc_meta_store_stats_g.mem_size > pdc_meta_store_cache_size_g &&
+           pdc_meta_store_lru_g->prev != keep) {
+        if (meta_store_evict(pdc_meta_store_lru_g->prev) != SUCCEED)
+            break;
+    }
+}
+
+perr_t
+PDC_Server_meta_store_open(const char *path, size_t cache_size)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_meta_store_fd_g >= 0)
+        PGOTO_DONE(ret_value);
+
+    snprintf(pdc_meta_store_path_g, ADDR_MAX, "%s", path);
+    pdc_meta_store_fd_g = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (pdc_meta_store_fd_g < 0)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot open metadata store %s", pdc_server_rank_g, path);
+
+    pdc_meta_store_dir_g = hash_table_new(meta_store_id_hash, meta_store_id_equal);
+    if (pdc_meta_store_dir_g == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot create the store directory", pdc_server_rank_g);
+    hash_table_register_free_functions(pdc_meta_store_dir_g, NULL, meta_store_entry_free);
+
+    pdc_meta_store_cache_size_g = cache_size;
+    memset(&pdc_meta_store_stats_g, 0, sizeof(pdc_meta_store_stats_t));
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_init(&pdc_meta_store_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_meta_store_close()
+{
+    FUNC_ENTER(NULL);
+
+    if (pdc_meta_store_fd_g < 0)
+        goto done;
+
+    // The dropped lists belong to metadata that is freed with the hash table
+    hash_table_free(pdc_meta_store_dir_g);
+    pdc_meta_store_dir_g = NULL;
+    pdc_meta_store_lru_g = NULL;
+    close(pdc_meta_store_fd_g);
+    pdc_meta_store_fd_g = -1;
+    unlink(pdc_meta_store_path_g);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_destroy(&pdc_meta_store_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+perr_t
+PDC_Server_meta_store_load(pdc_metadata_t *meta)
+{
+    perr_t                  ret_value = SUCCEED;
+    pdc_meta_store_entry_t *entry;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_meta_store_fd_g < 0)
+        PGOTO_DONE(ret_value);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_meta_store_mutex_g);
+#endif
+    entry = (pdc_meta_store_entry_t *)hash_table_lookup(pdc_meta_store_dir_g, &meta->obj_id);
+    if (entry == NULL)
+        goto unlock;
+
+    if (entry->resident) {
+        DL_DELETE(pdc_meta_store_lru_g, entry);
+        DL_PREPEND(pdc_meta_store_lru_g, entry);
+        goto unlock;
+    }
+
+    ret_value = meta_store_read(entry, &meta->kvtag_list_head);
+    if (ret_value != SUCCEED)
+        goto unlock;
+    entry->resident = 1;
+    entry->mem_size = meta_store_list_mem_size(meta->kvtag_list_head);
+    DL_PREPEND(pdc_meta_store_lru_g, entry);
+    meta_store_mem_add(entry);
+    pdc_meta_store_stats_g.n_resident++;
+    pdc_meta_store_stats_g.n_load++;
+
+unlock:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_meta_store_mutex_g);
+#endif
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_meta_store_touch(pdc_metadata_t *meta)
+{
+    pdc_meta_store_entry_t *entry;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_meta_store_fd_g < 0)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_meta_store_mutex_g);
+#endif
+    entry = (pdc_meta_store_entry_t *)hash_table_lookup(pdc_meta_store_dir_g, &meta->obj_id);
+
+    if (meta->kvtag_list_head == NULL) {
+        // No tags left, nothing to keep
+        if (entry != NULL) {
+            meta_store_drop_record(entry);
+            if (entry->resident) {
+                DL_DELETE(pdc_meta_store_lru_g, entry);
+                meta_store_mem_sub(entry);
+                pdc_meta_store_stats_g.n_resident--;
+            }
+            pdc_meta_store_stats_g.n_obj--;
+            hash_table_remove(pdc_meta_store_dir_g, &meta->obj_id);
+        }
+        goto unlock;
+    }
+
+    if (entry == NULL) {
+        entry = (pdc_meta_store_entry_t *)calloc(1, sizeof(pdc_meta_store_entry_t));
+        if (entry == NULL)
+            goto unlock;
+        entry->obj_id = meta->obj_id;
+        if (hash_table_insert(pdc_meta_store_dir_g, &entry->obj_id, entry) != 1) {
+            free(entry);
+            goto unlock;
+        }
+        pdc_meta_store_stats_g.n_obj++;
+    }
+    else if (entry->resident) {
+        DL_DELETE(pdc_meta_store_lru_g, entry);
+        meta_store_mem_sub(entry);
+        pdc_meta_store_stats_g.n_resident--;
+    }
+
+    // The list has changed, its record in the log is stale
+    meta_store_drop_record(entry);
+    entry->meta     = meta;
+    entry->resident = 1;
+    entry->mem_size = meta_store_list_mem_size(meta->kvtag_list_head);
+    DL_PREPEND(pdc_meta_store_lru_g, entry);
+    meta_store_mem_add(entry);
+    pdc_meta_store_stats_g.n_resident++;
+
+    meta_store_shrink(entry);
+
+    if (pdc_meta_store_stats_g.dead_size > PDC_META_STORE_COMPACT_SIZE &&
+        pdc_meta_store_stats_g.dead_size * 2 > pdc_meta_store_stats_g.log_size)
+        meta_store_compact();
+
+unlock:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_meta_store_mutex_g);
+#endif
+done:
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_meta_store_remove(pdc_metadata_t *meta)
+{
+    pdc_meta_store_entry_t *entry;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_meta_store_fd_g < 0)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_meta_store_mutex_g);
+#endif
+    entry = (pdc_meta_store_entry_t *)hash_table_lookup(pdc_meta_store_dir_g, &meta->obj_id);
+    if (entry != NULL) {
+        meta_store_drop_record(entry);
+        if (entry->resident) {
+            DL_DELETE(pdc_meta_store_lru_g, entry);
+            meta_store_mem_sub(entry);
+            pdc_meta_store_stats_g.n_resident--;
+        }
+        pdc_meta_store_stats_g.n_obj--;
+        hash_table_remove(pdc_meta_store_dir_g, &meta->obj_id);
+    }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_meta_store_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+pdc_kvtag_list_t *
+PDC_Server_meta_store_get(pdc_metadata_t *meta, int *is_copy)
+{
+    pdc_kvtag_list_t *      ret_value = NULL;
+    pdc_meta_store_entry_t *entry;
+    size_t                  mem_size;
+
+    FUNC_ENTER(NULL);
+
+    *is_copy = 0;
+    if (pdc_meta_store_fd_g < 0) {
+        ret_value = meta->kvtag_list_head;
+        goto done;
+    }
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_meta_store_mutex_g);
+#endif
+    entry = (pdc_meta_store_entry_t *)hash_table_lookup(pdc_meta_store_dir_g, &meta->obj_id);
+    if (entry == NULL || entry->resident) {
+        if (entry != NULL) {
+            DL_DELETE(pdc_meta_store_lru_g, entry);
+            DL_PREPEND(pdc_meta_store_lru_g, entry);
+        }
+        ret_value = meta->kvtag_list_head;
+        goto unlock;
+    }
+
+    if (meta_store_read(entry, &ret_value) != SUCCEED)
+        goto unlock;
+    pdc_meta_store_stats_g.n_load++;
+    mem_size = meta_store_list_mem_size(ret_value);
+#ifdef ENABLE_MULTITHREAD
+    // Other readers may be using the colder lists, so none can be dropped to make room
+    if (pdc_meta_store_stats_g.mem_size + mem_size > pdc_meta_store_cache_size_g) {
+        *is_copy = 1;
+        goto unlock;
+    }
+#endif
+
+    meta->kvtag_list_head = ret_value;
+    entry->resident       = 1;
+    entry->mem_size       = mem_size;
+    DL_PREPEND(pdc_meta_store_lru_g, entry);
+    meta_store_mem_add(entry);
+    pdc_meta_store_stats_g.n_resident++;
+#ifndef ENABLE_MULTITHREAD
+    meta_store_shrink(entry);
+#endif
+
+unlock:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_meta_store_mutex_g);
+#endif
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+pdc_kvtag_list_t *
+PDC_Server_meta_store_peek(pdc_metadata_t *meta, int *is_copy)
+{
+    pdc_kvtag_list_t *      ret_value = meta->kvtag_list_head;
+    pdc_meta_store_entry_t *entry;
+
+    FUNC_ENTER(NULL);
+
+    *is_copy = 0;
+    if (pdc_meta_store_fd_g < 0 || ret_value != NULL)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_meta_store_mutex_g);
+#endif
+    entry = (pdc_meta_store_entry_t *)hash_table_lookup(pdc_meta_store_dir_g, &meta->obj_id);
+    if (entry != NULL && !entry->resident && meta_store_read(entry, &ret_value) == SUCCEED)
+        *is_copy = 1;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_meta_store_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_meta_store_free_list(pdc_kvtag_list_t *list)
+{
+    pdc_kvtag_list_t *elt, *tmp;
+
+    DL_FOREACH_SAFE(list, elt, tmp)
+    {
+        DL_DELETE(list, elt);
+        free(elt->kvtag->name);
+        free(elt->kvtag->value);
+        free(elt->kvtag);
+        free(elt);
+    }
+}
+
+void
+PDC_Server_meta_store_get_stats(pdc_meta_store_stats_t *stats)
+{
+    FUNC_ENTER(NULL);
+
+    memset(stats, 0, sizeof(pdc_meta_store_stats_t));
+    if (pdc_meta_store_fd_g >= 0) {
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_lock(&pdc_meta_store_mutex_g);
+#endif
+        memcpy(stats, &pdc_meta_store_stats_g, sizeof(pdc_meta_store_stats_t));
+        stats->cache_size = pdc_meta_store_cache_size_g;
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_unlock(&pdc_meta_store_mutex_g);
+#endif
+    }
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&total_mem_usage_mutex_g);
+#endif
+    stats->total_mem_size = total_mem_usage_g > 0 ? (size_t)total_mem_usage_g : 0;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&total_mem_usage_mutex_g);
+#endif
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_meta_store_fork_prepare()
+{
+#ifdef ENABLE_MULTITHREAD
+    if (pdc_meta_store_fd_g >= 0)
+        hg_thread_mutex_lock(&pdc_meta_store_mutex_g);
+#endif
+}
+
+void
+PDC_Server_meta_store_fork_done()
+{
+#ifdef ENABLE_MULTITHREAD
+    if (pdc_meta_store_fd_g >= 0)
+        hg_thread_mutex_unlock(&pdc_meta_store_mutex_g);
+#endif
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+/*
+ * Log-structured store for the kvtag lists of objects, so that the tags of a namespace larger than memory
+ * live on disk. The lists of recently used objects stay in memory up to a cache size; when the cache is
+ * full the coldest lists are appended to a log file in the server tmp dir and dropped, and a directory
+ * keyed by object ID keeps where each one was written. A list is read back on its next access. The log is
+ * rewritten without its dead records once they are more than half of it. The store is a spill area, the
+ * checkpoint and the write-ahead log remain the durable copy of the tags.
+ *
+ * Only the list payloads are bounded by the cache size. The kvtag inverted index keeps a copy of every
+ * distinct value and the IDs of the objects that have it in memory, which is charged to the server memory
+ * usage (total_mem_usage_g) along with the resident lists.
+ */
+
+#ifndef PDC_SERVER_META_STORE_H
+#define PDC_SERVER_META_STORE_H
+
+#include "pdc_server_common.h"
+#include "pdc_client_server_common.h"
+
+// The log is compacted once its dead records exceed half of it and this size
+#define PDC_META_STORE_COMPACT_SIZE (64 << 20)
+
+typedef struct pdc_meta_store_stats_t {
+    uint64_t n_obj;       // objects with kvtags in the directory
+    uint64_t n_resident;  // of which the list is in memory
+    size_t   mem_size;    // bytes of resident lists
+    size_t   cache_size;  // bytes the resident lists are kept under
+    size_t   log_size;    // bytes in the log file
+    size_t   dead_size;   // bytes of records that were replaced
+    uint64_t n_load;      // lists read back from the log
+    uint64_t n_evict;     // lists dropped from memory
+    uint64_t n_compact;   // log rewrites
+    // bytes the server has accounted for, resident lists and the kvtag index included, set even when the
+    // store is disabled
+    size_t total_mem_size;
+} pdc_meta_store_stats_t;
+
+/***************************************/
+/* Library-private Function Prototypes */
+/***************************************/
+
+/**
+ * Open the store, kvtag lists stay in memory until it is opened. An existing log is discarded.
+ *
+ * \param path [IN]              Path of the log file
+ * \param cache_size [IN]        Bytes of kvtag lists kept in memory
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_meta_store_open(const char *path, size_t cache_size);
+
+/**
+ * Close the store and remove its log, the lists still on disk are lost
+ */
+void PDC_Server_meta_store_close();
+
+/**
+ * Make the kvtag list of an object resident, reading it back from the log if it was dropped. Called with
+ * the metadata write lock held before a change, the PDC_Server_meta_store_touch or
+ * PDC_Server_meta_store_remove that follows brings the cache back under its size.
+ *
+ * \param meta [IN]              Metadata of the object
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_meta_store_load(pdc_metadata_t *meta);
+
+/**
+ * Account for a resident kvtag list that was created or changed, colder lists are dropped while the cache
+ * is over its size. Called with the metadata write lock held.
+ *
+ * \param meta [IN]              Metadata of the object
+ */
+void PDC_Server_meta_store_touch(pdc_metadata_t *meta);
+
+/**
+ * Forget an object that is deleted, its kvtag list must be resident
+ *
+ * \param meta [IN]              Metadata of the object
+ */
+void PDC_Server_meta_store_remove(pdc_metadata_t *meta);
+
+/**
+ * Get the kvtag list of an object to look a tag up, called with the metadata read lock held. A list read
+ * back from the log is made resident, and colder lists are dropped to keep the cache under its size. In a
+ * multithreaded server other readers may hold the colder lists, so the list is instead returned as a copy
+ * when the cache has no room for it.
+ *
+ * \param meta [IN]              Metadata of the object
+ * \param is_copy [OUT]          Set if the list must be freed with PDC_Server_meta_store_free_list
+ *
+ * \return Head of the list, NULL if there are no tags or on failure
+ */
+pdc_kvtag_list_t *PDC_Server_meta_store_get(pdc_metadata_t *meta, int *is_copy);
+
+/**
+ * Get the kvtag list of an object without making it resident, e.g. to checkpoint it
+ *
+ * \param meta [IN]              Metadata of the object
+ * \param is_copy [OUT]          Set if the list was read from the log and must be freed with
+ *                               PDC_Server_meta_store_free_list
+ *
+ * \return Head of the list, NULL if there are no tags or on failure
+ */
+pdc_kvtag_list_t *PDC_Server_meta_store_peek(pdc_metadata_t *meta, int *is_copy);
+
+/**
+ * Free a kvtag list returned as a copy by PDC_Server_meta_store_get or PDC_Server_meta_store_peek
+ *
+ * \param list [IN]              Head of the list
+ */
+void PDC_Server_meta_store_free_list(pdc_kvtag_list_t *list);
+
+/**
+ * Get the occupancy of the store
+ *
+ * \param stats [OUT]            Statistics
+ */
+void PDC_Server_meta_store_get_stats(pdc_meta_store_stats_t *stats);
+
+/**
+ * Hold the store lock across a fork, so the child does not copy it while another thread has it
+ */
+void PDC_Server_meta_store_fork_prepare();
+
+/**
+ * Release the store lock taken by PDC_Server_meta_store_fork_prepare, in the parent and in the child
+ */
+void PDC_Server_meta_store_fork_done();
+
+#endif /* PDC_SERVER_META_STORE_H */
@@ -43,26 +43,44 @@
 
 #include "pdc_utlist.h"
 #include "pdc_hash-table.h"
-#include "pdc_dablooms.h"
+#include "pdc_swiss_table.h"
+#include "pdc_bloom.h"
 #include "pdc_interface.h"
 #include "pdc_client_server_common.h"
 #include "pdc_server_metadata.h"
+#include "pdc_server_wal.h"
+#include "pdc_server_meta_store.h"
 #include "pdc_server.h"
 
-#define BLOOM_TYPE_T counting_bloom_t
-#define BLOOM_NEW    new_counting_bloom
-#define BLOOM_CHECK  counting_bloom_check
-#define BLOOM_ADD    counting_bloom_add
-#define BLOOM_REMOVE counting_bloom_remove
-#define BLOOM_FREE   free_counting_bloom
-
 // Global hash table for storing metadata
-HashTable *metadata_hash_table_g  = NULL;
-HashTable *container_hash_table_g = NULL;
+HashTable *metadata_hash_table_g    = NULL;
+HashTable *metadata_id_hash_table_g = NULL;
+HashTable *container_hash_table_g   = NULL;
+HashTable *container_id_hash_table_g = NULL;
+HashTable *kvtag_index_hash_table_g = NULL;
+
+// Secondary indexes of partial queries, they reference metadata owned by metadata_hash_table_g
+static HashTable *         app_name_index_g = NULL;
+static HashTable *         user_id_index_g  = NULL;
+static HashTable *         tag_index_g      = NULL;
+static pdc_query_posting_t ndim_index_g[DIM_MAX + 1];
+// Keyed by time step and then object ID
+static pdc_skip_list_t *time_step_index_g = NULL;
+
+#ifndef DISABLE_SWISS_TABLE
+// Name indexes keyed by 64-bit name hashes, values are owned by metadata_hash_table_g and
+// container_hash_table_g
+static pdc_swiss_table_t *metadata_name_index_g  = NULL;
+static pdc_swiss_table_t *container_name_index_g = NULL;
+#endif
+
+// Next ID sequence number of each hash ring bucket
+static uint64_t pdc_id_seq_g[PDC_HASH_RING_NBUCKET];
 
 // Debug statistics var
 int      n_bloom_total_g            = 0;
 int      n_bloom_maybe_g            = 0;
+int      n_bloom_false_positive_g   = 0;
 double   server_bloom_check_time_g  = 0.0;
 double   server_bloom_insert_time_g = 0.0;
 double   server_insert_time_g       = 0.0;
@@ -129,6 +147,35 @@ PDC_Server_metadata_int_hash(void *vlocation)
     return *((uint32_t *)vlocation);
 }
 
+/*
+ * Check if two object ID keys are equal
+ *
+ * \param vlocation1 [IN]       Object ID index key
+ * \param vlocation2 [IN]       Object ID index key
+ *
+ * \return 1 if two keys are equal, 0 otherwise
+ */
+static int
+PDC_Server_metadata_id_equal(void *vlocation1, void *vlocation2)
+{
+    return *((uint64_t *)vlocation1) == *((uint64_t *)vlocation2);
+}
+
+/*
+ * Get object ID key's location in the object ID index
+ *
+ * \param vlocation [IN]        Object ID index key
+ *
+ * \return the location of the key in the table
+ */
+static unsigned int
+PDC_Server_metadata_id_hash(void *vlocation)
+{
+    uint64_t obj_id = *((uint64_t *)vlocation);
+
+    return (unsigned int)(obj_id ^ (obj_id >> 32));
+}
+
 /*
  * Free the hash key
  *
@@ -142,6 +189,69 @@ PDC_Server_metadata_int_hash_key_free(void *key)
     free((uint32_t *)key);
 }
 
+perr_t
+PDC_Server_metadata_set_strings(pdc_metadata_t *metadata, const char *app_name, const char *obj_name,
+                                const char *tags, const char *data_location)
+{
+    perr_t ret_value = SUCCEED;
+    char * name_copy, *tags_copy;
+
+    FUNC_ENTER(NULL);
+
+    name_copy = strdup(obj_name == NULL ? "" : obj_name);
+    tags_copy = strdup(tags == NULL ? "" : tags);
+    if (name_copy == NULL || tags_copy == NULL) {
+        free(name_copy);
+        free(tags_copy);
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot allocate metadata strings", pdc_server_rank_g);
+    }
+
+    // Few distinct app names and locations are shared by many objects, names and tags are mostly unique
+    metadata->app_name      = PDC_str_intern(app_name);
+    metadata->obj_name      = name_copy;
+    metadata->tags          = tags_copy;
+    metadata->data_location = PDC_str_intern(data_location);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&total_mem_usage_mutex_g);
+#endif
+    total_mem_usage_g += strlen(name_copy) + strlen(tags_copy) + 2;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&total_mem_usage_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_metadata_free_strings(pdc_metadata_t *metadata)
+{
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&total_mem_usage_mutex_g);
+#endif
+    total_mem_usage_g -= strlen(metadata->obj_name) + strlen(metadata->tags) + 2;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&total_mem_usage_mutex_g);
+#endif
+    free((void *)metadata->obj_name);
+    free((void *)metadata->tags);
+    metadata->obj_name = "";
+    metadata->tags     = "";
+
+    FUNC_LEAVE_VOID;
+}
+
+// Free a record taken out of the hash table, records decoded from a checkpoint live in its blocks
+static void
+metadata_record_free(pdc_metadata_t *metadata)
+{
+    PDC_Server_metadata_free_strings(metadata);
+    if (is_restart_g == 0)
+        free(metadata);
+}
+
 /*
  * Free metadata hash value
  *
@@ -161,15 +271,13 @@ PDC_Server_metadata_hash_value_free(void *value)
 
     // Free bloom filter
     if (head->bloom != NULL) {
-        BLOOM_FREE(head->bloom);
+        pdc_bloom_free(head->bloom);
     }
 
     // Free metadata list
-    if (is_restart_g == 0) {
-        DL_FOREACH_SAFE(head->metadata, elt, tmp)
-        {
-            free(elt);
-        }
+    DL_FOREACH_SAFE(head->metadata, elt, tmp)
+    {
+        metadata_record_free(elt);
     }
 }
 
@@ -186,6 +294,8 @@ PDC_Server_container_hash_value_free(void *value)
     pdc_cont_hash_table_entry_t *head = (pdc_cont_hash_table_entry_t *)value;
     if (head->obj_ids != NULL)
         free(head->obj_ids);
+    if (head->obj_id_slots != NULL)
+        free(head->obj_id_slots);
 }
 
 /*
@@ -202,10 +312,10 @@ PDC_Server_metadata_init(pdc_metadata_t *a)
 
     FUNC_ENTER(NULL);
 
-    a->user_id     = 0;
-    a->time_step   = 0;
-    a->app_name[0] = 0;
-    a->obj_name[0] = 0;
+    a->user_id   = 0;
+    a->time_step = 0;
+    a->app_name  = "";
+    a->obj_name  = "";
 
     a->obj_id  = 0;
     a->cont_id = 0;
@@ -215,8 +325,8 @@ PDC_Server_metadata_init(pdc_metadata_t *a)
 
     a->create_time        = 0;
     a->last_modified_time = 0;
-    a->tags[0]            = 0;
-    a->data_location[0]   = 0;
+    a->tags               = "";
+    a->data_location      = "";
 
     a->region_lock_head    = NULL;
     a->region_map_head     = NULL;
@@ -229,18 +339,43 @@ PDC_Server_metadata_init(pdc_metadata_t *a)
 // ^ hash table
 
 /*
- * Concatenate the metadata's obj_name and time_step to one char array
+ * Append tags to the metadata's tags, separated with ','
  *
  * \param  metadata [IN]        PDC metadata structure pointer
- * \param  output   [OUT]       Concatenated char array pointer
+ * \param  tags     [IN]        Tags to append
  *
  * \return void
  */
-static inline void
-combine_obj_info_to_string(pdc_metadata_t *metadata, char *output)
+static void
+metadata_append_tags(pdc_metadata_t *metadata, const char *tags)
 {
+    char * new_tags;
+    size_t len;
+
     FUNC_ENTER(NULL);
-    snprintf(output, TAG_LEN_MAX, "%s%d", metadata->obj_name, metadata->time_step);
+
+    len      = strlen(metadata->tags) + strlen(tags) + 2;
+    new_tags = (char *)malloc(len);
+    if (new_tags == NULL) {
+        printf("==PDC_SERVER[%d]: %s - cannot allocate tags\n", pdc_server_rank_g, __func__);
+        goto done;
+    }
+    if (metadata->tags[0] == 0)
+        snprintf(new_tags, len, "%s", tags);
+    else
+        snprintf(new_tags, len, "%s,%s", metadata->tags, tags);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&total_mem_usage_mutex_g);
+#endif
+    total_mem_usage_g += (double)strlen(new_tags) - (double)strlen(metadata->tags);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&total_mem_usage_mutex_g);
+#endif
+    free((void *)metadata->tags);
+    metadata->tags = new_tags;
+
+done:
+    FUNC_LEAVE_VOID;
 }
 
 /*
@@ -276,38 +411,30 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
-pdc_metadata_t *
-find_metadata_by_id(uint64_t obj_id)
+/*
+ * Add a metadata to the object ID index, the key points to the metadata's own obj_id
+ *
+ * \param  metadata[IN]     Metadata pointer to be indexed
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+metadata_id_index_insert(pdc_metadata_t *metadata)
 {
-    pdc_metadata_t *           ret_value = NULL;
-    pdc_hash_table_entry_head *head;
-    pdc_metadata_t *           elt;
-    HashTableIterator          hash_table_iter;
-    HashTablePair              pair;
-    int                        n_entry;
+    perr_t ret_value = SUCCEED;
 
     FUNC_ENTER(NULL);
 
-    if (metadata_hash_table_g != NULL) {
-        // Since we only have the obj id, need to iterate the entire hash table
-        n_entry = hash_table_num_entries(metadata_hash_table_g);
-        hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
-
-        while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
+    if (metadata_id_hash_table_g == NULL) {
+        printf("==PDC_SERVER: metadata_id_hash_table_g not initialized!\n");
+        ret_value = FAIL;
+        goto done;
+    }
 
-            pair = hash_table_iter_next(&hash_table_iter);
-            head = pair.value;
-            // Now iterate the list under this entry
-            DL_FOREACH(head->metadata, elt)
-            {
-                if (elt->obj_id == obj_id) {
-                    return elt;
-                }
-            }
-        }
-    } // if (metadata_hash_table_g != NULL)
-    else {
-        printf("==PDC_SERVER: metadata_hash_table_g not initialized!\n");
+    if (hash_table_insert(metadata_id_hash_table_g, &metadata->obj_id, metadata) != 1) {
+        printf("==PDC_SERVER[%d]: error inserting obj %" PRIu64 " to the ID index\n", pdc_server_rank_g,
+               metadata->obj_id);
+        ret_value = FAIL;
         goto done;
     }
 
@@ -315,194 +442,1214 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Remove a metadata from the object ID index, must be done before the metadata is freed
+ *
+ * \param  obj_id[IN]       Object ID
+ *
+ * \return void
+ */
+static void
+metadata_id_index_remove(uint64_t obj_id)
+{
+    FUNC_ENTER(NULL);
+
+    if (metadata_id_hash_table_g != NULL)
+        hash_table_remove(metadata_id_hash_table_g, &obj_id);
+
+    FUNC_LEAVE_VOID;
+}
+
 pdc_metadata_t *
-PDC_Server_get_obj_metadata(pdcid_t obj_id)
+find_metadata_by_id(uint64_t obj_id)
 {
     pdc_metadata_t *ret_value = NULL;
 
     FUNC_ENTER(NULL);
 
-    ret_value = find_metadata_by_id(obj_id);
+    if (metadata_id_hash_table_g != NULL) {
+        ret_value = hash_table_lookup(metadata_id_hash_table_g, &obj_id);
+    }
+    else {
+        printf("==PDC_SERVER: metadata_id_hash_table_g not initialized!\n");
+        goto done;
+    }
 
+done:
     FUNC_LEAVE(ret_value);
 }
 
-int
-PDC_Server_has_metadata(pdcid_t obj_id)
-{
-    if (obj_id / PDC_SERVER_ID_INTERVEL == (pdcid_t)pdc_server_rank_g + 1)
-        return 1;
-    return 0;
-}
-
 /*
- * Find if there is identical metadata exist in hash table
+ * Name key of an object, its name hashed together with its time step, used by the name index and the
+ * bloom filters
  *
- * \param  entry[IN]        Hash table entry of metadata
- * \param  a[IN]            Pointer to metadata to be checked against
+ * \param  obj_name[IN]      Object name
+ * \param  time_step[IN]     Time step
  *
- * \return NULL if no match is found/pointer to the found metadata otherwise
+ * \return 64-bit key
  */
-static pdc_metadata_t *
-find_identical_metadata(pdc_hash_table_entry_head *entry, pdc_metadata_t *a)
+static uint64_t
+metadata_name_index_key(const char *obj_name, int time_step)
 {
-    pdc_metadata_t *ret_value = NULL;
-    BLOOM_TYPE_T *  bloom;
-    int             bloom_check;
-    char            combined_string[TAG_LEN_MAX];
-    pdc_metadata_t *elt;
-
-    FUNC_ENTER(NULL);
+    return pdc_swiss_hash_bytes(obj_name, strlen(obj_name), (uint64_t)(uint32_t)time_step);
+}
 
-    // Use bloom filter to quick check if current metadata is in the list
-    if (entry->bloom != NULL && a->user_id != 0 && a->app_name[0] != 0) {
-        bloom = entry->bloom;
-        combine_obj_info_to_string(a, combined_string);
+#ifndef DISABLE_SWISS_TABLE
 
-#ifdef ENABLE_TIMING
-        struct timeval pdc_timer_start;
-        struct timeval pdc_timer_end;
-        double         ht_total_sec;
+static int
+metadata_name_index_match(const void *value, const void *arg)
+{
+    return PDC_metadata_cmp((pdc_metadata_t *)value, (pdc_metadata_t *)arg) == 0;
+}
 
-        gettimeofday(&pdc_timer_start, 0);
+static int
+container_name_index_match(const void *value, const void *arg)
+{
+    return strcmp(((const pdc_cont_hash_table_entry_t *)value)->cont_name, (const char *)arg) == 0;
+}
 #endif
 
-        bloom_check = BLOOM_CHECK(bloom, combined_string, strlen(combined_string));
+/*
+ * Add a metadata to the name index, must be done again after its name or time step changes
+ *
+ * \param  metadata[IN]     Metadata pointer to be indexed
+ *
+ * \return void
+ */
+static void
+metadata_name_index_insert(pdc_metadata_t *metadata)
+{
+    FUNC_ENTER(NULL);
 
-#ifdef ENABLE_TIMING
-        gettimeofday(&pdc_timer_end, 0);
-        ht_total_sec = PDC_get_elapsed_time_double(&pdc_timer_start, &pdc_timer_end);
+#ifndef DISABLE_SWISS_TABLE
+    if (metadata_name_index_g != NULL &&
+        pdc_swiss_table_insert(metadata_name_index_g,
+                               metadata_name_index_key(metadata->obj_name, metadata->time_step),
+                               metadata) == 0)
+        printf("==PDC_SERVER[%d]: error inserting obj %" PRIu64 " to the name index\n", pdc_server_rank_g,
+               metadata->obj_id);
 #endif
 
-#ifdef ENABLE_MULTITHREAD
-        hg_thread_mutex_lock(&pdc_bloom_time_mutex_g);
-#endif
+    FUNC_LEAVE_VOID;
+}
 
-#ifdef ENABLE_TIMING
-        server_bloom_check_time_g += ht_total_sec;
-#endif
+/*
+ * Remove a metadata from the name index, must be done before its name or time step changes
+ *
+ * \param  metadata[IN]     Metadata pointer
+ *
+ * \return void
+ */
+static void
+metadata_name_index_remove(pdc_metadata_t *metadata)
+{
+    FUNC_ENTER(NULL);
 
-#ifdef ENABLE_MULTITHREAD
-        hg_thread_mutex_unlock(&pdc_bloom_time_mutex_g);
+#ifndef DISABLE_SWISS_TABLE
+    if (metadata_name_index_g != NULL)
+        pdc_swiss_table_remove(metadata_name_index_g,
+                               metadata_name_index_key(metadata->obj_name, metadata->time_step), metadata);
 #endif
 
-        n_bloom_total_g++;
-        if (bloom_check == 0) {
-            ret_value = NULL;
-            goto done;
-        }
-        else {
-            // bloom filter says maybe, so need to check entire list
-            n_bloom_maybe_g++;
-            DL_FOREACH(entry->metadata, elt)
-            {
-                if (PDC_metadata_cmp(elt, a) == 0) {
-                    ret_value = elt;
-                    goto done;
-                }
-            }
-        }
-    }
-    else {
-        // Bloom has not been created
-        DL_FOREACH(entry->metadata, elt)
-        {
-            if (PDC_metadata_cmp(elt, a) == 0) {
-                ret_value = elt;
-                goto done;
-            }
-        }
-    } // if bloom==NULL
-
-done:
-    FUNC_LEAVE(ret_value);
+    FUNC_LEAVE_VOID;
 }
 
 /*
- * Allocate a new object ID
+ * Add a container to the name index
  *
- * \return 64-bit integer of object ID
+ * \param  cont_entry[IN]   Container entry
+ *
+ * \return void
  */
-static uint64_t
-PDC_Server_gen_obj_id()
+static void
+container_name_index_insert(pdc_cont_hash_table_entry_t *cont_entry)
 {
-    uint64_t ret_value;
-
     FUNC_ENTER(NULL);
 
-#ifdef ENABLE_MULTITHREAD
-    hg_thread_mutex_lock(&gen_obj_id_mutex_g);
-#endif
-
-    ret_value = pdc_id_seq_g++;
-
-#ifdef ENABLE_MULTITHREAD
-    hg_thread_mutex_unlock(&gen_obj_id_mutex_g);
+#ifndef DISABLE_SWISS_TABLE
+    if (container_name_index_g != NULL &&
+        pdc_swiss_table_insert(container_name_index_g,
+                               pdc_swiss_hash_bytes(cont_entry->cont_name, strlen(cont_entry->cont_name), 0),
+                               cont_entry) == 0)
+        printf("==PDC_SERVER[%d]: error inserting container %s to the name index\n", pdc_server_rank_g,
+               cont_entry->cont_name);
 #endif
 
-    FUNC_LEAVE(ret_value);
+    FUNC_LEAVE_VOID;
 }
 
-perr_t
-PDC_Server_init_hash_table()
+/*
+ * Remove a container from the name index
+ *
+ * \param  cont_entry[IN]   Container entry
+ *
+ * \return void
+ */
+static void
+container_name_index_remove(pdc_cont_hash_table_entry_t *cont_entry)
 {
-    perr_t ret_value = SUCCEED;
-
     FUNC_ENTER(NULL);
 
-    // Metadata hash table
-    metadata_hash_table_g = hash_table_new(PDC_Server_metadata_int_hash, PDC_Server_metadata_int_equal);
-    if (metadata_hash_table_g == NULL) {
-        printf("==PDC_SERVER: metadata_hash_table_g init error! Exit...\n");
-        goto done;
-    }
-    hash_table_register_free_functions(metadata_hash_table_g, PDC_Server_metadata_int_hash_key_free,
-                                       PDC_Server_metadata_hash_value_free);
-
-    // Container hash table
-    container_hash_table_g = hash_table_new(PDC_Server_metadata_int_hash, PDC_Server_metadata_int_equal);
-    if (container_hash_table_g == NULL) {
-        printf("==PDC_SERVER: container_hash_table_g init error! Exit...\n");
-        goto done;
-    }
-    hash_table_register_free_functions(container_hash_table_g, PDC_Server_metadata_int_hash_key_free,
-                                       PDC_Server_container_hash_value_free);
-
-    is_hash_table_init_g = 1;
+#ifndef DISABLE_SWISS_TABLE
+    if (container_name_index_g != NULL)
+        pdc_swiss_table_remove(container_name_index_g,
+                               pdc_swiss_hash_bytes(cont_entry->cont_name, strlen(cont_entry->cont_name), 0),
+                               cont_entry);
+#endif
 
-done:
-    FUNC_LEAVE(ret_value);
+    FUNC_LEAVE_VOID;
 }
 
 /*
- * Remove a metadata from bloom filter
+ * Get a container by its full name
  *
- * \param  metadata[IN]     Metadata pointer of the remove target
- * \param  bloom[IN]        Bloom filter's pointer
+ * \param  cont_name[IN]    Container name
  *
- * \return Non-negative on success/Negative on failure
+ * \return NULL if no match is found/pointer to the container entry otherwise
  */
-static perr_t
-PDC_Server_remove_from_bloom(pdc_metadata_t *metadata, BLOOM_TYPE_T *bloom)
+static pdc_cont_hash_table_entry_t *
+container_name_index_find(const char *cont_name)
 {
-    perr_t ret_value = SUCCEED;
+    pdc_cont_hash_table_entry_t *ret_value = NULL;
+#ifdef DISABLE_SWISS_TABLE
+    uint32_t hash_key;
+#endif
 
     FUNC_ENTER(NULL);
 
-    if (bloom == NULL) {
-        printf("==PDC_SERVER: PDC_Server_remove_from_bloom(): bloom pointer is NULL\n");
-        ret_value = FAIL;
-        goto done;
-    }
+#ifndef DISABLE_SWISS_TABLE
+    if (container_name_index_g != NULL)
+        ret_value = pdc_swiss_table_find(container_name_index_g,
+                                         pdc_swiss_hash_bytes(cont_name, strlen(cont_name), 0),
+                                         container_name_index_match, cont_name);
+#else
+    // Containers are keyed by the 32-bit name hash alone, double check with name match
+    hash_key  = PDC_get_hash_by_name(cont_name);
+    ret_value = hash_table_lookup(container_hash_table_g, &hash_key);
+    if (ret_value != NULL && strcmp(cont_name, ret_value->cont_name) != 0)
+        ret_value = NULL;
+#endif
 
-    char combined_string[TAG_LEN_MAX];
-    combine_obj_info_to_string(metadata, combined_string);
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_name_index_free()
+{
+    FUNC_ENTER(NULL);
+
+#ifndef DISABLE_SWISS_TABLE
+    pdc_swiss_table_free(metadata_name_index_g);
+    metadata_name_index_g = NULL;
+#endif
+
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Compare two kvtag values in byte order, a shorter value goes first when it is a prefix of the other
+ *
+ * \param  size1[IN]        Size of the first value
+ * \param  value1[IN]       First value
+ * \param  size2[IN]        Size of the second value
+ * \param  value2[IN]       Second value
+ *
+ * \return negative, 0 or positive like memcmp
+ */
+static int
+kvtag_value_cmp(uint32_t size1, const void *value1, uint32_t size2, const void *value2)
+{
+    int ret;
+
+    ret = memcmp(value1, value2, size1 < size2 ? size1 : size2);
+    if (ret != 0)
+        return ret;
+
+    return size1 < size2 ? -1 : (size1 > size2 ? 1 : 0);
+}
+
+static unsigned int
+kvtag_name_hash(void *vlocation)
+{
+    unsigned char *name = (unsigned char *)vlocation;
+    unsigned int   hash = 5381;
+
+    while (*name != 0)
+        hash = hash * 33 + *name++;
+
+    return hash;
+}
+
+static int
+kvtag_name_equal(void *vlocation1, void *vlocation2)
+{
+    return strcmp((char *)vlocation1, (char *)vlocation2) == 0;
+}
+
+static unsigned int
+kvtag_posting_hash(void *vlocation)
+{
+    pdc_kvtag_posting_t *posting = (pdc_kvtag_posting_t *)vlocation;
+    unsigned char *      value   = (unsigned char *)posting->value;
+    unsigned int         hash    = 2166136261u;
+    uint32_t             i;
+
+    for (i = 0; i < posting->size; i++)
+        hash = (hash ^ value[i]) * 16777619u;
+
+    return hash;
+}
+
+static int
+kvtag_posting_equal(void *vlocation1, void *vlocation2)
+{
+    pdc_kvtag_posting_t *posting1 = (pdc_kvtag_posting_t *)vlocation1;
+    pdc_kvtag_posting_t *posting2 = (pdc_kvtag_posting_t *)vlocation2;
+
+    return posting1->size == posting2->size && memcmp(posting1->value, posting2->value, posting1->size) == 0;
+}
+
+// The index keeps a copy of every distinct value and its posting in memory, outside of the kvtag store
+// cache, so it is charged to the server memory usage instead
+static void
+kvtag_index_mem_add(double size)
+{
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&total_mem_usage_mutex_g);
+#endif
+    total_mem_usage_g += size;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&total_mem_usage_mutex_g);
+#endif
+}
+
+static size_t
+kvtag_posting_mem_size(const pdc_kvtag_posting_t *posting)
+{
+    return sizeof(pdc_kvtag_posting_t) + posting->size +
+           (posting->obj_ids == NULL ? 0 : pdc_skip_list_mem_size(posting->obj_ids));
+}
+
+static void
+kvtag_posting_free(void *value)
+{
+    pdc_kvtag_posting_t *posting = (pdc_kvtag_posting_t *)value;
+
+    kvtag_index_mem_add(-(double)kvtag_posting_mem_size(posting));
+    free(posting->value);
+    pdc_skip_list_free(posting->obj_ids);
+    free(posting);
+}
+
+static void
+kvtag_index_value_free(void *value)
+{
+    pdc_kvtag_index_t *index = (pdc_kvtag_index_t *)value;
+    int                i;
+
+    kvtag_index_mem_add(-(double)(sizeof(pdc_kvtag_index_t) + strlen(index->name) + 1));
+    hash_table_free(index->postings);
+    for (i = 0; i < NCLASSES; i++)
+        free(index->num[i]);
+    free(index->sorted);
+    free(index->name);
+    free(index);
+}
+
+/*
+ * Size of a numeric kvtag value of the given type
+ *
+ * \param  type[IN]         Value type
+ *
+ * \return size in bytes, 0 if the type has no numeric order
+ */
+static uint32_t
+kvtag_num_type_size(int type)
+{
+    switch (type) {
+        case PDC_INT8:
+            return sizeof(int8_t);
+        case PDC_INT16:
+            return sizeof(int16_t);
+        case PDC_INT:
+            return sizeof(int);
+        case PDC_UINT:
+            return sizeof(unsigned);
+        case PDC_FLOAT:
+            return sizeof(float);
+        case PDC_DOUBLE:
+            return sizeof(double);
+        case PDC_INT64:
+            return sizeof(int64_t);
+        case PDC_UINT64:
+            return sizeof(uint64_t);
+        default:
+            return 0;
+    }
+}
+
+static double
+kvtag_num_value(int type, const void *value)
+{
+    switch (type) {
+        case PDC_INT8:
+            return (double)*(const int8_t *)value;
+        case PDC_INT16:
+            return (double)*(const int16_t *)value;
+        case PDC_INT:
+            return (double)*(const int *)value;
+        case PDC_UINT:
+            return (double)*(const unsigned *)value;
+        case PDC_FLOAT:
+            return (double)*(const float *)value;
+        case PDC_DOUBLE:
+            return *(const double *)value;
+        case PDC_INT64:
+            return (double)*(const int64_t *)value;
+        case PDC_UINT64:
+            return (double)*(const uint64_t *)value;
+        default:
+            return 0.0;
+    }
+}
+
+static int
+kvtag_num_key_cmp(const void *a, const void *b)
+{
+    double key1 = ((const pdc_kvtag_num_key_t *)a)->key;
+    double key2 = ((const pdc_kvtag_num_key_t *)b)->key;
+
+    return key1 < key2 ? -1 : (key1 > key2 ? 1 : 0);
+}
+
+static int
+kvtag_obj_id_cmp(const void *a, const void *b)
+{
+    uint64_t id1 = *(const uint64_t *)a;
+    uint64_t id2 = *(const uint64_t *)b;
+
+    return id1 < id2 ? -1 : (id1 > id2 ? 1 : 0);
+}
+
+// First position in the byte ordered postings whose value is >= (or > if strict) the given value
+static uint32_t
+kvtag_sorted_lower_bound(pdc_kvtag_index_t *index, uint32_t size, const void *value, int strict)
+{
+    uint32_t lo = 0, hi = index->n_sorted, mid;
+    int      cmp;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        cmp = kvtag_value_cmp(index->sorted[mid]->size, index->sorted[mid]->value, size, value);
+        if (cmp < 0 || (strict && cmp == 0))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// First position in the numeric postings whose key is >= (or > if strict) the given key
+static uint32_t
+kvtag_num_lower_bound(pdc_kvtag_num_key_t *keys, uint32_t n, double key, int strict)
+{
+    uint32_t lo = 0, hi = n, mid;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (keys[mid].key < key || (strict && keys[mid].key == key))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+static void
+kvtag_index_num_insert(pdc_kvtag_index_t *index, int type, pdc_kvtag_posting_t *posting)
+{
+    uint32_t pos;
+    double   key;
+
+    if (index->num[type] == NULL || posting->size != kvtag_num_type_size(type))
+        return;
+
+    if (index->n_num[type] == index->n_num_alloc[type]) {
+        index->n_num_alloc[type] *= 2;
+        index->num[type] = (pdc_kvtag_num_key_t *)realloc(
+            index->num[type], index->n_num_alloc[type] * sizeof(pdc_kvtag_num_key_t));
+    }
+
+    key = kvtag_num_value(type, posting->value);
+    pos = kvtag_num_lower_bound(index->num[type], index->n_num[type], key, 1);
+    memmove(&index->num[type][pos + 1], &index->num[type][pos],
+            (index->n_num[type] - pos) * sizeof(pdc_kvtag_num_key_t));
+    index->num[type][pos].key     = key;
+    index->num[type][pos].posting = posting;
+    index->n_num[type]++;
+}
+
+static void
+kvtag_index_num_remove(pdc_kvtag_index_t *index, int type, pdc_kvtag_posting_t *posting)
+{
+    uint32_t pos;
+
+    if (index->num[type] == NULL || posting->size != kvtag_num_type_size(type))
+        return;
+
+    pos = kvtag_num_lower_bound(index->num[type], index->n_num[type],
+                                kvtag_num_value(type, posting->value), 0);
+    while (pos < index->n_num[type] && index->num[type][pos].posting != posting)
+        pos++;
+    if (pos == index->n_num[type])
+        return;
+
+    memmove(&index->num[type][pos], &index->num[type][pos + 1],
+            (index->n_num[type] - pos - 1) * sizeof(pdc_kvtag_num_key_t));
+    index->n_num[type]--;
+}
+
+/*
+ * Build the numeric order of a kvtag name's values for one type, values of a different size are skipped
+ *
+ * \param  index[IN]        Inverted index of the kvtag name
+ * \param  type[IN]         Value type
+ *
+ * \return void
+ */
+static void
+kvtag_index_num_build(pdc_kvtag_index_t *index, int type)
+{
+    uint32_t i, type_size;
+
+    type_size                = kvtag_num_type_size(type);
+    index->n_num_alloc[type] = index->n_sorted > 0 ? index->n_sorted : 1;
+    index->num[type] = (pdc_kvtag_num_key_t *)malloc(index->n_num_alloc[type] * sizeof(pdc_kvtag_num_key_t));
+    index->n_num[type] = 0;
+    for (i = 0; i < index->n_sorted; i++) {
+        if (index->sorted[i]->size != type_size)
+            continue;
+        index->num[type][index->n_num[type]].key     = kvtag_num_value(type, index->sorted[i]->value);
+        index->num[type][index->n_num[type]].posting = index->sorted[i];
+        index->n_num[type]++;
+    }
+    qsort(index->num[type], index->n_num[type], sizeof(pdc_kvtag_num_key_t), kvtag_num_key_cmp);
+}
+
+/*
+ * Add an object to the inverted index entry of a kvtag
+ *
+ * \param  kvtag[IN]        Tag added to the object
+ * \param  obj_id[IN]       Object ID
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+kvtag_index_add(pdc_kvtag_t *kvtag, uint64_t obj_id)
+{
+    perr_t               ret_value = SUCCEED;
+    pdc_kvtag_index_t *  index;
+    pdc_kvtag_posting_t *posting, lookup;
+    size_t               mem_size;
+    uint32_t             pos;
+    int                  i;
+
+    FUNC_ENTER(NULL);
+
+    if (kvtag_index_hash_table_g == NULL) {
+        kvtag_index_hash_table_g = hash_table_new(kvtag_name_hash, kvtag_name_equal);
+        if (kvtag_index_hash_table_g == NULL) {
+            printf("==PDC_SERVER[%d]: kvtag_index_hash_table_g init error!\n", pdc_server_rank_g);
+            ret_value = FAIL;
+            goto done;
+        }
+        hash_table_register_free_functions(kvtag_index_hash_table_g, NULL, kvtag_index_value_free);
+    }
+
+    index = hash_table_lookup(kvtag_index_hash_table_g, kvtag->name);
+    if (index == NULL) {
+        index           = (pdc_kvtag_index_t *)calloc(1, sizeof(pdc_kvtag_index_t));
+        index->name     = strdup(kvtag->name);
+        index->postings = hash_table_new(kvtag_posting_hash, kvtag_posting_equal);
+        hash_table_register_free_functions(index->postings, NULL, kvtag_posting_free);
+        hash_table_insert(kvtag_index_hash_table_g, index->name, index);
+        kvtag_index_mem_add(sizeof(pdc_kvtag_index_t) + strlen(index->name) + 1);
+    }
+
+    lookup.size  = kvtag->size;
+    lookup.value = kvtag->value;
+    posting      = hash_table_lookup(index->postings, &lookup);
+    if (posting == NULL) {
+        posting          = (pdc_kvtag_posting_t *)calloc(1, sizeof(pdc_kvtag_posting_t));
+        posting->size    = kvtag->size;
+        posting->value   = malloc(kvtag->size);
+        posting->obj_ids = pdc_skip_list_new();
+        memcpy(posting->value, kvtag->value, kvtag->size);
+        hash_table_insert(index->postings, posting, posting);
+        kvtag_index_mem_add(kvtag_posting_mem_size(posting));
+
+        if (index->n_sorted == index->n_sorted_alloc) {
+            index->n_sorted_alloc = index->n_sorted_alloc == 0 ? 16 : index->n_sorted_alloc * 2;
+            index->sorted         = (pdc_kvtag_posting_t **)realloc(
+                index->sorted, index->n_sorted_alloc * sizeof(pdc_kvtag_posting_t *));
+        }
+        pos = kvtag_sorted_lower_bound(index, posting->size, posting->value, 0);
+        memmove(&index->sorted[pos + 1], &index->sorted[pos],
+                (index->n_sorted - pos) * sizeof(pdc_kvtag_posting_t *));
+        index->sorted[pos] = posting;
+        index->n_sorted++;
+
+        for (i = 0; i < NCLASSES; i++)
+            kvtag_index_num_insert(index, i, posting);
+    }
+
+    // IDs of consecutive creates are scattered over the hash ring buckets, a skip list keeps the insert
+    // at O(log n) wherever the ID lands
+    mem_size = kvtag_posting_mem_size(posting);
+    if (posting->obj_ids == NULL || pdc_skip_list_insert(posting->obj_ids, 0, obj_id, NULL) < 0) {
+        printf("==PDC_SERVER[%d]: %s - cannot index object %" PRIu64 "\n", pdc_server_rank_g, __func__,
+               obj_id);
+        ret_value = FAIL;
+    }
+    kvtag_index_mem_add((double)kvtag_posting_mem_size(posting) - (double)mem_size);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Remove an object from the inverted index entry of a kvtag, empty values are dropped from the index
+ *
+ * \param  kvtag[IN]        Tag removed from the object
+ * \param  obj_id[IN]       Object ID
+ *
+ * \return void
+ */
+static void
+kvtag_index_remove(pdc_kvtag_t *kvtag, uint64_t obj_id)
+{
+    pdc_kvtag_index_t *  index;
+    pdc_kvtag_posting_t *posting, lookup;
+    size_t               mem_size;
+    uint32_t             pos;
+    int                  i;
+
+    FUNC_ENTER(NULL);
+
+    if (kvtag_index_hash_table_g == NULL)
+        goto done;
+
+    index = hash_table_lookup(kvtag_index_hash_table_g, kvtag->name);
+    if (index == NULL)
+        goto done;
+
+    lookup.size  = kvtag->size;
+    lookup.value = kvtag->value;
+    posting      = hash_table_lookup(index->postings, &lookup);
+    if (posting == NULL)
+        goto done;
+
+    mem_size = kvtag_posting_mem_size(posting);
+    if (posting->obj_ids == NULL || !pdc_skip_list_remove(posting->obj_ids, 0, obj_id))
+        goto done;
+    kvtag_index_mem_add((double)kvtag_posting_mem_size(posting) - (double)mem_size);
+
+    if (pdc_skip_list_size(posting->obj_ids) == 0) {
+        for (i = 0; i < NCLASSES; i++)
+            kvtag_index_num_remove(index, i, posting);
+        pos = kvtag_sorted_lower_bound(index, posting->size, posting->value, 0);
+        memmove(&index->sorted[pos], &index->sorted[pos + 1],
+                (index->n_sorted - pos - 1) * sizeof(pdc_kvtag_posting_t *));
+        index->n_sorted--;
+        hash_table_remove(index->postings, posting);
+    }
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+// Index all kvtags of a metadata that is (re)inserted to the hash table, e.g. at restart
+static void
+kvtag_index_add_obj(pdc_metadata_t *metadata)
+{
+    pdc_kvtag_list_t *elt;
+
+    FUNC_ENTER(NULL);
+
+    DL_FOREACH(metadata->kvtag_list_head, elt)
+    {
+        kvtag_index_add(elt->kvtag, metadata->obj_id);
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+// Unindex the kvtags of a metadata that is deleted, its list is read back if it was spilled to the store
+static void
+kvtag_index_remove_obj(pdc_metadata_t *metadata)
+{
+    pdc_kvtag_list_t *elt;
+
+    FUNC_ENTER(NULL);
+
+    PDC_Server_meta_store_load(metadata);
+    DL_FOREACH(metadata->kvtag_list_head, elt)
+    {
+        kvtag_index_remove(elt->kvtag, metadata->obj_id);
+    }
+    PDC_Server_meta_store_remove(metadata);
+
+    FUNC_LEAVE_VOID;
+}
+
+static void
+kvtag_posting_collect(pdc_kvtag_posting_t *posting, uint64_t **obj_ids, uint32_t *n, uint32_t *alloc_size)
+{
+    pdc_skip_list_node_t *node;
+    uint64_t              n_obj = pdc_skip_list_size(posting->obj_ids);
+
+    if (*n + n_obj > *alloc_size) {
+        while (*n + n_obj > *alloc_size)
+            *alloc_size *= 2;
+        *obj_ids = (uint64_t *)realloc(*obj_ids, *alloc_size * sizeof(uint64_t));
+    }
+    for (node = pdc_skip_list_first(posting->obj_ids); node != NULL; node = pdc_skip_list_next(node))
+        (*obj_ids)[(*n)++] = pdc_skip_list_minor(node);
+}
+
+/*
+ * Collect the objects of one kvtag name whose value satisfies the query
+ *
+ * \param  index[IN]        Inverted index of the kvtag name
+ * \param  in[IN]           Query from client
+ * \param  obj_ids[IN/OUT]  Result array, grown as needed
+ * \param  n[IN/OUT]        Number of results
+ * \param  alloc_size[IN/OUT] Allocated size of the result array
+ *
+ * \return void
+ */
+static void
+kvtag_index_query(pdc_kvtag_index_t *index, kvtag_query_in_t *in, uint64_t **obj_ids, uint32_t *n,
+                  uint32_t *alloc_size)
+{
+    pdc_kvtag_posting_t *posting, lookup;
+    pdc_kvtag_num_key_t *keys;
+    uint32_t             i, start, end, n_keys;
+    double               key;
+    int                  type = in->type;
+
+    FUNC_ENTER(NULL);
+
+    // Any value
+    if (in->op == PDC_KVTAG_EQ && in->kvtag.size == 1 && ((char *)in->kvtag.value)[0] == ' ') {
+        for (i = 0; i < index->n_sorted; i++)
+            kvtag_posting_collect(index->sorted[i], obj_ids, n, alloc_size);
+        goto done;
+    }
+
+    if (in->op == PDC_KVTAG_EQ) {
+        lookup.size  = in->kvtag.size;
+        lookup.value = in->kvtag.value;
+        posting      = hash_table_lookup(index->postings, &lookup);
+        if (posting != NULL)
+            kvtag_posting_collect(posting, obj_ids, n, alloc_size);
+        goto done;
+    }
+
+    if (in->op == PDC_KVTAG_PREFIX) {
+        i = kvtag_sorted_lower_bound(index, in->kvtag.size, in->kvtag.value, 0);
+        for (; i < index->n_sorted; i++) {
+            posting = index->sorted[i];
+            if (posting->size < in->kvtag.size ||
+                memcmp(posting->value, in->kvtag.value, in->kvtag.size) != 0)
+                break;
+            kvtag_posting_collect(posting, obj_ids, n, alloc_size);
+        }
+        goto done;
+    }
+
+    if (type >= 0 && type < NCLASSES && kvtag_num_type_size(type) != 0 &&
+        kvtag_num_type_size(type) == in->kvtag.size) {
+        // Numeric range
+#ifdef ENABLE_MULTITHREAD
+        // Queries share the read lock, the first one of a type builds its keys
+        hg_thread_mutex_lock(&pdc_kvtag_index_mutex_g);
+#endif
+        if (index->num[type] == NULL)
+            kvtag_index_num_build(index, type);
+        keys   = index->num[type];
+        n_keys = index->n_num[type];
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_unlock(&pdc_kvtag_index_mutex_g);
+#endif
+        key    = kvtag_num_value(type, in->kvtag.value);
+        if (in->op == PDC_KVTAG_LT || in->op == PDC_KVTAG_LTE) {
+            start = 0;
+            end   = kvtag_num_lower_bound(keys, n_keys, key, in->op == PDC_KVTAG_LTE);
+        }
+        else {
+            start = kvtag_num_lower_bound(keys, n_keys, key, in->op == PDC_KVTAG_GT);
+            end   = n_keys;
+        }
+        for (i = start; i < end; i++)
+            kvtag_posting_collect(keys[i].posting, obj_ids, n, alloc_size);
+    }
+    else {
+        // Byte order range, e.g. strings
+        if (in->op == PDC_KVTAG_LT || in->op == PDC_KVTAG_LTE) {
+            start = 0;
+            end   = kvtag_sorted_lower_bound(index, in->kvtag.size, in->kvtag.value, in->op == PDC_KVTAG_LTE);
+        }
+        else {
+            start = kvtag_sorted_lower_bound(index, in->kvtag.size, in->kvtag.value, in->op == PDC_KVTAG_GT);
+            end   = index->n_sorted;
+        }
+        for (i = start; i < end; i++)
+            kvtag_posting_collect(index->sorted[i], obj_ids, n, alloc_size);
+    }
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_kvtag_index_free()
+{
+    FUNC_ENTER(NULL);
+
+    if (kvtag_index_hash_table_g != NULL) {
+        hash_table_free(kvtag_index_hash_table_g);
+        kvtag_index_hash_table_g = NULL;
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+static unsigned int
+query_user_id_hash(void *vlocation)
+{
+    return (unsigned int)*(int *)vlocation;
+}
+
+static int
+query_user_id_equal(void *vlocation1, void *vlocation2)
+{
+    return *(int *)vlocation1 == *(int *)vlocation2;
+}
+
+static void
+query_posting_free(void *value)
+{
+    pdc_query_posting_t *posting = (pdc_query_posting_t *)value;
+
+    free(posting->key);
+    pdc_skip_list_free(posting->meta);
+    free(posting);
+}
+
+static uint64_t
+query_posting_size(pdc_query_posting_t *posting)
+{
+    return posting->meta == NULL ? 0 : pdc_skip_list_size(posting->meta);
+}
+
+/*
+ * IDs carry the hash ring bucket of the name in their low bits, so consecutive creates land anywhere in
+ * a posting and it is kept in a skip list rather than a sorted array
+ */
+static void
+query_posting_add(pdc_query_posting_t *posting, pdc_metadata_t *metadata)
+{
+    if (posting->meta == NULL)
+        posting->meta = pdc_skip_list_new();
+    if (posting->meta == NULL || pdc_skip_list_insert(posting->meta, 0, metadata->obj_id, metadata) < 0)
+        printf("==PDC_SERVER[%d]: %s - cannot index object %" PRIu64 "\n", pdc_server_rank_g, __func__,
+               metadata->obj_id);
+}
 
-    ret_value = BLOOM_REMOVE(bloom, combined_string, strlen(combined_string));
-    if (ret_value != SUCCEED) {
-        printf("==PDC_SERVER[%d]: PDC_Server_remove_from_bloom() - error\n", pdc_server_rank_g);
+static void
+query_posting_remove(pdc_query_posting_t *posting, pdc_metadata_t *metadata)
+{
+    if (posting->meta != NULL)
+        pdc_skip_list_remove(posting->meta, 0, metadata->obj_id);
+}
+
+/*
+ * Find the posting of a value in a string or user ID index
+ *
+ * \param  index[IN/OUT]    Index, created on the first insertion
+ * \param  key[IN]          String value, or NULL for a user ID index
+ * \param  user_id[IN]      User ID value of a user ID index
+ * \param  create[IN]       Create the posting if it does not exist
+ *
+ * \return Posting, NULL if it does not exist and create is 0
+ */
+static pdc_query_posting_t *
+query_index_posting(HashTable **index, const char *key, int user_id, int create)
+{
+    pdc_query_posting_t *posting;
+
+    if (*index == NULL) {
+        if (!create)
+            return NULL;
+        if (key != NULL)
+            *index = hash_table_new(kvtag_name_hash, kvtag_name_equal);
+        else
+            *index = hash_table_new(query_user_id_hash, query_user_id_equal);
+        if (*index == NULL)
+            return NULL;
+        hash_table_register_free_functions(*index, NULL, query_posting_free);
+    }
+
+    posting = hash_table_lookup(*index, key != NULL ? (void *)key : (void *)&user_id);
+    if (posting == NULL && create) {
+        posting          = (pdc_query_posting_t *)calloc(1, sizeof(pdc_query_posting_t));
+        posting->user_id = user_id;
+        if (key != NULL)
+            posting->key = strdup(key);
+        hash_table_insert(*index, key != NULL ? (void *)posting->key : (void *)&posting->user_id, posting);
+    }
+
+    return posting;
+}
+
+static void
+query_index_update(HashTable **index, const char *key, int user_id, pdc_metadata_t *metadata, int add)
+{
+    pdc_query_posting_t *posting;
+
+    posting = query_index_posting(index, key, user_id, add);
+    if (posting == NULL)
+        return;
+
+    if (add)
+        query_posting_add(posting, metadata);
+    else {
+        query_posting_remove(posting, metadata);
+        if (query_posting_size(posting) == 0)
+            hash_table_remove(*index, key != NULL ? (void *)posting->key : (void *)&posting->user_id);
+    }
+}
+
+// Add or remove a metadata from the postings of each of its ','-separated tags
+static void
+query_index_update_tags(pdc_metadata_t *metadata, int add)
+{
+    const char *tags = metadata->tags, *end;
+    char        token[TAG_LEN_MAX];
+    size_t      len;
+
+    while (tags != NULL && *tags != 0) {
+        end = strchr(tags, ',');
+        len = end == NULL ? strlen(tags) : (size_t)(end - tags);
+        if (len > 0 && len < TAG_LEN_MAX) {
+            memcpy(token, tags, len);
+            token[len] = 0;
+            query_index_update(&tag_index_g, token, 0, metadata, add);
+        }
+        tags = end == NULL ? NULL : end + 1;
+    }
+}
+
+static void
+time_step_index_update(pdc_metadata_t *metadata, int add)
+{
+    if (time_step_index_g == NULL && add)
+        time_step_index_g = pdc_skip_list_new();
+    if (time_step_index_g == NULL)
+        return;
+
+    if (!add)
+        pdc_skip_list_remove(time_step_index_g, metadata->time_step, metadata->obj_id);
+    else if (pdc_skip_list_insert(time_step_index_g, metadata->time_step, metadata->obj_id, metadata) < 0)
+        printf("==PDC_SERVER[%d]: %s - cannot index object %" PRIu64 "\n", pdc_server_rank_g, __func__,
+               metadata->obj_id);
+}
+
+/*
+ * Add a metadata to the partial query indexes, or remove it. A metadata must be removed before its
+ * app name, time step or tags change and added again after
+ *
+ * \param  metadata[IN]     Metadata pointer
+ * \param  add[IN]          1 to add, 0 to remove
+ *
+ * \return void
+ */
+static void
+metadata_query_index_update(pdc_metadata_t *metadata, int add)
+{
+    FUNC_ENTER(NULL);
+
+    if (metadata->app_name != NULL && metadata->app_name[0] != 0)
+        query_index_update(&app_name_index_g, metadata->app_name, 0, metadata, add);
+    query_index_update(&user_id_index_g, NULL, metadata->user_id, metadata, add);
+    if (metadata->ndim <= DIM_MAX) {
+        if (add)
+            query_posting_add(&ndim_index_g[metadata->ndim], metadata);
+        else
+            query_posting_remove(&ndim_index_g[metadata->ndim], metadata);
+    }
+    time_step_index_update(metadata, add);
+    query_index_update_tags(metadata, add);
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_query_index_free()
+{
+    int i;
+
+    FUNC_ENTER(NULL);
+
+    if (app_name_index_g != NULL)
+        hash_table_free(app_name_index_g);
+    if (user_id_index_g != NULL)
+        hash_table_free(user_id_index_g);
+    if (tag_index_g != NULL)
+        hash_table_free(tag_index_g);
+    app_name_index_g = NULL;
+    user_id_index_g  = NULL;
+    tag_index_g      = NULL;
+    for (i = 0; i <= DIM_MAX; i++) {
+        pdc_skip_list_free(ndim_index_g[i].meta);
+        memset(&ndim_index_g[i], 0, sizeof(pdc_query_posting_t));
+    }
+    pdc_skip_list_free(time_step_index_g);
+    time_step_index_g = NULL;
+
+    FUNC_LEAVE_VOID;
+}
+
+pdc_metadata_t *
+PDC_Server_get_obj_metadata(pdcid_t obj_id)
+{
+    pdc_metadata_t *ret_value = NULL;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+    ret_value = find_metadata_by_id(obj_id);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+int
+PDC_Server_has_metadata(pdcid_t obj_id)
+{
+    if (PDC_get_server_by_obj_id(obj_id, pdc_server_size_g) == (uint32_t)pdc_server_rank_g)
+        return 1;
+    return 0;
+}
+
+/*
+ * Find if there is identical metadata exist in hash table
+ *
+ * \param  entry[IN]        Hash table entry of metadata
+ * \param  a[IN]            Pointer to metadata to be checked against
+ *
+ * \return NULL if no match is found/pointer to the found metadata otherwise
+ */
+static pdc_metadata_t *
+find_identical_metadata(pdc_hash_table_entry_head *entry, pdc_metadata_t *a)
+{
+    pdc_metadata_t *ret_value = NULL;
+    pdc_metadata_t *elt;
+#ifdef DISABLE_SWISS_TABLE
+    int bloom_check = 0;
+#endif
+
+    FUNC_ENTER(NULL);
+
+#ifndef DISABLE_SWISS_TABLE
+    // The name index resolves a full name and time step without walking the list, whose entries only
+    // share the 32-bit name hash. A miss costs one probe, so the lists have no bloom filter in front.
+    if (metadata_name_index_g != NULL && a->obj_name != NULL && a->obj_name[0] != '\0' &&
+        a->time_step >= 0) {
+        ret_value = pdc_swiss_table_find(metadata_name_index_g,
+                                         metadata_name_index_key(a->obj_name, a->time_step),
+                                         metadata_name_index_match, a);
+        goto done;
+    }
+#else
+    // Without the name index, the bloom filter of a long list rules out the names it never had
+    if (entry->bloom != NULL && a->user_id != 0 && a->app_name[0] != 0) {
+#ifdef ENABLE_TIMING
+        struct timeval pdc_timer_start;
+        struct timeval pdc_timer_end;
+        double         ht_total_sec;
+
+        gettimeofday(&pdc_timer_start, 0);
+#endif
+
+        bloom_check = pdc_bloom_check(entry->bloom, metadata_name_index_key(a->obj_name, a->time_step));
+
+#ifdef ENABLE_TIMING
+        gettimeofday(&pdc_timer_end, 0);
+        ht_total_sec = PDC_get_elapsed_time_double(&pdc_timer_start, &pdc_timer_end);
+#endif
+
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_lock(&pdc_bloom_time_mutex_g);
+#endif
+
+#ifdef ENABLE_TIMING
+        server_bloom_check_time_g += ht_total_sec;
+#endif
+
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_unlock(&pdc_bloom_time_mutex_g);
+#endif
+
+        n_bloom_total_g++;
+        if (bloom_check == 0)
+            goto done;
+        // bloom filter says maybe, so need to check entire list
+        n_bloom_maybe_g++;
+    }
+#endif
+
+    DL_FOREACH(entry->metadata, elt)
+    {
+        if (PDC_metadata_cmp(elt, a) == 0) {
+            ret_value = elt;
+            goto done;
+        }
+    }
+
+#ifdef DISABLE_SWISS_TABLE
+    if (bloom_check)
+        n_bloom_false_positive_g++;
+#endif
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Allocate a new object ID in the ring bucket of its placement key, so the ID resolves to the server
+ * that owns the name
+ *
+ * \param  key[IN]          Placement key, the name hash plus the time step
+ *
+ * \return 64-bit integer of object ID
+ */
+static uint64_t
+PDC_Server_gen_obj_id(uint32_t key)
+{
+    uint64_t ret_value;
+    uint32_t bucket;
+
+    FUNC_ENTER(NULL);
+
+    bucket = PDC_get_bucket_by_hash(key);
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&gen_obj_id_mutex_g);
+#endif
+
+    ret_value = PDC_SERVER_ID_INTERVEL + pdc_id_seq_g[bucket]++ * PDC_HASH_RING_NBUCKET + bucket;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&gen_obj_id_mutex_g);
+#endif
+
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_obj_id_seq_advance(uint64_t obj_id)
+{
+    uint32_t bucket;
+    uint64_t seq;
+
+    FUNC_ENTER(NULL);
+
+    if (obj_id < PDC_SERVER_ID_INTERVEL)
+        goto done;
+    bucket = PDC_get_bucket_by_obj_id(obj_id);
+    seq    = (obj_id - PDC_SERVER_ID_INTERVEL) / PDC_HASH_RING_NBUCKET;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&gen_obj_id_mutex_g);
+#endif
+
+    if (seq >= pdc_id_seq_g[bucket])
+        pdc_id_seq_g[bucket] = seq + 1;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&gen_obj_id_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+perr_t
+PDC_Server_init_hash_table()
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    // Metadata hash table
+    metadata_hash_table_g = hash_table_new(PDC_Server_metadata_int_hash, PDC_Server_metadata_int_equal);
+    if (metadata_hash_table_g == NULL) {
+        printf("==PDC_SERVER: metadata_hash_table_g init error! Exit...\n");
+        goto done;
+    }
+    hash_table_register_free_functions(metadata_hash_table_g, PDC_Server_metadata_int_hash_key_free,
+                                       PDC_Server_metadata_hash_value_free);
+
+    // Object ID index, keys point into the metadata and values are owned by metadata_hash_table_g
+    metadata_id_hash_table_g = hash_table_new(PDC_Server_metadata_id_hash, PDC_Server_metadata_id_equal);
+    if (metadata_id_hash_table_g == NULL) {
+        printf("==PDC_SERVER: metadata_id_hash_table_g init error! Exit...\n");
+        goto done;
+    }
+
+#ifndef DISABLE_SWISS_TABLE
+    // Name index, values are owned by metadata_hash_table_g
+    metadata_name_index_g = pdc_swiss_table_new();
+    if (metadata_name_index_g == NULL) {
+        printf("==PDC_SERVER: metadata_name_index_g init error! Exit...\n");
+        goto done;
+    }
+#endif
+
+    // Container hash table
+    container_hash_table_g = hash_table_new(PDC_Server_metadata_int_hash, PDC_Server_metadata_int_equal);
+    if (container_hash_table_g == NULL) {
+        printf("==PDC_SERVER: container_hash_table_g init error! Exit...\n");
+        goto done;
+    }
+    hash_table_register_free_functions(container_hash_table_g, PDC_Server_metadata_int_hash_key_free,
+                                       PDC_Server_container_hash_value_free);
+
+    // Container ID index, keys point into the container entries owned by container_hash_table_g
+    container_id_hash_table_g = hash_table_new(PDC_Server_metadata_id_hash, PDC_Server_metadata_id_equal);
+    if (container_id_hash_table_g == NULL) {
+        printf("==PDC_SERVER: container_id_hash_table_g init error! Exit...\n");
+        goto done;
+    }
+
+#ifndef DISABLE_SWISS_TABLE
+    // Container name index, values are owned by container_hash_table_g
+    container_name_index_g = pdc_swiss_table_new();
+    if (container_name_index_g == NULL) {
+        printf("==PDC_SERVER: container_name_index_g init error! Exit...\n");
         goto done;
     }
+#endif
+
+    is_hash_table_init_g = 1;
 
 done:
     FUNC_LEAVE(ret_value);
@@ -517,10 +1664,9 @@ done:
  * \return Non-negative on success/Negative on failure
  */
 static perr_t
-PDC_Server_add_to_bloom(pdc_metadata_t *metadata, BLOOM_TYPE_T *bloom)
+PDC_Server_add_to_bloom(pdc_metadata_t *metadata, pdc_bloom_t *bloom)
 {
     perr_t ret_value = SUCCEED;
-    char   combined_string[TAG_LEN_MAX];
 
     FUNC_ENTER(NULL);
 
@@ -528,11 +1674,9 @@ PDC_Server_add_to_bloom(pdc_metadata_t *metadata, BLOOM_TYPE_T *bloom)
         goto done;
     }
 
-    combine_obj_info_to_string(metadata, combined_string);
-
-    ret_value = BLOOM_ADD(bloom, combined_string, strlen(combined_string));
-    if (ret_value != SUCCEED) {
+    if (pdc_bloom_add(bloom, metadata_name_index_key(metadata->obj_name, metadata->time_step)) == 0) {
         printf("==PDC_SERVER[%d]: PDC_Server_add_to_bloom() - error \n", pdc_server_rank_g);
+        ret_value = FAIL;
         goto done;
     }
 
@@ -540,8 +1684,10 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+#ifdef DISABLE_SWISS_TABLE
 /*
- * Init a bloom filter
+ * Build the bloom filter of a hash table entry from its list, replacing the existing one. The filter
+ * is sized for twice the current list and grows with it.
  *
  * \param  entry[IN]     Entry of the metadata hash table
  *
@@ -550,16 +1696,11 @@ done:
 static perr_t
 PDC_Server_bloom_init(pdc_hash_table_entry_head *entry)
 {
-    perr_t ret_value  = 0;
-    int    capacity   = 500000;
-    double error_rate = 0.05;
+    perr_t          ret_value = SUCCEED;
+    pdc_metadata_t *elt;
 
     FUNC_ENTER(NULL);
 
-    // Init bloom filter
-    n_bloom_maybe_g = 0;
-    n_bloom_total_g = 0;
-
 #ifdef ENABLE_TIMING
     // Timing
     struct timeval pdc_timer_start;
@@ -569,13 +1710,25 @@ PDC_Server_bloom_init(pdc_hash_table_entry_head *entry)
     gettimeofday(&pdc_timer_start, 0);
 #endif
 
-    entry->bloom = (BLOOM_TYPE_T *)BLOOM_NEW(capacity, error_rate);
+    if (entry->bloom != NULL)
+        pdc_bloom_free(entry->bloom);
+    entry->bloom = pdc_bloom_new(2 * (uint64_t)entry->n_obj, BLOOM_ERROR_RATE);
     if (!entry->bloom) {
         fprintf(stderr, "ERROR: Could not create bloom filter\n");
-        ret_value = -1;
+        ret_value = FAIL;
         goto done;
     }
 
+    DL_FOREACH(entry->metadata, elt)
+    {
+        if (PDC_Server_add_to_bloom(elt, entry->bloom) != SUCCEED) {
+            pdc_bloom_free(entry->bloom);
+            entry->bloom = NULL;
+            ret_value    = FAIL;
+            goto done;
+        }
+    }
+
 #ifdef ENABLE_TIMING
     // Timing
     gettimeofday(&pdc_timer_end, 0);
@@ -588,36 +1741,49 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Add a metadata to the bloom filter of its hash table entry before it is appended to the list. The
+ * filter is created once the list is long and rebuilt when many of its keys were removed. A failure
+ * drops the filter, so that lookups walk the list instead of missing the metadata.
+ *
+ * \param  head[IN]      Entry of the metadata hash table
+ * \param  new[IN]       Metadata to be added
+ */
+static void
+PDC_Server_bloom_insert(pdc_hash_table_entry_head *head, pdc_metadata_t *new)
+{
+    int init_bloom;
+
+    FUNC_ENTER(NULL);
+
+    if (head->bloom != NULL)
+        init_bloom = pdc_bloom_n_removed(head->bloom) > (uint64_t)head->n_obj / 2;
+    else
+        init_bloom = head->n_obj >= CREATE_BLOOM_THRESHOLD;
+
+    if (init_bloom && PDC_Server_bloom_init(head) != SUCCEED)
+        printf("==PDC_SERVER[%d]: %s - error init bloom\n", pdc_server_rank_g, __func__);
+    else if (head->bloom != NULL && PDC_Server_add_to_bloom(new, head->bloom) != SUCCEED) {
+        printf("==PDC_SERVER[%d]: %s - error add to bloom\n", pdc_server_rank_g, __func__);
+        pdc_bloom_free(head->bloom);
+        head->bloom = NULL;
+    }
+
+    FUNC_LEAVE_VOID;
+}
+#endif
+
 perr_t
 PDC_Server_hash_table_list_insert(pdc_hash_table_entry_head *head, pdc_metadata_t *new)
 {
-    perr_t          ret_value = SUCCEED;
-    pdc_metadata_t *elt;
+    perr_t ret_value = SUCCEED;
 
     FUNC_ENTER(NULL);
 
-    // add to bloom filter
-    if (head->n_obj == CREATE_BLOOM_THRESHOLD) {
-        PDC_Server_bloom_init(head);
-        DL_FOREACH(head->metadata, elt)
-        {
-            PDC_Server_add_to_bloom(elt, head->bloom);
-        }
-        ret_value = PDC_Server_add_to_bloom(new, head->bloom);
-        if (ret_value != SUCCEED) {
-            printf("==PDC_SERVER[%d]: PDC_Server_hash_table_list_insert() - error add to bloom\n",
-                   pdc_server_rank_g);
-            goto done;
-        }
-    }
-    else if (head->n_obj >= CREATE_BLOOM_THRESHOLD || head->bloom != NULL) {
-        ret_value = PDC_Server_add_to_bloom(new, head->bloom);
-        if (ret_value != SUCCEED) {
-            printf("==PDC_SERVER[%d]: PDC_Server_hash_table_list_insert() - error add to bloom\n",
-                   pdc_server_rank_g);
-            goto done;
-        }
-    }
+#ifdef DISABLE_SWISS_TABLE
+    // Lookups through the name index need no bloom filter, the filters only serve builds without it
+    PDC_Server_bloom_insert(head, new);
+#endif
 
 #ifdef ENABLE_MULTITHREAD
     hg_thread_mutex_lock(&insert_hash_table_mutex_g);
@@ -625,13 +1791,16 @@ PDC_Server_hash_table_list_insert(pdc_hash_table_entry_head *head, pdc_metadata_
     // Currently $metadata is unique, insert to linked list
     DL_APPEND(head->metadata, new);
     head->n_obj++;
+    ret_value = metadata_id_index_insert(new);
+    metadata_name_index_insert(new);
+    kvtag_index_add_obj(new);
+    PDC_Server_meta_store_touch(new);
+    metadata_query_index_update(new, 1);
 
 #ifdef ENABLE_MULTITHREAD
     hg_thread_mutex_unlock(&insert_hash_table_mutex_g);
 #endif
 
-done:
-
     FUNC_LEAVE(ret_value);
 }
 
@@ -673,6 +1842,64 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+perr_t
+PDC_Server_metadata_restore(uint32_t hash_key, pdc_metadata_t *metadata)
+{
+    perr_t                     ret_value = SUCCEED;
+    pdc_hash_table_entry_head *lookup_value;
+    uint32_t *                 key;
+
+    FUNC_ENTER(NULL);
+
+    if (find_metadata_by_id(metadata->obj_id) != NULL) {
+        free(metadata);
+        goto done;
+    }
+    if (PDC_Server_metadata_set_strings(metadata, metadata->app_name, metadata->obj_name, metadata->tags,
+                                        metadata->data_location) != SUCCEED) {
+        free(metadata);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    metadata->kvtag_list_head                = NULL;
+    metadata->storage_region_list_head       = NULL;
+    metadata->all_storage_region_distributed = 0;
+    metadata->region_lock_head               = NULL;
+    metadata->region_map_head                = NULL;
+    metadata->region_buf_map_head            = NULL;
+    metadata->obj_hist                       = NULL;
+    metadata->prev                           = NULL;
+    metadata->next                           = NULL;
+    metadata->bloom                          = NULL;
+    PDC_Server_obj_id_seq_advance(metadata->obj_id);
+
+    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
+    if (lookup_value == NULL) {
+        key          = (uint32_t *)malloc(sizeof(uint32_t));
+        lookup_value = (pdc_hash_table_entry_head *)calloc(1, sizeof(pdc_hash_table_entry_head));
+        if (key == NULL || lookup_value == NULL) {
+            printf("==PDC_SERVER[%d]: %s - cannot allocate hash entry\n", pdc_server_rank_g, __func__);
+            ret_value = FAIL;
+            goto done;
+        }
+        *key = hash_key;
+        total_mem_usage_g += sizeof(uint32_t) + sizeof(pdc_hash_table_entry_head);
+        ret_value = PDC_Server_hash_table_list_init(lookup_value, key);
+        if (ret_value != SUCCEED)
+            goto done;
+    }
+
+    ret_value = PDC_Server_hash_table_list_insert(lookup_value, metadata);
+    if (ret_value != SUCCEED)
+        goto done;
+    total_mem_usage_g += sizeof(pdc_metadata_t);
+    n_metadata_g++;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Server_add_tag_metadata(metadata_add_tag_in_t *in, metadata_add_tag_out_t *out)
 {
@@ -708,7 +1935,7 @@ PDC_Server_add_tag_metadata(metadata_add_tag_in_t *in, metadata_add_tag_out_t *o
 #ifdef ENABLE_MULTITHREAD
     // Obtain lock for hash table
     unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
     if (metadata_hash_table_g != NULL) {
@@ -726,10 +1953,10 @@ PDC_Server_add_tag_metadata(metadata_add_tag_in_t *in, metadata_add_tag_out_t *o
                 // obj_name change is done through client with delete and add operation.
                 if (in->new_tag != NULL && in->new_tag[0] != 0 &&
                     !(in->new_tag[0] == ' ' && in->new_tag[1] == 0)) {
-                    // add a ',' to separate different tags
-                    target->tags[strlen(target->tags) + 1] = 0;
-                    target->tags[strlen(target->tags)]     = ',';
-                    strcat(target->tags, in->new_tag);
+                    metadata_query_index_update(target, 0);
+                    metadata_append_tags(target, in->new_tag);
+                    metadata_query_index_update(target, 1);
+                    PDC_Server_wal_log_obj_update(target);
                     out->ret = 1;
                 }
                 else
@@ -762,7 +1989,7 @@ PDC_Server_add_tag_metadata(metadata_add_tag_in_t *in, metadata_add_tag_out_t *o
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
     unlocked = 1;
 #endif
 
@@ -787,7 +2014,7 @@ PDC_Server_add_tag_metadata(metadata_add_tag_in_t *in, metadata_add_tag_out_t *o
 done:
 #ifdef ENABLE_MULTITHREAD
     if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+        hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
     fflush(stdout);
 
@@ -826,7 +2053,7 @@ PDC_Server_update_metadata(metadata_update_in_t *in, metadata_update_out_t *out)
 #ifdef ENABLE_MULTITHREAD
     int unlocked = 0;
     // Obtain lock for hash table
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
     if (metadata_hash_table_g != NULL) {
@@ -841,20 +2068,26 @@ PDC_Server_update_metadata(metadata_update_in_t *in, metadata_update_out_t *out)
                 // Check and find valid update fields
                 // Currently user_id, obj_name are not supported to be updated in this way
                 // obj_name change is done through client with delete and add operation.
-                if (in->new_metadata.time_step != -1)
+                metadata_query_index_update(target, 0);
+                if (in->new_metadata.time_step != -1) {
+                    metadata_name_index_remove(target);
                     target->time_step = in->new_metadata.time_step;
+                    metadata_name_index_insert(target);
+                    // The bloom filter is keyed by the time step too
+                    if (lookup_value->bloom != NULL) {
+                        pdc_bloom_remove(lookup_value->bloom);
+                        PDC_Server_add_to_bloom(target, lookup_value->bloom);
+                    }
+                }
                 if (in->new_metadata.app_name[0] != 0 &&
                     !(in->new_metadata.app_name[0] == ' ' && in->new_metadata.app_name[1] == 0))
-                    strcpy(target->app_name, in->new_metadata.app_name);
+                    target->app_name = PDC_str_intern(in->new_metadata.app_name);
                 if (in->new_metadata.data_location[0] != 0 &&
                     !(in->new_metadata.data_location[0] == ' ' && in->new_metadata.data_location[1] == 0))
-                    strcpy(target->data_location, in->new_metadata.data_location);
+                    target->data_location = PDC_str_intern(in->new_metadata.data_location);
                 if (in->new_metadata.tags[0] != 0 &&
                     !(in->new_metadata.tags[0] == ' ' && in->new_metadata.tags[1] == 0)) {
-                    // add a ',' to separate different tags
-                    target->tags[strlen(target->tags) + 1] = 0;
-                    target->tags[strlen(target->tags)]     = ',';
-                    strcat(target->tags, in->new_metadata.tags);
+                    metadata_append_tags(target, in->new_metadata.tags);
                 }
                 if (in->new_metadata.current_state != 0) {
                     target->transform_state          = in->new_metadata.current_state;
@@ -866,6 +2099,8 @@ PDC_Server_update_metadata(metadata_update_in_t *in, metadata_update_out_t *out)
                     target->current_state.dims[3]    = in->new_metadata.t_dims3;
                     target->current_state.meta_index = in->new_metadata.t_meta_index;
                 }
+                metadata_query_index_update(target, 1);
+                PDC_Server_wal_log_obj_update(target);
                 out->ret = 1;
             } // if (lookup_value != NULL)
             else {
@@ -890,7 +2125,7 @@ PDC_Server_update_metadata(metadata_update_in_t *in, metadata_update_out_t *out)
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
     unlocked = 1;
 #endif
 
@@ -915,7 +2150,7 @@ PDC_Server_update_metadata(metadata_update_in_t *in, metadata_update_out_t *out)
 done:
 #ifdef ENABLE_MULTITHREAD
     if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+        hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
     fflush(stdout);
     FUNC_LEAVE(ret_value);
@@ -924,12 +2159,9 @@ done:
 perr_t
 PDC_Server_delete_metadata_by_id(metadata_delete_by_id_in_t *in, metadata_delete_by_id_out_t *out)
 {
-    perr_t            ret_value = FAIL;
-    pdc_metadata_t *  elt;
-    HashTableIterator hash_table_iter;
-    HashTablePair     pair;
-    uint64_t          target_obj_id;
-    int               n_entry;
+    perr_t          ret_value = FAIL;
+    pdc_metadata_t *elt;
+    uint64_t        target_obj_id;
 
     FUNC_ENTER(NULL);
 
@@ -949,70 +2181,66 @@ PDC_Server_delete_metadata_by_id(metadata_delete_by_id_in_t *in, metadata_delete
 #ifdef ENABLE_MULTITHREAD
     // Obtain lock for hash table
     int unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
-    if (container_hash_table_g != NULL) {
+    if (container_hash_table_g != NULL && container_id_hash_table_g != NULL) {
         pdc_cont_hash_table_entry_t *cont_entry;
+        uint32_t                     cont_hash_key;
 
-        // Since we only have the obj id, need to iterate the entire hash table
-        n_entry = hash_table_num_entries(container_hash_table_g);
-        hash_table_iterate(container_hash_table_g, &hash_table_iter);
-
-        while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
-            pair       = hash_table_iter_next(&hash_table_iter);
-            cont_entry = pair.value;
-            if (cont_entry == NULL)
-                continue;
-
-            if (cont_entry->cont_id == target_obj_id) {
-                hash_table_remove(container_hash_table_g, &pair.key);
-                out->ret  = 1;
-                ret_value = SUCCEED;
-                goto done;
-            }
+#ifdef ENABLE_MULTITHREAD
+        // Container updates only hold the container lock, it is taken after the metadata lock
+        hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
+        cont_entry = hash_table_lookup(container_id_hash_table_g, &target_obj_id);
+        if (cont_entry != NULL) {
+            cont_hash_key = PDC_get_hash_by_name(cont_entry->cont_name);
+            container_name_index_remove(cont_entry);
+            hash_table_remove(container_id_hash_table_g, &target_obj_id);
+            hash_table_remove(container_hash_table_g, &cont_hash_key);
+            PDC_Server_wal_log_obj_delete(target_obj_id);
+            out->ret  = 1;
+            ret_value = SUCCEED;
         }
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
+        if (cont_entry != NULL)
+            goto done;
     }
     if (out->ret == -1 && metadata_hash_table_g != NULL) {
-
-        // Since we only have the obj id, need to iterate the entire hash table
         pdc_hash_table_entry_head *head;
-
-        n_entry = hash_table_num_entries(metadata_hash_table_g);
-        hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
-
-        while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
-
-            pair = hash_table_iter_next(&hash_table_iter);
-            head = pair.value;
-            // Now iterate the list under this entry
-            DL_FOREACH(head->metadata, elt)
-            {
-
-                if (elt->obj_id == target_obj_id) {
-                    // We found the delete target
-                    // Check if there are more objects in this list
-                    if (head->n_obj > 1) {
-                        // Remove from bloom filter
-                        if (head->bloom != NULL) {
-                            PDC_Server_remove_from_bloom(elt, head->bloom);
-                        }
-
-                        // Remove from linked list
-                        DL_DELETE(head->metadata, elt);
-                        head->n_obj--;
-                    }
-                    else {
-                        // This is the last item under the current entry, remove the hash entry
-                        uint32_t hash_key = PDC_get_hash_by_name(elt->obj_name);
-                        hash_table_remove(metadata_hash_table_g, &hash_key);
-                    }
-                    out->ret  = 1;
-                    ret_value = SUCCEED;
+        uint32_t                   hash_key;
+
+        elt = find_metadata_by_id(target_obj_id);
+        if (elt != NULL) {
+            hash_key = PDC_get_hash_by_name(elt->obj_name);
+            head     = hash_table_lookup(metadata_hash_table_g, &hash_key);
+            metadata_id_index_remove(target_obj_id);
+            metadata_name_index_remove(elt);
+            kvtag_index_remove_obj(elt);
+            metadata_query_index_update(elt, 0);
+            // Check if there are more objects in this list
+            if (head != NULL && head->n_obj > 1) {
+                // Remove from bloom filter
+                if (head->bloom != NULL) {
+                    pdc_bloom_remove(head->bloom);
                 }
-            } // DL_FOREACH
-        }     // while
-    }         // if (metadata_hash_table_g != NULL)
+
+                // Remove from linked list
+                DL_DELETE(head->metadata, elt);
+                head->n_obj--;
+                metadata_record_free(elt);
+            }
+            else {
+                // This is the last item under the current entry, remove the hash entry
+                hash_table_remove(metadata_hash_table_g, &hash_key);
+            }
+            PDC_Server_wal_log_obj_delete(target_obj_id);
+            out->ret  = 1;
+            ret_value = SUCCEED;
+        }
+    } // if (metadata_hash_table_g != NULL)
     else {
         printf("==PDC_SERVER: metadata_hash_table_g not initialized!\n");
         ret_value = FAIL;
@@ -1023,7 +2251,7 @@ PDC_Server_delete_metadata_by_id(metadata_delete_by_id_in_t *in, metadata_delete
 done:
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
     unlocked = 1;
 #endif
 
@@ -1056,7 +2284,7 @@ done:
 
 #ifdef ENABLE_MULTITHREAD
     if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+        hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
     FUNC_LEAVE(ret_value);
@@ -1090,16 +2318,16 @@ PDC_delete_metadata_from_hash_table(metadata_delete_in_t *in, metadata_delete_ou
 
     pdc_hash_table_entry_head *lookup_value;
     pdc_metadata_t             metadata;
-    strcpy(metadata.obj_name, in->obj_name);
-    metadata.time_step   = in->time_step;
-    metadata.app_name[0] = 0;
-    metadata.user_id     = -1;
-    metadata.obj_id      = 0;
+    metadata.obj_name  = in->obj_name;
+    metadata.time_step = in->time_step;
+    metadata.app_name  = "";
+    metadata.user_id   = -1;
+    metadata.obj_id    = 0;
 
 #ifdef ENABLE_MULTITHREAD
     // Obtain lock for hash table
     int unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
     if (metadata_hash_table_g != NULL) {
@@ -1111,18 +2339,28 @@ PDC_delete_metadata_from_hash_table(metadata_delete_in_t *in, metadata_delete_ou
             // Check if there exist metadata identical to current one
             target = find_identical_metadata(lookup_value, &metadata);
             if (target != NULL) {
+                PDC_Server_wal_log_obj_delete(target->obj_id);
                 if (lookup_value->n_obj > 1) {
                     // Remove from bloom filter
                     if (lookup_value->bloom != NULL) {
-                        PDC_Server_remove_from_bloom(target, lookup_value->bloom);
+                        pdc_bloom_remove(lookup_value->bloom);
                     }
 
                     // Remove from linked list
+                    metadata_id_index_remove(target->obj_id);
+                    metadata_name_index_remove(target);
+                    kvtag_index_remove_obj(target);
+                    metadata_query_index_update(target, 0);
                     DL_DELETE(lookup_value->metadata, target);
                     lookup_value->n_obj--;
+                    metadata_record_free(target);
                 }
                 else {
                     // Remove from hash
+                    metadata_id_index_remove(target->obj_id);
+                    metadata_name_index_remove(target);
+                    kvtag_index_remove_obj(target);
+                    metadata_query_index_update(target, 0);
                     hash_table_remove(metadata_hash_table_g, hash_key);
                 }
                 out->ret = 1;
@@ -1152,7 +2390,7 @@ PDC_delete_metadata_from_hash_table(metadata_delete_in_t *in, metadata_delete_ou
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
     unlocked = 1;
 #endif
 
@@ -1185,37 +2423,30 @@ PDC_delete_metadata_from_hash_table(metadata_delete_in_t *in, metadata_delete_ou
 done:
 #ifdef ENABLE_MULTITHREAD
     if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+        hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDC_insert_metadata_to_hash_table(gen_obj_id_in_t *in, gen_obj_id_out_t *out)
+/*
+ * Build a server metadata record from the transfer structure sent by a client
+ *
+ * \param  data[IN]         Metadata transfer structure received from client
+ * \param  data_type[IN]    Data type of the object
+ * \param  obj_name[IN]     Name of the object
+ *
+ * \return Pointer to the new metadata on success/NULL on failure
+ */
+static pdc_metadata_t *
+PDC_Server_metadata_from_transfer(pdc_metadata_transfer_t *data, int8_t data_type, const char *obj_name)
 {
-    perr_t          ret_value = SUCCEED;
+    pdc_metadata_t *ret_value = NULL;
     pdc_metadata_t *metadata;
-    uint32_t *      hash_key, i;
-#ifdef ENABLE_MULTITHREAD
-    // Obtain lock for hash table
-    int unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
-#endif
-    // DEBUG
-    int debug_flag = 0;
+    uint32_t        i;
 
     FUNC_ENTER(NULL);
 
-#ifdef ENABLE_TIMING
-    // Timing
-    struct timeval pdc_timer_start;
-    struct timeval pdc_timer_end;
-    double         ht_total_sec;
-
-    gettimeofday(&pdc_timer_start, 0);
-#endif
-
     metadata = (pdc_metadata_t *)malloc(sizeof(pdc_metadata_t));
     if (metadata == NULL) {
         printf("Cannot allocate pdc_metadata_t!\n");
@@ -1231,96 +2462,141 @@ PDC_insert_metadata_to_hash_table(gen_obj_id_in_t *in, gen_obj_id_out_t *out)
 #endif
 
     PDC_metadata_init(metadata);
-    metadata->cont_id   = in->data.cont_id;
-    metadata->data_type = in->data_type;
-    metadata->user_id   = in->data.user_id;
-    metadata->time_step = in->data.time_step;
-    metadata->ndim      = in->data.ndim;
-    metadata->dims[0]   = in->data.dims0;
-    metadata->dims[1]   = in->data.dims1;
-    metadata->dims[2]   = in->data.dims2;
-    metadata->dims[3]   = in->data.dims3;
+    metadata->cont_id   = data->cont_id;
+    metadata->data_type = data_type;
+    metadata->user_id   = data->user_id;
+    metadata->time_step = data->time_step;
+    metadata->ndim      = data->ndim;
+    metadata->dims[0]   = data->dims0;
+    metadata->dims[1]   = data->dims1;
+    metadata->dims[2]   = data->dims2;
+    metadata->dims[3]   = data->dims3;
     for (i = metadata->ndim; i < DIM_MAX; i++)
         metadata->dims[i] = 0;
 
-    strcpy(metadata->obj_name, in->data.obj_name);
-    strcpy(metadata->app_name, in->data.app_name);
-    strcpy(metadata->tags, in->data.tags);
-    strcpy(metadata->data_location, in->data.data_location);
-
-    hash_key = (uint32_t *)malloc(sizeof(uint32_t));
-    if (hash_key == NULL) {
-        printf("Cannot allocate hash_key!\n");
+    if (PDC_Server_metadata_set_strings(metadata, data->app_name, obj_name, data->tags,
+                                        data->data_location) != SUCCEED) {
+        free(metadata);
         goto done;
     }
-    total_mem_usage_g += sizeof(uint32_t);
-    *hash_key = in->hash_value;
-
-    pdc_hash_table_entry_head *lookup_value;
-    pdc_metadata_t *           found_identical;
 
-#ifdef ENABLE_MULTITHREAD
-    // Obtain lock for hash table
-    unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
-#endif
+    ret_value = metadata;
 
-    if (debug_flag == 1)
-        printf("checking hash table with key=%d\n", *hash_key);
+done:
+    FUNC_LEAVE(ret_value);
+}
 
-    if (metadata_hash_table_g != NULL) {
-        // lookup
-        lookup_value = hash_table_lookup(metadata_hash_table_g, hash_key);
+/*
+ * Insert a metadata record to the hash table, the caller must hold the hash table lock.
+ * The record is freed if an identical one already exists.
+ *
+ * \param  hash_value[IN]   Hash value of the object name
+ * \param  metadata[IN]     Metadata to be inserted
+ *
+ * \return The new object ID on success/0 on failure
+ */
+static uint64_t
+PDC_Server_insert_metadata_locked(uint32_t hash_value, pdc_metadata_t *metadata)
+{
+    uint64_t                   ret_value = 0;
+    uint32_t *                 hash_key;
+    pdc_hash_table_entry_head *lookup_value;
+    pdc_hash_table_entry_head *entry;
 
-        // Is this hash value exist in the Hash table?
-        if (lookup_value != NULL) {
-            if (debug_flag == 1)
-                printf("lookup_value not NULL!\n");
-            // Check if there exist metadata identical to current one
-            found_identical = find_identical_metadata(lookup_value, metadata);
-            if (found_identical != NULL) {
-                printf("==PDC_SERVER[%d]: Found identical metadata with name %s!\n", pdc_server_rank_g,
-                       metadata->obj_name);
-                out->obj_id = 0;
-                free(metadata);
-                goto done;
-            }
-            else {
-                PDC_Server_hash_table_list_insert(lookup_value, metadata);
-            }
-        }
-        else {
-            // First entry for current hasy_key, init linked list, and insert to hash table
-            if (debug_flag == 1) {
-                printf("lookup_value is NULL! Init linked list\n");
-            }
-            fflush(stdout);
+    FUNC_ENTER(NULL);
 
-            pdc_hash_table_entry_head *entry =
-                (pdc_hash_table_entry_head *)malloc(sizeof(pdc_hash_table_entry_head));
-            entry->bloom    = NULL;
-            entry->metadata = NULL;
-            entry->n_obj    = 0;
-            total_mem_usage_g += sizeof(pdc_hash_table_entry_head);
+    if (metadata_hash_table_g == NULL) {
+        printf("metadata_hash_table_g not initialized!\n");
+        PDC_Server_metadata_free_strings(metadata);
+        free(metadata);
+        goto done;
+    }
 
-            PDC_Server_hash_table_list_init(entry, hash_key);
-            PDC_Server_hash_table_list_insert(entry, metadata);
+    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_value);
+    if (lookup_value != NULL) {
+        // Check if there exist metadata identical to current one
+        if (find_identical_metadata(lookup_value, metadata) != NULL) {
+            printf("==PDC_SERVER[%d]: Found identical metadata with name %s!\n", pdc_server_rank_g,
+                   metadata->obj_name);
+            PDC_Server_metadata_free_strings(metadata);
+            free(metadata);
+            goto done;
         }
+        // Generate object id (uint64_t) before the insert indexes it
+        metadata->obj_id = PDC_Server_gen_obj_id(hash_value + metadata->time_step);
+        PDC_Server_hash_table_list_insert(lookup_value, metadata);
     }
     else {
-        printf("metadata_hash_table_g not initialized!\n");
-        goto done;
+        // First entry for current hash_key, init linked list, and insert to hash table
+        hash_key = (uint32_t *)malloc(sizeof(uint32_t));
+        entry    = (pdc_hash_table_entry_head *)malloc(sizeof(pdc_hash_table_entry_head));
+        if (hash_key == NULL || entry == NULL) {
+            printf("Cannot allocate hash table entry!\n");
+            free(hash_key);
+            free(entry);
+            PDC_Server_metadata_free_strings(metadata);
+            free(metadata);
+            goto done;
+        }
+        *hash_key       = hash_value;
+        entry->bloom    = NULL;
+        entry->metadata = NULL;
+        entry->n_obj    = 0;
+        total_mem_usage_g += sizeof(uint32_t) + sizeof(pdc_hash_table_entry_head);
+
+        PDC_Server_hash_table_list_init(entry, hash_key);
+        metadata->obj_id = PDC_Server_gen_obj_id(hash_value + metadata->time_step);
+        PDC_Server_hash_table_list_insert(entry, metadata);
     }
 
-    // Generate object id (uint64_t)
-    metadata->obj_id = PDC_Server_gen_obj_id();
+    ret_value = metadata->obj_id;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_insert_metadata_to_hash_table(gen_obj_id_in_t *in, gen_obj_id_out_t *out)
+{
+    perr_t          ret_value = SUCCEED;
+    pdc_metadata_t *metadata;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_TIMING
+    // Timing
+    struct timeval pdc_timer_start;
+    struct timeval pdc_timer_end;
+    double         ht_total_sec;
+
+    gettimeofday(&pdc_timer_start, 0);
+#endif
+
+    out->obj_id = 0;
+
+    metadata = PDC_Server_metadata_from_transfer(&in->data, in->data_type, in->data.obj_name);
+    if (metadata == NULL)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    // Obtain lock for hash table
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+
+    // Fill $out structure for returning the generated obj_id to client
+    out->obj_id = PDC_Server_insert_metadata_locked(in->hash_value, metadata);
+    // Logged under the lock, so a snapshot sees the object and its record together
+    if (out->obj_id != 0)
+        PDC_Server_wal_log_obj_create(in->hash_value, metadata);
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
-    unlocked = 1;
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
+    if (out->obj_id == 0)
+        goto done;
+
 #ifdef ENABLE_MULTITHREAD
     hg_thread_mutex_lock(&n_metadata_mutex_g);
 #endif
@@ -1329,9 +2605,6 @@ PDC_insert_metadata_to_hash_table(gen_obj_id_in_t *in, gen_obj_id_out_t *out)
     hg_thread_mutex_unlock(&n_metadata_mutex_g);
 #endif
 
-    // Fill $out structure for returning the generated obj_id to client
-    out->obj_id = metadata->obj_id;
-
 #ifdef ENABLE_TIMING
     // Timing
     gettimeofday(&pdc_timer_end, 0);
@@ -1351,11 +2624,96 @@ PDC_insert_metadata_to_hash_table(gen_obj_id_in_t *in, gen_obj_id_out_t *out)
 #endif
 
 done:
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_create_objs_batch(gen_obj_id_many_in_t *in, uint32_t n_obj, const uint32_t *hash_values,
+                             char **obj_names, uint64_t *obj_ids, uint32_t *n_created)
+{
+    perr_t           ret_value = SUCCEED;
+    pdc_metadata_t **metadata  = NULL;
+    uint32_t         i, n_ok = 0;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_TIMING
+    // Timing
+    struct timeval pdc_timer_start;
+    struct timeval pdc_timer_end;
+    double         ht_total_sec;
+
+    gettimeofday(&pdc_timer_start, 0);
+#endif
+
+    *n_created = 0;
+    if (n_obj == 0)
+        goto done;
+
+    // Build all records before taking the lock so the critical section is only the index inserts
+    metadata = (pdc_metadata_t **)calloc(n_obj, sizeof(pdc_metadata_t *));
+    if (metadata == NULL)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: %s - cannot allocate metadata array", pdc_server_rank_g,
+                    __func__);
+
+    for (i = 0; i < n_obj; i++) {
+        obj_ids[i]  = 0;
+        metadata[i] = PDC_Server_metadata_from_transfer(&in->data, in->data_type, obj_names[i]);
+    }
+
 #ifdef ENABLE_MULTITHREAD
-    if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    // Obtain lock for hash table once for the whole batch
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+
+    // Names are inserted in order, so duplicates within the batch are caught like existing ones
+    for (i = 0; i < n_obj; i++) {
+        if (metadata[i] == NULL)
+            continue;
+        obj_ids[i] = PDC_Server_insert_metadata_locked(hash_values[i], metadata[i]);
+        if (obj_ids[i] == 0)
+            continue;
+        PDC_Server_wal_log_obj_create(hash_values[i], metadata[i]);
+        n_ok++;
+    }
+
+#ifdef ENABLE_MULTITHREAD
+    // ^ Release hash table lock
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&n_metadata_mutex_g);
+#endif
+    n_metadata_g += n_ok;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&n_metadata_mutex_g);
+#endif
+
+    *n_created = n_ok;
+    if (n_ok != n_obj)
+        ret_value = FAIL;
+
+#ifdef ENABLE_TIMING
+    // Timing
+    gettimeofday(&pdc_timer_end, 0);
+    ht_total_sec = PDC_get_elapsed_time_double(&pdc_timer_start, &pdc_timer_end);
+#endif
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_time_mutex_g);
+#endif
+
+#ifdef ENABLE_TIMING
+    server_insert_time_g += ht_total_sec;
+#endif
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_time_mutex_g);
 #endif
 
+done:
+    free(metadata);
     FUNC_LEAVE(ret_value);
 }
 
@@ -1406,7 +2764,42 @@ PDC_Server_print_all_containers()
         printf("\n");
     }
 
-    FUNC_LEAVE(ret_value);
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Sum the occupancy of the bloom filters of all metadata hash table entries
+ *
+ * \param  stat[OUT]        Number of filters, keys, bits set, bits and bytes
+ *
+ * \return void
+ */
+static void
+PDC_Server_bloom_stats(uint64_t *stat)
+{
+    HashTableIterator          hash_table_iter;
+    HashTablePair              pair;
+    pdc_hash_table_entry_head *head;
+    pdc_bloom_stats_t          bloom_stats;
+
+    FUNC_ENTER(NULL);
+
+    memset(stat, 0, 5 * sizeof(uint64_t));
+    hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
+    while (hash_table_iter_has_more(&hash_table_iter)) {
+        pair = hash_table_iter_next(&hash_table_iter);
+        head = pair.value;
+        if (head->bloom == NULL)
+            continue;
+        pdc_bloom_get_stats(head->bloom, &bloom_stats);
+        stat[0]++;
+        stat[1] += bloom_stats.n_key;
+        stat[2] += bloom_stats.n_bit_set;
+        stat[3] += bloom_stats.n_bit;
+        stat[4] += bloom_stats.mem_size;
+    }
+
+    FUNC_LEAVE_VOID;
 }
 
 perr_t
@@ -1416,7 +2809,8 @@ PDC_Server_metadata_duplicate_check()
     HashTableIterator          hash_table_iter;
     HashTablePair              pair;
     int                        n_entry, count = 0;
-    int                        all_maybe, all_total, all_entry;
+    int                        all_maybe, all_total, all_false_positive, all_entry;
+    uint64_t                   bloom_stat[5], all_bloom_stat[5];
     int                        has_dup_obj = 0;
     int                        all_dup_obj = 0;
     pdc_metadata_t *           elt, *elt_next;
@@ -1425,19 +2819,30 @@ PDC_Server_metadata_duplicate_check()
     FUNC_ENTER(NULL);
 
     n_entry = hash_table_num_entries(metadata_hash_table_g);
+    PDC_Server_bloom_stats(bloom_stat);
 
 #ifdef ENABLE_MPI
     MPI_Reduce(&n_bloom_maybe_g, &all_maybe, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
     MPI_Reduce(&n_bloom_total_g, &all_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&n_bloom_false_positive_g, &all_false_positive, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(bloom_stat, all_bloom_stat, 5, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
     MPI_Reduce(&n_entry, &all_entry, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
 #else
-    all_maybe   = n_bloom_maybe_g;
-    all_total   = n_bloom_total_g;
-    all_entry   = n_entry;
+    all_maybe          = n_bloom_maybe_g;
+    all_total          = n_bloom_total_g;
+    all_false_positive = n_bloom_false_positive_g;
+    memcpy(all_bloom_stat, bloom_stat, sizeof(bloom_stat));
+    all_entry = n_entry;
 #endif
 
     if (pdc_server_rank_g == 0) {
-        printf("==PDC_SERVER: Bloom filter says maybe %d times out of %d\n", all_maybe, all_total);
+        printf("==PDC_SERVER: Bloom filter says maybe %d times out of %d, %d false positives\n", all_maybe,
+               all_total, all_false_positive);
+        if (all_bloom_stat[0] > 0)
+            printf("==PDC_SERVER: %" PRIu64 " bloom filters hold %" PRIu64 " keys in %" PRIu64
+                   " bytes, %.1f%% bits set\n",
+                   all_bloom_stat[0], all_bloom_stat[1], all_bloom_stat[4],
+                   100.0 * all_bloom_stat[2] / all_bloom_stat[3]);
         printf("==PDC_SERVER: Metadata duplicate check with %d hash entries ", all_entry);
     }
 
@@ -1484,6 +2889,42 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Check if each ','-separated tag of a query is one of the tags of a metadata
+ *
+ * \param  tags[IN]          Tags of the metadata
+ * \param  query[IN]         Tags of the query
+ *
+ * \return 1 if all query tags are found/0 otherwise
+ */
+static int
+metadata_has_tags(const char *tags, const char *query)
+{
+    const char *end, *pos;
+    size_t      len;
+    int         found;
+
+    while (query != NULL && *query != 0) {
+        end = strchr(query, ',');
+        len = end == NULL ? strlen(query) : (size_t)(end - query);
+        if (len > 0) {
+            found = 0;
+            pos   = tags;
+            while (!found && pos != NULL && *pos != 0) {
+                found = strncmp(pos, query, len) == 0 && (pos[len] == ',' || pos[len] == 0);
+                pos   = strchr(pos, ',');
+                if (pos != NULL)
+                    pos++;
+            }
+            if (!found)
+                return 0;
+        }
+        query = end == NULL ? NULL : end + 1;
+    }
+
+    return 1;
+}
+
 /*
  * Check if the metadata satisfies the constraint received from client
  *
@@ -1517,12 +2958,11 @@ is_metadata_satisfy_constraint(pdc_metadata_t *metadata, metadata_query_transfer
         ret_value = -1;
         goto done;
     }
-    if (constraints->ndim > 0 && metadata->ndim != constraints->ndim) {
+    if (constraints->ndim > 0 && constraints->ndim <= DIM_MAX && metadata->ndim != constraints->ndim) {
         ret_value = -1;
         goto done;
     }
-    // TODO: Currently only supports searching with one tag
-    if (strcmp(constraints->tags, " ") != 0 && strstr(metadata->tags, constraints->tags) == NULL) {
+    if (strcmp(constraints->tags, " ") != 0 && !metadata_has_tags(metadata->tags, constraints->tags)) {
         ret_value = -1;
         goto done;
     }
@@ -1531,73 +2971,256 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
-perr_t
-PDC_Server_get_partial_query_result(metadata_query_transfer_in_t *in, uint32_t *n_meta, void ***buf_ptrs)
+// At most this many tags of a query are looked up in the tag index, the others are only checked
+#define QUERY_PLAN_MAX_TAG 16
+
+static void
+query_plan_pick(pdc_query_posting_t *candidate, pdc_query_posting_t **posting, uint64_t *best)
+{
+    // A value missing from its index has no object, so the query has no result
+    static pdc_query_posting_t empty_posting;
+
+    if (candidate == NULL)
+        candidate = &empty_posting;
+    if (query_posting_size(candidate) < *best) {
+        *best    = query_posting_size(candidate);
+        *posting = candidate;
+    }
+}
+
+/*
+ * Pick the most selective index of a partial query among the postings of its app name, user ID, ndim
+ * and tags and its time step range. The other constraints are checked on the objects of that index,
+ * which costs less than intersecting the other postings as they tend to be much larger.
+ *
+ * \param  in[IN]            Query constraints
+ * \param  posting[OUT]      Posting that drives the query, NULL if the time step range does
+ *
+ * \return 1 if an index drives the query/0 if it needs a full scan
+ */
+static int
+query_index_plan(metadata_query_transfer_in_t *in, pdc_query_posting_t **posting)
+{
+    uint64_t    best = UINT64_MAX, ts_start = 0, ts_end = 0;
+    const char *tags, *end;
+    char        token[TAG_LEN_MAX];
+    size_t      len;
+    int         n_tag = 0, ret_value = 0;
+
+    *posting = NULL;
+
+    if (in->user_id > 0) {
+        query_plan_pick(query_index_posting(&user_id_index_g, NULL, in->user_id, 0), posting, &best);
+        ret_value = 1;
+    }
+    if (strcmp(in->app_name, " ") != 0) {
+        query_plan_pick(query_index_posting(&app_name_index_g, in->app_name, 0, 0), posting, &best);
+        ret_value = 1;
+    }
+    if (in->ndim > 0 && in->ndim <= DIM_MAX) {
+        query_plan_pick(&ndim_index_g[in->ndim], posting, &best);
+        ret_value = 1;
+    }
+    if (strcmp(in->tags, " ") != 0) {
+        for (tags = in->tags; tags != NULL && *tags != 0 && n_tag < QUERY_PLAN_MAX_TAG; n_tag++) {
+            end = strchr(tags, ',');
+            len = end == NULL ? strlen(tags) : (size_t)(end - tags);
+            if (len > 0 && len < TAG_LEN_MAX) {
+                memcpy(token, tags, len);
+                token[len] = 0;
+                query_plan_pick(query_index_posting(&tag_index_g, token, 0, 0), posting, &best);
+                ret_value = 1;
+            }
+            tags = end == NULL ? NULL : end + 1;
+        }
+    }
+    if (in->time_step_from > 0 && in->time_step_to > 0) {
+        // The ranks of the range ends give its size without walking it
+        if (time_step_index_g != NULL) {
+            pdc_skip_list_lower_bound(time_step_index_g, in->time_step_from, 0, &ts_start);
+            pdc_skip_list_lower_bound(time_step_index_g, in->time_step_to, UINT64_MAX, &ts_end);
+        }
+        if (ts_end < ts_start)
+            ts_end = ts_start;
+        if (ts_end - ts_start < best)
+            *posting = NULL;
+        ret_value = 1;
+    }
+
+    return ret_value;
+}
+
+// Serialize a metadata into a page, 0 if it does not fit
+static int
+query_page_append(pdc_metadata_t *elt, char *buf, uint64_t buf_size, uint32_t *n_meta, uint64_t *nbytes)
+{
+    size_t size = PDC_metadata_serialize(elt, NULL);
+
+    if (*nbytes + size > buf_size) {
+        if (*n_meta == 0)
+            printf("==PDC_SERVER[%d]: %s - metadata of %zu bytes does not fit in a page\n", pdc_server_rank_g,
+                   __func__, size);
+        return 0;
+    }
+    *nbytes += PDC_metadata_serialize(elt, buf + *nbytes);
+    (*n_meta)++;
+
+    return 1;
+}
+
+/*
+ * Page of a query driven by an index, in the key order of the index. A posting is keyed by object ID,
+ * so its cursor is the ID of the next object. The time step index is keyed by (time step, object ID),
+ * so its cursor is the time step of the next object and its minor part the ID of that object. Either
+ * way a page seeks straight to its first object, and pages stay consistent when objects are created or
+ * deleted in between.
+ */
+static perr_t
+query_index_page(metadata_query_transfer_in_t *in, pdc_query_posting_t *posting, uint64_t cursor,
+                 uint64_t cursor_minor, char *buf, uint64_t buf_size, uint32_t *n_meta, uint64_t *nbytes,
+                 uint64_t *next_cursor, uint64_t *next_cursor_minor)
+{
+    perr_t                ret_value = SUCCEED;
+    pdc_metadata_t *      elt;
+    pdc_skip_list_node_t *node = NULL, *end = NULL;
+
+    FUNC_ENTER(NULL);
+
+    if (posting == NULL && time_step_index_g != NULL) {
+        // Every time step in the range is > 0, so a cursor of 0 is the first page
+        if (cursor == 0)
+            node = pdc_skip_list_lower_bound(time_step_index_g, in->time_step_from, 0, NULL);
+        else
+            node = pdc_skip_list_lower_bound(time_step_index_g, (int64_t)cursor, cursor_minor, NULL);
+        end = pdc_skip_list_lower_bound(time_step_index_g, in->time_step_to, UINT64_MAX, NULL);
+    }
+    else if (posting != NULL && posting->meta != NULL)
+        node = pdc_skip_list_lower_bound(posting->meta, 0, cursor, NULL);
+
+    for (; node != end; node = pdc_skip_list_next(node)) {
+        elt = (pdc_metadata_t *)pdc_skip_list_value(node);
+        if (is_metadata_satisfy_constraint(elt, in) != 1)
+            continue;
+        if (!query_page_append(elt, buf, buf_size, n_meta, nbytes)) {
+            if (*n_meta == 0)
+                ret_value = FAIL;
+            if (posting == NULL) {
+                *next_cursor       = (uint64_t)elt->time_step;
+                *next_cursor_minor = elt->obj_id;
+            }
+            else
+                *next_cursor = elt->obj_id;
+            break;
+        }
+    }
+
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Page of a query that no index can answer, such as listing all objects. The cursor is the position of
+ * the next metadata in the hash table, with the index of its hash table chain in the high 32 bits and
+ * its index among the metadata of that chain in the low 32 bits, so a page seeks to its chain instead
+ * of walking the table from the start. Objects created or deleted between two pages, or the table
+ * growing, may shift the positions, so they can be missed or listed twice, the same as when the objects
+ * change while a single query runs.
+ */
+static perr_t
+query_scan_page(metadata_query_transfer_in_t *in, uint64_t cursor, char *buf, uint64_t buf_size,
+                uint32_t *n_meta, uint64_t *nbytes, uint64_t *next_cursor)
 {
-    perr_t                     ret_value = FAIL;
-    uint32_t                   i;
-    uint32_t                   n_buf, iter = 0;
+    perr_t                     ret_value = SUCCEED;
+    uint32_t                   start_chain, start_elt, chain, elt_idx = 0;
     pdc_hash_table_entry_head *head;
     pdc_metadata_t *           elt;
     HashTableIterator          hash_table_iter;
-    int                        n_entry;
     HashTablePair              pair;
 
     FUNC_ENTER(NULL);
 
-    // n_buf = n_metadata_g + 1 for potential padding array
-    n_buf     = n_metadata_g + 1;
-    *buf_ptrs = (void **)calloc(n_buf, sizeof(void *));
-    for (i = 0; i < n_buf; i++) {
-        (*buf_ptrs)[i] = (void *)calloc(1, sizeof(void *));
-    }
-    // TODO: free buf_ptrs
-    if (metadata_hash_table_g != NULL) {
-
-        n_entry = hash_table_num_entries(metadata_hash_table_g);
-        hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
+    start_chain = (uint32_t)(cursor >> 32);
+    start_elt   = (uint32_t)cursor;
+    chain       = start_chain;
 
-        while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
-            pair = hash_table_iter_next(&hash_table_iter);
-            head = pair.value;
-            DL_FOREACH(head->metadata, elt)
-            {
-                // List all objects, no need to check other constraints
-                if (in->is_list_all == 1) {
-                    (*buf_ptrs)[iter++] = elt;
-                }
-                // check if current metadata matches search constraint
-                else if (is_metadata_satisfy_constraint(elt, in) == 1) {
-                    (*buf_ptrs)[iter++] = elt;
+    hash_table_iterate_from(metadata_hash_table_g, &hash_table_iter, start_chain);
+    while (hash_table_iter_has_more(&hash_table_iter)) {
+        // Several entries can share a chain, the metadata are counted across them
+        if (hash_table_iter.next_chain != chain) {
+            chain   = hash_table_iter.next_chain;
+            elt_idx = 0;
+        }
+        pair = hash_table_iter_next(&hash_table_iter);
+        head = pair.value;
+        DL_FOREACH(head->metadata, elt)
+        {
+            if (chain == start_chain && elt_idx < start_elt) {
+                elt_idx++;
+                continue;
+            }
+            // List all objects, no need to check other constraints
+            if (in->is_list_all == 1 || is_metadata_satisfy_constraint(elt, in) == 1) {
+                if (!query_page_append(elt, buf, buf_size, n_meta, nbytes)) {
+                    if (*n_meta == 0)
+                        ret_value = FAIL;
+                    *next_cursor = ((uint64_t)chain << 32) | elt_idx;
+                    goto done;
                 }
             }
+            elt_idx++;
         }
-        *n_meta = iter;
-    } // if (metadata_hash_table_g != NULL)
-    else {
+    }
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_get_partial_query_page(metadata_query_transfer_in_t *in, uint64_t cursor, uint64_t cursor_minor,
+                                  char *buf, uint64_t buf_size, uint32_t *n_meta, uint64_t *nbytes,
+                                  uint64_t *next_cursor, uint64_t *next_cursor_minor)
+{
+    perr_t               ret_value = SUCCEED;
+    pdc_query_posting_t *posting;
+
+    FUNC_ENTER(NULL);
+
+    *n_meta            = 0;
+    *nbytes            = 0;
+    *next_cursor       = 0;
+    *next_cursor_minor = 0;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+    if (metadata_hash_table_g == NULL) {
         printf("==PDC_SERVER: metadata_hash_table_g not initialized!\n");
         ret_value = FAIL;
         goto done;
     }
 
-    ret_value = SUCCEED;
+    // A query takes the same path on every page, so its cursor always means the same
+    if (in->is_list_all != 1 && query_index_plan(in, &posting))
+        ret_value = query_index_page(in, posting, cursor, cursor_minor, buf, buf_size, n_meta, nbytes,
+                                     next_cursor, next_cursor_minor);
+    else
+        ret_value = query_scan_page(in, cursor, buf, buf_size, n_meta, nbytes, next_cursor);
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
     FUNC_LEAVE(ret_value);
 }
 
 perr_t
-PDC_Server_get_kvtag_query_result(pdc_kvtag_t *in, uint32_t *n_meta, uint64_t **obj_ids)
+PDC_Server_get_kvtag_query_result(kvtag_query_in_t *in, uint32_t *n_meta, uint64_t **obj_ids)
 {
-    perr_t                     ret_value = SUCCEED;
-    uint32_t                   iter      = 0;
-    pdc_hash_table_entry_head *head;
-    pdc_metadata_t *           elt;
-    pdc_kvtag_list_t *         kvtag_list_elt;
-    HashTableIterator          hash_table_iter;
-    int                        n_entry, is_name_match, is_value_match;
-    HashTablePair              pair;
-    uint32_t                   alloc_size = 100;
+    perr_t             ret_value = SUCCEED;
+    uint32_t           iter      = 0, i, n_unique;
+    pdc_kvtag_index_t *index;
+    HashTableIterator  hash_table_iter;
+    HashTablePair      pair;
+    uint32_t           alloc_size = 100;
 
     FUNC_ENTER(NULL);
 
@@ -1605,59 +3228,48 @@ PDC_Server_get_kvtag_query_result(pdc_kvtag_t *in, uint32_t *n_meta, uint64_t **
     // TODO: free obj_ids
     *obj_ids = (void *)calloc(alloc_size, sizeof(uint64_t));
 
-    if (metadata_hash_table_g != NULL) {
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+    if (metadata_hash_table_g == NULL) {
+        printf("==PDC_SERVER: metadata_hash_table_g not initialized!\n");
+        ret_value = FAIL;
+        goto done;
+    }
 
-        n_entry = hash_table_num_entries(metadata_hash_table_g);
-        hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
+    // No object has a kvtag yet
+    if (kvtag_index_hash_table_g == NULL)
+        goto done;
 
-        while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
+    if (in->kvtag.name[0] != ' ') {
+        index = hash_table_lookup(kvtag_index_hash_table_g, in->kvtag.name);
+        if (index != NULL)
+            kvtag_index_query(index, in, obj_ids, &iter, &alloc_size);
+    }
+    else {
+        hash_table_iterate(kvtag_index_hash_table_g, &hash_table_iter);
+        while (hash_table_iter_has_more(&hash_table_iter)) {
             pair = hash_table_iter_next(&hash_table_iter);
-            head = pair.value;
-            DL_FOREACH(head->metadata, elt)
-            {
-                DL_FOREACH(elt->kvtag_list_head, kvtag_list_elt)
-                {
-                    is_name_match  = 0;
-                    is_value_match = 0;
-                    if (in->name[0] != ' ') {
-                        if (strcmp(in->name, kvtag_list_elt->kvtag->name) == 0)
-                            is_name_match = 1;
-                        else
-                            continue;
-                    }
-                    else
-                        is_name_match = 1;
-
-                    if (((char *)(in->value))[0] != ' ') {
-                        if (memcmp(in->value, kvtag_list_elt->kvtag->value, in->size) == 0)
-                            is_value_match = 1;
-                        else
-                            continue;
-                    }
-                    else
-                        is_value_match = 1;
-
-                    if (is_name_match == 1 && is_value_match == 1) {
-                        if (iter >= alloc_size) {
-                            alloc_size *= 2;
-                            *obj_ids = (void *)realloc(*obj_ids, alloc_size * sizeof(uint64_t));
-                        }
-                        (*obj_ids)[iter++] = elt->obj_id;
-                        break;
-                    }
+            kvtag_index_query((pdc_kvtag_index_t *)pair.value, in, obj_ids, &iter, &alloc_size);
+        }
+    }
 
-                } // End for each kvtag
-            }     // End for each metadata
-        }         // End while
-        *n_meta = iter;
-    } // if (metadata_hash_table_g != NULL)
-    else {
-        printf("==PDC_SERVER: metadata_hash_table_g not initialized!\n");
-        ret_value = FAIL;
-        goto done;
+    // An object matches once even if several of its tags do
+    if (iter > 1) {
+        qsort(*obj_ids, iter, sizeof(uint64_t), kvtag_obj_id_cmp);
+        n_unique = 1;
+        for (i = 1; i < iter; i++) {
+            if ((*obj_ids)[i] != (*obj_ids)[n_unique - 1])
+                (*obj_ids)[n_unique++] = (*obj_ids)[i];
+        }
+        iter = n_unique;
     }
+    *n_meta = iter;
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
     fflush(stdout);
 
     FUNC_LEAVE(ret_value);
@@ -1681,9 +3293,12 @@ PDC_Server_search_with_name_timestep(const char *obj_name, uint32_t hash_key, ui
 
     name = obj_name;
 
-    strcpy(metadata.obj_name, name);
+    metadata.obj_name = name;
     metadata.time_step = ts;
 
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
     if (metadata_hash_table_g != NULL) {
         // lookup
         lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
@@ -1711,6 +3326,9 @@ PDC_Server_search_with_name_timestep(const char *obj_name, uint32_t hash_key, ui
         printf("==PDC_SERVER[%d]: Queried object with name [%s] not found! \n", pdc_server_rank_g, name);
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
     fflush(stdout);
     FUNC_LEAVE(ret_value);
 }
@@ -1732,10 +3350,13 @@ PDC_Server_search_with_name_hash(const char *obj_name, uint32_t hash_key, pdc_me
 
     name = obj_name;
 
-    strcpy(metadata.obj_name, name);
+    metadata.obj_name = name;
     // TODO: currently PDC_Client_query_metadata_name_timestep is not taking timestep for querying
     metadata.time_step = 0;
 
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
     if (metadata_hash_table_g != NULL) {
         // lookup
         lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
@@ -1763,6 +3384,9 @@ PDC_Server_search_with_name_hash(const char *obj_name, uint32_t hash_key, pdc_me
         printf("==PDC_SERVER[%d]: Queried object with name [%s] not found! \n", pdc_server_rank_g, name);
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
     fflush(stdout);
     FUNC_LEAVE(ret_value);
 }
@@ -1772,42 +3396,26 @@ PDC_Server_get_local_metadata_by_id(uint64_t obj_id, pdc_metadata_t **res_meta_p
 {
     perr_t ret_value = SUCCEED;
 
-    pdc_hash_table_entry_head *head;
-    pdc_metadata_t *           elt;
-    HashTableIterator          hash_table_iter;
-    int                        n_entry;
-    HashTablePair              pair;
-
     FUNC_ENTER(NULL);
 
     *res_meta_ptr = NULL;
 
-    if (metadata_hash_table_g != NULL) {
-        // Since we only have the obj id, need to iterate the entire hash table
-        n_entry = hash_table_num_entries(metadata_hash_table_g);
-        hash_table_iterate(metadata_hash_table_g, &hash_table_iter);
-
-        while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
-            pair = hash_table_iter_next(&hash_table_iter);
-            head = pair.value;
-            // Now iterate the list under this entry
-            DL_FOREACH(head->metadata, elt)
-            {
-                if (elt->obj_id == obj_id) {
-                    *res_meta_ptr = elt;
-                    goto done;
-                }
-            }
-        }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+    if (metadata_id_hash_table_g != NULL) {
+        *res_meta_ptr = hash_table_lookup(metadata_id_hash_table_g, &obj_id);
     }
     else {
-        printf("==PDC_SERVER: metadata_hash_table_g not initialized!\n");
-        ret_value     = FAIL;
-        *res_meta_ptr = NULL;
+        printf("==PDC_SERVER: metadata_id_hash_table_g not initialized!\n");
+        ret_value = FAIL;
         goto done;
     }
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
     FUNC_LEAVE(ret_value);
 }
 
@@ -1823,7 +3431,7 @@ PDC_Server_get_metadata_by_id_cb(const struct hg_cb_info *callback_info)
 {
     hg_return_t                ret_value;
     hg_handle_t                handle;
-    pdc_metadata_t *           meta = NULL;
+    pdc_metadata_t *           meta = NULL, res_meta;
     get_metadata_by_id_args_t *cb_args;
     get_metadata_by_id_out_t   output;
 
@@ -1841,8 +3449,9 @@ PDC_Server_get_metadata_by_id_cb(const struct hg_cb_info *callback_info)
 
     if (output.res_meta.obj_id != 0) {
         // TODO free metdata
-        meta = (pdc_metadata_t *)malloc(sizeof(pdc_metadata_t));
-        PDC_transfer_t_to_metadata_t(&output.res_meta, meta);
+        PDC_metadata_init(&res_meta);
+        PDC_transfer_t_to_metadata_t(&output.res_meta, &res_meta);
+        meta = PDC_metadata_dup(&res_meta);
     }
     else {
         printf("==PDC_SERVER[%d]: %s - no valid metadata is retrieved\n", pdc_server_rank_g, __func__);
@@ -1956,18 +3565,23 @@ PDC_Server_create_container(gen_cont_id_in_t *in, gen_cont_id_out_t *out)
     pdc_cont_hash_table_entry_t *lookup_value;
 
 #ifdef ENABLE_MULTITHREAD
-    hg_thread_mutex_lock(&pdc_container_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
 #endif
 
     if (container_hash_table_g != NULL) {
         // lookup
-        lookup_value = hash_table_lookup(container_hash_table_g, &in->hash_value);
+        lookup_value = container_name_index_find(in->cont_name);
 
-        // Is this hash value exist in the Hash table?
+        // Is this container name exist in the Hash table?
         if (lookup_value != NULL) {
-            // Check if there exist container identical to current one
             out->cont_id = lookup_value->cont_id;
         }
+        else if (hash_table_lookup(container_hash_table_g, &in->hash_value) != NULL) {
+            // A different name owns the hash value, containers are keyed by it alone
+            printf("==PDC_SERVER[%d]: %s - container %s collides with an existing container\n",
+                   pdc_server_rank_g, __func__, in->cont_name);
+            ret_value = FAIL;
+        }
         else {
             hash_key = (uint32_t *)malloc(sizeof(uint32_t));
             if (hash_key == NULL) {
@@ -1983,7 +3597,7 @@ PDC_Server_create_container(gen_cont_id_in_t *in, gen_cont_id_out_t *out)
             entry->n_obj       = 0;
             entry->n_allocated = 0;
             entry->obj_ids     = NULL;
-            entry->cont_id     = PDC_Server_gen_obj_id();
+            entry->cont_id     = PDC_Server_gen_obj_id(in->hash_value);
 #ifdef ENABLE_MULTITHREAD
             hg_thread_mutex_lock(&total_mem_usage_mutex_g);
 #endif
@@ -1996,8 +3610,15 @@ PDC_Server_create_container(gen_cont_id_in_t *in, gen_cont_id_out_t *out)
                 printf("==PDC_SERVER[%d]: %s - hash table insert failed\n", pdc_server_rank_g, __func__);
                 ret_value = FAIL;
             }
-            else
+            else if (hash_table_insert(container_id_hash_table_g, &entry->cont_id, entry) != 1) {
+                printf("==PDC_SERVER[%d]: %s - ID index insert failed\n", pdc_server_rank_g, __func__);
+                ret_value = FAIL;
+            }
+            else {
+                container_name_index_insert(entry);
+                PDC_Server_wal_log_cont_create(in->hash_value, entry->cont_id, entry->cont_name);
                 out->cont_id = entry->cont_id;
+            }
         }
     }
     else {
@@ -2008,7 +3629,7 @@ PDC_Server_create_container(gen_cont_id_in_t *in, gen_cont_id_out_t *out)
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_container_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
     hg_thread_mutex_lock(&pdc_time_mutex_g);
 #endif
 
@@ -2027,6 +3648,42 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+perr_t
+PDC_Server_restore_container(uint32_t hash_key, const char *cont_name, uint64_t cont_id)
+{
+    perr_t                       ret_value = SUCCEED;
+    pdc_cont_hash_table_entry_t *entry;
+    uint32_t *                   key;
+
+    FUNC_ENTER(NULL);
+
+    if (hash_table_lookup(container_hash_table_g, &hash_key) != NULL)
+        goto done;
+
+    key   = (uint32_t *)malloc(sizeof(uint32_t));
+    entry = (pdc_cont_hash_table_entry_t *)calloc(1, sizeof(pdc_cont_hash_table_entry_t));
+    if (key == NULL || entry == NULL) {
+        printf("==PDC_SERVER[%d]: %s - cannot allocate container entry\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+    *key = hash_key;
+    snprintf(entry->cont_name, ADDR_MAX, "%s", cont_name);
+    entry->cont_id = cont_id;
+    total_mem_usage_g += sizeof(uint32_t) + sizeof(pdc_cont_hash_table_entry_t);
+    PDC_Server_obj_id_seq_advance(cont_id);
+
+    if (hash_table_insert(container_hash_table_g, key, entry) != 1) {
+        printf("==PDC_SERVER[%d]: %s - hash table insert failed\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+    ret_value = PDC_Server_container_restore(entry);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
 /*
  * Delete a container by name
  *
@@ -2050,7 +3707,7 @@ PDC_Server_delete_container_by_name(gen_cont_id_in_t *in, gen_cont_id_out_t *out
     pdc_cont_hash_table_entry_t *lookup_value;
 
 #ifdef ENABLE_MULTITHREAD
-    hg_thread_mutex_lock(&pdc_container_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
 #endif
 
     if (container_hash_table_g != NULL) {
@@ -2079,20 +3736,18 @@ PDC_Server_delete_container_by_name(gen_cont_id_in_t *in, gen_cont_id_out_t *out
         goto done;
     }
 
+done:
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_container_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
 #endif
-
-done:
     FUNC_LEAVE(ret_value);
 }
 
 perr_t
 PDC_Server_find_container_by_name(const char *cont_name, pdc_cont_hash_table_entry_t **out)
 {
-    perr_t   ret_value = SUCCEED;
-    uint32_t hash_key;
+    perr_t ret_value = SUCCEED;
 
     FUNC_ENTER(NULL);
     if (NULL == cont_name || NULL == out) {
@@ -2102,14 +3757,13 @@ PDC_Server_find_container_by_name(const char *cont_name, pdc_cont_hash_table_ent
 
     if (container_hash_table_g != NULL) {
         // lookup
-        hash_key = PDC_get_hash_by_name(cont_name);
-        *out     = hash_table_lookup(container_hash_table_g, &hash_key);
-        if (*out != NULL) {
-            // Double check with name match
-            if (strcmp(cont_name, (*out)->cont_name) != 0) {
-                *out = NULL;
-            }
-        }
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_rwlock_rdlock(&pdc_container_hash_table_rwlock_g);
+#endif
+        *out = container_name_index_find(cont_name);
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_rwlock_release_rdlock(&pdc_container_hash_table_rwlock_g);
+#endif
     }
     else {
         printf("container_hash_table_g not initialized!\n");
@@ -2137,11 +3791,7 @@ done:
 static perr_t
 PDC_Server_find_container_by_id(uint64_t cont_id, pdc_cont_hash_table_entry_t **out)
 {
-    perr_t                       ret_value = SUCCEED;
-    pdc_cont_hash_table_entry_t *cont_entry;
-    HashTableIterator            hash_table_iter;
-    int                          n_entry;
-    HashTablePair                pair;
+    perr_t ret_value = SUCCEED;
 
     FUNC_ENTER(NULL);
 
@@ -2150,25 +3800,11 @@ PDC_Server_find_container_by_id(uint64_t cont_id, pdc_cont_hash_table_entry_t **
         goto done;
     }
 
-    if (container_hash_table_g != NULL) {
-        // Since we only have the obj id, need to iterate the entire hash table
-        n_entry = hash_table_num_entries(container_hash_table_g);
-        hash_table_iterate(container_hash_table_g, &hash_table_iter);
-
-        while (n_entry != 0 && hash_table_iter_has_more(&hash_table_iter)) {
-            pair       = hash_table_iter_next(&hash_table_iter);
-            cont_entry = pair.value;
-            if (cont_entry == NULL)
-                continue;
-
-            if (cont_entry->cont_id == cont_id) {
-                *out = cont_entry;
-                goto done;
-            }
-        }
+    if (container_id_hash_table_g != NULL) {
+        *out = hash_table_lookup(container_id_hash_table_g, &cont_id);
     }
     else {
-        printf("==PDC_SERVER[%d]: %s - container_hash_table_g not initialized!\n", pdc_server_rank_g,
+        printf("==PDC_SERVER[%d]: %s - container_id_hash_table_g not initialized!\n", pdc_server_rank_g,
                __func__);
         ret_value = FAIL;
         out       = NULL;
@@ -2181,21 +3817,122 @@ done:
     FUNC_LEAVE(ret_value);
 }
 
+// Home slot of an object ID in the membership set of a container
+static inline uint32_t
+cont_obj_slot_home(pdc_cont_hash_table_entry_t *cont_entry, uint64_t obj_id)
+{
+    return (uint32_t)((obj_id * 0x9E3779B97F4A7C15ULL) >> 32) & (cont_entry->n_slots - 1);
+}
+
+/*
+ * Slot of an object ID in the membership set of a container, or the empty slot where it would be inserted
+ *
+ * \param  cont_entry[IN]     Container entry
+ * \param  obj_id[IN]         Object ID
+ *
+ * \return slot index
+ */
+static uint32_t
+cont_obj_slot_find(pdc_cont_hash_table_entry_t *cont_entry, uint64_t obj_id)
+{
+    uint32_t mask = cont_entry->n_slots - 1;
+    uint32_t slot = cont_obj_slot_home(cont_entry, obj_id);
+    int32_t  pos;
+
+    while ((pos = cont_entry->obj_id_slots[slot]) >= 0 && cont_entry->obj_ids[pos] != obj_id)
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+/*
+ * Rebuild the membership set of a container with a new number of slots (a power of 2)
+ *
+ * \param  cont_entry[IN]     Container entry
+ * \param  n_slots[IN]        Number of slots
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+cont_obj_set_rebuild(pdc_cont_hash_table_entry_t *cont_entry, uint32_t n_slots)
+{
+    perr_t ret_value = SUCCEED;
+    int    i;
+
+    FUNC_ENTER(NULL);
+
+    free(cont_entry->obj_id_slots);
+    total_mem_usage_g -= sizeof(int32_t) * cont_entry->n_slots;
+
+    cont_entry->n_slots      = n_slots;
+    cont_entry->obj_id_slots = (int32_t *)malloc(sizeof(int32_t) * n_slots);
+    if (NULL == cont_entry->obj_id_slots) {
+        printf("==PDC_SERVER[%d]: %s - ERROR with malloc!\n", pdc_server_rank_g, __func__);
+        cont_entry->n_slots = 0;
+        ret_value           = FAIL;
+        goto done;
+    }
+    total_mem_usage_g += sizeof(int32_t) * n_slots;
+    memset(cont_entry->obj_id_slots, -1, sizeof(int32_t) * n_slots);
+
+    for (i = 0; i < cont_entry->n_obj; i++)
+        cont_entry->obj_id_slots[cont_obj_slot_find(cont_entry, cont_entry->obj_ids[i])] = i;
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Empty a slot of the membership set, shifting back the following entries of its probe chain
+ *
+ * \param  cont_entry[IN]     Container entry
+ * \param  slot[IN]           Slot to be emptied
+ *
+ * \return void
+ */
+static void
+cont_obj_slot_remove(pdc_cont_hash_table_entry_t *cont_entry, uint32_t slot)
+{
+    uint32_t mask = cont_entry->n_slots - 1;
+    uint32_t next, home;
+
+    FUNC_ENTER(NULL);
+
+    next = (slot + 1) & mask;
+    while (cont_entry->obj_id_slots[next] >= 0) {
+        home = cont_obj_slot_home(cont_entry, cont_entry->obj_ids[cont_entry->obj_id_slots[next]]);
+        // Move the entry back if its home is not in (slot, next]
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            cont_entry->obj_id_slots[slot] = cont_entry->obj_id_slots[next];
+            slot                           = next;
+        }
+        next = (next + 1) & mask;
+    }
+    cont_entry->obj_id_slots[slot] = -1;
+
+    FUNC_LEAVE_VOID;
+}
+
 perr_t
 PDC_Server_container_add_objs(int n_obj, uint64_t *obj_ids, uint64_t cont_id)
 {
     perr_t                       ret_value    = SUCCEED;
     pdc_cont_hash_table_entry_t *cont_entry   = NULL;
     int                          realloc_size = 0;
+    int                          i, n_dup = 0;
+    uint32_t                     slot, n_slots;
 
     FUNC_ENTER(NULL);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
     ret_value = PDC_Server_find_container_by_id(cont_id, &cont_entry);
 
     if (cont_entry != NULL) {
         // Check if need to allocate space
         if (cont_entry->n_allocated == 0) {
-            cont_entry->n_allocated = PDC_ALLOC_BASE_NUM;
-            cont_entry->obj_ids     = (uint64_t *)calloc(sizeof(uint64_t), PDC_ALLOC_BASE_NUM);
+            cont_entry->n_allocated = PDC_ALLOC_BASE_NUM > n_obj ? PDC_ALLOC_BASE_NUM : n_obj;
+            cont_entry->obj_ids     = (uint64_t *)calloc(sizeof(uint64_t), cont_entry->n_allocated);
             total_mem_usage_g += sizeof(uint64_t) * cont_entry->n_allocated;
         }
         else if (cont_entry->n_allocated < cont_entry->n_obj + n_obj) {
@@ -2221,17 +3958,34 @@ PDC_Server_container_add_objs(int n_obj, uint64_t *obj_ids, uint64_t cont_id)
             total_mem_usage_g += sizeof(uint64_t) * cont_entry->n_allocated;
         }
 
-        // Append the new ids
-        memcpy(cont_entry->obj_ids + cont_entry->n_obj, obj_ids, n_obj * sizeof(uint64_t));
-        cont_entry->n_obj += n_obj;
+        // Keep the membership set at most half full
+        n_slots = cont_entry->n_slots == 0 ? PDC_ALLOC_BASE_NUM : cont_entry->n_slots;
+        while (n_slots < 2 * (uint32_t)(cont_entry->n_obj + n_obj))
+            n_slots *= 2;
+        if (n_slots != cont_entry->n_slots && cont_obj_set_rebuild(cont_entry, n_slots) != SUCCEED) {
+            ret_value = FAIL;
+            goto done;
+        }
+
+        // Append the new ids, skipping the ones already in the container
+        for (i = 0; i < n_obj; i++) {
+            slot = cont_obj_slot_find(cont_entry, obj_ids[i]);
+            if (cont_entry->obj_id_slots[slot] >= 0) {
+                n_dup++;
+                continue;
+            }
+            cont_entry->obj_ids[cont_entry->n_obj] = obj_ids[i];
+            cont_entry->obj_id_slots[slot]         = cont_entry->n_obj;
+            cont_entry->n_obj++;
+        }
+
+        PDC_Server_wal_log_cont_objs(PDC_WAL_CONT_ADD_OBJS, cont_id, n_obj, obj_ids);
 
         // Debug prints
         if (is_debug_g == 1) {
-            printf("==PDC_SERVER[%d]: add %d objects to container %" PRIu64 ", total %d !\n",
-                   pdc_server_rank_g, n_obj, cont_id, cont_entry->n_obj - cont_entry->n_deleted);
+            printf("==PDC_SERVER[%d]: add %d objects (%d duplicates) to container %" PRIu64 ", total %d !\n",
+                   pdc_server_rank_g, n_obj - n_dup, n_dup, cont_id, cont_entry->n_obj);
         }
-
-        // TODO: find duplicates
     }
     else {
         printf("==PDC_SERVER[%d]: %s - container %" PRIu64 " not found!\n", pdc_server_rank_g, __func__,
@@ -2241,6 +3995,9 @@ PDC_Server_container_add_objs(int n_obj, uint64_t *obj_ids, uint64_t cont_id)
     }
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
     fflush(stdout);
     FUNC_LEAVE(ret_value);
 }
@@ -2250,23 +4007,34 @@ PDC_Server_container_del_objs(int n_obj, uint64_t *obj_ids, uint64_t cont_id)
 {
     perr_t                       ret_value  = SUCCEED;
     pdc_cont_hash_table_entry_t *cont_entry = NULL;
-    int                          i, j;
+    int                          i, pos, last;
     int                          n_deletes = 0;
+    uint32_t                     slot;
 
     FUNC_ENTER(NULL);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
     ret_value = PDC_Server_find_container_by_id(cont_id, &cont_entry);
 
     if (cont_entry != NULL) {
-        for (i = 0; i < n_obj; i++) {
-            for (j = 0; j < cont_entry->n_obj; j++) {
-                if (cont_entry->obj_ids[j] == obj_ids[i]) {
-                    cont_entry->obj_ids[j] = 0;
-                    cont_entry->n_deleted++;
-                    n_deletes++;
-                    break;
-                }
+        for (i = 0; i < n_obj && cont_entry->n_slots > 0; i++) {
+            slot = cont_obj_slot_find(cont_entry, obj_ids[i]);
+            pos  = cont_entry->obj_id_slots[slot];
+            if (pos < 0)
+                continue;
+            cont_obj_slot_remove(cont_entry, slot);
+
+            // Fill the hole with the last member so obj_ids stays compact
+            last = cont_entry->n_obj - 1;
+            if (pos != last) {
+                cont_entry->obj_ids[pos] = cont_entry->obj_ids[last];
+                cont_entry->obj_id_slots[cont_obj_slot_find(cont_entry, cont_entry->obj_ids[pos])] = pos;
             }
+            cont_entry->n_obj--;
+            n_deletes++;
         }
+        PDC_Server_wal_log_cont_objs(PDC_WAL_CONT_DEL_OBJS, cont_id, n_obj, obj_ids);
         // Debug print
         printf("==PDC_SERVER[%d]: successfully deleted %d objects!\n", pdc_server_rank_g, n_deletes);
 
@@ -2283,11 +4051,50 @@ PDC_Server_container_del_objs(int n_obj, uint64_t *obj_ids, uint64_t cont_id)
     }
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
     fflush(stdout);
 
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Rebuild the membership set of a container restored from a checkpoint, and add it to the ID index
+ *
+ * \param  cont_entry[IN]     Container entry with obj_ids and n_obj restored
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t
+PDC_Server_container_restore(pdc_cont_hash_table_entry_t *cont_entry)
+{
+    perr_t   ret_value = SUCCEED;
+    uint32_t n_slots   = PDC_ALLOC_BASE_NUM;
+
+    FUNC_ENTER(NULL);
+
+    cont_entry->n_slots      = 0;
+    cont_entry->obj_id_slots = NULL;
+    if (cont_entry->n_obj > 0) {
+        while (n_slots < 2 * (uint32_t)cont_entry->n_obj)
+            n_slots *= 2;
+        ret_value = cont_obj_set_rebuild(cont_entry, n_slots);
+        if (ret_value != SUCCEED)
+            goto done;
+    }
+
+    if (hash_table_insert(container_id_hash_table_g, &cont_entry->cont_id, cont_entry) != 1) {
+        printf("==PDC_SERVER[%d]: %s - ID index insert failed\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+        goto done;
+    }
+    container_name_index_insert(cont_entry);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Server_container_add_tags(uint64_t cont_id, char *tags)
 {
@@ -2295,12 +4102,16 @@ PDC_Server_container_add_tags(uint64_t cont_id, char *tags)
     pdc_cont_hash_table_entry_t *cont_entry = NULL;
 
     FUNC_ENTER(NULL);
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
     ret_value = PDC_Server_find_container_by_id(cont_id, &cont_entry);
 
     if (cont_entry != NULL) {
 
         if (tags != NULL) {
             strcat(cont_entry->tags, tags);
+            PDC_Server_wal_log_cont_tags(cont_id, tags);
         }
     }
     else {
@@ -2311,6 +4122,9 @@ PDC_Server_container_add_tags(uint64_t cont_id, char *tags)
     }
 
 done:
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_rwlock_release_wrlock(&pdc_container_hash_table_rwlock_g);
+#endif
     fflush(stdout);
 
     FUNC_LEAVE(ret_value);
@@ -2497,6 +4311,12 @@ PDC_Server_query_read_names_clinet_cb(const struct hg_cb_info *callback_info)
 perr_t
 PDC_free_cont_hash_table()
 {
+#ifndef DISABLE_SWISS_TABLE
+    pdc_swiss_table_free(container_name_index_g);
+    container_name_index_g = NULL;
+#endif
+    if (container_id_hash_table_g != NULL)
+        hash_table_free(container_id_hash_table_g);
     if (container_hash_table_g != NULL)
         hash_table_free(container_hash_table_g);
     return SUCCEED;
@@ -2527,6 +4347,49 @@ PDC_add_kvtag_to_list(pdc_kvtag_list_t **list_head, pdc_kvtag_t *tag)
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Add a kvtag to an object or container, with the metadata write lock held
+ *
+ * \param  hash_key[IN]     Hash value of the object or container name
+ * \param  obj_id[IN]       Object or container ID
+ * \param  kvtag[IN]        Tag, copied
+ *
+ * \return Non-negative on success/Negative if the target is not found
+ */
+static perr_t
+kvtag_add_locked(uint32_t hash_key, uint64_t obj_id, pdc_kvtag_t *kvtag)
+{
+    perr_t                       ret_value = SUCCEED;
+    pdc_hash_table_entry_head *  lookup_value;
+    pdc_cont_hash_table_entry_t *cont_lookup_value;
+    pdc_metadata_t *             target;
+
+    FUNC_ENTER(NULL);
+
+    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
+    if (lookup_value != NULL) {
+        target = find_metadata_by_id_from_list(lookup_value->metadata, obj_id);
+        if (target == NULL)
+            PGOTO_DONE(FAIL);
+        PDC_Server_meta_store_load(target);
+        PDC_add_kvtag_to_list(&target->kvtag_list_head, kvtag);
+        PDC_Server_meta_store_touch(target);
+        kvtag_index_add(kvtag, obj_id);
+    }
+    else { // look for containers
+        cont_lookup_value = hash_table_lookup(container_hash_table_g, &hash_key);
+        if (cont_lookup_value == NULL) {
+            printf("==PDC_SERVER[%d]: add tag target %" PRIu64 " not found!\n", pdc_server_rank_g, obj_id);
+            PGOTO_DONE(FAIL);
+        }
+        PDC_add_kvtag_to_list(&cont_lookup_value->kvtag_list_head, kvtag);
+    }
+    PDC_Server_wal_log_kvtag_add(hash_key, obj_id, kvtag);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Server_add_kvtag(metadata_add_kvtag_in_t *in, metadata_add_tag_out_t *out)
 {
@@ -2537,8 +4400,6 @@ PDC_Server_add_kvtag(metadata_add_kvtag_in_t *in, metadata_add_tag_out_t *out)
 #ifdef ENABLE_MULTITHREAD
     int unlocked;
 #endif
-    pdc_hash_table_entry_head *  lookup_value;
-    pdc_cont_hash_table_entry_t *cont_lookup_value;
 
     FUNC_ENTER(NULL);
 
@@ -2555,40 +4416,15 @@ PDC_Server_add_kvtag(metadata_add_kvtag_in_t *in, metadata_add_tag_out_t *out)
 #ifdef ENABLE_MULTITHREAD
     // Obtain lock for hash table
     unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
-    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
-    if (lookup_value != NULL) {
-        pdc_metadata_t *target;
-        target = find_metadata_by_id_from_list(lookup_value->metadata, obj_id);
-        if (target != NULL) {
-            PDC_add_kvtag_to_list(&target->kvtag_list_head, &in->kvtag);
-            out->ret = 1;
-        } // if (lookup_value != NULL)
-        else {
-            // Object not found
-            ret_value = FAIL;
-            out->ret  = -1;
-        }
-
-    }      // if lookup_value != NULL
-    else { // look for containers
-        cont_lookup_value = hash_table_lookup(container_hash_table_g, &hash_key);
-        if (cont_lookup_value != NULL) {
-            PDC_add_kvtag_to_list(&cont_lookup_value->kvtag_list_head, &in->kvtag);
-            out->ret = 1;
-        }
-        else {
-            printf("==PDC_SERVER[%d]: add tag target %" PRIu64 " not found!\n", pdc_server_rank_g, obj_id);
-            ret_value = FAIL;
-            out->ret  = -1;
-        }
-    }
+    ret_value = kvtag_add_locked(hash_key, obj_id, &in->kvtag);
+    out->ret  = ret_value == SUCCEED ? 1 : -1;
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
     unlocked = 1;
 #endif
 
@@ -2612,7 +4448,7 @@ PDC_Server_add_kvtag(metadata_add_kvtag_in_t *in, metadata_add_tag_out_t *out)
 
 #ifdef ENABLE_MULTITHREAD
     if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+        hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
     fflush(stdout);
 
@@ -2642,18 +4478,72 @@ PDC_get_kvtag_value_from_list(pdc_kvtag_list_t **list_head, char *key, metadata_
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Find a kvtag of an object or container, with the metadata read lock held
+ *
+ * \param  hash_key[IN]     Hash value of the object or container name
+ * \param  obj_id[IN]       Object or container ID
+ * \param  key[IN]          Tag name
+ * \param  out[OUT]         Tag name, size and value, left as is if the target has no such tag
+ * \param  tmp_list[OUT]    Set if out points into a copy of the list read from the metadata store, to be
+ *                          freed with PDC_Server_meta_store_free_list once out is used
+ *
+ * \return Non-negative on success/Negative if the target is not found
+ */
+static perr_t
+kvtag_get_locked(uint32_t hash_key, uint64_t obj_id, char *key, metadata_get_kvtag_out_t *out,
+                 pdc_kvtag_list_t **tmp_list)
+{
+    perr_t                       ret_value = SUCCEED;
+    pdc_hash_table_entry_head *  lookup_value;
+    pdc_cont_hash_table_entry_t *cont_lookup_value;
+    pdc_metadata_t *             target;
+    pdc_kvtag_list_t *           kvtag_list;
+    int                          is_copy;
+
+    FUNC_ENTER(NULL);
+
+    *tmp_list    = NULL;
+    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
+    if (lookup_value != NULL) {
+        target = find_metadata_by_id_from_list(lookup_value->metadata, obj_id);
+        if (target == NULL)
+            PGOTO_DONE(FAIL);
+        kvtag_list = PDC_Server_meta_store_get(target, &is_copy);
+        PDC_get_kvtag_value_from_list(&kvtag_list, key, out);
+        if (is_copy)
+            *tmp_list = kvtag_list;
+    }
+    else {
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_rwlock_rdlock(&pdc_container_hash_table_rwlock_g);
+#endif
+        cont_lookup_value = hash_table_lookup(container_hash_table_g, &hash_key);
+        if (cont_lookup_value != NULL)
+            PDC_get_kvtag_value_from_list(&cont_lookup_value->kvtag_list_head, key, out);
+        else
+            ret_value = FAIL;
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_rwlock_release_rdlock(&pdc_container_hash_table_rwlock_g);
+#endif
+    }
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Server_get_kvtag(metadata_get_kvtag_in_t *in, metadata_get_kvtag_out_t *out)
 {
 
-    perr_t   ret_value = SUCCEED;
-    uint32_t hash_key;
-    uint64_t obj_id;
+    perr_t            ret_value = SUCCEED;
+    uint32_t          hash_key;
+    uint64_t          obj_id;
+    pdc_kvtag_list_t *tmp_list;
+    void *            value;
 #ifdef ENABLE_MULTITHREAD
     int unlocked;
 #endif
-    pdc_hash_table_entry_head *  lookup_value;
-    pdc_cont_hash_table_entry_t *cont_lookup_value;
 
     FUNC_ENTER(NULL);
 
@@ -2668,36 +4558,23 @@ PDC_Server_get_kvtag(metadata_get_kvtag_in_t *in, metadata_get_kvtag_out_t *out)
     obj_id   = in->obj_id;
 
 #ifdef ENABLE_MULTITHREAD
-    // Obtain lock for hash table
+    // Obtain read lock for hash table, gets of different objects run concurrently
     unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
-    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
-    if (lookup_value != NULL) {
-        pdc_metadata_t *target;
-        target = find_metadata_by_id_from_list(lookup_value->metadata, obj_id);
-        if (target != NULL) {
-            PDC_get_kvtag_value_from_list(&target->kvtag_list_head, in->key, out);
-            out->ret = 1;
-        }
-        else {
-            ret_value = FAIL;
-            out->ret  = -1;
-        }
-    }
-    else {
+    ret_value = kvtag_get_locked(hash_key, obj_id, in->key, out, &tmp_list);
+    out->ret  = ret_value == SUCCEED ? 1 : -1;
 
-        cont_lookup_value = hash_table_lookup(container_hash_table_g, &hash_key);
-        if (cont_lookup_value != NULL) {
-            PDC_get_kvtag_value_from_list(&cont_lookup_value->kvtag_list_head, in->key, out);
-            out->ret = 1;
-        }
-        else {
-            ret_value = FAIL;
-            out->ret  = -1;
-        }
+    // The response is sent after the lock is released, from a copy that the handler frees
+    if (out->kvtag.name != NULL) {
+        value = malloc(out->kvtag.size);
+        if (value != NULL)
+            memcpy(value, out->kvtag.value, out->kvtag.size);
+        out->kvtag.name  = strdup(out->kvtag.name);
+        out->kvtag.value = value;
     }
+    PDC_Server_meta_store_free_list(tmp_list);
 
     if (ret_value != SUCCEED) {
         printf("==PDC_SERVER[%d]: %s - error \n", pdc_server_rank_g, __func__);
@@ -2706,7 +4583,7 @@ PDC_Server_get_kvtag(metadata_get_kvtag_in_t *in, metadata_get_kvtag_out_t *out)
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
     unlocked = 1;
 #endif
 
@@ -2731,7 +4608,7 @@ PDC_Server_get_kvtag(metadata_get_kvtag_in_t *in, metadata_get_kvtag_out_t *out)
 done:
 #ifdef ENABLE_MULTITHREAD
     if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+        hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
     fflush(stdout);
 
@@ -2763,6 +4640,74 @@ PDC_del_kvtag_value_from_list(pdc_kvtag_list_t **list_head, char *key)
     FUNC_LEAVE(ret_value);
 }
 
+/*
+ * Drop an object from the inverted index entry of the kvtag that is about to be deleted,
+ * unless the object has another tag with the same name and value
+ *
+ * \param  metadata[IN]     Metadata of the object
+ * \param  key[IN]          Name of the kvtag to be deleted
+ *
+ * \return void
+ */
+static void
+kvtag_index_del_obj_tag(pdc_metadata_t *metadata, char *key)
+{
+    pdc_kvtag_list_t *elt, *target = NULL;
+
+    FUNC_ENTER(NULL);
+
+    DL_FOREACH(metadata->kvtag_list_head, elt)
+    {
+        if (strcmp(elt->kvtag->name, key) != 0)
+            continue;
+        if (target == NULL)
+            target = elt;
+        else if (elt->kvtag->size == target->kvtag->size &&
+                 memcmp(elt->kvtag->value, target->kvtag->value, elt->kvtag->size) == 0)
+            goto done;
+    }
+
+    if (target != NULL)
+        kvtag_index_remove(target->kvtag, metadata->obj_id);
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Delete a kvtag from an object, with the metadata write lock held
+ *
+ * \param  hash_key[IN]     Hash value of the object name
+ * \param  obj_id[IN]       Object ID
+ * \param  key[IN]          Tag name
+ *
+ * \return Non-negative on success/Negative if the object is not found
+ */
+static perr_t
+kvtag_del_locked(uint32_t hash_key, uint64_t obj_id, char *key)
+{
+    perr_t                     ret_value = SUCCEED;
+    pdc_hash_table_entry_head *lookup_value;
+    pdc_metadata_t *           target = NULL;
+
+    FUNC_ENTER(NULL);
+
+    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
+    if (lookup_value != NULL)
+        target = find_metadata_by_id_from_list(lookup_value->metadata, obj_id);
+    if (target == NULL)
+        PGOTO_DONE(FAIL);
+
+    PDC_Server_meta_store_load(target);
+    kvtag_index_del_obj_tag(target, key);
+    PDC_del_kvtag_value_from_list(&target->kvtag_list_head, key);
+    PDC_Server_meta_store_touch(target);
+    PDC_Server_wal_log_kvtag_del(hash_key, obj_id, key);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
 perr_t
 PDC_Server_del_kvtag(metadata_get_kvtag_in_t *in, metadata_add_tag_out_t *out)
 {
@@ -2773,7 +4718,6 @@ PDC_Server_del_kvtag(metadata_get_kvtag_in_t *in, metadata_add_tag_out_t *out)
 #ifdef ENABLE_MULTITHREAD
     int unlocked;
 #endif
-    pdc_hash_table_entry_head *lookup_value;
 
     FUNC_ENTER(NULL);
 
@@ -2790,26 +4734,11 @@ PDC_Server_del_kvtag(metadata_get_kvtag_in_t *in, metadata_add_tag_out_t *out)
 #ifdef ENABLE_MULTITHREAD
     // Obtain lock for hash table
     unlocked = 0;
-    hg_thread_mutex_lock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
 
-    lookup_value = hash_table_lookup(metadata_hash_table_g, &hash_key);
-    if (lookup_value != NULL) {
-        pdc_metadata_t *target;
-        target = find_metadata_by_id_from_list(lookup_value->metadata, obj_id);
-        if (target != NULL) {
-            PDC_del_kvtag_value_from_list(&target->kvtag_list_head, in->key);
-            out->ret = 1;
-        }
-        else {
-            ret_value = FAIL;
-            out->ret  = -1;
-        }
-    }
-    else {
-        ret_value = FAIL;
-        out->ret  = -1;
-    }
+    ret_value = kvtag_del_locked(hash_key, obj_id, in->key);
+    out->ret  = ret_value == SUCCEED ? 1 : -1;
 
     if (ret_value != SUCCEED) {
         printf("==PDC_SERVER[%d]: %s - error \n", pdc_server_rank_g, __func__);
@@ -2818,7 +4747,7 @@ PDC_Server_del_kvtag(metadata_get_kvtag_in_t *in, metadata_add_tag_out_t *out)
 
 #ifdef ENABLE_MULTITHREAD
     // ^ Release hash table lock
-    hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+    hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
     unlocked = 1;
 #endif
 
@@ -2843,9 +4772,130 @@ PDC_Server_del_kvtag(metadata_get_kvtag_in_t *in, metadata_add_tag_out_t *out)
 done:
 #ifdef ENABLE_MULTITHREAD
     if (unlocked == 0)
-        hg_thread_mutex_unlock(&pdc_metadata_hash_table_mutex_g);
+        hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
 #endif
     fflush(stdout);
 
     FUNC_LEAVE(ret_value);
 }
+
+// Copy data into the response buffer if it still fits, the offset advances regardless
+static void
+kvtag_many_put_resp(char *resp, uint64_t resp_capacity, uint64_t *off, const void *data, uint64_t size)
+{
+    if (*off + size <= resp_capacity && size > 0)
+        memcpy(resp + *off, data, size);
+    *off += size;
+}
+
+perr_t
+PDC_Server_kvtag_many(int32_t op, uint32_t n_entry, const char *req, uint64_t req_size, char *resp,
+                      uint64_t resp_capacity, uint32_t *n_done, uint64_t *resp_size)
+{
+    perr_t                   ret_value = SUCCEED;
+    const char *             pos = req, *end = req + req_size;
+    kvtag_many_entry_t       entry;
+    pdc_kvtag_t              kvtag;
+    metadata_get_kvtag_out_t get_out;
+    pdc_kvtag_list_t *       tmp_list;
+    uint64_t                 off = 0;
+    uint32_t                 i, value_size;
+    int32_t                  status;
+
+    FUNC_ENTER(NULL);
+
+#ifdef ENABLE_TIMING
+    struct timeval pdc_timer_start;
+    struct timeval pdc_timer_end;
+    double         ht_total_sec;
+    gettimeofday(&pdc_timer_start, 0);
+#endif
+
+    *n_done = 0;
+    if (op != PDC_KVTAG_MANY_ADD && op != PDC_KVTAG_MANY_GET && op != PDC_KVTAG_MANY_DEL)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: %s - invalid operation %d", pdc_server_rank_g, __func__, op);
+
+#ifdef ENABLE_MULTITHREAD
+    if (op == PDC_KVTAG_MANY_GET)
+        hg_thread_rwlock_rdlock(&pdc_metadata_hash_table_rwlock_g);
+    else
+        hg_thread_rwlock_wrlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+
+    for (i = 0; i < n_entry; i++) {
+        if ((uint64_t)(end - pos) < sizeof(kvtag_many_entry_t)) {
+            ret_value = FAIL;
+            break;
+        }
+        memcpy(&entry, pos, sizeof(kvtag_many_entry_t));
+        pos += sizeof(kvtag_many_entry_t);
+        if (op != PDC_KVTAG_MANY_ADD)
+            entry.value_size = 0;
+        if (entry.name_len == 0 || (uint64_t)(end - pos) < (uint64_t)entry.name_len + entry.value_size ||
+            pos[entry.name_len - 1] != '\0') {
+            ret_value = FAIL;
+            break;
+        }
+        kvtag.name  = (char *)pos;
+        kvtag.size  = entry.value_size;
+        kvtag.value = (void *)(pos + entry.name_len);
+        pos += entry.name_len + entry.value_size;
+
+        if (op == PDC_KVTAG_MANY_ADD)
+            status = kvtag_add_locked(entry.hash_value, entry.obj_id, &kvtag) == SUCCEED ? 1 : -1;
+        else if (op == PDC_KVTAG_MANY_DEL)
+            status = kvtag_del_locked(entry.hash_value, entry.obj_id, kvtag.name) == SUCCEED ? 1 : -1;
+        else {
+            memset(&get_out, 0, sizeof(get_out));
+            tmp_list = NULL;
+            if (kvtag_get_locked(entry.hash_value, entry.obj_id, kvtag.name, &get_out, &tmp_list) != SUCCEED)
+                status = -1;
+            else
+                status = get_out.kvtag.name != NULL ? 1 : 0;
+        }
+        if (status == 1)
+            (*n_done)++;
+
+        kvtag_many_put_resp(resp, resp_capacity, &off, &status, sizeof(int32_t));
+        if (op == PDC_KVTAG_MANY_GET) {
+            // The values are copied out before the lock is released
+            value_size = status == 1 ? (uint32_t)get_out.kvtag.size : 0;
+            kvtag_many_put_resp(resp, resp_capacity, &off, &value_size, sizeof(uint32_t));
+            kvtag_many_put_resp(resp, resp_capacity, &off, get_out.kvtag.value, value_size);
+            PDC_Server_meta_store_free_list(tmp_list);
+        }
+    }
+
+#ifdef ENABLE_MULTITHREAD
+    if (op == PDC_KVTAG_MANY_GET)
+        hg_thread_rwlock_release_rdlock(&pdc_metadata_hash_table_rwlock_g);
+    else
+        hg_thread_rwlock_release_wrlock(&pdc_metadata_hash_table_rwlock_g);
+#endif
+
+    *resp_size = off;
+    if (ret_value != SUCCEED)
+        PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: %s - malformed entry %u of %u", pdc_server_rank_g, __func__, i,
+                    n_entry);
+
+#ifdef ENABLE_TIMING
+    gettimeofday(&pdc_timer_end, 0);
+    ht_total_sec = PDC_get_elapsed_time_double(&pdc_timer_start, &pdc_timer_end);
+#endif
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_time_mutex_g);
+#endif
+
+#ifdef ENABLE_TIMING
+    server_update_time_g += ht_total_sec;
+#endif
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_time_mutex_g);
+#endif
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
@@ -33,11 +33,14 @@
 #include "mercury_atomic.h"
 
 #include "pdc_hash-table.h"
+#include "pdc_skip_list.h"
 
 #include "pdc_server_common.h"
 #include "pdc_client_server_common.h"
 
 #define CREATE_BLOOM_THRESHOLD 64
+// Target false positive rate of the per-entry bloom filters, only kept when built with DISABLE_SWISS_TABLE
+#define BLOOM_ERROR_RATE 0.01
 
 /*****************************/
 /* Library-private Variables */
@@ -47,7 +50,10 @@ extern int           pdc_server_size_g;
 extern char          pdc_server_tmp_dir_g[ADDR_MAX];
 extern uint32_t      n_metadata_g;
 extern HashTable *   metadata_hash_table_g;
+extern HashTable *   metadata_id_hash_table_g;
+extern HashTable *   kvtag_index_hash_table_g;
 extern HashTable *   container_hash_table_g;
+extern HashTable *   container_id_hash_table_g;
 extern hg_class_t *  hg_class_g;
 extern hg_context_t *hg_context_g;
 extern int           is_debug_g;
@@ -78,8 +84,45 @@ typedef struct pdc_cont_hash_table_entry_t {
     uint64_t *        obj_ids;
     char              tags[TAG_LEN_MAX];
     pdc_kvtag_list_t *kvtag_list_head;
+    // Open addressing set over obj_ids, each slot is an index into obj_ids or -1 if empty
+    int32_t *obj_id_slots;
+    uint32_t n_slots;
 } pdc_cont_hash_table_entry_t;
 
+// Objects that have a kvtag with one name and value, obj_ids is keyed by object ID
+typedef struct pdc_kvtag_posting_t {
+    uint32_t         size;
+    void *           value;
+    pdc_skip_list_t *obj_ids;
+} pdc_kvtag_posting_t;
+
+typedef struct pdc_kvtag_num_key_t {
+    double               key;
+    pdc_kvtag_posting_t *posting;
+} pdc_kvtag_num_key_t;
+
+// Inverted index of one kvtag name
+typedef struct pdc_kvtag_index_t {
+    char *name;
+    // value -> posting, for exact matches
+    HashTable *postings;
+    // postings in byte order of the value, for prefix and non-numeric range matches
+    pdc_kvtag_posting_t **sorted;
+    uint32_t              n_sorted;
+    uint32_t              n_sorted_alloc;
+    // postings in numeric order, built on the first range query with that type
+    pdc_kvtag_num_key_t *num[NCLASSES];
+    uint32_t             n_num[NCLASSES];
+    uint32_t             n_num_alloc[NCLASSES];
+} pdc_kvtag_index_t;
+
+// Objects sharing one value of an attribute used by partial queries, meta is keyed by object ID
+typedef struct pdc_query_posting_t {
+    char *           key; // app name or tag, NULL in the user ID and ndim indexes
+    int              user_id;
+    pdc_skip_list_t *meta;
+} pdc_query_posting_t;
+
 /***************************************/
 /* Library-private Function Prototypes */
 /***************************************/
@@ -93,6 +136,22 @@ typedef struct pdc_cont_hash_table_entry_t {
  */
 perr_t PDC_insert_metadata_to_hash_table(gen_obj_id_in_t *in, gen_obj_id_out_t *out);
 
+/**
+ * Insert a batch of objects sharing one set of properties to the hash table, holding the hash table
+ * lock once for the whole batch
+ *
+ * \param in [IN]               Input structure received from client, contains the shared properties
+ * \param n_obj [IN]            Number of objects in the batch
+ * \param hash_values [IN]      Hash value of each object name
+ * \param obj_names [IN]        Name of each object
+ * \param obj_ids [OUT]         Generated object IDs, 0 for objects that were not created
+ * \param n_created [OUT]       Number of objects created
+ *
+ * \return Non-negative if all objects were created/Negative otherwise
+ */
+perr_t PDC_Server_create_objs_batch(gen_obj_id_many_in_t *in, uint32_t n_obj, const uint32_t *hash_values,
+                                    char **obj_names, uint64_t *obj_ids, uint32_t *n_created);
+
 /**
  * Metadata server process buffer map
  *
@@ -159,16 +218,24 @@ perr_t PDC_Server_search_with_name_timestep(const char *obj_name, uint32_t hash_
                                             pdc_metadata_t **out);
 
 /**
- * Get the metadata that satisfies the query constraint
+ * Serialize one page of the metadata that satisfies the query constraint
  *
  * \param in [IN]               Input structure from client that contains the query constraint
- * \param n_meta [OUT]          Number of metadata that satisfies the query constraint
- * \param buf_ptrs [OUT]        Pointers to the found metadata
+ * \param cursor [IN]           Position to resume from, 0 for the first page
+ * \param cursor_minor [IN]     Second part of the position, for queries paged by a composite key
+ * \param buf [IN]              Buffer the metadata are serialized into
+ * \param buf_size [IN]         Size of the buffer
+ * \param n_meta [OUT]          Number of metadata in the page
+ * \param nbytes [OUT]          Serialized size of the page
+ * \param next_cursor [OUT]     Position of the next page, 0 if there is none
+ * \param next_cursor_minor [OUT] Second part of the position of the next page
  *
  * \return Non-negative on success/Negative on failure
  */
-perr_t PDC_Server_get_partial_query_result(metadata_query_transfer_in_t *in, uint32_t *n_meta,
-                                           void ***buf_ptrs);
+perr_t PDC_Server_get_partial_query_page(metadata_query_transfer_in_t *in, uint64_t cursor,
+                                         uint64_t cursor_minor, char *buf, uint64_t buf_size,
+                                         uint32_t *n_meta, uint64_t *nbytes, uint64_t *next_cursor,
+                                         uint64_t *next_cursor_minor);
 
 /**
  * Get the metadata that satisfies the query constraint
@@ -179,7 +246,28 @@ perr_t PDC_Server_get_partial_query_result(metadata_query_transfer_in_t *in, uin
  *
  * \return Non-negative on success/Negative on failure
  */
-perr_t PDC_Server_get_kvtag_query_result(pdc_kvtag_t *in, uint32_t *n_meta, uint64_t **buf_ptrs);
+perr_t PDC_Server_get_kvtag_query_result(kvtag_query_in_t *in, uint32_t *n_meta, uint64_t **buf_ptrs);
+
+/**
+ * Free the kvtag inverted index
+ *
+ * \return void
+ */
+void PDC_Server_kvtag_index_free();
+
+/**
+ * Free the secondary indexes of partial queries
+ *
+ * \return void
+ */
+void PDC_Server_query_index_free();
+
+/**
+ * Free the metadata name index
+ *
+ * \return void
+ */
+void PDC_Server_name_index_free();
 
 /**
  * Get the kvtag with the given key
@@ -201,6 +289,23 @@ perr_t PDC_Server_get_kvtag(metadata_get_kvtag_in_t *in, metadata_get_kvtag_out_
  */
 perr_t PDC_Server_del_kvtag(metadata_get_kvtag_in_t *in, metadata_add_tag_out_t *out);
 
+/**
+ * Add, get or delete a batch of kvtags, holding the hash table lock once for the whole batch
+ *
+ * \param op [IN]               PDC_KVTAG_MANY_ADD, PDC_KVTAG_MANY_GET or PDC_KVTAG_MANY_DEL
+ * \param n_entry [IN]          Number of entries in the request
+ * \param req [IN]              Entries, laid out as described at kvtag_many_in_t
+ * \param req_size [IN]         Size of req in bytes
+ * \param resp [OUT]            Buffer for the responses
+ * \param resp_capacity [IN]    Size of resp in bytes
+ * \param n_done [OUT]          Number of entries that succeeded
+ * \param resp_size [OUT]       Size of the responses in bytes, only written if not above resp_capacity
+ *
+ * \return Non-negative on success/Negative if the request is malformed
+ */
+perr_t PDC_Server_kvtag_many(int32_t op, uint32_t n_entry, const char *req, uint64_t req_size, char *resp,
+                             uint64_t resp_capacity, uint32_t *n_done, uint64_t *resp_size);
+
 /**
  * Wrapper function of find_metadata_by_id().
  *
@@ -220,6 +325,47 @@ pdc_metadata_t *PDC_Server_get_obj_metadata(pdcid_t obj_id);
  */
 perr_t PDC_Server_delete_metadata_by_id(metadata_delete_by_id_in_t *in, metadata_delete_by_id_out_t *out);
 
+/**
+ * Insert metadata logged in the write-ahead log, keeping its object ID. Metadata of an object that
+ * already exists is freed.
+ *
+ * \param hash_key [IN]         Hash value of object name
+ * \param metadata [IN]         Allocated metadata, owned by the hash table afterwards. Its strings may
+ *                              point into the log record, the hash table keeps its own copies
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_metadata_restore(uint32_t hash_key, pdc_metadata_t *metadata);
+
+/**
+ * Set the strings of a metadata record. The app name and data location are interned, the object name
+ * and tags are copied for the record and freed with PDC_Server_metadata_free_strings.
+ *
+ * \param metadata [IN]         Metadata record
+ * \param app_name [IN]         Application name
+ * \param obj_name [IN]         Object name
+ * \param tags [IN]             Tags
+ * \param data_location [IN]    Data location
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_metadata_set_strings(pdc_metadata_t *metadata, const char *app_name, const char *obj_name,
+                                       const char *tags, const char *data_location);
+
+/**
+ * Free the object name and tags of a metadata record
+ *
+ * \param metadata [IN]         Metadata record
+ */
+void PDC_Server_metadata_free_strings(pdc_metadata_t *metadata);
+
+/**
+ * Make sure IDs allocated later are past an ID restored from a checkpoint or the log
+ *
+ * \param obj_id [IN]           Restored object or container ID
+ */
+void PDC_Server_obj_id_seq_advance(uint64_t obj_id);
+
 /**
  * Create a container
  *
@@ -230,6 +376,17 @@ perr_t PDC_Server_delete_metadata_by_id(metadata_delete_by_id_in_t *in, metadata
  */
 perr_t PDC_Server_create_container(gen_cont_id_in_t *in, gen_cont_id_out_t *out);
 
+/**
+ * Recreate a container logged in the write-ahead log, keeping its container ID
+ *
+ * \param hash_key [IN]         Hash value of container name
+ * \param cont_name [IN]        Container name
+ * \param cont_id [IN]          Container ID
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_restore_container(uint32_t hash_key, const char *cont_name, uint64_t cont_id);
+
 /**
  * Search a container by name
  *
@@ -312,7 +469,7 @@ perr_t PDC_Server_hash_table_list_init(pdc_hash_table_entry_head *entry, uint32_
 perr_t PDC_Server_hash_table_list_insert(pdc_hash_table_entry_head *head, pdc_metadata_t *new);
 
 /**
- * Get the metadata with the specified object ID by iteration of all metadata in the hash table
+ * Get the metadata with the specified object ID from the object ID index
  *
  * \param obj_id [IN]           Object ID
  *
@@ -367,6 +524,15 @@ perr_t PDC_Server_container_add_tags(uint64_t cont_id, char *tags);
  */
 perr_t PDC_free_cont_hash_table();
 
+/**
+ * Rebuild the object membership set of a container restored from a checkpoint, and index it by ID
+ *
+ * \param cont_entry [IN]       Container entry with its obj_ids and n_obj restored
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_container_restore(pdc_cont_hash_table_entry_t *cont_entry);
+
 /**
  * Add the kvtag received from one client to the corresponding metadata structure
  *
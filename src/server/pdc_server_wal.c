@@ -0,0 +1,860 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <inttypes.h>
+
+#include "pdc_config.h"
+#include "pdc_utlist.h"
+#include "pdc_client_server_common.h"
+#include "pdc_server_metadata.h"
+#include "pdc_server_data.h"
+#include "pdc_server_wal.h"
+#include "pdc_server.h"
+
+// Log file, NULL while logging is disabled, e.g. during replay
+static FILE *pdc_wal_file_g = NULL;
+static char  pdc_wal_path_g[ADDR_MAX];
+// Log segment retired by PDC_Server_wal_rotate, kept until a snapshot covering it is on disk
+static char pdc_wal_old_path_g[ADDR_MAX + 4];
+// Records not committed yet
+static char * pdc_wal_buf_g       = NULL;
+static size_t pdc_wal_buf_size_g  = 0;
+static size_t pdc_wal_buf_alloc_g = 0;
+// Committed bytes in the log file
+static size_t   pdc_wal_file_size_g = 0;
+static uint64_t pdc_wal_lsn_g       = 0;
+#ifdef ENABLE_MULTITHREAD
+static hg_thread_mutex_t pdc_wal_mutex_g;
+#endif
+
+uint32_t
+PDC_Server_checksum(const void *buf, size_t size)
+{
+    const unsigned char *p    = (const unsigned char *)buf;
+    uint32_t             hash = 2166136261u;
+    size_t               i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * Start a record of size bytes of payload in the buffer, the log lock is held until wal_record_end
+ *
+ * \param  op[IN]           Record type
+ * \param  size[IN]         Payload size
+ *
+ * \return Pointer to the payload/NULL if logging is disabled or on failure
+ */
+static char *
+wal_record_begin(pdc_wal_op_t op, size_t size)
+{
+    char *                   ret_value = NULL;
+    pdc_wal_record_header_t *header;
+    size_t                   new_alloc;
+    char *                   new_buf;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_wal_file_g == NULL)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_wal_mutex_g);
+#endif
+    if (pdc_wal_buf_size_g + sizeof(pdc_wal_record_header_t) + size > pdc_wal_buf_alloc_g) {
+        new_alloc = pdc_wal_buf_alloc_g == 0 ? PDC_WAL_GROUP_COMMIT_SIZE : pdc_wal_buf_alloc_g;
+        while (new_alloc < pdc_wal_buf_size_g + sizeof(pdc_wal_record_header_t) + size)
+            new_alloc *= 2;
+        new_buf = (char *)realloc(pdc_wal_buf_g, new_alloc);
+        if (new_buf == NULL) {
+            printf("==PDC_SERVER[%d]: %s - cannot grow log buffer\n", pdc_server_rank_g, __func__);
+#ifdef ENABLE_MULTITHREAD
+            hg_thread_mutex_unlock(&pdc_wal_mutex_g);
+#endif
+            goto done;
+        }
+        pdc_wal_buf_g       = new_buf;
+        pdc_wal_buf_alloc_g = new_alloc;
+    }
+
+    header           = (pdc_wal_record_header_t *)(pdc_wal_buf_g + pdc_wal_buf_size_g);
+    header->lsn      = ++pdc_wal_lsn_g;
+    header->op       = op;
+    header->size     = (uint32_t)size;
+    header->checksum = 0;
+    header->reserved = 0;
+    ret_value        = (char *)(header + 1);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Finish the record started by wal_record_begin, and commit the buffer once it is large enough
+ */
+static void
+wal_record_end()
+{
+    pdc_wal_record_header_t *header;
+    int                      is_full;
+
+    FUNC_ENTER(NULL);
+
+    header           = (pdc_wal_record_header_t *)(pdc_wal_buf_g + pdc_wal_buf_size_g);
+    header->checksum = PDC_Server_checksum(header + 1, header->size);
+    pdc_wal_buf_size_g += sizeof(pdc_wal_record_header_t) + header->size;
+    is_full = pdc_wal_buf_size_g >= PDC_WAL_GROUP_COMMIT_SIZE;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_wal_mutex_g);
+#endif
+
+    if (is_full)
+        PDC_Server_wal_commit();
+
+    FUNC_LEAVE_VOID;
+}
+
+static char *
+wal_put(char *pos, const void *src, size_t size)
+{
+    memcpy(pos, src, size);
+    return pos + size;
+}
+
+// Strings are stored with their length, including the terminating NUL
+static char *
+wal_put_str(char *pos, const char *str)
+{
+    uint32_t len = str == NULL ? 1 : strlen(str) + 1;
+
+    pos = wal_put(pos, &len, sizeof(uint32_t));
+    return wal_put(pos, str == NULL ? "" : str, len);
+}
+
+static size_t
+wal_str_size(const char *str)
+{
+    return sizeof(uint32_t) + (str == NULL ? 1 : strlen(str) + 1);
+}
+
+/*
+ * Read size bytes of a record payload
+ *
+ * \return Non-negative on success/Negative if the payload is too short
+ */
+static perr_t
+wal_get(const char **pos, const char *end, void *dst, size_t size)
+{
+    if ((size_t)(end - *pos) < size)
+        return FAIL;
+    memcpy(dst, *pos, size);
+    *pos += size;
+    return SUCCEED;
+}
+
+/*
+ * Read a string of a record payload, the result points into the payload
+ *
+ * \return Non-negative on success/Negative if the payload is too short or malformed
+ */
+static perr_t
+wal_get_str(const char **pos, const char *end, const char **str)
+{
+    uint32_t len;
+
+    if (wal_get(pos, end, &len, sizeof(uint32_t)) != SUCCEED || len == 0 || (size_t)(end - *pos) < len ||
+        (*pos)[len - 1] != '\0')
+        return FAIL;
+    *str = *pos;
+    *pos += len;
+    return SUCCEED;
+}
+
+perr_t
+PDC_Server_wal_open(const char *path, int discard)
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    snprintf(pdc_wal_path_g, ADDR_MAX, "%s", path);
+    snprintf(pdc_wal_old_path_g, ADDR_MAX + 4, "%s.old", path);
+    if (discard)
+        unlink(pdc_wal_old_path_g);
+
+    pdc_wal_file_g = discard ? NULL : fopen(path, "r+b");
+    if (pdc_wal_file_g == NULL)
+        pdc_wal_file_g = fopen(path, "w+b");
+    if (pdc_wal_file_g == NULL) {
+        printf("==PDC_SERVER[%d]: %s - cannot open log file %s\n", pdc_server_rank_g, __func__, path);
+        ret_value = FAIL;
+        goto done;
+    }
+    fseek(pdc_wal_file_g, 0, SEEK_END);
+    pdc_wal_file_size_g = ftell(pdc_wal_file_g);
+    pdc_wal_buf_size_g  = 0;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_init(&pdc_wal_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_wal_commit()
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_wal_file_g == NULL)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_wal_mutex_g);
+#endif
+    if (pdc_wal_buf_size_g > 0) {
+        if (fwrite(pdc_wal_buf_g, 1, pdc_wal_buf_size_g, pdc_wal_file_g) != pdc_wal_buf_size_g ||
+            fflush(pdc_wal_file_g) != 0 || fdatasync(fileno(pdc_wal_file_g)) != 0) {
+            printf("==PDC_SERVER[%d]: %s - log write failed\n", pdc_server_rank_g, __func__);
+            ret_value = FAIL;
+        }
+        pdc_wal_file_size_g += pdc_wal_buf_size_g;
+        pdc_wal_buf_size_g = 0;
+    }
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_wal_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_wal_truncate()
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_wal_file_g == NULL)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_wal_mutex_g);
+#endif
+    fflush(pdc_wal_file_g);
+    if (ftruncate(fileno(pdc_wal_file_g), 0) != 0) {
+        printf("==PDC_SERVER[%d]: %s - log truncate failed\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+    }
+    rewind(pdc_wal_file_g);
+    pdc_wal_file_size_g = 0;
+    pdc_wal_buf_size_g  = 0;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_wal_mutex_g);
+#endif
+    unlink(pdc_wal_old_path_g);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_wal_rotate()
+{
+    perr_t ret_value = SUCCEED;
+
+    FUNC_ENTER(NULL);
+
+    if (pdc_wal_file_g == NULL)
+        goto done;
+
+    // A retired segment that no snapshot covers yet must not be overwritten
+    if (access(pdc_wal_old_path_g, F_OK) == 0) {
+        ret_value = FAIL;
+        goto done;
+    }
+
+    ret_value = PDC_Server_wal_commit();
+    if (ret_value != SUCCEED)
+        goto done;
+
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_lock(&pdc_wal_mutex_g);
+#endif
+    fclose(pdc_wal_file_g);
+    if (rename(pdc_wal_path_g, pdc_wal_old_path_g) != 0) {
+        printf("==PDC_SERVER[%d]: %s - cannot rename log file\n", pdc_server_rank_g, __func__);
+        ret_value = FAIL;
+    }
+    // Keep appending to the current segment if the rename failed
+    pdc_wal_file_g = fopen(pdc_wal_path_g, ret_value == SUCCEED ? "w+b" : "a+b");
+    if (pdc_wal_file_g == NULL) {
+        printf("==PDC_SERVER[%d]: %s - cannot reopen log file, logging stopped\n", pdc_server_rank_g,
+               __func__);
+        ret_value = FAIL;
+    }
+    else if (ret_value == SUCCEED)
+        pdc_wal_file_size_g = 0;
+#ifdef ENABLE_MULTITHREAD
+    hg_thread_mutex_unlock(&pdc_wal_mutex_g);
+#endif
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+void
+PDC_Server_wal_remove_old()
+{
+    FUNC_ENTER(NULL);
+
+    unlink(pdc_wal_old_path_g);
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_close()
+{
+    FUNC_ENTER(NULL);
+
+    if (pdc_wal_file_g != NULL) {
+        PDC_Server_wal_commit();
+        fclose(pdc_wal_file_g);
+        pdc_wal_file_g = NULL;
+#ifdef ENABLE_MULTITHREAD
+        hg_thread_mutex_destroy(&pdc_wal_mutex_g);
+#endif
+    }
+    free(pdc_wal_buf_g);
+    pdc_wal_buf_g       = NULL;
+    pdc_wal_buf_size_g  = 0;
+    pdc_wal_buf_alloc_g = 0;
+
+    FUNC_LEAVE_VOID;
+}
+
+size_t
+PDC_Server_wal_size()
+{
+    return pdc_wal_file_size_g + pdc_wal_buf_size_g;
+}
+
+uint64_t
+PDC_Server_wal_lsn()
+{
+    return pdc_wal_lsn_g;
+}
+
+void
+PDC_Server_wal_fork_prepare()
+{
+#ifdef ENABLE_MULTITHREAD
+    if (pdc_wal_file_g != NULL)
+        hg_thread_mutex_lock(&pdc_wal_mutex_g);
+#endif
+}
+
+void
+PDC_Server_wal_fork_done()
+{
+#ifdef ENABLE_MULTITHREAD
+    if (pdc_wal_file_g != NULL)
+        hg_thread_mutex_unlock(&pdc_wal_mutex_g);
+#endif
+}
+
+void
+PDC_Server_wal_set_lsn(uint64_t lsn)
+{
+    pdc_wal_lsn_g = lsn;
+}
+
+void
+PDC_Server_wal_log_obj_create(uint32_t hash_key, pdc_metadata_t *metadata)
+{
+    char *pos;
+
+    FUNC_ENTER(NULL);
+
+    pos = wal_record_begin(PDC_WAL_OBJ_CREATE, sizeof(uint32_t) + PDC_metadata_serialize(metadata, NULL));
+    if (pos != NULL) {
+        pos = wal_put(pos, &hash_key, sizeof(uint32_t));
+        PDC_metadata_serialize(metadata, pos);
+        wal_record_end();
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_obj_update(pdc_metadata_t *metadata)
+{
+    char *pos;
+
+    FUNC_ENTER(NULL);
+
+    pos = wal_record_begin(PDC_WAL_OBJ_UPDATE, PDC_metadata_serialize(metadata, NULL));
+    if (pos != NULL) {
+        PDC_metadata_serialize(metadata, pos);
+        wal_record_end();
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_obj_delete(uint64_t obj_id)
+{
+    char *pos;
+
+    FUNC_ENTER(NULL);
+
+    pos = wal_record_begin(PDC_WAL_OBJ_DELETE, sizeof(uint64_t));
+    if (pos != NULL) {
+        wal_put(pos, &obj_id, sizeof(uint64_t));
+        wal_record_end();
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_kvtag_add(uint32_t hash_key, uint64_t obj_id, pdc_kvtag_t *kvtag)
+{
+    char * pos;
+    size_t size;
+
+    FUNC_ENTER(NULL);
+
+    size = sizeof(uint32_t) + sizeof(uint64_t) + wal_str_size(kvtag->name) + sizeof(uint32_t) + kvtag->size;
+    pos  = wal_record_begin(PDC_WAL_KVTAG_ADD, size);
+    if (pos != NULL) {
+        pos = wal_put(pos, &hash_key, sizeof(uint32_t));
+        pos = wal_put(pos, &obj_id, sizeof(uint64_t));
+        pos = wal_put_str(pos, kvtag->name);
+        pos = wal_put(pos, &kvtag->size, sizeof(uint32_t));
+        wal_put(pos, kvtag->value, kvtag->size);
+        wal_record_end();
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_kvtag_del(uint32_t hash_key, uint64_t obj_id, const char *key)
+{
+    char *pos;
+
+    FUNC_ENTER(NULL);
+
+    pos = wal_record_begin(PDC_WAL_KVTAG_DEL, sizeof(uint32_t) + sizeof(uint64_t) + wal_str_size(key));
+    if (pos != NULL) {
+        pos = wal_put(pos, &hash_key, sizeof(uint32_t));
+        pos = wal_put(pos, &obj_id, sizeof(uint64_t));
+        wal_put_str(pos, key);
+        wal_record_end();
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_cont_create(uint32_t hash_key, uint64_t cont_id, const char *cont_name)
+{
+    char *pos;
+
+    FUNC_ENTER(NULL);
+
+    pos = wal_record_begin(PDC_WAL_CONT_CREATE,
+                           sizeof(uint32_t) + sizeof(uint64_t) + wal_str_size(cont_name));
+    if (pos != NULL) {
+        pos = wal_put(pos, &hash_key, sizeof(uint32_t));
+        pos = wal_put(pos, &cont_id, sizeof(uint64_t));
+        wal_put_str(pos, cont_name);
+        wal_record_end();
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_cont_objs(pdc_wal_op_t op, uint64_t cont_id, int n_obj, uint64_t *obj_ids)
+{
+    char *pos;
+
+    FUNC_ENTER(NULL);
+
+    if (n_obj <= 0)
+        goto done;
+
+    pos = wal_record_begin(op, sizeof(uint64_t) + sizeof(int) + sizeof(uint64_t) * n_obj);
+    if (pos != NULL) {
+        pos = wal_put(pos, &cont_id, sizeof(uint64_t));
+        pos = wal_put(pos, &n_obj, sizeof(int));
+        wal_put(pos, obj_ids, sizeof(uint64_t) * n_obj);
+        wal_record_end();
+    }
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_cont_tags(uint64_t cont_id, const char *tags)
+{
+    char *pos;
+
+    FUNC_ENTER(NULL);
+
+    pos = wal_record_begin(PDC_WAL_CONT_ADD_TAGS, sizeof(uint64_t) + wal_str_size(tags));
+    if (pos != NULL) {
+        pos = wal_put(pos, &cont_id, sizeof(uint64_t));
+        wal_put_str(pos, tags);
+        wal_record_end();
+    }
+
+    FUNC_LEAVE_VOID;
+}
+
+void
+PDC_Server_wal_log_region(pdc_wal_op_t op, uint64_t obj_id, size_t ndim, uint64_t *start,
+                          uint64_t *count, uint64_t offset, uint64_t data_size, const char *path)
+{
+    region_extent_t extent;
+    char *          pos;
+
+    FUNC_ENTER(NULL);
+
+    if (ndim > DIM_MAX)
+        goto done;
+
+    memset(&extent, 0, sizeof(region_extent_t));
+    extent.ndim = ndim;
+    memcpy(extent.start, start, sizeof(uint64_t) * ndim);
+    memcpy(extent.count, count, sizeof(uint64_t) * ndim);
+    extent.offset    = offset;
+    extent.data_size = data_size;
+
+    pos = wal_record_begin(op, sizeof(uint64_t) + sizeof(region_extent_t) + wal_str_size(path));
+    if (pos != NULL) {
+        pos = wal_put(pos, &obj_id, sizeof(uint64_t));
+        pos = wal_put(pos, &extent, sizeof(region_extent_t));
+        wal_put_str(pos, path);
+        wal_record_end();
+    }
+
+done:
+    FUNC_LEAVE_VOID;
+}
+
+/*
+ * Copy the fields an update can change onto the current metadata of the object
+ */
+static perr_t
+wal_replay_obj_update(pdc_metadata_t *update)
+{
+    perr_t          ret_value = SUCCEED;
+    pdc_metadata_t *target, old;
+
+    FUNC_ENTER(NULL);
+
+    target = PDC_Server_get_obj_metadata(update->obj_id);
+    if (target == NULL) {
+        ret_value = FAIL;
+        goto done;
+    }
+    // The strings of the update point into the log record, the target takes copies
+    old = *target;
+    if (PDC_Server_metadata_set_strings(target, update->app_name, old.obj_name, update->tags,
+                                        update->data_location) != SUCCEED) {
+        ret_value = FAIL;
+        goto done;
+    }
+    PDC_Server_metadata_free_strings(&old);
+    target->time_step       = update->time_step;
+    target->data_type       = update->data_type;
+    target->ndim            = update->ndim;
+    target->transform_state = update->transform_state;
+    memcpy(target->dims, update->dims, sizeof(uint64_t) * DIM_MAX);
+    memcpy(&target->current_state, &update->current_state, sizeof(struct _pdc_transform_state));
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Set where a region is stored in its object's metadata
+ */
+static perr_t
+wal_replay_region_storage(uint64_t obj_id, region_extent_t *extent, const char *path)
+{
+    perr_t         ret_value = SUCCEED;
+    region_list_t *region;
+
+    FUNC_ENTER(NULL);
+
+    region = (region_list_t *)calloc(1, sizeof(region_list_t));
+    if (region == NULL) {
+        ret_value = FAIL;
+        goto done;
+    }
+    PDC_init_region_list(region);
+    region->ndim = extent->ndim;
+    memcpy(region->start, extent->start, sizeof(uint64_t) * DIM_MAX);
+    memcpy(region->count, extent->count, sizeof(uint64_t) * DIM_MAX);
+    region->offset    = extent->offset;
+    region->data_size = extent->data_size;
+    snprintf(region->storage_location, ADDR_MAX, "%s", path);
+
+    ret_value = PDC_Server_update_local_region_storage_loc(region, obj_id, PDC_UPDATE_STORAGE);
+    free(region);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Apply one log record
+ *
+ * \param  op[IN]           Record type
+ * \param  payload[IN]      Record payload
+ * \param  size[IN]         Payload size
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+wal_replay_record(uint32_t op, const char *payload, uint32_t size)
+{
+    perr_t                      ret_value = SUCCEED;
+    const char *                pos = payload, *end = payload + size;
+    const char *                str;
+    uint32_t                    hash_key;
+    uint64_t                    id;
+    int                         n_obj;
+    uint64_t *                  obj_ids;
+    pdc_metadata_t *            metadata;
+    pdc_metadata_t              update;
+    region_extent_t             extent;
+    metadata_add_kvtag_in_t     kvtag_in;
+    metadata_get_kvtag_in_t     kvtag_del_in;
+    metadata_delete_by_id_in_t  delete_in;
+    metadata_delete_by_id_out_t delete_out;
+    metadata_add_tag_out_t      tag_out;
+
+    FUNC_ENTER(NULL);
+
+    switch (op) {
+        case PDC_WAL_OBJ_CREATE:
+            if (wal_get(&pos, end, &hash_key, sizeof(uint32_t)) != SUCCEED ||
+                (size_t)(end - pos) < sizeof(pdc_metadata_t))
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            metadata = (pdc_metadata_t *)malloc(sizeof(pdc_metadata_t));
+            if (metadata == NULL)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot allocate metadata", pdc_server_rank_g);
+            PDC_metadata_deserialize(pos, metadata);
+            ret_value = PDC_Server_metadata_restore(hash_key, metadata);
+            break;
+        case PDC_WAL_OBJ_UPDATE:
+            if ((size_t)(end - pos) < sizeof(pdc_metadata_t))
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            PDC_metadata_deserialize(pos, &update);
+            ret_value = wal_replay_obj_update(&update);
+            break;
+        case PDC_WAL_OBJ_DELETE:
+            if (wal_get(&pos, end, &id, sizeof(uint64_t)) != SUCCEED)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            delete_in.obj_id = id;
+            PDC_Server_delete_metadata_by_id(&delete_in, &delete_out);
+            break;
+        case PDC_WAL_KVTAG_ADD:
+            if (wal_get(&pos, end, &kvtag_in.hash_value, sizeof(uint32_t)) != SUCCEED ||
+                wal_get(&pos, end, &kvtag_in.obj_id, sizeof(uint64_t)) != SUCCEED ||
+                wal_get_str(&pos, end, &str) != SUCCEED ||
+                wal_get(&pos, end, &kvtag_in.kvtag.size, sizeof(uint32_t)) != SUCCEED ||
+                (size_t)(end - pos) < kvtag_in.kvtag.size)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            kvtag_in.kvtag.name  = (char *)str;
+            kvtag_in.kvtag.value = (void *)pos;
+            ret_value            = PDC_Server_add_kvtag(&kvtag_in, &tag_out);
+            break;
+        case PDC_WAL_KVTAG_DEL:
+            if (wal_get(&pos, end, &kvtag_del_in.hash_value, sizeof(uint32_t)) != SUCCEED ||
+                wal_get(&pos, end, &kvtag_del_in.obj_id, sizeof(uint64_t)) != SUCCEED ||
+                wal_get_str(&pos, end, &str) != SUCCEED)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            kvtag_del_in.key = (char *)str;
+            ret_value        = PDC_Server_del_kvtag(&kvtag_del_in, &tag_out);
+            break;
+        case PDC_WAL_CONT_CREATE:
+            if (wal_get(&pos, end, &hash_key, sizeof(uint32_t)) != SUCCEED ||
+                wal_get(&pos, end, &id, sizeof(uint64_t)) != SUCCEED ||
+                wal_get_str(&pos, end, &str) != SUCCEED)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            ret_value = PDC_Server_restore_container(hash_key, str, id);
+            break;
+        case PDC_WAL_CONT_ADD_OBJS:
+        case PDC_WAL_CONT_DEL_OBJS:
+            if (wal_get(&pos, end, &id, sizeof(uint64_t)) != SUCCEED ||
+                wal_get(&pos, end, &n_obj, sizeof(int)) != SUCCEED || n_obj <= 0 ||
+                (size_t)(end - pos) < sizeof(uint64_t) * n_obj)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            // The payload is not aligned for uint64_t
+            obj_ids = (uint64_t *)malloc(sizeof(uint64_t) * n_obj);
+            if (obj_ids == NULL)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: cannot allocate object IDs", pdc_server_rank_g);
+            memcpy(obj_ids, pos, sizeof(uint64_t) * n_obj);
+            if (op == PDC_WAL_CONT_ADD_OBJS)
+                ret_value = PDC_Server_container_add_objs(n_obj, obj_ids, id);
+            else
+                ret_value = PDC_Server_container_del_objs(n_obj, obj_ids, id);
+            free(obj_ids);
+            break;
+        case PDC_WAL_CONT_ADD_TAGS:
+            if (wal_get(&pos, end, &id, sizeof(uint64_t)) != SUCCEED ||
+                wal_get_str(&pos, end, &str) != SUCCEED)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            ret_value = PDC_Server_container_add_tags(id, (char *)str);
+            break;
+        case PDC_WAL_REGION_STORAGE:
+        case PDC_WAL_REGION_EXTENT:
+            if (wal_get(&pos, end, &id, sizeof(uint64_t)) != SUCCEED ||
+                wal_get(&pos, end, &extent, sizeof(region_extent_t)) != SUCCEED ||
+                wal_get_str(&pos, end, &str) != SUCCEED || extent.ndim > DIM_MAX)
+                PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: malformed log record", pdc_server_rank_g);
+            if (op == PDC_WAL_REGION_STORAGE)
+                ret_value = wal_replay_region_storage(id, &extent, str);
+            else
+                ret_value = PDC_Server_restore_region_extent(id, &extent, str);
+            break;
+        default:
+            PGOTO_ERROR(FAIL, "==PDC_SERVER[%d]: unknown log record type %u", pdc_server_rank_g, op);
+    }
+
+done:
+    FUNC_LEAVE(ret_value);
+}
+
+/*
+ * Apply the records in one log segment that are newer than the loaded checkpoint
+ *
+ * \param  path[IN]         Path of the log segment
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+static perr_t
+wal_replay_file(const char *path)
+{
+    perr_t                  ret_value = SUCCEED;
+    FILE *                  file;
+    pdc_wal_record_header_t header;
+    char *                  payload     = NULL;
+    size_t                  payload_max = 0;
+    long                    valid_size  = 0, file_size;
+    int                     n_applied = 0, n_failed = 0;
+
+    FUNC_ENTER(NULL);
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+        goto done;
+
+    while (fread(&header, sizeof(pdc_wal_record_header_t), 1, file) == 1) {
+        if (header.size > payload_max) {
+            free(payload);
+            payload_max = header.size;
+            payload     = (char *)malloc(payload_max);
+            if (payload == NULL) {
+                printf("==PDC_SERVER[%d]: %s - cannot allocate %u bytes\n", pdc_server_rank_g, __func__,
+                       header.size);
+                ret_value = FAIL;
+                break;
+            }
+        }
+        // A short or corrupted record is the torn tail of a commit interrupted by a crash
+        if (fread(payload, 1, header.size, file) != header.size ||
+            PDC_Server_checksum(payload, header.size) != header.checksum)
+            break;
+        valid_size = ftell(file);
+
+        // Records up to the checkpoint's sequence number are already in the checkpoint
+        if (header.lsn <= pdc_wal_lsn_g)
+            continue;
+        pdc_wal_lsn_g = header.lsn;
+        if (wal_replay_record(header.op, payload, header.size) == SUCCEED)
+            n_applied++;
+        else
+            n_failed++;
+    }
+
+    fseek(file, 0, SEEK_END);
+    file_size = ftell(file);
+    fclose(file);
+    free(payload);
+
+    if (ret_value == SUCCEED && valid_size < file_size) {
+        printf("==PDC_SERVER[%d]: dropping %ld bytes of incomplete log records\n", pdc_server_rank_g,
+               file_size - valid_size);
+        if (truncate(path, valid_size) != 0)
+            printf("==PDC_SERVER[%d]: %s - cannot truncate %s\n", pdc_server_rank_g, __func__, path);
+    }
+    if (n_applied > 0 || n_failed > 0)
+        printf("==PDC_SERVER[%d]: replayed %d log records, %d failed\n", pdc_server_rank_g, n_applied,
+               n_failed);
+
+done:
+    fflush(stdout);
+    FUNC_LEAVE(ret_value);
+}
+
+perr_t
+PDC_Server_wal_replay(const char *path)
+{
+    perr_t ret_value = SUCCEED;
+    char   old_path[ADDR_MAX + 4];
+
+    FUNC_ENTER(NULL);
+
+    // A segment retired for a snapshot that did not finish comes first
+    snprintf(old_path, ADDR_MAX + 4, "%s.old", path);
+    ret_value = wal_replay_file(old_path);
+    if (ret_value != SUCCEED)
+        goto done;
+    ret_value = wal_replay_file(path);
+
+done:
+    FUNC_LEAVE(ret_value);
+}
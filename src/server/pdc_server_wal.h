@@ -0,0 +1,249 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+/*
+ * Write-ahead log of metadata changes, replayed on top of the last checkpoint at restart. Records are
+ * buffered and committed in groups by the progress loop, with one fdatasync per commit. Durability is
+ * relaxed: handlers respond before the records of their change are committed, so a crash can lose the
+ * changes of the last progress iteration, up to about PDC_WAL_GROUP_COMMIT_SIZE bytes of records, that
+ * clients were told succeeded. What is replayed is always a prefix of the log.
+ */
+
+#ifndef PDC_SERVER_WAL_H
+#define PDC_SERVER_WAL_H
+
+#include "pdc_server_common.h"
+#include "pdc_client_server_common.h"
+
+// Buffered log records are written out once they reach this size, even within a progress iteration
+#define PDC_WAL_GROUP_COMMIT_SIZE (1 << 20)
+// A checkpoint is taken, and the log truncated, once the log grows past this size
+#define PDC_WAL_CHECKPOINT_SIZE (64 << 20)
+
+typedef enum {
+    PDC_WAL_OBJ_CREATE     = 1,
+    PDC_WAL_OBJ_UPDATE     = 2,
+    PDC_WAL_OBJ_DELETE     = 3,
+    PDC_WAL_KVTAG_ADD      = 4,
+    PDC_WAL_KVTAG_DEL      = 5,
+    PDC_WAL_CONT_CREATE    = 6,
+    PDC_WAL_CONT_ADD_OBJS  = 7,
+    PDC_WAL_CONT_DEL_OBJS  = 8,
+    PDC_WAL_CONT_ADD_TAGS  = 9,
+    PDC_WAL_REGION_STORAGE = 10,
+    PDC_WAL_REGION_EXTENT  = 11
+} pdc_wal_op_t;
+
+// Every record is this header followed by size bytes of payload
+typedef struct pdc_wal_record_header_t {
+    uint64_t lsn; // log sequence number, increasing across checkpoints
+    uint32_t op;
+    uint32_t size;
+    uint32_t checksum; // of the payload
+    uint32_t reserved;
+} pdc_wal_record_header_t;
+
+/***************************************/
+/* Library-private Function Prototypes */
+/***************************************/
+
+/**
+ * FNV-1a checksum of log records and checkpoint blocks
+ *
+ * \param buf [IN]               Data
+ * \param size [IN]              Data size
+ *
+ * \return Checksum
+ */
+uint32_t PDC_Server_checksum(const void *buf, size_t size);
+
+/**
+ * Open the write-ahead log, logging is disabled until it is opened
+ *
+ * \param path [IN]              Path of the log file
+ * \param discard [IN]           Discard existing records when set
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_wal_open(const char *path, int discard);
+
+/**
+ * Commit the buffered records, flush and sync them to the log file
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_wal_commit();
+
+/**
+ * Discard all records, including a retired segment, called once a checkpoint holding their effect is on
+ * disk. No records may be logged while that checkpoint is written.
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_wal_truncate();
+
+/**
+ * Commit the buffered records and start a new log segment, the current one is kept as <path>.old
+ * until a snapshot taken at this point is on disk
+ *
+ * \return Non-negative on success/Negative on failure, also if a retired segment is still there
+ */
+perr_t PDC_Server_wal_rotate();
+
+/**
+ * Remove the log segment retired by PDC_Server_wal_rotate, called once the snapshot covering it is on disk
+ */
+void PDC_Server_wal_remove_old();
+
+/**
+ * Commit the buffered records and close the log
+ */
+void PDC_Server_wal_close();
+
+/**
+ * Get the size of the log file, including buffered records
+ *
+ * \return Size in bytes
+ */
+size_t PDC_Server_wal_size();
+
+/**
+ * Get the sequence number of the last logged record, which a checkpoint saves to skip replayed records
+ *
+ * \return Log sequence number
+ */
+uint64_t PDC_Server_wal_lsn();
+
+/**
+ * Hold the log lock across a fork, so the child reads a sequence number that matches the buffered records
+ */
+void PDC_Server_wal_fork_prepare();
+
+/**
+ * Release the log lock taken by PDC_Server_wal_fork_prepare, in the parent and in the child
+ */
+void PDC_Server_wal_fork_done();
+
+/**
+ * Set the sequence number of the last record already in the loaded checkpoint
+ *
+ * \param lsn [IN]               Log sequence number
+ */
+void PDC_Server_wal_set_lsn(uint64_t lsn);
+
+/**
+ * Apply the records in the log, including a retired segment, that are newer than the loaded checkpoint.
+ * Must be called before PDC_Server_wal_open. A torn record at the end of the log, left by a crash, is cut
+ * off.
+ *
+ * \param path [IN]              Path of the log file
+ *
+ * \return Non-negative on success/Negative on failure
+ */
+perr_t PDC_Server_wal_replay(const char *path);
+
+/**
+ * Log an object creation
+ *
+ * \param hash_key [IN]          Hash value of the object name
+ * \param metadata [IN]          Metadata of the new object, with its object ID
+ */
+void PDC_Server_wal_log_obj_create(uint32_t hash_key, pdc_metadata_t *metadata);
+
+/**
+ * Log an update of an object's names, tags, dimensions or transform state
+ *
+ * \param metadata [IN]          Metadata after the update
+ */
+void PDC_Server_wal_log_obj_update(pdc_metadata_t *metadata);
+
+/**
+ * Log an object deletion
+ *
+ * \param obj_id [IN]            Object ID
+ */
+void PDC_Server_wal_log_obj_delete(uint64_t obj_id);
+
+/**
+ * Log a kvtag added to an object or container
+ *
+ * \param hash_key [IN]          Hash value of the object or container name
+ * \param obj_id [IN]            Object ID
+ * \param kvtag [IN]             Tag
+ */
+void PDC_Server_wal_log_kvtag_add(uint32_t hash_key, uint64_t obj_id, pdc_kvtag_t *kvtag);
+
+/**
+ * Log a kvtag deleted from an object
+ *
+ * \param hash_key [IN]          Hash value of the object name
+ * \param obj_id [IN]            Object ID
+ * \param key [IN]               Tag name
+ */
+void PDC_Server_wal_log_kvtag_del(uint32_t hash_key, uint64_t obj_id, const char *key);
+
+/**
+ * Log a container creation
+ *
+ * \param hash_key [IN]          Hash value of the container name
+ * \param cont_id [IN]           Container ID
+ * \param cont_name [IN]         Container name
+ */
+void PDC_Server_wal_log_cont_create(uint32_t hash_key, uint64_t cont_id, const char *cont_name);
+
+/**
+ * Log objects added to or deleted from a container
+ *
+ * \param op [IN]                PDC_WAL_CONT_ADD_OBJS or PDC_WAL_CONT_DEL_OBJS
+ * \param cont_id [IN]           Container ID
+ * \param n_obj [IN]             Number of objects
+ * \param obj_ids [IN]           Object IDs
+ */
+void PDC_Server_wal_log_cont_objs(pdc_wal_op_t op, uint64_t cont_id, int n_obj, uint64_t *obj_ids);
+
+/**
+ * Log tags added to a container
+ *
+ * \param cont_id [IN]           Container ID
+ * \param tags [IN]              Tags
+ */
+void PDC_Server_wal_log_cont_tags(uint64_t cont_id, const char *tags);
+
+/**
+ * Log where a region of an object is stored
+ *
+ * \param op [IN]                PDC_WAL_REGION_STORAGE for the object's metadata, PDC_WAL_REGION_EXTENT
+ *                               for the data server's own record
+ * \param obj_id [IN]            Object ID
+ * \param ndim [IN]              Number of dimensions
+ * \param start [IN]             Region start
+ * \param count [IN]             Region count
+ * \param offset [IN]            Offset in the data file
+ * \param data_size [IN]         Size of the region in bytes
+ * \param path [IN]              Path of the data file
+ */
+void PDC_Server_wal_log_region(pdc_wal_op_t op, uint64_t obj_id, size_t ndim, uint64_t *start,
+                               uint64_t *count, uint64_t offset, uint64_t data_size, const char *path);
+
+#endif /* PDC_SERVER_WAL_H */
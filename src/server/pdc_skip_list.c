@@ -0,0 +1,294 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "pdc_skip_list.h"
+
+#define SKIP_LIST_MAX_LEVEL 32
+
+typedef struct pdc_skip_list_link {
+    pdc_skip_list_node_t *next;
+    // Entries from this node to next, counting next, or to the end of the list
+    uint64_t span;
+} pdc_skip_list_link_t;
+
+struct pdc_skip_list_node {
+    int64_t              major;
+    uint64_t             minor;
+    void *               value;
+    pdc_skip_list_link_t link[];
+};
+
+struct pdc_skip_list {
+    // The head only has the levels in use, most lists are short and never need more than a few
+    pdc_skip_list_node_t *head;
+    int                   head_level;
+    int                   level;
+    uint64_t              size;
+    size_t                mem_size;
+    uint64_t              rng;
+};
+
+static inline int
+skip_list_less(const pdc_skip_list_node_t *node, int64_t major, uint64_t minor)
+{
+    return node->major < major || (node->major == major && node->minor < minor);
+}
+
+// Each level holds a quarter of the entries of the level below
+static int
+skip_list_random_level(pdc_skip_list_t *list)
+{
+    int level = 1;
+
+    list->rng ^= list->rng << 13;
+    list->rng ^= list->rng >> 7;
+    list->rng ^= list->rng << 17;
+    while (level < SKIP_LIST_MAX_LEVEL && ((list->rng >> (2 * level)) & 3) == 0)
+        level++;
+
+    return level;
+}
+
+static inline size_t
+skip_list_node_size(int level)
+{
+    return sizeof(pdc_skip_list_node_t) + level * sizeof(pdc_skip_list_link_t);
+}
+
+static pdc_skip_list_node_t *
+skip_list_node_new(int level)
+{
+    return (pdc_skip_list_node_t *)calloc(1, skip_list_node_size(level));
+}
+
+// Make room for the given number of levels in the head, the new levels are empty
+static int
+skip_list_grow_head(pdc_skip_list_t *list, int level)
+{
+    pdc_skip_list_node_t *head;
+
+    if (level <= list->head_level)
+        return 0;
+    head = (pdc_skip_list_node_t *)realloc(list->head, skip_list_node_size(level));
+    if (head == NULL)
+        return -1;
+    memset(&head->link[list->head_level], 0, (level - list->head_level) * sizeof(pdc_skip_list_link_t));
+    list->mem_size += skip_list_node_size(level) - skip_list_node_size(list->head_level);
+    list->head       = head;
+    list->head_level = level;
+
+    return 0;
+}
+
+/*
+ * Find the last node before the key on each level and the number of entries up to and including it.
+ * update[0] is the last node whose key is smaller than the given one.
+ */
+static void
+skip_list_find(const pdc_skip_list_t *list, int64_t major, uint64_t minor, pdc_skip_list_node_t **update,
+               uint64_t *rank)
+{
+    pdc_skip_list_node_t *node = list->head;
+    int                   i;
+
+    for (i = list->level - 1; i >= 0; i--) {
+        rank[i] = i == list->level - 1 ? 0 : rank[i + 1];
+        while (node->link[i].next != NULL && skip_list_less(node->link[i].next, major, minor)) {
+            rank[i] += node->link[i].span;
+            node = node->link[i].next;
+        }
+        update[i] = node;
+    }
+}
+
+pdc_skip_list_t *
+pdc_skip_list_new(void)
+{
+    pdc_skip_list_t *list;
+
+    list = (pdc_skip_list_t *)calloc(1, sizeof(pdc_skip_list_t));
+    if (list == NULL)
+        return NULL;
+    list->head = skip_list_node_new(1);
+    if (list->head == NULL) {
+        free(list);
+        return NULL;
+    }
+    list->head_level = 1;
+    list->level      = 1;
+    list->mem_size   = sizeof(pdc_skip_list_t) + skip_list_node_size(1);
+    list->rng   = 0x9e3779b97f4a7c15ULL ^ (uint64_t)(uintptr_t)list;
+
+    return list;
+}
+
+void
+pdc_skip_list_free(pdc_skip_list_t *list)
+{
+    pdc_skip_list_node_t *node, *next;
+
+    if (list == NULL)
+        return;
+    for (node = list->head; node != NULL; node = next) {
+        next = node->link[0].next;
+        free(node);
+    }
+    free(list);
+}
+
+int
+pdc_skip_list_insert(pdc_skip_list_t *list, int64_t major, uint64_t minor, void *value)
+{
+    pdc_skip_list_node_t *update[SKIP_LIST_MAX_LEVEL], *node;
+    uint64_t              rank[SKIP_LIST_MAX_LEVEL];
+    int                   i, level;
+
+    // Grow the head before searching, so update never points to a head that was moved
+    level = skip_list_random_level(list);
+    if (skip_list_grow_head(list, level) < 0)
+        return -1;
+
+    skip_list_find(list, major, minor, update, rank);
+    node = update[0]->link[0].next;
+    if (node != NULL && node->major == major && node->minor == minor)
+        return 0;
+
+    node = skip_list_node_new(level);
+    if (node == NULL)
+        return -1;
+    node->major = major;
+    node->minor = minor;
+    node->value = value;
+    list->mem_size += skip_list_node_size(level);
+
+    if (level > list->level) {
+        for (i = list->level; i < level; i++) {
+            rank[i]                   = 0;
+            update[i]                 = list->head;
+            list->head->link[i].span = list->size;
+        }
+        list->level = level;
+    }
+
+    for (i = 0; i < level; i++) {
+        node->link[i].next      = update[i]->link[i].next;
+        update[i]->link[i].next = node;
+        node->link[i].span      = update[i]->link[i].span - (rank[0] - rank[i]);
+        update[i]->link[i].span = rank[0] - rank[i] + 1;
+    }
+    for (i = level; i < list->level; i++)
+        update[i]->link[i].span++;
+    list->size++;
+
+    return 1;
+}
+
+int
+pdc_skip_list_remove(pdc_skip_list_t *list, int64_t major, uint64_t minor)
+{
+    pdc_skip_list_node_t *update[SKIP_LIST_MAX_LEVEL], *node;
+    uint64_t              rank[SKIP_LIST_MAX_LEVEL];
+    int                   i, level = 0;
+
+    skip_list_find(list, major, minor, update, rank);
+    node = update[0]->link[0].next;
+    if (node == NULL || node->major != major || node->minor != minor)
+        return 0;
+
+    for (i = 0; i < list->level; i++) {
+        if (update[i]->link[i].next == node) {
+            level++;
+            update[i]->link[i].span += node->link[i].span - 1;
+            update[i]->link[i].next = node->link[i].next;
+        }
+        else
+            update[i]->link[i].span--;
+    }
+    while (list->level > 1 && list->head->link[list->level - 1].next == NULL)
+        list->level--;
+    list->size--;
+    list->mem_size -= skip_list_node_size(level);
+    free(node);
+
+    return 1;
+}
+
+uint64_t
+pdc_skip_list_size(const pdc_skip_list_t *list)
+{
+    return list->size;
+}
+
+size_t
+pdc_skip_list_mem_size(const pdc_skip_list_t *list)
+{
+    return list->mem_size;
+}
+
+pdc_skip_list_node_t *
+pdc_skip_list_lower_bound(const pdc_skip_list_t *list, int64_t major, uint64_t minor, uint64_t *rank)
+{
+    pdc_skip_list_node_t *update[SKIP_LIST_MAX_LEVEL];
+    uint64_t              level_rank[SKIP_LIST_MAX_LEVEL];
+
+    skip_list_find(list, major, minor, update, level_rank);
+    if (rank != NULL)
+        *rank = level_rank[0];
+
+    return update[0]->link[0].next;
+}
+
+pdc_skip_list_node_t *
+pdc_skip_list_first(const pdc_skip_list_t *list)
+{
+    return list->head->link[0].next;
+}
+
+pdc_skip_list_node_t *
+pdc_skip_list_next(const pdc_skip_list_node_t *node)
+{
+    return node->link[0].next;
+}
+
+int64_t
+pdc_skip_list_major(const pdc_skip_list_node_t *node)
+{
+    return node->major;
+}
+
+uint64_t
+pdc_skip_list_minor(const pdc_skip_list_node_t *node)
+{
+    return node->minor;
+}
+
+void *
+pdc_skip_list_value(const pdc_skip_list_node_t *node)
+{
+    return node->value;
+}
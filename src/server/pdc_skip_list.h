@@ -0,0 +1,136 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+
+/*
+ * Ordered set keyed by a (major, minor) pair, kept as a skip list whose links record how many entries
+ * they skip. Insert, remove and finding the first entry at or after a key take O(log n) time and also
+ * give the rank of that entry, so the size of a key range is found without walking it.
+ */
+
+#ifndef PDC_SKIP_LIST_H
+#define PDC_SKIP_LIST_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct pdc_skip_list      pdc_skip_list_t;
+typedef struct pdc_skip_list_node pdc_skip_list_node_t;
+
+/**
+ * Create an empty list
+ *
+ * \return Pointer to the list on success/NULL on failure
+ */
+pdc_skip_list_t *pdc_skip_list_new(void);
+
+/**
+ * Free a list, the values are not freed
+ *
+ * \param list [IN]              List to free
+ */
+void pdc_skip_list_free(pdc_skip_list_t *list);
+
+/**
+ * Insert an entry
+ *
+ * \param list [IN]              List
+ * \param major [IN]             Major part of the key
+ * \param minor [IN]             Minor part of the key
+ * \param value [IN]             Value of the entry
+ *
+ * \return 1 if inserted/0 if the key is already in the list/-1 on memory allocation failure
+ */
+int pdc_skip_list_insert(pdc_skip_list_t *list, int64_t major, uint64_t minor, void *value);
+
+/**
+ * Remove an entry
+ *
+ * \param list [IN]              List
+ * \param major [IN]             Major part of the key
+ * \param minor [IN]             Minor part of the key
+ *
+ * \return 1 if removed/0 if the key is not in the list
+ */
+int pdc_skip_list_remove(pdc_skip_list_t *list, int64_t major, uint64_t minor);
+
+/**
+ * Number of entries
+ *
+ * \param list [IN]              List
+ *
+ * \return Number of entries
+ */
+uint64_t pdc_skip_list_size(const pdc_skip_list_t *list);
+
+/**
+ * Bytes allocated by a list, its nodes included
+ *
+ * \param list [IN]              List
+ *
+ * \return Number of bytes
+ */
+size_t pdc_skip_list_mem_size(const pdc_skip_list_t *list);
+
+/**
+ * Find the first entry whose key is >= the given one
+ *
+ * \param list [IN]              List
+ * \param major [IN]             Major part of the key
+ * \param minor [IN]             Minor part of the key
+ * \param rank [OUT]             Number of entries before it, may be NULL
+ *
+ * \return Entry, NULL if all keys are smaller
+ */
+pdc_skip_list_node_t *pdc_skip_list_lower_bound(const pdc_skip_list_t *list, int64_t major, uint64_t minor,
+                                                uint64_t *rank);
+
+/**
+ * First entry of a list
+ *
+ * \param list [IN]              List
+ *
+ * \return Entry, NULL if the list is empty
+ */
+pdc_skip_list_node_t *pdc_skip_list_first(const pdc_skip_list_t *list);
+
+/**
+ * Entry following another one
+ *
+ * \param node [IN]              Entry
+ *
+ * \return Entry, NULL at the end of the list
+ */
+pdc_skip_list_node_t *pdc_skip_list_next(const pdc_skip_list_node_t *node);
+
+/**
+ * Key and value of an entry
+ *
+ * \param node [IN]              Entry
+ */
+int64_t  pdc_skip_list_major(const pdc_skip_list_node_t *node);
+uint64_t pdc_skip_list_minor(const pdc_skip_list_node_t *node);
+void *   pdc_skip_list_value(const pdc_skip_list_node_t *node);
+
+#endif /* PDC_SKIP_LIST_H */
@@ -0,0 +1,394 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "pdc_swiss_table.h"
+
+#define SWISS_GROUP_WIDTH 16
+#define SWISS_MIN_CAPACITY 16
+// Control bytes: a full slot holds the low 7 bits of its hash, the others have the top bit set
+#define SWISS_CTRL_EMPTY ((int8_t)-128)
+#define SWISS_CTRL_DELETED ((int8_t)-2)
+
+#define SWISS_H1(hash) ((size_t)((hash) >> 7))
+#define SWISS_H2(hash) ((int8_t)((hash)&0x7f))
+
+typedef struct pdc_swiss_slot_t {
+    uint64_t hash;
+    void *   value;
+} pdc_swiss_slot_t;
+
+struct pdc_swiss_table {
+    // capacity + SWISS_GROUP_WIDTH bytes, the tail mirrors the first group so a group can be loaded at
+    // any slot without wrapping
+    int8_t *          ctrl;
+    pdc_swiss_slot_t *slots;
+    size_t            capacity; // power of 2
+    size_t            size;
+    size_t            growth_left; // empty slots that can be filled before the table is rehashed
+};
+
+/* wyhash, final version 4 */
+static const uint64_t swiss_secret_g[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+                                           0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+static inline void
+swiss_mum(uint64_t *a, uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = *a;
+
+    r *= *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b, hi, lo;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline uint64_t
+swiss_mix(uint64_t a, uint64_t b)
+{
+    swiss_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t
+swiss_read8(const uint8_t *p)
+{
+    uint64_t v;
+
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t
+swiss_read4(const uint8_t *p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, 4);
+    return v;
+}
+
+uint64_t
+pdc_swiss_hash_bytes(const void *data, size_t len, uint64_t seed)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t       a, b, see1, see2;
+    size_t         i;
+
+    seed ^= swiss_mix(seed ^ swiss_secret_g[0], swiss_secret_g[1]);
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (swiss_read4(p) << 32) | swiss_read4(p + ((len >> 3) << 2));
+            b = (swiss_read4(p + len - 4) << 32) | swiss_read4(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        }
+        else
+            a = b = 0;
+    }
+    else {
+        i = len;
+        if (i > 48) {
+            see1 = seed;
+            see2 = seed;
+            do {
+                seed = swiss_mix(swiss_read8(p) ^ swiss_secret_g[1], swiss_read8(p + 8) ^ seed);
+                see1 = swiss_mix(swiss_read8(p + 16) ^ swiss_secret_g[2], swiss_read8(p + 24) ^ see1);
+                see2 = swiss_mix(swiss_read8(p + 32) ^ swiss_secret_g[3], swiss_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = swiss_mix(swiss_read8(p) ^ swiss_secret_g[1], swiss_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = swiss_read8(p + i - 16);
+        b = swiss_read8(p + i - 8);
+    }
+    a ^= swiss_secret_g[1];
+    b ^= seed;
+    swiss_mum(&a, &b);
+
+    return swiss_mix(a ^ swiss_secret_g[0] ^ len, b ^ swiss_secret_g[1]);
+}
+
+/* Bit i of the returned masks is set when slot pos + i qualifies */
+
+static inline uint32_t
+swiss_group_match(const int8_t *ctrl, int8_t h2)
+{
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+#else
+    uint32_t mask = 0;
+    int      i;
+
+    for (i = 0; i < SWISS_GROUP_WIDTH; i++)
+        mask |= (uint32_t)(ctrl[i] == h2) << i;
+    return mask;
+#endif
+}
+
+static inline uint32_t
+swiss_group_match_empty(const int8_t *ctrl)
+{
+    return swiss_group_match(ctrl, SWISS_CTRL_EMPTY);
+}
+
+static inline uint32_t
+swiss_group_match_empty_or_deleted(const int8_t *ctrl)
+{
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), group));
+#else
+    uint32_t mask = 0;
+    int      i;
+
+    for (i = 0; i < SWISS_GROUP_WIDTH; i++)
+        mask |= (uint32_t)(ctrl[i] < -1) << i;
+    return mask;
+#endif
+}
+
+static inline int
+swiss_lowest_bit(uint32_t mask)
+{
+    return __builtin_ctz(mask);
+}
+
+static inline void
+swiss_set_ctrl(pdc_swiss_table_t *table, size_t i, int8_t h)
+{
+    table->ctrl[i] = h;
+    if (i < SWISS_GROUP_WIDTH)
+        table->ctrl[table->capacity + i] = h;
+}
+
+static inline size_t
+swiss_max_load(size_t capacity)
+{
+    // 7/8 load factor
+    return capacity - capacity / 8;
+}
+
+// Index of the first empty or deleted slot on the probe sequence of the hash
+static size_t
+swiss_find_free(pdc_swiss_table_t *table, uint64_t hash)
+{
+    size_t   mask = table->capacity - 1, pos = SWISS_H1(hash) & mask, step = 0;
+    uint32_t free_mask;
+
+    while (1) {
+        free_mask = swiss_group_match_empty_or_deleted(table->ctrl + pos);
+        if (free_mask != 0)
+            return (pos + swiss_lowest_bit(free_mask)) & mask;
+        step += SWISS_GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    }
+}
+
+static int
+swiss_alloc(pdc_swiss_table_t *table, size_t capacity)
+{
+    table->ctrl  = (int8_t *)malloc(capacity + SWISS_GROUP_WIDTH);
+    table->slots = (pdc_swiss_slot_t *)malloc(capacity * sizeof(pdc_swiss_slot_t));
+    if (table->ctrl == NULL || table->slots == NULL) {
+        free(table->ctrl);
+        free(table->slots);
+        return 0;
+    }
+    memset(table->ctrl, SWISS_CTRL_EMPTY, capacity + SWISS_GROUP_WIDTH);
+    table->capacity    = capacity;
+    table->size        = 0;
+    table->growth_left = swiss_max_load(capacity);
+
+    return 1;
+}
+
+// Move all values to new arrays, growing when the table is more than half full, which also drops the
+// tombstones of removed values
+static int
+swiss_rehash(pdc_swiss_table_t *table)
+{
+    int8_t *          old_ctrl     = table->ctrl;
+    pdc_swiss_slot_t *old_slots    = table->slots;
+    size_t            old_capacity = table->capacity, capacity = old_capacity, i, j;
+
+    if (table->size >= old_capacity / 2)
+        capacity *= 2;
+    if (swiss_alloc(table, capacity) == 0) {
+        table->ctrl  = old_ctrl;
+        table->slots = old_slots;
+        return 0;
+    }
+
+    for (i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] < 0)
+            continue;
+        j = swiss_find_free(table, old_slots[i].hash);
+        swiss_set_ctrl(table, j, SWISS_H2(old_slots[i].hash));
+        table->slots[j] = old_slots[i];
+        table->size++;
+        table->growth_left--;
+    }
+    free(old_ctrl);
+    free(old_slots);
+
+    return 1;
+}
+
+// Index of the slot holding a matching value, capacity if there is none
+static size_t
+swiss_find_slot(pdc_swiss_table_t *table, uint64_t hash, pdc_swiss_table_match_func match, const void *arg,
+                const void *value)
+{
+    size_t   mask = table->capacity - 1, pos = SWISS_H1(hash) & mask, step = 0, i;
+    int8_t   h2   = SWISS_H2(hash);
+    uint32_t tag_mask;
+
+    while (1) {
+        tag_mask = swiss_group_match(table->ctrl + pos, h2);
+        while (tag_mask != 0) {
+            i = (pos + swiss_lowest_bit(tag_mask)) & mask;
+            if (table->slots[i].hash == hash &&
+                (value != NULL ? table->slots[i].value == value
+                               : (match == NULL || match(table->slots[i].value, arg)))) {
+                return i;
+            }
+            tag_mask &= tag_mask - 1;
+        }
+        // An empty slot ends the probe sequence, the value would have been placed there
+        if (swiss_group_match_empty(table->ctrl + pos) != 0)
+            return table->capacity;
+        step += SWISS_GROUP_WIDTH;
+        if (step > table->capacity)
+            return table->capacity;
+        pos = (pos + step) & mask;
+    }
+}
+
+pdc_swiss_table_t *
+pdc_swiss_table_new(void)
+{
+    pdc_swiss_table_t *table;
+
+    table = (pdc_swiss_table_t *)calloc(1, sizeof(pdc_swiss_table_t));
+    if (table == NULL)
+        return NULL;
+    if (swiss_alloc(table, SWISS_MIN_CAPACITY) == 0) {
+        free(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+void
+pdc_swiss_table_free(pdc_swiss_table_t *table)
+{
+    if (table == NULL)
+        return;
+    free(table->ctrl);
+    free(table->slots);
+    free(table);
+}
+
+int
+pdc_swiss_table_insert(pdc_swiss_table_t *table, uint64_t hash, void *value)
+{
+    size_t i;
+
+    i = swiss_find_free(table, hash);
+    // Reusing a tombstone keeps the load unchanged, filling an empty slot may need more room first
+    if (table->ctrl[i] == SWISS_CTRL_EMPTY && table->growth_left == 0) {
+        if (swiss_rehash(table) == 0)
+            return 0;
+        i = swiss_find_free(table, hash);
+    }
+    if (table->ctrl[i] == SWISS_CTRL_EMPTY)
+        table->growth_left--;
+    swiss_set_ctrl(table, i, SWISS_H2(hash));
+    table->slots[i].hash  = hash;
+    table->slots[i].value = value;
+    table->size++;
+
+    return 1;
+}
+
+void *
+pdc_swiss_table_find(pdc_swiss_table_t *table, uint64_t hash, pdc_swiss_table_match_func match,
+                     const void *arg)
+{
+    size_t i;
+
+    i = swiss_find_slot(table, hash, match, arg, NULL);
+    if (i == table->capacity)
+        return NULL;
+
+    return table->slots[i].value;
+}
+
+int
+pdc_swiss_table_remove(pdc_swiss_table_t *table, uint64_t hash, const void *value)
+{
+    size_t i;
+
+    i = swiss_find_slot(table, hash, NULL, NULL, value);
+    if (i == table->capacity)
+        return 0;
+    swiss_set_ctrl(table, i, SWISS_CTRL_DELETED);
+    table->size--;
+
+    return 1;
+}
+
+size_t
+pdc_swiss_table_size(pdc_swiss_table_t *table)
+{
+    return table->size;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+/*
+ * Open-addressing hash table in the SwissTable layout. Slots are probed a group of 16 at a time by
+ * comparing one control byte per slot, which holds 7 bits of the hash, so a lookup touches the
+ * control bytes and only the slots whose tag matches. Each slot keeps the full 64-bit hash and a
+ * value pointer; several values may share a hash, lookups tell them apart with a match function.
+ */
+
+#ifndef PDC_SWISS_TABLE_H
+#define PDC_SWISS_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct pdc_swiss_table pdc_swiss_table_t;
+
+/**
+ * Check if a value with the probed hash is the one looked for
+ *
+ * \param value [IN]             Value stored in the table
+ * \param arg [IN]               Argument given to the lookup
+ *
+ * \return 1 if the value matches/0 otherwise
+ */
+typedef int (*pdc_swiss_table_match_func)(const void *value, const void *arg);
+
+/**
+ * 64-bit hash of a byte string, wyhash
+ *
+ * \param data [IN]              Data to hash
+ * \param len [IN]               Data size
+ * \param seed [IN]              Seed, e.g. a time step to hash together with a name
+ *
+ * \return Hash value
+ */
+uint64_t pdc_swiss_hash_bytes(const void *data, size_t len, uint64_t seed);
+
+/**
+ * Create an empty table
+ *
+ * \return Pointer to the table on success/NULL on failure
+ */
+pdc_swiss_table_t *pdc_swiss_table_new(void);
+
+/**
+ * Free a table, the values are not freed
+ *
+ * \param table [IN]             Table to free
+ */
+void pdc_swiss_table_free(pdc_swiss_table_t *table);
+
+/**
+ * Insert a value, duplicates of hash and value are not checked
+ *
+ * \param table [IN]             Table
+ * \param hash [IN]              64-bit hash of the value's key
+ * \param value [IN]             Value, must not be NULL
+ *
+ * \return 1 on success/0 on memory allocation failure
+ */
+int pdc_swiss_table_insert(pdc_swiss_table_t *table, uint64_t hash, void *value);
+
+/**
+ * Find the first value with the hash that satisfies a match function
+ *
+ * \param table [IN]             Table
+ * \param hash [IN]              64-bit hash of the key looked for
+ * \param match [IN]             Match function, NULL returns the first value with the hash
+ * \param arg [IN]               Argument passed to the match function
+ *
+ * \return The value if found/NULL otherwise
+ */
+void *pdc_swiss_table_find(pdc_swiss_table_t *table, uint64_t hash, pdc_swiss_table_match_func match,
+                           const void *arg);
+
+/**
+ * Remove one value inserted with the hash
+ *
+ * \param table [IN]             Table
+ * \param hash [IN]              Hash the value was inserted with
+ * \param value [IN]             Value to remove
+ *
+ * \return 1 if the value was removed/0 if it was not found
+ */
+int pdc_swiss_table_remove(pdc_swiss_table_t *table, uint64_t hash, const void *value);
+
+/**
+ * Number of values in a table
+ *
+ * \param table [IN]             Table
+ *
+ * \return Number of values
+ */
+size_t pdc_swiss_table_size(pdc_swiss_table_t *table);
+
+#endif /* PDC_SWISS_TABLE_H */
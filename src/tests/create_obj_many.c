@@ -0,0 +1,146 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pdc.h"
+
+#define NOBJ 64
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t              pdc, cont_prop, cont, obj_prop;
+    pdcid_t              obj_ids[NOBJ], dup_ids[NOBJ];
+    char                 obj_name_buf[NOBJ][64];
+    const char *         obj_names[NOBJ];
+    struct pdc_obj_info *obj_info;
+    perr_t               ret;
+    int                  i, rank = 0, size = 1, ret_value = 0;
+    uint64_t             dims[2] = {16, 16};
+    char                 cont_name[128];
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+    // create a pdc
+    pdc = PDCinit("pdc");
+
+    // create a container property
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    if (cont_prop <= 0) {
+        printf("Fail to create container property @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+    // create a container
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+    // create an object property
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    if (obj_prop <= 0) {
+        printf("Fail to create object property @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_set_obj_dims(obj_prop, 2, dims);
+    PDCprop_set_obj_type(obj_prop, PDC_FLOAT);
+
+    for (i = 0; i < NOBJ; i++) {
+        sprintf(obj_name_buf[i], "many_%d_%d", rank, i);
+        obj_names[i] = obj_name_buf[i];
+    }
+
+    // create all objects with one request per metadata server
+    ret = PDCobj_create_many(cont, NOBJ, obj_names, obj_prop, obj_ids);
+    if (ret != SUCCEED) {
+        printf("Fail to create objects @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+    for (i = 0; i < NOBJ; i++) {
+        if (obj_ids[i] <= 0) {
+            printf("Object %s was not created\n", obj_names[i]);
+            ret_value = 1;
+            continue;
+        }
+        obj_info = PDCobj_get_info(obj_ids[i]);
+        if (obj_info == NULL || obj_info->meta_id == 0 || strcmp(obj_info->name, obj_names[i]) != 0) {
+            printf("Wrong info for object %s\n", obj_names[i]);
+            ret_value = 1;
+        }
+    }
+
+    // creating the same names again must fail for every object
+    ret = PDCobj_create_many(cont, NOBJ, obj_names, obj_prop, dup_ids);
+    if (ret == SUCCEED) {
+        printf("Duplicate objects were created @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+    for (i = 0; i < NOBJ; i++) {
+        if (dup_ids[i] != 0) {
+            printf("Duplicate object %s was created\n", obj_names[i]);
+            ret_value = 1;
+            PDCobj_close(dup_ids[i]);
+        }
+    }
+
+    for (i = 0; i < NOBJ; i++) {
+        if (obj_ids[i] > 0 && PDCobj_close(obj_ids[i]) < 0) {
+            printf("fail to close object %s\n", obj_names[i]);
+            ret_value = 1;
+        }
+    }
+    if (ret_value == 0)
+        printf("Created and closed %d objects\n", NOBJ);
+
+    // close a container
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1\n");
+        ret_value = 1;
+    }
+    // close a object property
+    if (PDCprop_close(obj_prop) < 0) {
+        printf("Fail to close property @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    // close a container property
+    if (PDCprop_close(cont_prop) < 0) {
+        printf("Fail to close property @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    // close pdc
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC\n");
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
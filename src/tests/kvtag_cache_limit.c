@@ -0,0 +1,174 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pdc.h"
+#include "pdc_client_connect.h"
+#define N_OBJ      2048
+#define VALUE_SIZE 1024
+// Reads may not grow the server memory outside of the resident lists by more than this
+#define MEM_SLACK (64 << 10)
+
+// Record the memory every server holds outside of its resident kvtag lists
+static int
+get_outside_size(int rank, uint64_t *outside)
+{
+    meta_store_stats_out_t stats;
+    int                    i, n_bad = 0;
+
+    for (i = 0; i < pdc_server_num_g; i++) {
+        if (PDC_Client_server_meta_store_stats(i, &stats) != SUCCEED) {
+            printf("[%d] Fail to get the kvtag store stats of server %d @ line %d\n", rank, i, __LINE__);
+            n_bad++;
+            continue;
+        }
+        outside[i] = stats.total_mem_size - stats.mem_size;
+    }
+    return n_bad;
+}
+
+// Check that the kvtag lists resident on every server fit in its cache, and that the rest of the server
+// memory did not grow since it was recorded
+static int
+check_resident_size(int rank, const uint64_t *outside)
+{
+    meta_store_stats_out_t stats;
+    int                    i, n_bad = 0;
+
+    for (i = 0; i < pdc_server_num_g; i++) {
+        if (PDC_Client_server_meta_store_stats(i, &stats) != SUCCEED) {
+            printf("[%d] Fail to get the kvtag store stats of server %d @ line %d\n", rank, i, __LINE__);
+            n_bad++;
+            continue;
+        }
+        if (stats.cache_size == 0 || stats.mem_size > stats.cache_size || stats.n_load == 0) {
+            printf("[%d] Server %d: %llu bytes resident for a cache of %llu, %llu loads @ line %d\n", rank, i,
+                   (unsigned long long)stats.mem_size, (unsigned long long)stats.cache_size,
+                   (unsigned long long)stats.n_load, __LINE__);
+            n_bad++;
+        }
+        if (stats.total_mem_size - stats.mem_size > outside[i] + MEM_SLACK) {
+            printf("[%d] Server %d: %llu bytes outside the lists, %llu before the reads @ line %d\n", rank, i,
+                   (unsigned long long)(stats.total_mem_size - stats.mem_size),
+                   (unsigned long long)outside[i], __LINE__);
+            n_bad++;
+        }
+    }
+    return n_bad;
+}
+
+// Run with PDC_METADATA_STORE_CACHE_MB=1 on the server, a read-only pass over the 2 MB of tags must not grow
+// the resident lists past the cache, nor keep what it reads anywhere else in the server
+int
+main(int argc, char **argv)
+{
+    pdcid_t  pdc, cont_prop, cont, obj_prop;
+    pdcid_t *objs;
+    char     cont_name[128], obj_name[128], value[VALUE_SIZE];
+    void *   got       = NULL;
+    psize_t  got_size  = 0;
+    int      rank      = 0, i, pass, n_bad = 0;
+    int      ret_value = 0;
+
+    // Per server, bytes held outside of the resident kvtag lists before the read passes
+    uint64_t *outside = NULL;
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    objs     = (pdcid_t *)calloc(N_OBJ, sizeof(pdcid_t));
+    for (i = 0; i < N_OBJ; i++) {
+        sprintf(obj_name, "cache_%d_%d", rank, i);
+        objs[i] = PDCobj_create(cont, obj_name, obj_prop);
+        memset(value, 'a' + i % 26, VALUE_SIZE);
+        if (objs[i] <= 0 || PDCobj_put_tag(objs[i], "blob", value, VALUE_SIZE) < 0) {
+            printf("Fail to create a tagged object @ line  %d!\n", __LINE__);
+            ret_value = 1;
+            break;
+        }
+    }
+
+#ifdef ENABLE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    outside = (uint64_t *)calloc(pdc_server_num_g, sizeof(uint64_t));
+    if (rank == 0 && get_outside_size(rank, outside) > 0)
+        ret_value = 1;
+
+    // Read every tag twice, oldest first, so that each pass reads back the lists the previous one dropped
+    for (pass = 0; pass < 2 && ret_value == 0; pass++) {
+        for (i = 0; i < N_OBJ; i++) {
+            memset(value, 'a' + i % 26, VALUE_SIZE);
+            if (PDCobj_get_tag(objs[i], "blob", &got, &got_size) < 0 || got_size != VALUE_SIZE ||
+                memcmp(got, value, VALUE_SIZE) != 0)
+                n_bad++;
+            free(got);
+            got = NULL;
+        }
+        if (n_bad > 0) {
+            printf("%d tags were not read back @ line %d\n", n_bad, __LINE__);
+            ret_value = 1;
+        }
+#ifdef ENABLE_MPI
+        MPI_Barrier(MPI_COMM_WORLD);
+#endif
+        if (rank == 0 && check_resident_size(rank, outside) > 0)
+            ret_value = 1;
+    }
+    free(outside);
+
+    for (i = 0; i < N_OBJ; i++) {
+        if (objs[i] > 0)
+            PDCobj_close(objs[i]);
+    }
+    free(objs);
+
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pdc.h"
+#define N_OBJ    64
+#define BIG_SIZE 1000
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t pdc, cont_prop, cont, obj_prop;
+    pdcid_t obj_ids[2 * N_OBJ];
+    char *  tag_names[2 * N_OBJ];
+    void *  tag_values[2 * N_OBJ];
+    psize_t value_sizes[2 * N_OBJ];
+    int     values[N_OBJ];
+    char    big[BIG_SIZE], cont_name[128], obj_name[128];
+    int     rank = 0, i, ret_value = 0;
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    // Every object gets a small tag and a tag too large for the first guess of a batched get
+    memset(big, 'x', BIG_SIZE);
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    for (i = 0; i < N_OBJ; i++) {
+        sprintf(obj_name, "many_%d_%d", rank, i);
+        obj_ids[i] = PDCobj_create(cont, obj_name, obj_prop);
+        if (obj_ids[i] <= 0) {
+            printf("Fail to create object @ line  %d!\n", __LINE__);
+            ret_value = 1;
+        }
+        values[i]              = i;
+        obj_ids[N_OBJ + i]     = obj_ids[i];
+        tag_names[i]           = "small";
+        tag_names[N_OBJ + i]   = "big";
+        tag_values[i]          = &values[i];
+        tag_values[N_OBJ + i]  = big;
+        value_sizes[i]         = sizeof(int);
+        value_sizes[N_OBJ + i] = BIG_SIZE;
+    }
+
+    if (PDCobj_put_tag_many(2 * N_OBJ, obj_ids, tag_names, tag_values, value_sizes) < 0) {
+        printf("fail to put tags @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+
+    if (PDCobj_get_tag_many(2 * N_OBJ, obj_ids, tag_names, tag_values, value_sizes) < 0) {
+        printf("fail to get tags @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    for (i = 0; i < N_OBJ; i++) {
+        if (tag_values[i] == NULL || value_sizes[i] != sizeof(int) || *(int *)tag_values[i] != i) {
+            printf("wrong small tag of object %d @ line %d\n", i, __LINE__);
+            ret_value = 1;
+        }
+        if (tag_values[N_OBJ + i] == NULL || value_sizes[N_OBJ + i] != BIG_SIZE ||
+            memcmp(tag_values[N_OBJ + i], big, BIG_SIZE) != 0) {
+            printf("wrong big tag of object %d @ line %d\n", i, __LINE__);
+            ret_value = 1;
+        }
+    }
+    for (i = 0; i < 2 * N_OBJ; i++)
+        free(tag_values[i]);
+
+    if (PDCobj_del_tag_many(N_OBJ, obj_ids, tag_names) < 0) {
+        printf("fail to delete tags @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+
+    // The small tags are gone, the big ones are untouched
+    if (PDCobj_get_tag_many(2 * N_OBJ, obj_ids, tag_names, tag_values, value_sizes) < 0) {
+        printf("fail to get tags @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    for (i = 0; i < N_OBJ; i++) {
+        if (tag_values[i] != NULL || value_sizes[i] != 0) {
+            printf("small tag of object %d not deleted @ line %d\n", i, __LINE__);
+            ret_value = 1;
+        }
+        if (tag_values[N_OBJ + i] == NULL || value_sizes[N_OBJ + i] != BIG_SIZE) {
+            printf("big tag of object %d lost @ line %d\n", i, __LINE__);
+            ret_value = 1;
+        }
+        free(tag_values[N_OBJ + i]);
+    }
+
+    for (i = 0; i < N_OBJ; i++)
+        PDCobj_close(obj_ids[i]);
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
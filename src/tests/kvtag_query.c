@@ -31,6 +31,17 @@
 #include "pdc.h"
 #include "pdc_client_connect.h"
 
+// A query must return exactly the one expected object
+static int
+check_single_result(const char *what, int nobj, uint64_t *obj_ids, uint64_t expected)
+{
+    if (nobj != 1 || obj_ids == NULL || obj_ids[0] != expected) {
+        printf("%s query returned %d objects, expected only %" PRIu64 "\n", what, nobj, expected);
+        return 1;
+    }
+    return 0;
+}
+
 int
 main()
 {
@@ -44,6 +55,9 @@ main()
     int         v2 = 2;
     double      v3 = 3.45;
 
+    uint64_t o1_id = 0, o2_id = 0;
+    int      ret_value = 0;
+
     // create a pdc
     pdc = PDCinit("pdc");
     printf("create a new pdc\n");
@@ -154,6 +168,49 @@ main()
     if (obj_ids1 != NULL)
         free(obj_ids1);
 
+    if (obj1 > 0 && obj2 > 0) {
+        o1_id = PDCobj_get_info(obj1)->meta_id;
+        o2_id = PDCobj_get_info(obj2)->meta_id;
+    }
+    else
+        ret_value = 1;
+
+    // key3double > 3.0 should match o2
+    v3      = 3.0;
+    obj_ids = NULL;
+    if (PDC_Client_query_kvtag_op(&kvtag3, PDC_KVTAG_GT, PDC_DOUBLE, &nobj, &obj_ids) < 0) {
+        printf("fail to query a kvtag with range\n");
+        ret_value = 1;
+    }
+    else {
+        printf("successfully queried a tag with range, nres=%d\n", nobj);
+        for (i = 0; i < nobj; i++)
+            printf("%" PRIu64 ", ", obj_ids[i]);
+        printf("\n\n");
+        if (check_single_result("Range", nobj, obj_ids, o2_id) != 0)
+            ret_value = 1;
+    }
+    if (obj_ids != NULL)
+        free(obj_ids);
+
+    // key1string starting with "val" should match o1
+    kvtag1.size = 3;
+    obj_ids     = NULL;
+    if (PDC_Client_query_kvtag_op(&kvtag1, PDC_KVTAG_PREFIX, PDC_CHAR, &nobj, &obj_ids) < 0) {
+        printf("fail to query a kvtag with prefix\n");
+        ret_value = 1;
+    }
+    else {
+        printf("successfully queried a tag with prefix, nres=%d\n", nobj);
+        for (i = 0; i < nobj; i++)
+            printf("%" PRIu64 ", ", obj_ids[i]);
+        printf("\n\n");
+        if (check_single_result("Prefix", nobj, obj_ids, o1_id) != 0)
+            ret_value = 1;
+    }
+    if (obj_ids != NULL)
+        free(obj_ids);
+
     // close first object
     if (PDCobj_close(obj1) < 0)
         printf("fail to close object o1\n");
@@ -192,5 +249,5 @@ main()
     if (PDCclose(pdc) < 0)
         printf("fail to close PDC\n");
 
-    return 0;
+    return ret_value;
 }
@@ -0,0 +1,120 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pdc.h"
+#include "pdc_client_connect.h"
+#define N_OBJ 64
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t     pdc, cont_prop, cont, obj_prop, obj;
+    char        cont_name[128], obj_name[128];
+    int         rank = 0, size = 1, i, n_res = 0, n_col = 0, n_mine = 0, ret_value = 0;
+    int         v = 0;
+    uint64_t *  ids = NULL;
+    pdc_kvtag_t kvtag;
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    // Tag every object with the same value, their metadata is spread over all servers
+    kvtag.name  = "fanout";
+    kvtag.value = (void *)&v;
+    kvtag.size  = sizeof(int);
+
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    for (i = 0; i < N_OBJ; i++) {
+        sprintf(obj_name, "fanout_%d_%d", rank, i);
+        obj = PDCobj_create(cont, obj_name, obj_prop);
+        if (obj <= 0 || PDCobj_put_tag(obj, kvtag.name, kvtag.value, kvtag.size) < 0) {
+            printf("Fail to create a tagged object @ line  %d!\n", __LINE__);
+            ret_value = 1;
+            break;
+        }
+        PDCobj_close(obj);
+    }
+#ifdef ENABLE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    if (PDC_Client_query_kvtag(&kvtag, &n_res, &ids) != SUCCEED || n_res != N_OBJ * size) {
+        printf("queried %d objects, expected %d @ line %d\n", n_res, N_OBJ * size, __LINE__);
+        ret_value = 1;
+    }
+    free(ids);
+    ids = NULL;
+
+    // Each client only gets the objects on its share of the servers
+    if (PDC_Client_query_kvtag_col(&kvtag, &n_mine, &ids) != SUCCEED) {
+        printf("fail to query kvtag collectively @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    free(ids);
+    ids = NULL;
+#ifdef ENABLE_MPI
+    MPI_Allreduce(&n_mine, &n_col, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#else
+    n_col = n_mine;
+#endif
+    if (n_col != N_OBJ * size) {
+        printf("collectively queried %d objects, expected %d @ line %d\n", n_col, N_OBJ * size, __LINE__);
+        ret_value = 1;
+    }
+
+    if (PDC_Client_query_kvtag_mpi(&kvtag, &n_res, &ids) != SUCCEED || n_res != N_OBJ * size) {
+        printf("gathered %d objects, expected %d @ line %d\n", n_res, N_OBJ * size, __LINE__);
+        ret_value = 1;
+    }
+    free(ids);
+
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pdc.h"
+#define N_OBJ      2048
+#define VALUE_SIZE 1024
+
+// Run with PDC_METADATA_STORE_CACHE_MB=1 on the server, so most of the 2 MB of tags are spilled to disk
+int
+main(int argc, char **argv)
+{
+    pdcid_t  pdc, cont_prop, cont, obj_prop;
+    pdcid_t *objs;
+    char     cont_name[128], obj_name[128], value[VALUE_SIZE];
+    void *   got       = NULL;
+    psize_t  got_size  = 0;
+    int      rank      = 0, i, n_bad = 0;
+    int      ret_value = 0;
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    objs     = (pdcid_t *)calloc(N_OBJ, sizeof(pdcid_t));
+    for (i = 0; i < N_OBJ; i++) {
+        sprintf(obj_name, "store_%d_%d", rank, i);
+        objs[i] = PDCobj_create(cont, obj_name, obj_prop);
+        memset(value, 'a' + i % 26, VALUE_SIZE);
+        if (objs[i] <= 0 || PDCobj_put_tag(objs[i], "blob", value, VALUE_SIZE) < 0) {
+            printf("Fail to create a tagged object @ line  %d!\n", __LINE__);
+            ret_value = 1;
+            break;
+        }
+    }
+
+    // The first objects are the coldest, so their tags are read back from the store
+    for (i = 0; i < N_OBJ && ret_value == 0; i++) {
+        memset(value, 'a' + i % 26, VALUE_SIZE);
+        if (PDCobj_get_tag(objs[i], "blob", &got, &got_size) < 0 || got_size != VALUE_SIZE ||
+            memcmp(got, value, VALUE_SIZE) != 0)
+            n_bad++;
+        free(got);
+        got = NULL;
+    }
+
+    // Delete half of the tags, the other half must still be there
+    for (i = 0; i < N_OBJ && ret_value == 0; i += 2) {
+        if (PDCobj_del_tag(objs[i], "blob") < 0)
+            n_bad++;
+    }
+    for (i = 1; i < N_OBJ && ret_value == 0; i += 2) {
+        memset(value, 'a' + i % 26, VALUE_SIZE);
+        if (PDCobj_get_tag(objs[i], "blob", &got, &got_size) < 0 || got_size != VALUE_SIZE ||
+            memcmp(got, value, VALUE_SIZE) != 0)
+            n_bad++;
+        free(got);
+        got = NULL;
+    }
+    if (n_bad > 0) {
+        printf("%d tags were not read back @ line %d\n", n_bad, __LINE__);
+        ret_value = 1;
+    }
+
+    for (i = 0; i < N_OBJ; i++) {
+        if (objs[i] > 0)
+            PDCobj_close(objs[i]);
+    }
+    free(objs);
+
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "pdc.h"
+#include "pdc_client_connect.h"
+#define N_OBJ 256
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t            pdc, cont_prop, cont, obj_prop, obj;
+    char               cont_name[128], obj_name[128];
+    int                rank = 0, i, j, n_obj = 0, n_page = 0, n_res, n_total = 0, n_found = 0;
+    int                ret_value = 0;
+    uint64_t           dims[1];
+    pdc_metadata_t **  out = NULL;
+    pdc_query_cursor_t cursor;
+
+    // Small pages so the objects take several round trips
+    setenv("PDC_QUERY_PAGE_SIZE_KB", "4", 1);
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    dims[0]  = 16;
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    PDCprop_set_obj_type(obj_prop, PDC_INT);
+    PDCprop_set_obj_dims(obj_prop, 1, dims);
+    PDCprop_set_obj_user_id(obj_prop, getuid());
+    PDCprop_set_obj_app_name(obj_prop, "PagedQueryTest");
+    for (i = 0; i < N_OBJ; i++) {
+        sprintf(obj_name, "paged_%d_%d", rank, i);
+        obj = PDCobj_create(cont, obj_name, obj_prop);
+        if (obj <= 0) {
+            printf("Fail to create object @ line  %d!\n", __LINE__);
+            ret_value = 1;
+            break;
+        }
+        PDCobj_close(obj);
+    }
+
+    if (PDC_Client_list_all(&n_obj, &out) != SUCCEED) {
+        printf("fail to list all objects @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    if (n_obj < N_OBJ) {
+        printf("listed %d objects, expected at least %d @ line %d\n", n_obj, N_OBJ, __LINE__);
+        ret_value = 1;
+    }
+
+    memset(&cursor, 0, sizeof(pdc_query_cursor_t));
+    while (!cursor.done) {
+        if (PDC_partial_query_page(1, -1, NULL, NULL, -1, -1, -1, NULL, &cursor, &n_res, &out) != SUCCEED) {
+            printf("fail to get a page @ line %d\n", __LINE__);
+            ret_value = 1;
+            break;
+        }
+        if (n_res == 0)
+            continue;
+        n_page++;
+        n_total += n_res;
+        for (j = 0; j < n_res; j++) {
+            if (strncmp(out[j]->obj_name, "paged_", 6) == 0)
+                n_found++;
+        }
+        free(out[0]);
+        free(out);
+    }
+    printf("%d objects in %d pages\n", n_total, n_page);
+    if (n_found < N_OBJ || n_page < 2) {
+        printf("found %d objects in %d pages @ line %d\n", n_found, n_page, __LINE__);
+        ret_value = 1;
+    }
+
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pdc.h"
+
+// Sizes around the limit of data sent with the request, and one that needs a bulk transfer
+#define N_SIZE 4
+static const uint64_t obj_size_g[N_SIZE] = {1, 2048, 2049, 1048576};
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t  pdc, cont_prop, cont;
+    pdcid_t  obj[N_SIZE];
+    perr_t   error_code;
+    char     cont_name[128], obj_name[128];
+    int      rank = 0, size = 1;
+    int      i;
+    uint64_t j;
+    int      ret_value = 0;
+    char *   data, *read_data;
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+    data      = (char *)malloc(obj_size_g[N_SIZE - 1]);
+    read_data = (char *)malloc(obj_size_g[N_SIZE - 1]);
+
+    // create a pdc
+    pdc = PDCinit("pdc");
+    printf("create a new pdc\n");
+
+    // create a container property
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    if (cont_prop <= 0) {
+        printf("Fail to create container property @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+    // create a container
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    for (i = 0; i < N_SIZE; i++) {
+        for (j = 0; j < obj_size_g[i]; j++)
+            data[j] = (char)(j * 7 + i);
+        sprintf(obj_name, "o%d_%d", i, rank);
+        obj[i] = PDCobj_put_data(obj_name, (void *)data, obj_size_g[i], cont);
+        if (obj[i] <= 0) {
+            printf("Fail to put %" PRIu64 " bytes into object @ line  %d!\n", obj_size_g[i], __LINE__);
+            ret_value = 1;
+        }
+    }
+
+    for (i = 0; i < N_SIZE; i++) {
+        if (obj[i] <= 0)
+            continue;
+        memset(read_data, 0, obj_size_g[i]);
+        error_code = PDCobj_get_data(obj[i], (void *)read_data, obj_size_g[i]);
+        if (error_code != SUCCEED) {
+            printf("Fail to get %" PRIu64 " bytes from object @ line  %d!\n", obj_size_g[i], __LINE__);
+            ret_value = 1;
+            continue;
+        }
+        for (j = 0; j < obj_size_g[i]; j++) {
+            if (read_data[j] != (char)(j * 7 + i)) {
+                printf("wrong value at byte %" PRIu64 " of object %d\n", j, i);
+                ret_value = 1;
+                break;
+            }
+        }
+        if (PDCobj_close(obj[i]) < 0) {
+            printf("fail to close object %d\n", i);
+            ret_value = 1;
+        }
+    }
+
+    // close a container
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1\n");
+        ret_value = 1;
+    }
+    // close a container property
+    if (PDCprop_close(cont_prop) < 0) {
+        printf("Fail to close property @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    // close pdc
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC\n");
+        ret_value = 1;
+    }
+    free(data);
+    free(read_data);
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
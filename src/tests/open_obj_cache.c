@@ -0,0 +1,132 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "pdc.h"
+#include "pdc_client_connect.h"
+#define N_OPEN 16
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t                    pdc, cont_prop, cont, obj_prop, obj1, obj2;
+    char                       cont_name[128], obj_name1[128];
+    int                        rank = 0, i;
+    int                        ret_value = 0;
+    uint64_t                   dims[1];
+    pdc_metadata_t *           meta = NULL;
+    pdc_metadata_cache_stats_t stats;
+
+    // Keep metadata returned by name queries for a minute
+    setenv("PDC_METADATA_CACHE_LEASE", "60", 1);
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    dims[0]  = 1024;
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    PDCprop_set_obj_type(obj_prop, PDC_INT);
+    PDCprop_set_obj_dims(obj_prop, 1, dims);
+    PDCprop_set_obj_user_id(obj_prop, getuid());
+    PDCprop_set_obj_app_name(obj_prop, "MetaCacheTest");
+
+    sprintf(obj_name1, "o1_%d", rank);
+    obj1 = PDCobj_create(cont, obj_name1, obj_prop);
+    if (obj1 <= 0) {
+        printf("Fail to create object @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    // Only the first open asks the metadata server
+    for (i = 0; i < N_OPEN; i++) {
+        obj2 = PDCobj_open(obj_name1, pdc);
+        if (obj2 <= 0) {
+            printf("Fail to open object @ line  %d!\n", __LINE__);
+            ret_value = 1;
+            break;
+        }
+        if (PDCobj_close(obj2) < 0) {
+            printf("fail to close object @ line %d\n", __LINE__);
+            ret_value = 1;
+        }
+    }
+
+    PDC_Client_metadata_cache_get_stats(&stats);
+    printf("metadata cache: %" PRIu64 " hits, %" PRIu64 " misses\n", stats.n_hit, stats.n_miss);
+    if (stats.n_hit < N_OPEN - 1) {
+        printf("expected at least %d metadata cache hits @ line %d\n", N_OPEN - 1, __LINE__);
+        ret_value = 1;
+    }
+
+    // Deleting the object drops its entry, so the next query goes to the server
+    if (PDCobj_del(obj1) != SUCCEED) {
+        printf("fail to delete object @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDC_Client_query_metadata_name_timestep(obj_name1, 0, &meta);
+    if (meta != NULL) {
+        printf("deleted object still found @ line %d\n", __LINE__);
+        ret_value = 1;
+        free(meta);
+    }
+    PDC_Client_metadata_cache_get_stats(&stats);
+    if (stats.n_invalidate < 1) {
+        printf("expected an invalidated metadata cache entry @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+
+    if (PDCobj_close(obj1) < 0) {
+        printf("fail to close object o1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
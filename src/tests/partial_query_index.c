@@ -0,0 +1,129 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "pdc.h"
+#include "pdc_client_connect.h"
+#define N_OBJ 40
+
+static int
+check_query(const char *app_name, int time_step_from, int time_step_to, const char *tags, int expected,
+            int line)
+{
+    pdc_metadata_t **out = NULL;
+    int              n_res = 0;
+
+    if (PDC_partial_query(0, -1, app_name, NULL, time_step_from, time_step_to, -1, tags, &n_res, &out) !=
+        SUCCEED) {
+        printf("fail to query @ line %d\n", line);
+        return 1;
+    }
+    if (n_res != expected) {
+        printf("found %d objects, expected %d @ line %d\n", n_res, expected, line);
+        return 1;
+    }
+
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t  pdc, cont_prop, cont, obj_prop, obj, obj5 = 0;
+    char     obj_name[128], tags[128];
+    int      i, ret_value = 0;
+    uint64_t dims[1];
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    cont      = PDCcont_create("c_query_index", cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    dims[0]  = 16;
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    PDCprop_set_obj_type(obj_prop, PDC_INT);
+    PDCprop_set_obj_dims(obj_prop, 1, dims);
+    PDCprop_set_obj_user_id(obj_prop, getuid());
+    for (i = 0; i < N_OBJ; i++) {
+        sprintf(obj_name, "idx_obj_%d", i);
+        sprintf(tags, "t=%d,grp=%d", i, i % 4);
+        PDCprop_set_obj_app_name(obj_prop, i % 2 == 0 ? "appA" : "appB");
+        PDCprop_set_obj_time_step(obj_prop, i);
+        PDCprop_set_obj_tags(obj_prop, tags);
+        obj = PDCobj_create(cont, obj_name, obj_prop);
+        if (obj <= 0) {
+            printf("Fail to create object @ line  %d!\n", __LINE__);
+            ret_value = 1;
+            break;
+        }
+        if (i == 5)
+            obj5 = obj;
+        else
+            PDCobj_close(obj);
+    }
+
+    // App name and time step range, the even time steps in [10, 19]
+    ret_value |= check_query("appA", 10, 19, NULL, 5, __LINE__);
+    ret_value |= check_query(NULL, 10, 19, NULL, 10, __LINE__);
+    // Tags match whole tags, all of them
+    ret_value |= check_query(NULL, -1, -1, "grp=1", 10, __LINE__);
+    ret_value |= check_query(NULL, -1, -1, "grp=1,t=5", 1, __LINE__);
+    ret_value |= check_query(NULL, -1, -1, "grp=", 0, __LINE__);
+    ret_value |= check_query("appB", -1, -1, "grp=2", 0, __LINE__);
+    ret_value |= check_query("appC", -1, -1, NULL, 0, __LINE__);
+
+    // Deleted objects leave the indexes
+    if (PDCobj_del(obj5) != SUCCEED) {
+        printf("fail to delete object @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    ret_value |= check_query(NULL, -1, -1, "grp=1", 9, __LINE__);
+    ret_value |= check_query("appB", 1, 9, NULL, 4, __LINE__);
+
+    PDCobj_close(obj5);
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright Notice for
+ * Proactive Data Containers (PDC) Software Library and Utilities
+ * -----------------------------------------------------------------------------
+
+ *** Copyright Notice ***
+
+ * Proactive Data Containers (PDC) Copyright (c) 2017, The Regents of the
+ * University of California, through Lawrence Berkeley National Laboratory,
+ * UChicago Argonne, LLC, operator of Argonne National Laboratory, and The HDF
+ * Group (subject to receipt of any required approvals from the U.S. Dept. of
+ * Energy).  All rights reserved.
+
+ * If you have questions about your rights to use or distribute this software,
+ * please contact Berkeley Lab's Innovation & Partnerships Office at  IPO@lbl.gov.
+
+ * NOTICE.  This Software was developed under funding from the U.S. Department of
+ * Energy and the U.S. Government consequently retains certain rights. As such, the
+ * U.S. Government has been granted for itself and others acting on its behalf a
+ * paid-up, nonexclusive, irrevocable, worldwide license in the Software to
+ * reproduce, distribute copies to the public, prepare derivative works, and
+ * perform publicly and display publicly, and to permit other to do so.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "pdc.h"
+#include "pdc_client_connect.h"
+#define BUF_LEN 1024
+#define N_STEP  8
+
+int
+main(int argc, char **argv)
+{
+    pdcid_t                pdc, cont_prop, cont, obj_prop, obj1, reg, reg_global, transfer_request;
+    perr_t                 ret;
+    char                   cont_name[128], obj_name1[128];
+    int                    rank = 0, step, i;
+    int                    ret_value = 0;
+    uint64_t               offset[1], offset_length[1], dims[1];
+    pdc_bulk_cache_stats_t stats;
+
+    int *data      = (int *)malloc(sizeof(int) * BUF_LEN);
+    int *data_read = (int *)malloc(sizeof(int) * BUF_LEN);
+
+    // Use bulk transfers even when the server is on the same node, and cache their registration
+    setenv("PDC_SHM_ARENA_SIZE_MB", "0", 1);
+    setenv("PDC_BULK_CACHE_SIZE_MB", "16", 1);
+
+#ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    pdc = PDCinit("pdc");
+
+    cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc);
+    sprintf(cont_name, "c%d", rank);
+    cont = PDCcont_create(cont_name, cont_prop);
+    if (cont <= 0) {
+        printf("Fail to create container @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    dims[0]  = BUF_LEN;
+    obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc);
+    PDCprop_set_obj_type(obj_prop, PDC_INT);
+    PDCprop_set_obj_dims(obj_prop, 1, dims);
+    PDCprop_set_obj_user_id(obj_prop, getuid());
+    PDCprop_set_obj_app_name(obj_prop, "BulkCacheTest");
+
+    sprintf(obj_name1, "o1_%d", rank);
+    obj1 = PDCobj_create(cont, obj_name1, obj_prop);
+    if (obj1 <= 0) {
+        printf("Fail to create object @ line  %d!\n", __LINE__);
+        ret_value = 1;
+    }
+
+    offset[0]        = 0;
+    offset_length[0] = BUF_LEN;
+    reg              = PDCregion_create(1, offset, offset_length);
+    reg_global       = PDCregion_create(1, offset, offset_length);
+
+    // Write the same buffer every timestep, only the first transfer registers it
+    for (step = 0; step < N_STEP; step++) {
+        for (i = 0; i < BUF_LEN; ++i)
+            data[i] = i + step;
+
+        transfer_request = PDCregion_transfer_create(data, PDC_WRITE, obj1, reg, reg_global);
+        ret              = PDCregion_transfer_start(transfer_request);
+        if (ret != SUCCEED) {
+            printf("Fail to region transfer start @ line %d\n", __LINE__);
+            ret_value = 1;
+        }
+        ret = PDCregion_transfer_wait(transfer_request);
+        if (ret != SUCCEED) {
+            printf("Fail to region transfer wait @ line %d\n", __LINE__);
+            ret_value = 1;
+        }
+        PDCregion_transfer_close(transfer_request);
+    }
+
+    transfer_request = PDCregion_transfer_create(data_read, PDC_READ, obj1, reg, reg_global);
+    ret              = PDCregion_transfer_start(transfer_request);
+    if (ret != SUCCEED) {
+        printf("Fail to region transfer start @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    ret = PDCregion_transfer_wait(transfer_request);
+    if (ret != SUCCEED) {
+        printf("Fail to region transfer wait @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCregion_transfer_close(transfer_request);
+
+    for (i = 0; i < BUF_LEN; ++i) {
+        if (data_read[i] != i + N_STEP - 1) {
+            printf("wrong value %d!=%d @ line %d\n", data_read[i], i + N_STEP - 1, __LINE__);
+            ret_value = 1;
+            break;
+        }
+    }
+
+    PDC_Client_bulk_cache_get_stats(&stats);
+    printf("bulk cache: %" PRIu64 " hits, %" PRIu64 " misses\n", stats.n_hit, stats.n_miss);
+    if (stats.n_hit < N_STEP - 1) {
+        printf("expected at least %d bulk cache hits @ line %d\n", N_STEP - 1, __LINE__);
+        ret_value = 1;
+    }
+
+    PDCregion_close(reg);
+    PDCregion_close(reg_global);
+    if (PDCobj_close(obj1) < 0) {
+        printf("fail to close object o1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    if (PDCcont_close(cont) < 0) {
+        printf("fail to close container c1 @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+    PDCprop_close(obj_prop);
+    PDCprop_close(cont_prop);
+    free(data);
+    free(data_read);
+    if (PDCclose(pdc) < 0) {
+        printf("fail to close PDC @ line %d\n", __LINE__);
+        ret_value = 1;
+    }
+#ifdef ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return ret_value;
+}
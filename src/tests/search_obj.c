@@ -76,6 +76,8 @@ main(int argc, char **argv)
     int            n_entry;
     int            use_name = -1;
     pdc_metadata_t entry;
+    int            k, str_len;
+    char           str_buf[TAG_LEN_MAX];
     uint32_t *     hash_key;
     int            j, read_count = 0, tmp_count;
 
@@ -182,7 +184,13 @@ main(int argc, char **argv)
                 break;
             }
             fread(&entry, sizeof(pdc_metadata_t), 1, file);
-            sprintf(obj_names[read_count], "%s", entry.obj_name);
+            // app_name, obj_name, tags and data_location follow the struct
+            for (k = 0; k < 4; k++) {
+                if (fread(&str_len, sizeof(int), 1, file) == 0 || fread(str_buf, str_len, 1, file) == 0)
+                    printf("read failed\n");
+                if (k == 1)
+                    sprintf(obj_names[read_count], "%s", str_buf);
+            }
             obj_ts[i] = entry.time_step;
             /* printf("Read name %s\n", obj_names[read_count]); */
             read_count++;
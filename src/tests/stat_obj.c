@@ -61,6 +61,8 @@ main(int argc, char **argv)
     int             n_entry;
     char *          tmp_dir;
     pdc_metadata_t  entry;
+    int             k, str_len;
+    char            str_buf[TAG_LEN_MAX];
     uint32_t *      hash_key;
     int             j, read_count = 0, tmp_count;
     int             progress_factor;
@@ -172,7 +174,13 @@ main(int argc, char **argv)
             if (fread(&entry, sizeof(pdc_metadata_t), 1, file) == 0) {
                 printf("read failed\n");
             }
-            sprintf(obj_names[read_count], "%s", entry.obj_name);
+            // app_name, obj_name, tags and data_location follow the struct
+            for (k = 0; k < 4; k++) {
+                if (fread(&str_len, sizeof(int), 1, file) == 0 || fread(str_buf, str_len, 1, file) == 0)
+                    printf("read failed\n");
+                if (k == 1)
+                    sprintf(obj_names[read_count], "%s", str_buf);
+            }
             obj_ts[read_count] = entry.time_step;
             read_count++;
         }
@@ -57,6 +57,8 @@ main(int argc, char **argv)
     char            filename[1024], pdc_server_tmp_dir_g[128];
     int             n_entry;
     pdc_metadata_t  entry;
+    int             k, str_len;
+    char            str_buf[TAG_LEN_MAX];
     uint32_t *      hash_key;
     int             j, read_count = 0, tmp_count;
     pdc_metadata_t *res = NULL;
@@ -123,10 +125,10 @@ main(int argc, char **argv)
         use_name = atoi(env_str);
     }
 
-    new.time_step = -1;
-    strcpy(new.app_name, "updated_app_name");
-    strcpy(new.data_location, "updated_obj_data_location");
-    strcpy(new.tags, "updated_tags");
+    new.time_step     = -1;
+    new.app_name      = "updated_app_name";
+    new.data_location = "updated_obj_data_location";
+    new.tags          = "updated_tags";
     srand(rank + 1);
 
     if (rank == 0) {
@@ -177,7 +179,13 @@ main(int argc, char **argv)
             if (fread(&entry, sizeof(pdc_metadata_t), 1, file) == 0) {
                 printf("read failed\n");
             }
-            sprintf(obj_names[read_count], "%s", entry.obj_name);
+            // app_name, obj_name, tags and data_location follow the struct
+            for (k = 0; k < 4; k++) {
+                if (fread(&str_len, sizeof(int), 1, file) == 0 || fread(str_buf, str_len, 1, file) == 0)
+                    printf("read failed\n");
+                if (k == 1)
+                    sprintf(obj_names[read_count], "%s", str_buf);
+            }
             obj_ts[read_count] = entry.time_step;
             read_count++;
         }